@@ -0,0 +1,179 @@
+# Benchmarks of the transforms.
+#
+#   ruby bench/benchmark.rb                  # or: rake bench
+#   ruby bench/benchmark.rb --compare before.json after.json
+#
+# Sizes 2^BENCH_MIN..2^BENCH_MAX points (4..24) are swept for every operation
+# of BENCH_OPS (all by default); DFTs stop at 2^BENCH_DFT_MAX (12) points, 2D
+# DFTs at 2^(BENCH_DFT_MAX + 4). Each case runs for at least BENCH_TIME
+# seconds (0.2) and the best run is reported as ns per point and GFLOPS
+# (5 N log2 N for complex FFTs, 2.5 N log2 N for Hartley transforms, 3 N for
+# magnitudes and N for phases, an atan2 counted as one operation). Where a
+# packed buffer variant runs the same kernel, its time is the kernel time and
+# the rest of the Array call is boxing (unboxing the input and building the
+# result); a negative boxing time means the two runs were too noisy.
+# Results are saved as JSON into BENCH_OUTPUT (bench/results/<time>.json).
+require 'json'
+require 'fileutils'
+require File.expand_path('../../lib/ft', __FILE__)
+
+module FTBench
+  OPERATIONS = %w(fft dft fht dht fft2d dft2d fht2d dht2d magnitude phase)
+
+  module_function
+
+  def setting(name, default)
+    ENV[name] ? ENV[name].to_f : default
+  end
+
+  def now
+    Process.clock_gettime(Process::CLOCK_MONOTONIC)
+  end
+
+  # best time of repeated runs taking at least the time budget
+  def measure(budget)
+    best = nil
+    started = now
+    loop do
+      t = now
+      yield
+      elapsed = now - t
+      best = elapsed if best.nil? || elapsed < best
+      break if now - started >= budget
+    end
+    best
+  end
+
+  def complex(n)
+    [Array.new(n) { |i| Math.sin(i * 0.1) }, Array.new(n) { |i| Math.cos(i * 0.3) }]
+  end
+
+  def real(n)
+    Array.new(n) { |i| Math.sin(i * 0.1) + 0.5 }
+  end
+
+  def matrix(rows, columns)
+    Array.new(rows) { |j| Array.new(columns) { |i| Math.sin(i * 0.1 + j) } }
+  end
+
+  def interleaved(data)
+    data[0].zip(data[1]).flatten.pack('E*')
+  end
+
+  def flops(op, n)
+    log = Math.log2(n)
+    case op
+    when 'fft', 'fft2d' then 5.0 * n * log
+    when 'fht', 'dht', 'fht2d', 'dht2d' then 2.5 * n * log
+    when 'dft' then 8.0 * n * n
+    when 'dft2d' then 8.0 * n * 2 * Math.sqrt(n)
+    when 'magnitude' then 3.0 * n
+    when 'phase' then 1.0 * n
+    end
+  end
+
+  # a call of the Array API and its kernel without boxing (or nil)
+  def prepare(op, n)
+    side = Math.sqrt(n).to_i
+    case op
+    when 'fft', 'dft', 'magnitude', 'phase'
+      data = complex(n)
+      packed = interleaved(data)
+      output = String.new
+      kernel = op == 'fft' ? lambda { FT.fft_buffer(packed, output) } : nil
+      [lambda { data.send(op) }, kernel]
+    when 'fht', 'dht'
+      data = real(n)
+      packed = data.pack('E*')
+      output = String.new
+      [lambda { data.send(op) }, lambda { FT.send("#{op}_buffer", packed, output) }]
+    when 'fft2d', 'dft2d'
+      data = [matrix(side, side), matrix(side, side)]
+      packed = interleaved([data[0].flatten, data[1].flatten])
+      output = String.new
+      kernel = op == 'fft2d' ? lambda { FT.fft2d_buffer(packed, side, output) } : nil
+      [lambda { data.send(op) }, kernel]
+    when 'fht2d', 'dht2d'
+      data = matrix(side, side)
+      packed = data.flatten.pack('E*')
+      output = String.new
+      kernel = op == 'fht2d' ? lambda { FT.fht2d_buffer(packed, side, output) } : nil
+      [lambda { data.send(op) }, kernel]
+    end
+  end
+
+  def sizes(op)
+    min = setting('BENCH_MIN', 4).to_i
+    max = setting('BENCH_MAX', 24).to_i
+    dft_max = setting('BENCH_DFT_MAX', 12).to_i
+    max = [max, dft_max].min if op == 'dft'
+    max = [max, dft_max + 4].min if op == 'dft2d'
+    exponents = (min..max).to_a
+    exponents = exponents.select(&:even?) if op.end_with?('2d')
+    exponents
+  end
+
+  def run
+    budget = setting('BENCH_TIME', 0.2)
+    ops = ENV['BENCH_OPS'] ? ENV['BENCH_OPS'].split(',') : OPERATIONS
+    results = []
+
+    puts format('%-10s %9s %12s %9s %8s %8s', 'operation', 'points', 'ns/point', 'GFLOPS', 'kernel', 'boxing')
+    ops.each do |op|
+      sizes(op).each do |exponent|
+        n = 1 << exponent
+        call, kernel = prepare(op, n)
+        seconds = measure(budget, &call)
+        kernel_seconds = kernel ? measure(budget, &kernel) : nil
+        work = flops(op, n)
+        result = {
+          'operation' => op, 'log2' => exponent, 'points' => n,
+          'seconds' => seconds, 'ns_per_point' => seconds * 1.0e9 / n,
+          'gflops' => work ? work / seconds / 1.0e9 : nil,
+          'kernel_seconds' => kernel_seconds,
+          'boxing_seconds' => kernel_seconds ? seconds - kernel_seconds : nil
+        }
+        results << result
+        puts format('%-10s %9d %12.2f %9s %8s %8s', op, n, result['ns_per_point'],
+          work ? format('%.3f', result['gflops']) : '-',
+          kernel_seconds ? format('%.0f%%', 100.0 * kernel_seconds / seconds) : '-',
+          kernel_seconds ? format('%.0f%%', 100.0 * result['boxing_seconds'] / seconds) : '-')
+        GC.start
+      end
+    end
+
+    save(results)
+  end
+
+  def save(results)
+    path = ENV['BENCH_OUTPUT'] || File.join(File.dirname(__FILE__), 'results', Time.now.strftime('%Y%m%d-%H%M%S') + '.json')
+    FileUtils.mkdir_p(File.dirname(path))
+    meta = {
+      'time' => Time.now.to_s, 'ruby' => RUBY_DESCRIPTION, 'simd' => FT.simd.to_s,
+      'threads' => FT.threads, 'host' => `uname -a`.strip
+    }
+    File.write(path, JSON.pretty_generate('meta' => meta, 'results' => results))
+    puts "results saved to #{path}"
+  end
+
+  # ns/point of two runs side by side, slower cases (by more than 10%) marked
+  def compare(before_path, after_path)
+    before, after = [before_path, after_path].map do |path|
+      JSON.parse(File.read(path))['results'].map { |r| [[r['operation'], r['points']], r] }.to_h
+    end
+    puts format('%-10s %9s %12s %12s %8s', 'operation', 'points', 'before', 'after', 'ratio')
+    (before.keys & after.keys).each do |key|
+      ratio = after[key]['ns_per_point'] / before[key]['ns_per_point']
+      puts format('%-10s %9d %12.2f %12.2f %8.2f%s', key[0], key[1], before[key]['ns_per_point'],
+        after[key]['ns_per_point'], ratio, ratio > 1.1 ? ' slower' : '')
+    end
+  end
+end
+
+if __FILE__ == $0
+  if ARGV[0] == '--compare'
+    FTBench.compare(ARGV[1], ARGV[2])
+  else
+    FTBench.run
+  end
+end
@@ -0,0 +1,362 @@
+/**
+ * @file batch_fft.c
+ * @brief Many FFTs of the same length in one call.
+ * A buffer holds K transforms of N points one after another (interleaved
+ * complex values, like fft_buffer) and the result holds their spectra in
+ * the same order, so a batch costs one method call, one plan and one
+ * output String. Power of 2 lengths are computed batch_width transforms at
+ * a time: the transforms are interleaved element by element (in bit-reversed
+ * order) and every stage runs the batch passes of simd.c, in which each
+ * vector lane belongs to another transform. Even the first stages of short
+ * transforms, too short for the vectors of a single transform, use whole
+ * vectors then. Other lengths are computed one by one with the shared plan.
+ * Large batches are spread over the worker threads, which read and write
+ * the Strings in place; both are locked meanwhile, so other Ruby threads
+ * cannot move their memory.
+ * @author placek@ragnarson.com
+ */
+#include "frequency_transformations.h"
+
+/**
+ * @brief Number of transforms given to a worker thread at once.
+ */
+#define BATCH_CHUNK 64
+
+/**
+ * @brief A batch of transforms of a buffer.
+ */
+typedef struct
+{
+    const ft_buffer * input;
+    char * output;
+    long length;
+    long count;
+    int precision;
+    const ft_plan * plan;
+    const ft_simd_kernels * kernels;
+    long width;
+    VALUE locked[2];
+    ft_buffer buffer;
+} batch_transform;
+
+/**
+ * @brief Compute a chunk of power of 2 transforms in double precision.
+ * @author placek@ragnarson.com
+ * @param index Index of the chunk.
+ * @param data A batch (batch_transform).
+ */
+static void batch_chunk(long index, void * data)
+{
+    const batch_transform * t = data;
+    const ft_plan * plan = t->plan;
+    const ft_simd_kernels * kernels = t->kernels;
+    long n = t->length, w = t->width, first, last, lanes, j, k, step;
+    size_t size = 2 * n * sizeof(double);
+    double * block[2], * values[2];
+    ft_buffer part = *t->input;
+
+    block[0] = malloc(n * w * sizeof(double));
+    block[1] = malloc(n * w * sizeof(double));
+    values[0] = malloc(n * sizeof(double));
+    values[1] = malloc(n * sizeof(double));
+
+    last = (index + 1) * BATCH_CHUNK < t->count ? (index + 1) * BATCH_CHUNK : t->count;
+    for(first = index * BATCH_CHUNK; first < last; first += w)
+    {
+        lanes = last - first < w ? last - first : w;
+
+        // interleave the transforms in bit-reversed order (missing lanes are zeros)
+        for(j = 0; j < w; j++)
+        {
+            if(j < lanes)
+            {
+                part.data = t->input->data + (first + j) * size;
+                ft_buffer_read_complex(&part, values[0], values[1], n);
+            }
+            for(k = 0; k < n; k++)
+            {
+                block[0][plan->reversed[k] * w + j] = j < lanes ? values[0][k] : 0.0;
+                block[1][plan->reversed[k] * w + j] = j < lanes ? values[1][k] : 0.0;
+            }
+        }
+
+        for(step = 1; step < n; step <<= 1)
+            kernels->batch_radix2(block[0], block[1], n, step,
+                plan->twiddle_real + step - 1, plan->twiddle_imag + step - 1);
+
+        for(j = 0; j < lanes; j++)
+        {
+            for(k = 0; k < n; k++)
+            {
+                values[0][k] = block[0][k * w + j] * plan->scale;
+                values[1][k] = block[1][k * w + j] * plan->scale;
+            }
+            ft_buffer_write_complex(t->output + (first + j) * size, values[0], values[1], n);
+        }
+    }
+
+    // no memory leaks
+    free(block[0]);
+    free(block[1]);
+    free(values[0]);
+    free(values[1]);
+}
+
+/**
+ * @brief Compute a chunk of power of 2 transforms in single precision.
+ * @see batch_chunk()
+ * @author placek@ragnarson.com
+ */
+static void batch_chunk_single(long index, void * data)
+{
+    const batch_transform * t = data;
+    const ft_plan * plan = t->plan;
+    const ft_simd_kernels * kernels = t->kernels;
+    long n = t->length, w = t->width, first, last, lanes, j, k, step;
+    size_t size = 2 * n * sizeof(float);
+    float * block[2], * values[2], scale = (float)plan->scale;
+    ft_buffer part = *t->input;
+
+    block[0] = malloc(n * w * sizeof(float));
+    block[1] = malloc(n * w * sizeof(float));
+    values[0] = malloc(n * sizeof(float));
+    values[1] = malloc(n * sizeof(float));
+
+    last = (index + 1) * BATCH_CHUNK < t->count ? (index + 1) * BATCH_CHUNK : t->count;
+    for(first = index * BATCH_CHUNK; first < last; first += w)
+    {
+        lanes = last - first < w ? last - first : w;
+
+        // interleave the transforms in bit-reversed order (missing lanes are zeros)
+        for(j = 0; j < w; j++)
+        {
+            if(j < lanes)
+            {
+                part.data = t->input->data + (first + j) * size;
+                ft_buffer_read_complex_single(&part, values[0], values[1], n);
+            }
+            for(k = 0; k < n; k++)
+            {
+                block[0][plan->reversed[k] * w + j] = j < lanes ? values[0][k] : 0.0f;
+                block[1][plan->reversed[k] * w + j] = j < lanes ? values[1][k] : 0.0f;
+            }
+        }
+
+        for(step = 1; step < n; step <<= 1)
+            kernels->batch_radix2_float(block[0], block[1], n, step,
+                plan->single_twiddle_real + step - 1, plan->single_twiddle_imag + step - 1);
+
+        for(j = 0; j < lanes; j++)
+        {
+            for(k = 0; k < n; k++)
+            {
+                values[0][k] = block[0][k * w + j] * scale;
+                values[1][k] = block[1][k * w + j] * scale;
+            }
+            ft_buffer_write_complex_single(t->output + (first + j) * size, values[0], values[1], n);
+        }
+    }
+
+    // no memory leaks
+    free(block[0]);
+    free(block[1]);
+    free(values[0]);
+    free(values[1]);
+}
+
+/**
+ * @brief Compute a chunk of transforms of other lengths one by one.
+ * Single precision data is transformed in double precision and rounded.
+ * @see batch_chunk()
+ * @author placek@ragnarson.com
+ */
+static void batch_chunk_plan(long index, void * data)
+{
+    const batch_transform * t = data;
+    long n = t->length, i, k, last;
+    size_t size = 2 * n * (t->precision == FT_FLOAT32 ? sizeof(float) : sizeof(double));
+    double * values[2], * scratch = malloc((ft_plan_scratch_length(t->plan) + 1) * sizeof(double));
+    float * single[2] = { NULL, NULL };
+    ft_buffer part = *t->input;
+
+    values[0] = malloc(n * sizeof(double));
+    values[1] = malloc(n * sizeof(double));
+    if(t->precision == FT_FLOAT32)
+    {
+        single[0] = malloc(n * sizeof(float));
+        single[1] = malloc(n * sizeof(float));
+    }
+
+    last = (index + 1) * BATCH_CHUNK < t->count ? (index + 1) * BATCH_CHUNK : t->count;
+    for(i = index * BATCH_CHUNK; i < last; i++)
+    {
+        part.data = t->input->data + i * size;
+        if(t->precision == FT_FLOAT32)
+        {
+            ft_buffer_read_complex_single(&part, single[0], single[1], n);
+            for(k = 0; k < n; k++)
+            {
+                values[0][k] = single[0][k];
+                values[1][k] = single[1][k];
+            }
+        }
+        else
+            ft_buffer_read_complex(&part, values[0], values[1], n);
+
+        ft_plan_execute_scratch(t->plan, values[0], values[1], scratch);
+
+        if(t->precision == FT_FLOAT32)
+        {
+            for(k = 0; k < n; k++)
+            {
+                single[0][k] = (float)values[0][k];
+                single[1][k] = (float)values[1][k];
+            }
+            ft_buffer_write_complex_single(t->output + i * size, single[0], single[1], n);
+        }
+        else
+            ft_buffer_write_complex(t->output + i * size, values[0], values[1], n);
+    }
+
+    // no memory leaks
+    free(scratch);
+    free(values[0]);
+    free(values[1]);
+    free(single[0]);
+    free(single[1]);
+}
+
+/**
+ * @brief Compute all the transforms of a batch (run without the GVL).
+ * @author placek@ragnarson.com
+ * @param data A batch (batch_transform).
+ * @return NULL.
+ */
+static void * batch_run(void * data)
+{
+    batch_transform * t = data;
+    long chunks = (t->count + BATCH_CHUNK - 1) / BATCH_CHUNK;
+
+    if(t->plan->algorithm != FT_RADIX2)
+        ft_parallel_for(chunks, batch_chunk_plan, t);
+    else if(t->precision == FT_FLOAT32)
+        ft_parallel_for(chunks, batch_chunk_single, t);
+    else
+        ft_parallel_for(chunks, batch_chunk, t);
+
+    return NULL;
+}
+
+static VALUE batch_body(VALUE data)
+{
+    batch_transform * t = (batch_transform *)data;
+
+    // do the actual transforms
+    ft_without_gvl(batch_run, t, t->count * t->length);
+
+    return Qnil;
+}
+
+static VALUE batch_release(VALUE data)
+{
+    batch_transform * t = (batch_transform *)data;
+
+    if(!NIL_P(t->locked[0]))
+        rb_str_unlocktmp(t->locked[0]);
+    if(!NIL_P(t->locked[1]))
+        rb_str_unlocktmp(t->locked[1]);
+    ft_buffer_close(&t->buffer);
+    ft_plan_free((ft_plan *)t->plan);
+
+    return Qnil;
+}
+
+/**
+ * @brief Compute FFTs of a batch of transforms in a buffer.
+ * The instruction set is taken once, so FT.simd= called by another thread
+ * meanwhile does not change the width of the blocks under the workers.
+ * @author placek@ragnarson.com
+ * @params argc Number of arguments.
+ * @params argv Arguments (input, length of a transform, optional output String and precision: option).
+ * @params direction An FFT direction (1 - forward FFT, -1 - reverse FFT).
+ * @return The output String (nil for empty data or data that is not a whole number of transforms).
+ */
+static VALUE prepare_batch_buffer(int argc, VALUE * argv, int direction)
+{
+    VALUE input, rb_length, output, options;
+    ft_plan * plan;
+    batch_transform t;
+    long size;
+
+    rb_scan_args(argc, argv, "21:", &input, &rb_length, &output, &options);
+    t.precision = ft_precision(options);
+    t.length = NUM2LONG(rb_length);
+    if(t.length < 1)
+        rb_raise(rb_eArgError, "length should be positive");
+    size = 2 * t.length * (t.precision == FT_FLOAT32 ? sizeof(float) : sizeof(double));
+    ft_buffer_open(input, &t.buffer, t.precision);
+    t.count = t.buffer.size / size;
+    if(t.count < 1 || t.buffer.size % size)
+    {
+        ft_buffer_close(&t.buffer);
+        return Qnil;
+    }
+    if(!NIL_P(output) && !RB_TYPE_P(output, T_STRING))
+    {
+        ft_buffer_close(&t.buffer);
+        Check_Type(output, T_STRING);
+    }
+
+    // pin both Strings (the output may be the input itself)
+    output = ft_buffer_output(output, t.count * size);
+    t.locked[0] = RB_TYPE_P(input, T_STRING) ? rb_str_locktmp(input) : Qnil;
+    t.locked[1] = output != input ? rb_str_locktmp(output) : Qnil;
+    if(RB_TYPE_P(input, T_STRING))
+        t.buffer.data = RSTRING_PTR(input);
+
+    plan = ft_plan_create(t.length, direction);
+    if(t.precision == FT_FLOAT32 && plan->algorithm == FT_RADIX2)
+        ft_plan_make_single(plan);
+    t.input = &t.buffer;
+    t.output = RSTRING_PTR(output);
+    t.plan = plan;
+    t.kernels = ft_simd();
+    t.width = t.precision == FT_FLOAT32 ? t.kernels->batch_width_float : t.kernels->batch_width;
+
+    rb_ensure(batch_body, (VALUE)&t, batch_release, (VALUE)&t);
+
+    return output;
+}
+
+/**
+ * @brief Compute forward FFTs of a batch.
+ * FT.fft_batch_buffer(input, length, output = nil, precision: :float64)
+ * transforms every run of length complex values of the input.
+ * @author placek@ragnarson.com
+ * @return A String with the interleaved spectra.
+ */
+static VALUE fft_batch_buffer(int argc, VALUE * argv, VALUE self)
+{
+    return prepare_batch_buffer(argc, argv, 1);
+}
+
+/**
+ * @brief Compute reverse FFTs of a batch.
+ * @see fft_batch_buffer()
+ * @author placek@ragnarson.com
+ * @return A String with the interleaved data.
+ */
+static VALUE rfft_batch_buffer(int argc, VALUE * argv, VALUE self)
+{
+    return prepare_batch_buffer(argc, argv, -1);
+}
+
+/**
+ * @brief Define the batch buffer transforms.
+ * @author placek@ragnarson.com
+ */
+void Init_batch_fft(void)
+{
+    rb_define_singleton_method(FT, "fft_batch_buffer", fft_batch_buffer, -1);
+    rb_define_singleton_method(FT, "rfft_batch_buffer", rfft_batch_buffer, -1);
+}
@@ -0,0 +1,655 @@
+/**
+ * @file buffer.c
+ * @brief Transforms of packed binary buffers.
+ * The data is read straight from a binary String of little-endian doubles
+ * (or an object exporting a memory view of doubles, like Numo::DFloat or
+ * Numo::DComplex) and written into a binary String, so no Ruby object is
+ * created per element. Complex data is interleaved (real, imaginary, real, ...).
+ * FFT and FHT buffers can also hold floats (precision: :float32), which are
+ * transformed in single precision.
+ * @author placek@ragnarson.com
+ */
+#include "frequency_transformations.h"
+#include "ruby/encoding.h"
+#include <string.h>
+
+/**
+ * @brief Open a buffer for reading.
+ * Accepts a String or, where available, an object exporting a contiguous
+ * memory view of doubles (or floats).
+ * @author placek@ragnarson.com
+ * @param object A String or an object with memory view.
+ * @param buffer A buffer to fill.
+ * @param precision FT_FLOAT64 for doubles, FT_FLOAT32 for floats.
+ */
+void ft_buffer_open(VALUE object, ft_buffer * buffer, int precision)
+{
+    buffer->object = object;
+    buffer->precision = precision;
+    buffer->view_taken = FALSE;
+
+    if(RB_TYPE_P(object, T_STRING))
+    {
+        buffer->data = RSTRING_PTR(object);
+        buffer->size = RSTRING_LEN(object);
+        buffer->swap = FT_BIG_ENDIAN;
+        return;
+    }
+
+#ifdef HAVE_RUBY_MEMORY_VIEW_H
+    if(rb_memory_view_available_p(object) &&
+        rb_memory_view_get(object, &buffer->view, RUBY_MEMORY_VIEW_FORMAT | RUBY_MEMORY_VIEW_ROW_MAJOR))
+    {
+        const char * format = buffer->view.format;
+
+        buffer->view_taken = TRUE;
+        if(!rb_memory_view_is_row_major_contiguous(&buffer->view) || !format || !*format ||
+            strspn(format, precision == FT_FLOAT32 ? "f" : "d") != strlen(format))
+        {
+            ft_buffer_close(buffer);
+            rb_raise(rb_eTypeError, "memory view should be a contiguous buffer of %s",
+                precision == FT_FLOAT32 ? "floats" : "doubles");
+        }
+        buffer->data = buffer->view.data;
+        buffer->size = buffer->view.byte_size;
+        buffer->swap = FALSE;
+        return;
+    }
+#endif
+
+    rb_raise(rb_eTypeError, "expected a String of packed %s", precision == FT_FLOAT32 ? "floats" : "doubles");
+}
+
+/**
+ * @brief Close a buffer opened by ft_buffer_open().
+ * @author placek@ragnarson.com
+ * @param buffer A buffer.
+ */
+void ft_buffer_close(ft_buffer * buffer)
+{
+#ifdef HAVE_RUBY_MEMORY_VIEW_H
+    if(buffer->view_taken)
+        rb_memory_view_release(&buffer->view);
+#endif
+    buffer->view_taken = FALSE;
+}
+
+/**
+ * @brief Prepare an output String.
+ * Reuses the given String (resized to the needed size) or creates a new one.
+ * @author placek@ragnarson.com
+ * @param output A String to reuse or nil.
+ * @param size Number of bytes.
+ * @return A binary String of the given size.
+ */
+VALUE ft_buffer_output(VALUE output, long size)
+{
+    if(NIL_P(output))
+        output = rb_str_new(NULL, size);
+    else
+    {
+        Check_Type(output, T_STRING);
+        rb_str_modify(output);
+        rb_str_resize(output, size);
+    }
+    rb_enc_associate(output, rb_ascii8bit_encoding());
+
+    return output;
+}
+
+/**
+ * @brief Read a double from a buffer.
+ * @author placek@ragnarson.com
+ * @param data Pointer to 8 bytes.
+ * @param swap Reverse the byte order.
+ * @return The value.
+ */
+static double read_double(const char * data, int swap)
+{
+    double value;
+    char bytes[sizeof(double)];
+    int i;
+
+    if(!swap)
+    {
+        memcpy(&value, data, sizeof(double));
+        return value;
+    }
+    for(i = 0; i < (int)sizeof(double); i++)
+        bytes[i] = data[sizeof(double) - 1 - i];
+    memcpy(&value, bytes, sizeof(double));
+    return value;
+}
+
+/**
+ * @brief Write a little-endian double into a buffer.
+ * @author placek@ragnarson.com
+ * @param data Pointer to 8 bytes.
+ * @param value The value.
+ */
+static void write_double(char * data, double value)
+{
+    char bytes[sizeof(double)];
+    int i;
+
+    memcpy(bytes, &value, sizeof(double));
+    if(!FT_BIG_ENDIAN)
+    {
+        memcpy(data, bytes, sizeof(double));
+        return;
+    }
+    for(i = 0; i < (int)sizeof(double); i++)
+        data[i] = bytes[sizeof(double) - 1 - i];
+}
+
+/**
+ * @brief Read a float from a buffer.
+ * @see read_double()
+ * @author placek@ragnarson.com
+ */
+static float read_float(const char * data, int swap)
+{
+    float value;
+    char bytes[sizeof(float)];
+    int i;
+
+    if(!swap)
+    {
+        memcpy(&value, data, sizeof(float));
+        return value;
+    }
+    for(i = 0; i < (int)sizeof(float); i++)
+        bytes[i] = data[sizeof(float) - 1 - i];
+    memcpy(&value, bytes, sizeof(float));
+    return value;
+}
+
+/**
+ * @brief Write a little-endian float into a buffer.
+ * @see write_double()
+ * @author placek@ragnarson.com
+ */
+static void write_float(char * data, float value)
+{
+    char bytes[sizeof(float)];
+    int i;
+
+    memcpy(bytes, &value, sizeof(float));
+    if(!FT_BIG_ENDIAN)
+    {
+        memcpy(data, bytes, sizeof(float));
+        return;
+    }
+    for(i = 0; i < (int)sizeof(float); i++)
+        data[i] = bytes[sizeof(float) - 1 - i];
+}
+
+/**
+ * @brief Read one little-endian value of packed data.
+ * @author placek@ragnarson.com
+ * @param data Pointer to the value.
+ * @param precision FT_FLOAT64 or FT_FLOAT32.
+ * @return The value.
+ */
+double ft_buffer_load(const char * data, int precision)
+{
+    if(precision == FT_FLOAT32)
+        return read_float(data, FT_BIG_ENDIAN);
+    return read_double(data, FT_BIG_ENDIAN);
+}
+
+/**
+ * @brief Write one little-endian value of packed data.
+ * @author placek@ragnarson.com
+ * @param data Pointer to the value.
+ * @param value The value.
+ * @param precision FT_FLOAT64 or FT_FLOAT32.
+ */
+void ft_buffer_store(char * data, double value, int precision)
+{
+    if(precision == FT_FLOAT32)
+        write_float(data, (float)value);
+    else
+        write_double(data, value);
+}
+
+/**
+ * @brief Unpack interleaved complex data into real and imaginary parts.
+ * @author placek@ragnarson.com
+ * @param buffer An open buffer.
+ * @param real Place for real parts.
+ * @param imag Place for imaginary parts.
+ * @param length Number of complex values.
+ */
+void ft_buffer_read_complex(const ft_buffer * buffer, double * real, double * imag, long length)
+{
+    long i;
+    const char * data = buffer->data;
+
+    for(i = 0; i < length; i++)
+    {
+        real[i] = read_double(data + 2 * i * sizeof(double), buffer->swap);
+        imag[i] = read_double(data + (2 * i + 1) * sizeof(double), buffer->swap);
+    }
+}
+
+/**
+ * @brief Unpack real data.
+ * @author placek@ragnarson.com
+ * @param buffer An open buffer.
+ * @param values Place for values.
+ * @param length Number of values.
+ */
+void ft_buffer_read_real(const ft_buffer * buffer, double * values, long length)
+{
+    long i;
+
+    if(!buffer->swap)
+    {
+        memcpy(values, buffer->data, length * sizeof(double));
+        return;
+    }
+    for(i = 0; i < length; i++)
+        values[i] = read_double(buffer->data + i * sizeof(double), TRUE);
+}
+
+/**
+ * @brief Pack real and imaginary parts into interleaved little-endian data.
+ * @author placek@ragnarson.com
+ * @param data Output bytes (16 per value).
+ * @param real Real parts.
+ * @param imag Imaginary parts.
+ * @param length Number of complex values.
+ */
+void ft_buffer_write_complex(char * data, const double * real, const double * imag, long length)
+{
+    long i;
+
+    for(i = 0; i < length; i++)
+    {
+        write_double(data + 2 * i * sizeof(double), real[i]);
+        write_double(data + (2 * i + 1) * sizeof(double), imag[i]);
+    }
+}
+
+/**
+ * @brief Pack real data into little-endian data.
+ * @author placek@ragnarson.com
+ * @param data Output bytes (8 per value).
+ * @param values Values.
+ * @param length Number of values.
+ */
+void ft_buffer_write_real(char * data, const double * values, long length)
+{
+    long i;
+
+    if(!FT_BIG_ENDIAN)
+    {
+        memcpy(data, values, length * sizeof(double));
+        return;
+    }
+    for(i = 0; i < length; i++)
+        write_double(data + i * sizeof(double), values[i]);
+}
+
+/**
+ * @brief Unpack interleaved complex floats into real and imaginary parts.
+ * @see ft_buffer_read_complex()
+ * @author placek@ragnarson.com
+ */
+void ft_buffer_read_complex_single(const ft_buffer * buffer, float * real, float * imag, long length)
+{
+    long i;
+    const char * data = buffer->data;
+
+    for(i = 0; i < length; i++)
+    {
+        real[i] = read_float(data + 2 * i * sizeof(float), buffer->swap);
+        imag[i] = read_float(data + (2 * i + 1) * sizeof(float), buffer->swap);
+    }
+}
+
+/**
+ * @brief Unpack real floats.
+ * @see ft_buffer_read_real()
+ * @author placek@ragnarson.com
+ */
+void ft_buffer_read_real_single(const ft_buffer * buffer, float * values, long length)
+{
+    long i;
+
+    if(!buffer->swap)
+    {
+        memcpy(values, buffer->data, length * sizeof(float));
+        return;
+    }
+    for(i = 0; i < length; i++)
+        values[i] = read_float(buffer->data + i * sizeof(float), TRUE);
+}
+
+/**
+ * @brief Pack real and imaginary parts into interleaved little-endian floats.
+ * @see ft_buffer_write_complex()
+ * @author placek@ragnarson.com
+ */
+void ft_buffer_write_complex_single(char * data, const float * real, const float * imag, long length)
+{
+    long i;
+
+    for(i = 0; i < length; i++)
+    {
+        write_float(data + 2 * i * sizeof(float), real[i]);
+        write_float(data + (2 * i + 1) * sizeof(float), imag[i]);
+    }
+}
+
+/**
+ * @brief Pack real data into little-endian floats.
+ * @see ft_buffer_write_real()
+ * @author placek@ragnarson.com
+ */
+void ft_buffer_write_real_single(char * data, const float * values, long length)
+{
+    long i;
+
+    if(!FT_BIG_ENDIAN)
+    {
+        memcpy(data, values, length * sizeof(float));
+        return;
+    }
+    for(i = 0; i < length; i++)
+        write_float(data + i * sizeof(float), values[i]);
+}
+
+/**
+ * @brief Compute a FFT of a buffer.
+ * @author placek@ragnarson.com
+ * @params argc Number of arguments.
+ * @params argv Arguments (input, optional output String and precision: option).
+ * @params direction An FFT direction (1 - forward FFT, -1 - reverse FFT).
+ * @return The output String (nil for empty or uneven data).
+ */
+static VALUE prepare_fft_buffer(int argc, VALUE * argv, int direction)
+{
+    VALUE input, output, options;
+    ft_buffer buffer;
+    ft_plan * plan;
+    long length, size;
+    int precision;
+    double * values;
+
+    rb_scan_args(argc, argv, "11:", &input, &output, &options);
+    precision = ft_precision(options);
+    size = 2 * (precision == FT_FLOAT32 ? sizeof(float) : sizeof(double));
+    ft_buffer_open(input, &buffer, precision);
+    length = buffer.size / size;
+    if(length < 1 || buffer.size % size)
+    {
+        ft_buffer_close(&buffer);
+        return Qnil;
+    }
+
+    plan = ft_plan_create(length, direction);
+    if(precision == FT_FLOAT32)
+    {
+        ft_plan_make_single(plan);
+        ft_buffer_read_complex_single(&buffer, plan->single_buffer[0], plan->single_buffer[1], length);
+        ft_buffer_close(&buffer);
+        ft_plan_execute_single_without_gvl(plan, plan->single_buffer[0], plan->single_buffer[1], FALSE);
+        output = ft_buffer_output(output, length * size);
+        ft_buffer_write_complex_single(RSTRING_PTR(output), plan->single_buffer[0], plan->single_buffer[1], length);
+        ft_plan_free(plan);
+        return output;
+    }
+
+    values = malloc(2 * length * sizeof(double));
+    ft_buffer_read_complex(&buffer, values, values + length, length);
+    ft_buffer_close(&buffer);
+
+    // do the actual transform
+    ft_plan_execute_without_gvl(plan, values, values + length);
+
+    output = ft_buffer_output(output, length * size);
+    ft_buffer_write_complex(RSTRING_PTR(output), values, values + length, length);
+    ft_plan_free(plan);
+    free(values);
+
+    return output;
+}
+
+/**
+ * @brief Compute a forward FFT of a buffer.
+ * FT.fft_buffer(input, output = nil, precision: :float64)
+ * @author placek@ragnarson.com
+ * @return A String with the interleaved spectrum.
+ */
+static VALUE fft_buffer(int argc, VALUE * argv, VALUE self)
+{
+    return prepare_fft_buffer(argc, argv, 1);
+}
+
+/**
+ * @brief Compute a reverse FFT of a buffer.
+ * FT.rfft_buffer(input, output = nil, precision: :float64)
+ * @author placek@ragnarson.com
+ * @return A String with interleaved data.
+ */
+static VALUE rfft_buffer(int argc, VALUE * argv, VALUE self)
+{
+    return prepare_fft_buffer(argc, argv, -1);
+}
+
+/**
+ * @brief Compute a FFT of a buffer of real data.
+ * FT.real_fft_buffer(input, output = nil)
+ * @see ft_real_plan_forward()
+ * @author placek@ragnarson.com
+ * @return A String with the interleaved length / 2 + 1 bins.
+ */
+static VALUE real_fft_buffer(int argc, VALUE * argv, VALUE self)
+{
+    VALUE input, output;
+    ft_buffer buffer;
+    ft_real_plan * plan;
+    double * values, * spectrum[2];
+    long length;
+
+    rb_scan_args(argc, argv, "11", &input, &output);
+    ft_buffer_open(input, &buffer, FT_FLOAT64);
+    length = buffer.size / sizeof(double);
+    if(length < 1 || buffer.size % sizeof(double))
+    {
+        ft_buffer_close(&buffer);
+        return Qnil;
+    }
+
+    values = malloc(length * sizeof(double));
+    spectrum[0] = malloc((length / 2 + 1) * sizeof(double));
+    spectrum[1] = malloc((length / 2 + 1) * sizeof(double));
+    ft_buffer_read_real(&buffer, values, length);
+    ft_buffer_close(&buffer);
+
+    // do the actual transform
+    plan = ft_real_plan_create(length, 1);
+    ft_real_plan_forward_without_gvl(plan, values, spectrum[0], spectrum[1]);
+    ft_real_plan_free(plan);
+
+    output = ft_buffer_output(output, 2 * (length / 2 + 1) * sizeof(double));
+    ft_buffer_write_complex(RSTRING_PTR(output), spectrum[0], spectrum[1], length / 2 + 1);
+
+    // no memory leaks
+    free(values);
+    free(spectrum[0]);
+    free(spectrum[1]);
+
+    return output;
+}
+
+/**
+ * @brief Compute a reverse FFT of a buffer with half of a spectrum of real data.
+ * FT.inverse_real_fft_buffer(input, length = nil, output = nil)
+ * @see ft_real_plan_inverse()
+ * @author placek@ragnarson.com
+ * @return A String with real data.
+ */
+static VALUE inverse_real_fft_buffer(int argc, VALUE * argv, VALUE self)
+{
+    VALUE input, rb_length, output;
+    ft_buffer buffer;
+    ft_real_plan * plan;
+    double * values, * spectrum[2];
+    long bins, length;
+
+    rb_scan_args(argc, argv, "12", &input, &rb_length, &output);
+    ft_buffer_open(input, &buffer, FT_FLOAT64);
+    bins = buffer.size / (2 * sizeof(double));
+    length = NIL_P(rb_length) ? 2 * (bins - 1) : NUM2LONG(rb_length);
+    if(length < 1 || length / 2 + 1 != bins || buffer.size % (2 * sizeof(double)))
+    {
+        ft_buffer_close(&buffer);
+        return Qnil;
+    }
+
+    values = malloc(length * sizeof(double));
+    spectrum[0] = malloc(bins * sizeof(double));
+    spectrum[1] = malloc(bins * sizeof(double));
+    ft_buffer_read_complex(&buffer, spectrum[0], spectrum[1], bins);
+    ft_buffer_close(&buffer);
+
+    // do the actual transform
+    plan = ft_real_plan_create(length, -1);
+    ft_real_plan_inverse_without_gvl(plan, spectrum[0], spectrum[1], values);
+    ft_real_plan_free(plan);
+
+    output = ft_buffer_output(output, length * sizeof(double));
+    ft_buffer_write_real(RSTRING_PTR(output), values, length);
+
+    // no memory leaks
+    free(values);
+    free(spectrum[0]);
+    free(spectrum[1]);
+
+    return output;
+}
+
+/**
+ * @brief Compute a single precision FHT of a buffer of floats.
+ * @see ft_fht_single()
+ * @author placek@ragnarson.com
+ * @param input A String of packed floats (or a memory view of floats).
+ * @param output A String to reuse or nil.
+ * @return The output String (nil for data of odd length).
+ */
+static VALUE fht_buffer_single(VALUE input, VALUE output)
+{
+    ft_buffer buffer;
+    ft_plan * plan;
+    long length;
+
+    ft_buffer_open(input, &buffer, FT_FLOAT32);
+    length = buffer.size / sizeof(float);
+    if(length % 2 == 1 || buffer.size % sizeof(float))
+    {
+        ft_buffer_close(&buffer);
+        return Qnil;
+    }
+    if(length == 0)
+    {
+        ft_buffer_close(&buffer);
+        return ft_buffer_output(output, 0);
+    }
+
+    plan = ft_plan_create(length, 1);
+    ft_plan_make_single(plan);
+    ft_buffer_read_real_single(&buffer, plan->single_buffer[0], length);
+    ft_buffer_close(&buffer);
+
+    // do the actual transform
+    ft_plan_execute_single_without_gvl(plan, plan->single_buffer[0], plan->single_buffer[1], TRUE);
+
+    output = ft_buffer_output(output, length * sizeof(float));
+    ft_buffer_write_real_single(RSTRING_PTR(output), plan->single_buffer[0], length);
+    ft_plan_free(plan);
+
+    return output;
+}
+
+/**
+ * @brief Compute a Hartley transform of a buffer.
+ * @author placek@ragnarson.com
+ * @params argc Number of arguments.
+ * @params argv Arguments (input, optional output String and, for FHT, precision: option).
+ * @params fast Use FHT (TRUE) or DHT (FALSE).
+ * @return The output String (nil for data of odd length).
+ */
+static VALUE prepare_hartley_buffer(int argc, VALUE * argv, int fast)
+{
+    VALUE input, output, options = Qnil;
+    ft_buffer buffer;
+    double * values;
+    long length;
+
+    if(fast)
+        rb_scan_args(argc, argv, "11:", &input, &output, &options);
+    else
+        rb_scan_args(argc, argv, "11", &input, &output);
+    if(ft_precision(options) == FT_FLOAT32)
+        return fht_buffer_single(input, output);
+
+    ft_buffer_open(input, &buffer, FT_FLOAT64);
+    length = buffer.size / sizeof(double);
+    if(length % 2 == 1 || buffer.size % sizeof(double))
+    {
+        ft_buffer_close(&buffer);
+        return Qnil;
+    }
+
+    values = malloc(length * sizeof(double));
+    ft_buffer_read_real(&buffer, values, length);
+    ft_buffer_close(&buffer);
+
+    // do the actual transform
+    ft_perform_job(fast ? FT_JOB_FHT : FT_JOB_DHT, values, NULL, length, 1);
+
+    output = ft_buffer_output(output, length * sizeof(double));
+    ft_buffer_write_real(RSTRING_PTR(output), values, length);
+    free(values);
+
+    return output;
+}
+
+/**
+ * @brief Compute a FHT of a buffer.
+ * FT.fht_buffer(input, output = nil, precision: :float64)
+ * @author placek@ragnarson.com
+ * @return A String with transformed data.
+ */
+static VALUE fht_buffer(int argc, VALUE * argv, VALUE self)
+{
+    return prepare_hartley_buffer(argc, argv, TRUE);
+}
+
+/**
+ * @brief Compute a DHT of a buffer.
+ * FT.dht_buffer(input, output = nil)
+ * @author placek@ragnarson.com
+ * @return A String with transformed data.
+ */
+static VALUE dht_buffer(int argc, VALUE * argv, VALUE self)
+{
+    return prepare_hartley_buffer(argc, argv, FALSE);
+}
+
+/**
+ * @brief Define the buffer transforms.
+ * @author placek@ragnarson.com
+ */
+void Init_buffer(void)
+{
+    rb_define_singleton_method(FT, "fft_buffer", fft_buffer, -1);
+    rb_define_singleton_method(FT, "rfft_buffer", rfft_buffer, -1);
+    rb_define_singleton_method(FT, "real_fft_buffer", real_fft_buffer, -1);
+    rb_define_singleton_method(FT, "inverse_real_fft_buffer", inverse_real_fft_buffer, -1);
+    rb_define_singleton_method(FT, "fht_buffer", fht_buffer, -1);
+    rb_define_singleton_method(FT, "dht_buffer", dht_buffer, -1);
+}
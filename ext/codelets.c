@@ -0,0 +1,73 @@
+/**
+ * @file codelets.c
+ * @brief Unrolled kernels of short transforms.
+ * FFTs and FHTs of powers of 2 up to FT_CODELET_MAX points are computed by
+ * straight-line code generated by generate_codelets.rb (see codelets.h):
+ * no loop control, no bit-reversal loop and no factor recurrence or table,
+ * the factors are constants of the code and trivial ones cost nothing. The
+ * plans, fft_kernel() and fht_kernel() hand such lengths over to them.
+ * @author placek@ragnarson.com
+ */
+#include "frequency_transformations.h"
+#include "codelets.h"
+
+/**
+ * @brief Get the codelet index of a length.
+ * @author placek@ragnarson.com
+ * @param length Length of a transform.
+ * @return log2 of the length (0 if there is no codelet of the length).
+ */
+static int codelet_index(long length)
+{
+    int index = 0;
+
+    if(length < 2 || length > FT_CODELET_MAX || (length & (length - 1)))
+        return 0;
+    while(length > 1)
+    {
+        length >>= 1;
+        index++;
+    }
+    return index;
+}
+
+/**
+ * @brief Compute a short FFT in place with a codelet.
+ * The result is not scaled.
+ * @author placek@ragnarson.com
+ * @param real Real parts of processing data.
+ * @param imag Imaginary parts of processing data.
+ * @param length Length of processing data.
+ * @param direction An FFT direction (1 - forward FFT, -1 - reverse FFT).
+ * @return TRUE if there is a codelet of the length (FALSE - nothing done).
+ */
+int ft_codelet_fft(double * real, double * imag, long length, int direction)
+{
+    int index = codelet_index(length);
+
+    if(index == 0)
+        return FALSE;
+    if(direction == -1)
+        fft_codelets_reverse[index](real, imag);
+    else
+        fft_codelets_forward[index](real, imag);
+    return TRUE;
+}
+
+/**
+ * @brief Compute a short FHT in place with a codelet.
+ * The result is normalized like by fht_kernel().
+ * @author placek@ragnarson.com
+ * @param values Processing data.
+ * @param length Length of processing data.
+ * @return TRUE if there is a codelet of the length (FALSE - nothing done).
+ */
+int ft_codelet_fht(double * values, long length)
+{
+    int index = codelet_index(length);
+
+    if(index == 0)
+        return FALSE;
+    fht_codelets[index](values);
+    return TRUE;
+}
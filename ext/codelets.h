@@ -0,0 +1,2716 @@
+/**
+ * @file codelets.h
+ * @brief Unrolled FFT and FHT kernels of 2 to 64 points.
+ * Generated by generate_codelets.rb, do not edit. Included by codelets.c.
+ * @author placek@ragnarson.com
+ */
+
+static void fft_codelet_2_forward(double * real, double * imag)
+{
+    double r0 = real[0], i0 = imag[0];
+    double r1 = real[1], i1 = imag[1];
+    double tr, ti;
+
+    // stage of step 1
+    tr = r1; ti = i1;
+    r1 = r0 - tr; i1 = i0 - ti; r0 += tr; i0 += ti;
+
+    real[0] = r0; imag[0] = i0;
+    real[1] = r1; imag[1] = i1;
+}
+
+static void fft_codelet_2_reverse(double * real, double * imag)
+{
+    double r0 = real[0], i0 = imag[0];
+    double r1 = real[1], i1 = imag[1];
+    double tr, ti;
+
+    // stage of step 1
+    tr = r1; ti = i1;
+    r1 = r0 - tr; i1 = i0 - ti; r0 += tr; i0 += ti;
+
+    real[0] = r0; imag[0] = i0;
+    real[1] = r1; imag[1] = i1;
+}
+
+static void fht_codelet_2(double * values)
+{
+    double v0 = values[0];
+    double v1 = values[1];
+    double a, b;
+
+    // level 2
+    a = v0; b = v1; v0 = a + b; v1 = a - b;
+
+    values[0] = v0 * 0.7071067811865475;
+    values[1] = v1 * 0.7071067811865475;
+}
+
+static void fft_codelet_4_forward(double * real, double * imag)
+{
+    double r0 = real[0], i0 = imag[0];
+    double r1 = real[2], i1 = imag[2];
+    double r2 = real[1], i2 = imag[1];
+    double r3 = real[3], i3 = imag[3];
+    double tr, ti;
+
+    // stage of step 1
+    tr = r1; ti = i1;
+    r1 = r0 - tr; i1 = i0 - ti; r0 += tr; i0 += ti;
+    tr = r3; ti = i3;
+    r3 = r2 - tr; i3 = i2 - ti; r2 += tr; i2 += ti;
+    // stage of step 2
+    tr = r2; ti = i2;
+    r2 = r0 - tr; i2 = i0 - ti; r0 += tr; i0 += ti;
+    tr = i3; ti = -r3;
+    r3 = r1 - tr; i3 = i1 - ti; r1 += tr; i1 += ti;
+
+    real[0] = r0; imag[0] = i0;
+    real[1] = r1; imag[1] = i1;
+    real[2] = r2; imag[2] = i2;
+    real[3] = r3; imag[3] = i3;
+}
+
+static void fft_codelet_4_reverse(double * real, double * imag)
+{
+    double r0 = real[0], i0 = imag[0];
+    double r1 = real[2], i1 = imag[2];
+    double r2 = real[1], i2 = imag[1];
+    double r3 = real[3], i3 = imag[3];
+    double tr, ti;
+
+    // stage of step 1
+    tr = r1; ti = i1;
+    r1 = r0 - tr; i1 = i0 - ti; r0 += tr; i0 += ti;
+    tr = r3; ti = i3;
+    r3 = r2 - tr; i3 = i2 - ti; r2 += tr; i2 += ti;
+    // stage of step 2
+    tr = r2; ti = i2;
+    r2 = r0 - tr; i2 = i0 - ti; r0 += tr; i0 += ti;
+    tr = -i3; ti = r3;
+    r3 = r1 - tr; i3 = i1 - ti; r1 += tr; i1 += ti;
+
+    real[0] = r0; imag[0] = i0;
+    real[1] = r1; imag[1] = i1;
+    real[2] = r2; imag[2] = i2;
+    real[3] = r3; imag[3] = i3;
+}
+
+static void fht_codelet_4(double * values)
+{
+    double v0 = values[0];
+    double v1 = values[2];
+    double v2 = values[1];
+    double v3 = values[3];
+    double a, b;
+
+    // level 2
+    a = v0; b = v1; v0 = a + b; v1 = a - b;
+    a = v2; b = v3; v2 = a + b; v3 = a - b;
+    // level 4
+    a = v0; b = v2; v0 = a + b; v2 = a - b;
+    a = v1; b = v3; v1 = a + b; v3 = a - b;
+
+    values[0] = v0 * 0.5;
+    values[1] = v1 * 0.5;
+    values[2] = v2 * 0.5;
+    values[3] = v3 * 0.5;
+}
+
+static void fft_codelet_8_forward(double * real, double * imag)
+{
+    double r0 = real[0], i0 = imag[0];
+    double r1 = real[4], i1 = imag[4];
+    double r2 = real[2], i2 = imag[2];
+    double r3 = real[6], i3 = imag[6];
+    double r4 = real[1], i4 = imag[1];
+    double r5 = real[5], i5 = imag[5];
+    double r6 = real[3], i6 = imag[3];
+    double r7 = real[7], i7 = imag[7];
+    double tr, ti;
+
+    // stage of step 1
+    tr = r1; ti = i1;
+    r1 = r0 - tr; i1 = i0 - ti; r0 += tr; i0 += ti;
+    tr = r3; ti = i3;
+    r3 = r2 - tr; i3 = i2 - ti; r2 += tr; i2 += ti;
+    tr = r5; ti = i5;
+    r5 = r4 - tr; i5 = i4 - ti; r4 += tr; i4 += ti;
+    tr = r7; ti = i7;
+    r7 = r6 - tr; i7 = i6 - ti; r6 += tr; i6 += ti;
+    // stage of step 2
+    tr = r2; ti = i2;
+    r2 = r0 - tr; i2 = i0 - ti; r0 += tr; i0 += ti;
+    tr = i3; ti = -r3;
+    r3 = r1 - tr; i3 = i1 - ti; r1 += tr; i1 += ti;
+    tr = r6; ti = i6;
+    r6 = r4 - tr; i6 = i4 - ti; r4 += tr; i4 += ti;
+    tr = i7; ti = -r7;
+    r7 = r5 - tr; i7 = i5 - ti; r5 += tr; i5 += ti;
+    // stage of step 4
+    tr = r4; ti = i4;
+    r4 = r0 - tr; i4 = i0 - ti; r0 += tr; i0 += ti;
+    tr = r5 * 0.7071067811865476 - i5 * -0.7071067811865475; ti = r5 * -0.7071067811865475 + i5 * 0.7071067811865476;
+    r5 = r1 - tr; i5 = i1 - ti; r1 += tr; i1 += ti;
+    tr = i6; ti = -r6;
+    r6 = r2 - tr; i6 = i2 - ti; r2 += tr; i2 += ti;
+    tr = r7 * -0.7071067811865475 - i7 * -0.7071067811865476; ti = r7 * -0.7071067811865476 + i7 * -0.7071067811865475;
+    r7 = r3 - tr; i7 = i3 - ti; r3 += tr; i3 += ti;
+
+    real[0] = r0; imag[0] = i0;
+    real[1] = r1; imag[1] = i1;
+    real[2] = r2; imag[2] = i2;
+    real[3] = r3; imag[3] = i3;
+    real[4] = r4; imag[4] = i4;
+    real[5] = r5; imag[5] = i5;
+    real[6] = r6; imag[6] = i6;
+    real[7] = r7; imag[7] = i7;
+}
+
+static void fft_codelet_8_reverse(double * real, double * imag)
+{
+    double r0 = real[0], i0 = imag[0];
+    double r1 = real[4], i1 = imag[4];
+    double r2 = real[2], i2 = imag[2];
+    double r3 = real[6], i3 = imag[6];
+    double r4 = real[1], i4 = imag[1];
+    double r5 = real[5], i5 = imag[5];
+    double r6 = real[3], i6 = imag[3];
+    double r7 = real[7], i7 = imag[7];
+    double tr, ti;
+
+    // stage of step 1
+    tr = r1; ti = i1;
+    r1 = r0 - tr; i1 = i0 - ti; r0 += tr; i0 += ti;
+    tr = r3; ti = i3;
+    r3 = r2 - tr; i3 = i2 - ti; r2 += tr; i2 += ti;
+    tr = r5; ti = i5;
+    r5 = r4 - tr; i5 = i4 - ti; r4 += tr; i4 += ti;
+    tr = r7; ti = i7;
+    r7 = r6 - tr; i7 = i6 - ti; r6 += tr; i6 += ti;
+    // stage of step 2
+    tr = r2; ti = i2;
+    r2 = r0 - tr; i2 = i0 - ti; r0 += tr; i0 += ti;
+    tr = -i3; ti = r3;
+    r3 = r1 - tr; i3 = i1 - ti; r1 += tr; i1 += ti;
+    tr = r6; ti = i6;
+    r6 = r4 - tr; i6 = i4 - ti; r4 += tr; i4 += ti;
+    tr = -i7; ti = r7;
+    r7 = r5 - tr; i7 = i5 - ti; r5 += tr; i5 += ti;
+    // stage of step 4
+    tr = r4; ti = i4;
+    r4 = r0 - tr; i4 = i0 - ti; r0 += tr; i0 += ti;
+    tr = r5 * 0.7071067811865476 - i5 * 0.7071067811865475; ti = r5 * 0.7071067811865475 + i5 * 0.7071067811865476;
+    r5 = r1 - tr; i5 = i1 - ti; r1 += tr; i1 += ti;
+    tr = -i6; ti = r6;
+    r6 = r2 - tr; i6 = i2 - ti; r2 += tr; i2 += ti;
+    tr = r7 * -0.7071067811865475 - i7 * 0.7071067811865476; ti = r7 * 0.7071067811865476 + i7 * -0.7071067811865475;
+    r7 = r3 - tr; i7 = i3 - ti; r3 += tr; i3 += ti;
+
+    real[0] = r0; imag[0] = i0;
+    real[1] = r1; imag[1] = i1;
+    real[2] = r2; imag[2] = i2;
+    real[3] = r3; imag[3] = i3;
+    real[4] = r4; imag[4] = i4;
+    real[5] = r5; imag[5] = i5;
+    real[6] = r6; imag[6] = i6;
+    real[7] = r7; imag[7] = i7;
+}
+
+static void fht_codelet_8(double * values)
+{
+    double v0 = values[0];
+    double v1 = values[4];
+    double v2 = values[2];
+    double v3 = values[6];
+    double v4 = values[1];
+    double v5 = values[5];
+    double v6 = values[3];
+    double v7 = values[7];
+    double a, b;
+
+    // level 2
+    a = v0; b = v1; v0 = a + b; v1 = a - b;
+    a = v2; b = v3; v2 = a + b; v3 = a - b;
+    a = v4; b = v5; v4 = a + b; v5 = a - b;
+    a = v6; b = v7; v6 = a + b; v7 = a - b;
+    // level 4
+    a = v0; b = v2; v0 = a + b; v2 = a - b;
+    a = v1; b = v3; v1 = a + b; v3 = a - b;
+    a = v4; b = v6; v4 = a + b; v6 = a - b;
+    a = v5; b = v7; v5 = a + b; v7 = a - b;
+    // level 8
+    a = v5; b = v7;
+    v5 = a * 0.7071067811865476 + b * 0.7071067811865475; v7 = a * 0.7071067811865475 - b * 0.7071067811865476;
+    a = v0; b = v4; v0 = a + b; v4 = a - b;
+    a = v1; b = v5; v1 = a + b; v5 = a - b;
+    a = v2; b = v6; v2 = a + b; v6 = a - b;
+    a = v3; b = v7; v3 = a + b; v7 = a - b;
+
+    values[0] = v0 * 0.35355339059327373;
+    values[1] = v1 * 0.35355339059327373;
+    values[2] = v2 * 0.35355339059327373;
+    values[3] = v3 * 0.35355339059327373;
+    values[4] = v4 * 0.35355339059327373;
+    values[5] = v5 * 0.35355339059327373;
+    values[6] = v6 * 0.35355339059327373;
+    values[7] = v7 * 0.35355339059327373;
+}
+
+static void fft_codelet_16_forward(double * real, double * imag)
+{
+    double r0 = real[0], i0 = imag[0];
+    double r1 = real[8], i1 = imag[8];
+    double r2 = real[4], i2 = imag[4];
+    double r3 = real[12], i3 = imag[12];
+    double r4 = real[2], i4 = imag[2];
+    double r5 = real[10], i5 = imag[10];
+    double r6 = real[6], i6 = imag[6];
+    double r7 = real[14], i7 = imag[14];
+    double r8 = real[1], i8 = imag[1];
+    double r9 = real[9], i9 = imag[9];
+    double r10 = real[5], i10 = imag[5];
+    double r11 = real[13], i11 = imag[13];
+    double r12 = real[3], i12 = imag[3];
+    double r13 = real[11], i13 = imag[11];
+    double r14 = real[7], i14 = imag[7];
+    double r15 = real[15], i15 = imag[15];
+    double tr, ti;
+
+    // stage of step 1
+    tr = r1; ti = i1;
+    r1 = r0 - tr; i1 = i0 - ti; r0 += tr; i0 += ti;
+    tr = r3; ti = i3;
+    r3 = r2 - tr; i3 = i2 - ti; r2 += tr; i2 += ti;
+    tr = r5; ti = i5;
+    r5 = r4 - tr; i5 = i4 - ti; r4 += tr; i4 += ti;
+    tr = r7; ti = i7;
+    r7 = r6 - tr; i7 = i6 - ti; r6 += tr; i6 += ti;
+    tr = r9; ti = i9;
+    r9 = r8 - tr; i9 = i8 - ti; r8 += tr; i8 += ti;
+    tr = r11; ti = i11;
+    r11 = r10 - tr; i11 = i10 - ti; r10 += tr; i10 += ti;
+    tr = r13; ti = i13;
+    r13 = r12 - tr; i13 = i12 - ti; r12 += tr; i12 += ti;
+    tr = r15; ti = i15;
+    r15 = r14 - tr; i15 = i14 - ti; r14 += tr; i14 += ti;
+    // stage of step 2
+    tr = r2; ti = i2;
+    r2 = r0 - tr; i2 = i0 - ti; r0 += tr; i0 += ti;
+    tr = i3; ti = -r3;
+    r3 = r1 - tr; i3 = i1 - ti; r1 += tr; i1 += ti;
+    tr = r6; ti = i6;
+    r6 = r4 - tr; i6 = i4 - ti; r4 += tr; i4 += ti;
+    tr = i7; ti = -r7;
+    r7 = r5 - tr; i7 = i5 - ti; r5 += tr; i5 += ti;
+    tr = r10; ti = i10;
+    r10 = r8 - tr; i10 = i8 - ti; r8 += tr; i8 += ti;
+    tr = i11; ti = -r11;
+    r11 = r9 - tr; i11 = i9 - ti; r9 += tr; i9 += ti;
+    tr = r14; ti = i14;
+    r14 = r12 - tr; i14 = i12 - ti; r12 += tr; i12 += ti;
+    tr = i15; ti = -r15;
+    r15 = r13 - tr; i15 = i13 - ti; r13 += tr; i13 += ti;
+    // stage of step 4
+    tr = r4; ti = i4;
+    r4 = r0 - tr; i4 = i0 - ti; r0 += tr; i0 += ti;
+    tr = r5 * 0.7071067811865476 - i5 * -0.7071067811865475; ti = r5 * -0.7071067811865475 + i5 * 0.7071067811865476;
+    r5 = r1 - tr; i5 = i1 - ti; r1 += tr; i1 += ti;
+    tr = i6; ti = -r6;
+    r6 = r2 - tr; i6 = i2 - ti; r2 += tr; i2 += ti;
+    tr = r7 * -0.7071067811865475 - i7 * -0.7071067811865476; ti = r7 * -0.7071067811865476 + i7 * -0.7071067811865475;
+    r7 = r3 - tr; i7 = i3 - ti; r3 += tr; i3 += ti;
+    tr = r12; ti = i12;
+    r12 = r8 - tr; i12 = i8 - ti; r8 += tr; i8 += ti;
+    tr = r13 * 0.7071067811865476 - i13 * -0.7071067811865475; ti = r13 * -0.7071067811865475 + i13 * 0.7071067811865476;
+    r13 = r9 - tr; i13 = i9 - ti; r9 += tr; i9 += ti;
+    tr = i14; ti = -r14;
+    r14 = r10 - tr; i14 = i10 - ti; r10 += tr; i10 += ti;
+    tr = r15 * -0.7071067811865475 - i15 * -0.7071067811865476; ti = r15 * -0.7071067811865476 + i15 * -0.7071067811865475;
+    r15 = r11 - tr; i15 = i11 - ti; r11 += tr; i11 += ti;
+    // stage of step 8
+    tr = r8; ti = i8;
+    r8 = r0 - tr; i8 = i0 - ti; r0 += tr; i0 += ti;
+    tr = r9 * 0.9238795325112867 - i9 * -0.3826834323650898; ti = r9 * -0.3826834323650898 + i9 * 0.9238795325112867;
+    r9 = r1 - tr; i9 = i1 - ti; r1 += tr; i1 += ti;
+    tr = r10 * 0.7071067811865476 - i10 * -0.7071067811865475; ti = r10 * -0.7071067811865475 + i10 * 0.7071067811865476;
+    r10 = r2 - tr; i10 = i2 - ti; r2 += tr; i2 += ti;
+    tr = r11 * 0.38268343236508984 - i11 * -0.9238795325112867; ti = r11 * -0.9238795325112867 + i11 * 0.38268343236508984;
+    r11 = r3 - tr; i11 = i3 - ti; r3 += tr; i3 += ti;
+    tr = i12; ti = -r12;
+    r12 = r4 - tr; i12 = i4 - ti; r4 += tr; i4 += ti;
+    tr = r13 * -0.3826834323650897 - i13 * -0.9238795325112867; ti = r13 * -0.9238795325112867 + i13 * -0.3826834323650897;
+    r13 = r5 - tr; i13 = i5 - ti; r5 += tr; i5 += ti;
+    tr = r14 * -0.7071067811865475 - i14 * -0.7071067811865476; ti = r14 * -0.7071067811865476 + i14 * -0.7071067811865475;
+    r14 = r6 - tr; i14 = i6 - ti; r6 += tr; i6 += ti;
+    tr = r15 * -0.9238795325112867 - i15 * -0.3826834323650899; ti = r15 * -0.3826834323650899 + i15 * -0.9238795325112867;
+    r15 = r7 - tr; i15 = i7 - ti; r7 += tr; i7 += ti;
+
+    real[0] = r0; imag[0] = i0;
+    real[1] = r1; imag[1] = i1;
+    real[2] = r2; imag[2] = i2;
+    real[3] = r3; imag[3] = i3;
+    real[4] = r4; imag[4] = i4;
+    real[5] = r5; imag[5] = i5;
+    real[6] = r6; imag[6] = i6;
+    real[7] = r7; imag[7] = i7;
+    real[8] = r8; imag[8] = i8;
+    real[9] = r9; imag[9] = i9;
+    real[10] = r10; imag[10] = i10;
+    real[11] = r11; imag[11] = i11;
+    real[12] = r12; imag[12] = i12;
+    real[13] = r13; imag[13] = i13;
+    real[14] = r14; imag[14] = i14;
+    real[15] = r15; imag[15] = i15;
+}
+
+static void fft_codelet_16_reverse(double * real, double * imag)
+{
+    double r0 = real[0], i0 = imag[0];
+    double r1 = real[8], i1 = imag[8];
+    double r2 = real[4], i2 = imag[4];
+    double r3 = real[12], i3 = imag[12];
+    double r4 = real[2], i4 = imag[2];
+    double r5 = real[10], i5 = imag[10];
+    double r6 = real[6], i6 = imag[6];
+    double r7 = real[14], i7 = imag[14];
+    double r8 = real[1], i8 = imag[1];
+    double r9 = real[9], i9 = imag[9];
+    double r10 = real[5], i10 = imag[5];
+    double r11 = real[13], i11 = imag[13];
+    double r12 = real[3], i12 = imag[3];
+    double r13 = real[11], i13 = imag[11];
+    double r14 = real[7], i14 = imag[7];
+    double r15 = real[15], i15 = imag[15];
+    double tr, ti;
+
+    // stage of step 1
+    tr = r1; ti = i1;
+    r1 = r0 - tr; i1 = i0 - ti; r0 += tr; i0 += ti;
+    tr = r3; ti = i3;
+    r3 = r2 - tr; i3 = i2 - ti; r2 += tr; i2 += ti;
+    tr = r5; ti = i5;
+    r5 = r4 - tr; i5 = i4 - ti; r4 += tr; i4 += ti;
+    tr = r7; ti = i7;
+    r7 = r6 - tr; i7 = i6 - ti; r6 += tr; i6 += ti;
+    tr = r9; ti = i9;
+    r9 = r8 - tr; i9 = i8 - ti; r8 += tr; i8 += ti;
+    tr = r11; ti = i11;
+    r11 = r10 - tr; i11 = i10 - ti; r10 += tr; i10 += ti;
+    tr = r13; ti = i13;
+    r13 = r12 - tr; i13 = i12 - ti; r12 += tr; i12 += ti;
+    tr = r15; ti = i15;
+    r15 = r14 - tr; i15 = i14 - ti; r14 += tr; i14 += ti;
+    // stage of step 2
+    tr = r2; ti = i2;
+    r2 = r0 - tr; i2 = i0 - ti; r0 += tr; i0 += ti;
+    tr = -i3; ti = r3;
+    r3 = r1 - tr; i3 = i1 - ti; r1 += tr; i1 += ti;
+    tr = r6; ti = i6;
+    r6 = r4 - tr; i6 = i4 - ti; r4 += tr; i4 += ti;
+    tr = -i7; ti = r7;
+    r7 = r5 - tr; i7 = i5 - ti; r5 += tr; i5 += ti;
+    tr = r10; ti = i10;
+    r10 = r8 - tr; i10 = i8 - ti; r8 += tr; i8 += ti;
+    tr = -i11; ti = r11;
+    r11 = r9 - tr; i11 = i9 - ti; r9 += tr; i9 += ti;
+    tr = r14; ti = i14;
+    r14 = r12 - tr; i14 = i12 - ti; r12 += tr; i12 += ti;
+    tr = -i15; ti = r15;
+    r15 = r13 - tr; i15 = i13 - ti; r13 += tr; i13 += ti;
+    // stage of step 4
+    tr = r4; ti = i4;
+    r4 = r0 - tr; i4 = i0 - ti; r0 += tr; i0 += ti;
+    tr = r5 * 0.7071067811865476 - i5 * 0.7071067811865475; ti = r5 * 0.7071067811865475 + i5 * 0.7071067811865476;
+    r5 = r1 - tr; i5 = i1 - ti; r1 += tr; i1 += ti;
+    tr = -i6; ti = r6;
+    r6 = r2 - tr; i6 = i2 - ti; r2 += tr; i2 += ti;
+    tr = r7 * -0.7071067811865475 - i7 * 0.7071067811865476; ti = r7 * 0.7071067811865476 + i7 * -0.7071067811865475;
+    r7 = r3 - tr; i7 = i3 - ti; r3 += tr; i3 += ti;
+    tr = r12; ti = i12;
+    r12 = r8 - tr; i12 = i8 - ti; r8 += tr; i8 += ti;
+    tr = r13 * 0.7071067811865476 - i13 * 0.7071067811865475; ti = r13 * 0.7071067811865475 + i13 * 0.7071067811865476;
+    r13 = r9 - tr; i13 = i9 - ti; r9 += tr; i9 += ti;
+    tr = -i14; ti = r14;
+    r14 = r10 - tr; i14 = i10 - ti; r10 += tr; i10 += ti;
+    tr = r15 * -0.7071067811865475 - i15 * 0.7071067811865476; ti = r15 * 0.7071067811865476 + i15 * -0.7071067811865475;
+    r15 = r11 - tr; i15 = i11 - ti; r11 += tr; i11 += ti;
+    // stage of step 8
+    tr = r8; ti = i8;
+    r8 = r0 - tr; i8 = i0 - ti; r0 += tr; i0 += ti;
+    tr = r9 * 0.9238795325112867 - i9 * 0.3826834323650898; ti = r9 * 0.3826834323650898 + i9 * 0.9238795325112867;
+    r9 = r1 - tr; i9 = i1 - ti; r1 += tr; i1 += ti;
+    tr = r10 * 0.7071067811865476 - i10 * 0.7071067811865475; ti = r10 * 0.7071067811865475 + i10 * 0.7071067811865476;
+    r10 = r2 - tr; i10 = i2 - ti; r2 += tr; i2 += ti;
+    tr = r11 * 0.38268343236508984 - i11 * 0.9238795325112867; ti = r11 * 0.9238795325112867 + i11 * 0.38268343236508984;
+    r11 = r3 - tr; i11 = i3 - ti; r3 += tr; i3 += ti;
+    tr = -i12; ti = r12;
+    r12 = r4 - tr; i12 = i4 - ti; r4 += tr; i4 += ti;
+    tr = r13 * -0.3826834323650897 - i13 * 0.9238795325112867; ti = r13 * 0.9238795325112867 + i13 * -0.3826834323650897;
+    r13 = r5 - tr; i13 = i5 - ti; r5 += tr; i5 += ti;
+    tr = r14 * -0.7071067811865475 - i14 * 0.7071067811865476; ti = r14 * 0.7071067811865476 + i14 * -0.7071067811865475;
+    r14 = r6 - tr; i14 = i6 - ti; r6 += tr; i6 += ti;
+    tr = r15 * -0.9238795325112867 - i15 * 0.3826834323650899; ti = r15 * 0.3826834323650899 + i15 * -0.9238795325112867;
+    r15 = r7 - tr; i15 = i7 - ti; r7 += tr; i7 += ti;
+
+    real[0] = r0; imag[0] = i0;
+    real[1] = r1; imag[1] = i1;
+    real[2] = r2; imag[2] = i2;
+    real[3] = r3; imag[3] = i3;
+    real[4] = r4; imag[4] = i4;
+    real[5] = r5; imag[5] = i5;
+    real[6] = r6; imag[6] = i6;
+    real[7] = r7; imag[7] = i7;
+    real[8] = r8; imag[8] = i8;
+    real[9] = r9; imag[9] = i9;
+    real[10] = r10; imag[10] = i10;
+    real[11] = r11; imag[11] = i11;
+    real[12] = r12; imag[12] = i12;
+    real[13] = r13; imag[13] = i13;
+    real[14] = r14; imag[14] = i14;
+    real[15] = r15; imag[15] = i15;
+}
+
+static void fht_codelet_16(double * values)
+{
+    double v0 = values[0];
+    double v1 = values[8];
+    double v2 = values[4];
+    double v3 = values[12];
+    double v4 = values[2];
+    double v5 = values[10];
+    double v6 = values[6];
+    double v7 = values[14];
+    double v8 = values[1];
+    double v9 = values[9];
+    double v10 = values[5];
+    double v11 = values[13];
+    double v12 = values[3];
+    double v13 = values[11];
+    double v14 = values[7];
+    double v15 = values[15];
+    double a, b;
+
+    // level 2
+    a = v0; b = v1; v0 = a + b; v1 = a - b;
+    a = v2; b = v3; v2 = a + b; v3 = a - b;
+    a = v4; b = v5; v4 = a + b; v5 = a - b;
+    a = v6; b = v7; v6 = a + b; v7 = a - b;
+    a = v8; b = v9; v8 = a + b; v9 = a - b;
+    a = v10; b = v11; v10 = a + b; v11 = a - b;
+    a = v12; b = v13; v12 = a + b; v13 = a - b;
+    a = v14; b = v15; v14 = a + b; v15 = a - b;
+    // level 4
+    a = v0; b = v2; v0 = a + b; v2 = a - b;
+    a = v1; b = v3; v1 = a + b; v3 = a - b;
+    a = v4; b = v6; v4 = a + b; v6 = a - b;
+    a = v5; b = v7; v5 = a + b; v7 = a - b;
+    a = v8; b = v10; v8 = a + b; v10 = a - b;
+    a = v9; b = v11; v9 = a + b; v11 = a - b;
+    a = v12; b = v14; v12 = a + b; v14 = a - b;
+    a = v13; b = v15; v13 = a + b; v15 = a - b;
+    // level 8
+    a = v5; b = v7;
+    v5 = a * 0.7071067811865476 + b * 0.7071067811865475; v7 = a * 0.7071067811865475 - b * 0.7071067811865476;
+    a = v0; b = v4; v0 = a + b; v4 = a - b;
+    a = v1; b = v5; v1 = a + b; v5 = a - b;
+    a = v2; b = v6; v2 = a + b; v6 = a - b;
+    a = v3; b = v7; v3 = a + b; v7 = a - b;
+    a = v13; b = v15;
+    v13 = a * 0.7071067811865476 + b * 0.7071067811865475; v15 = a * 0.7071067811865475 - b * 0.7071067811865476;
+    a = v8; b = v12; v8 = a + b; v12 = a - b;
+    a = v9; b = v13; v9 = a + b; v13 = a - b;
+    a = v10; b = v14; v10 = a + b; v14 = a - b;
+    a = v11; b = v15; v11 = a + b; v15 = a - b;
+    // level 16
+    a = v9; b = v15;
+    v9 = a * 0.9238795325112867 + b * 0.3826834323650898; v15 = a * 0.3826834323650898 - b * 0.9238795325112867;
+    a = v10; b = v14;
+    v10 = a * 0.7071067811865476 + b * 0.7071067811865475; v14 = a * 0.7071067811865475 - b * 0.7071067811865476;
+    a = v11; b = v13;
+    v11 = a * 0.38268343236508984 + b * 0.9238795325112867; v13 = a * 0.9238795325112867 - b * 0.38268343236508984;
+    a = v0; b = v8; v0 = a + b; v8 = a - b;
+    a = v1; b = v9; v1 = a + b; v9 = a - b;
+    a = v2; b = v10; v2 = a + b; v10 = a - b;
+    a = v3; b = v11; v3 = a + b; v11 = a - b;
+    a = v4; b = v12; v4 = a + b; v12 = a - b;
+    a = v5; b = v13; v5 = a + b; v13 = a - b;
+    a = v6; b = v14; v6 = a + b; v14 = a - b;
+    a = v7; b = v15; v7 = a + b; v15 = a - b;
+
+    values[0] = v0 * 0.25;
+    values[1] = v1 * 0.25;
+    values[2] = v2 * 0.25;
+    values[3] = v3 * 0.25;
+    values[4] = v4 * 0.25;
+    values[5] = v5 * 0.25;
+    values[6] = v6 * 0.25;
+    values[7] = v7 * 0.25;
+    values[8] = v8 * 0.25;
+    values[9] = v9 * 0.25;
+    values[10] = v10 * 0.25;
+    values[11] = v11 * 0.25;
+    values[12] = v12 * 0.25;
+    values[13] = v13 * 0.25;
+    values[14] = v14 * 0.25;
+    values[15] = v15 * 0.25;
+}
+
+static void fft_codelet_32_forward(double * real, double * imag)
+{
+    double r0 = real[0], i0 = imag[0];
+    double r1 = real[16], i1 = imag[16];
+    double r2 = real[8], i2 = imag[8];
+    double r3 = real[24], i3 = imag[24];
+    double r4 = real[4], i4 = imag[4];
+    double r5 = real[20], i5 = imag[20];
+    double r6 = real[12], i6 = imag[12];
+    double r7 = real[28], i7 = imag[28];
+    double r8 = real[2], i8 = imag[2];
+    double r9 = real[18], i9 = imag[18];
+    double r10 = real[10], i10 = imag[10];
+    double r11 = real[26], i11 = imag[26];
+    double r12 = real[6], i12 = imag[6];
+    double r13 = real[22], i13 = imag[22];
+    double r14 = real[14], i14 = imag[14];
+    double r15 = real[30], i15 = imag[30];
+    double r16 = real[1], i16 = imag[1];
+    double r17 = real[17], i17 = imag[17];
+    double r18 = real[9], i18 = imag[9];
+    double r19 = real[25], i19 = imag[25];
+    double r20 = real[5], i20 = imag[5];
+    double r21 = real[21], i21 = imag[21];
+    double r22 = real[13], i22 = imag[13];
+    double r23 = real[29], i23 = imag[29];
+    double r24 = real[3], i24 = imag[3];
+    double r25 = real[19], i25 = imag[19];
+    double r26 = real[11], i26 = imag[11];
+    double r27 = real[27], i27 = imag[27];
+    double r28 = real[7], i28 = imag[7];
+    double r29 = real[23], i29 = imag[23];
+    double r30 = real[15], i30 = imag[15];
+    double r31 = real[31], i31 = imag[31];
+    double tr, ti;
+
+    // stage of step 1
+    tr = r1; ti = i1;
+    r1 = r0 - tr; i1 = i0 - ti; r0 += tr; i0 += ti;
+    tr = r3; ti = i3;
+    r3 = r2 - tr; i3 = i2 - ti; r2 += tr; i2 += ti;
+    tr = r5; ti = i5;
+    r5 = r4 - tr; i5 = i4 - ti; r4 += tr; i4 += ti;
+    tr = r7; ti = i7;
+    r7 = r6 - tr; i7 = i6 - ti; r6 += tr; i6 += ti;
+    tr = r9; ti = i9;
+    r9 = r8 - tr; i9 = i8 - ti; r8 += tr; i8 += ti;
+    tr = r11; ti = i11;
+    r11 = r10 - tr; i11 = i10 - ti; r10 += tr; i10 += ti;
+    tr = r13; ti = i13;
+    r13 = r12 - tr; i13 = i12 - ti; r12 += tr; i12 += ti;
+    tr = r15; ti = i15;
+    r15 = r14 - tr; i15 = i14 - ti; r14 += tr; i14 += ti;
+    tr = r17; ti = i17;
+    r17 = r16 - tr; i17 = i16 - ti; r16 += tr; i16 += ti;
+    tr = r19; ti = i19;
+    r19 = r18 - tr; i19 = i18 - ti; r18 += tr; i18 += ti;
+    tr = r21; ti = i21;
+    r21 = r20 - tr; i21 = i20 - ti; r20 += tr; i20 += ti;
+    tr = r23; ti = i23;
+    r23 = r22 - tr; i23 = i22 - ti; r22 += tr; i22 += ti;
+    tr = r25; ti = i25;
+    r25 = r24 - tr; i25 = i24 - ti; r24 += tr; i24 += ti;
+    tr = r27; ti = i27;
+    r27 = r26 - tr; i27 = i26 - ti; r26 += tr; i26 += ti;
+    tr = r29; ti = i29;
+    r29 = r28 - tr; i29 = i28 - ti; r28 += tr; i28 += ti;
+    tr = r31; ti = i31;
+    r31 = r30 - tr; i31 = i30 - ti; r30 += tr; i30 += ti;
+    // stage of step 2
+    tr = r2; ti = i2;
+    r2 = r0 - tr; i2 = i0 - ti; r0 += tr; i0 += ti;
+    tr = i3; ti = -r3;
+    r3 = r1 - tr; i3 = i1 - ti; r1 += tr; i1 += ti;
+    tr = r6; ti = i6;
+    r6 = r4 - tr; i6 = i4 - ti; r4 += tr; i4 += ti;
+    tr = i7; ti = -r7;
+    r7 = r5 - tr; i7 = i5 - ti; r5 += tr; i5 += ti;
+    tr = r10; ti = i10;
+    r10 = r8 - tr; i10 = i8 - ti; r8 += tr; i8 += ti;
+    tr = i11; ti = -r11;
+    r11 = r9 - tr; i11 = i9 - ti; r9 += tr; i9 += ti;
+    tr = r14; ti = i14;
+    r14 = r12 - tr; i14 = i12 - ti; r12 += tr; i12 += ti;
+    tr = i15; ti = -r15;
+    r15 = r13 - tr; i15 = i13 - ti; r13 += tr; i13 += ti;
+    tr = r18; ti = i18;
+    r18 = r16 - tr; i18 = i16 - ti; r16 += tr; i16 += ti;
+    tr = i19; ti = -r19;
+    r19 = r17 - tr; i19 = i17 - ti; r17 += tr; i17 += ti;
+    tr = r22; ti = i22;
+    r22 = r20 - tr; i22 = i20 - ti; r20 += tr; i20 += ti;
+    tr = i23; ti = -r23;
+    r23 = r21 - tr; i23 = i21 - ti; r21 += tr; i21 += ti;
+    tr = r26; ti = i26;
+    r26 = r24 - tr; i26 = i24 - ti; r24 += tr; i24 += ti;
+    tr = i27; ti = -r27;
+    r27 = r25 - tr; i27 = i25 - ti; r25 += tr; i25 += ti;
+    tr = r30; ti = i30;
+    r30 = r28 - tr; i30 = i28 - ti; r28 += tr; i28 += ti;
+    tr = i31; ti = -r31;
+    r31 = r29 - tr; i31 = i29 - ti; r29 += tr; i29 += ti;
+    // stage of step 4
+    tr = r4; ti = i4;
+    r4 = r0 - tr; i4 = i0 - ti; r0 += tr; i0 += ti;
+    tr = r5 * 0.7071067811865476 - i5 * -0.7071067811865475; ti = r5 * -0.7071067811865475 + i5 * 0.7071067811865476;
+    r5 = r1 - tr; i5 = i1 - ti; r1 += tr; i1 += ti;
+    tr = i6; ti = -r6;
+    r6 = r2 - tr; i6 = i2 - ti; r2 += tr; i2 += ti;
+    tr = r7 * -0.7071067811865475 - i7 * -0.7071067811865476; ti = r7 * -0.7071067811865476 + i7 * -0.7071067811865475;
+    r7 = r3 - tr; i7 = i3 - ti; r3 += tr; i3 += ti;
+    tr = r12; ti = i12;
+    r12 = r8 - tr; i12 = i8 - ti; r8 += tr; i8 += ti;
+    tr = r13 * 0.7071067811865476 - i13 * -0.7071067811865475; ti = r13 * -0.7071067811865475 + i13 * 0.7071067811865476;
+    r13 = r9 - tr; i13 = i9 - ti; r9 += tr; i9 += ti;
+    tr = i14; ti = -r14;
+    r14 = r10 - tr; i14 = i10 - ti; r10 += tr; i10 += ti;
+    tr = r15 * -0.7071067811865475 - i15 * -0.7071067811865476; ti = r15 * -0.7071067811865476 + i15 * -0.7071067811865475;
+    r15 = r11 - tr; i15 = i11 - ti; r11 += tr; i11 += ti;
+    tr = r20; ti = i20;
+    r20 = r16 - tr; i20 = i16 - ti; r16 += tr; i16 += ti;
+    tr = r21 * 0.7071067811865476 - i21 * -0.7071067811865475; ti = r21 * -0.7071067811865475 + i21 * 0.7071067811865476;
+    r21 = r17 - tr; i21 = i17 - ti; r17 += tr; i17 += ti;
+    tr = i22; ti = -r22;
+    r22 = r18 - tr; i22 = i18 - ti; r18 += tr; i18 += ti;
+    tr = r23 * -0.7071067811865475 - i23 * -0.7071067811865476; ti = r23 * -0.7071067811865476 + i23 * -0.7071067811865475;
+    r23 = r19 - tr; i23 = i19 - ti; r19 += tr; i19 += ti;
+    tr = r28; ti = i28;
+    r28 = r24 - tr; i28 = i24 - ti; r24 += tr; i24 += ti;
+    tr = r29 * 0.7071067811865476 - i29 * -0.7071067811865475; ti = r29 * -0.7071067811865475 + i29 * 0.7071067811865476;
+    r29 = r25 - tr; i29 = i25 - ti; r25 += tr; i25 += ti;
+    tr = i30; ti = -r30;
+    r30 = r26 - tr; i30 = i26 - ti; r26 += tr; i26 += ti;
+    tr = r31 * -0.7071067811865475 - i31 * -0.7071067811865476; ti = r31 * -0.7071067811865476 + i31 * -0.7071067811865475;
+    r31 = r27 - tr; i31 = i27 - ti; r27 += tr; i27 += ti;
+    // stage of step 8
+    tr = r8; ti = i8;
+    r8 = r0 - tr; i8 = i0 - ti; r0 += tr; i0 += ti;
+    tr = r9 * 0.9238795325112867 - i9 * -0.3826834323650898; ti = r9 * -0.3826834323650898 + i9 * 0.9238795325112867;
+    r9 = r1 - tr; i9 = i1 - ti; r1 += tr; i1 += ti;
+    tr = r10 * 0.7071067811865476 - i10 * -0.7071067811865475; ti = r10 * -0.7071067811865475 + i10 * 0.7071067811865476;
+    r10 = r2 - tr; i10 = i2 - ti; r2 += tr; i2 += ti;
+    tr = r11 * 0.38268343236508984 - i11 * -0.9238795325112867; ti = r11 * -0.9238795325112867 + i11 * 0.38268343236508984;
+    r11 = r3 - tr; i11 = i3 - ti; r3 += tr; i3 += ti;
+    tr = i12; ti = -r12;
+    r12 = r4 - tr; i12 = i4 - ti; r4 += tr; i4 += ti;
+    tr = r13 * -0.3826834323650897 - i13 * -0.9238795325112867; ti = r13 * -0.9238795325112867 + i13 * -0.3826834323650897;
+    r13 = r5 - tr; i13 = i5 - ti; r5 += tr; i5 += ti;
+    tr = r14 * -0.7071067811865475 - i14 * -0.7071067811865476; ti = r14 * -0.7071067811865476 + i14 * -0.7071067811865475;
+    r14 = r6 - tr; i14 = i6 - ti; r6 += tr; i6 += ti;
+    tr = r15 * -0.9238795325112867 - i15 * -0.3826834323650899; ti = r15 * -0.3826834323650899 + i15 * -0.9238795325112867;
+    r15 = r7 - tr; i15 = i7 - ti; r7 += tr; i7 += ti;
+    tr = r24; ti = i24;
+    r24 = r16 - tr; i24 = i16 - ti; r16 += tr; i16 += ti;
+    tr = r25 * 0.9238795325112867 - i25 * -0.3826834323650898; ti = r25 * -0.3826834323650898 + i25 * 0.9238795325112867;
+    r25 = r17 - tr; i25 = i17 - ti; r17 += tr; i17 += ti;
+    tr = r26 * 0.7071067811865476 - i26 * -0.7071067811865475; ti = r26 * -0.7071067811865475 + i26 * 0.7071067811865476;
+    r26 = r18 - tr; i26 = i18 - ti; r18 += tr; i18 += ti;
+    tr = r27 * 0.38268343236508984 - i27 * -0.9238795325112867; ti = r27 * -0.9238795325112867 + i27 * 0.38268343236508984;
+    r27 = r19 - tr; i27 = i19 - ti; r19 += tr; i19 += ti;
+    tr = i28; ti = -r28;
+    r28 = r20 - tr; i28 = i20 - ti; r20 += tr; i20 += ti;
+    tr = r29 * -0.3826834323650897 - i29 * -0.9238795325112867; ti = r29 * -0.9238795325112867 + i29 * -0.3826834323650897;
+    r29 = r21 - tr; i29 = i21 - ti; r21 += tr; i21 += ti;
+    tr = r30 * -0.7071067811865475 - i30 * -0.7071067811865476; ti = r30 * -0.7071067811865476 + i30 * -0.7071067811865475;
+    r30 = r22 - tr; i30 = i22 - ti; r22 += tr; i22 += ti;
+    tr = r31 * -0.9238795325112867 - i31 * -0.3826834323650899; ti = r31 * -0.3826834323650899 + i31 * -0.9238795325112867;
+    r31 = r23 - tr; i31 = i23 - ti; r23 += tr; i23 += ti;
+    // stage of step 16
+    tr = r16; ti = i16;
+    r16 = r0 - tr; i16 = i0 - ti; r0 += tr; i0 += ti;
+    tr = r17 * 0.9807852804032304 - i17 * -0.19509032201612825; ti = r17 * -0.19509032201612825 + i17 * 0.9807852804032304;
+    r17 = r1 - tr; i17 = i1 - ti; r1 += tr; i1 += ti;
+    tr = r18 * 0.9238795325112867 - i18 * -0.3826834323650898; ti = r18 * -0.3826834323650898 + i18 * 0.9238795325112867;
+    r18 = r2 - tr; i18 = i2 - ti; r2 += tr; i2 += ti;
+    tr = r19 * 0.8314696123025452 - i19 * -0.5555702330196022; ti = r19 * -0.5555702330196022 + i19 * 0.8314696123025452;
+    r19 = r3 - tr; i19 = i3 - ti; r3 += tr; i3 += ti;
+    tr = r20 * 0.7071067811865476 - i20 * -0.7071067811865475; ti = r20 * -0.7071067811865475 + i20 * 0.7071067811865476;
+    r20 = r4 - tr; i20 = i4 - ti; r4 += tr; i4 += ti;
+    tr = r21 * 0.5555702330196023 - i21 * -0.8314696123025452; ti = r21 * -0.8314696123025452 + i21 * 0.5555702330196023;
+    r21 = r5 - tr; i21 = i5 - ti; r5 += tr; i5 += ti;
+    tr = r22 * 0.38268343236508984 - i22 * -0.9238795325112867; ti = r22 * -0.9238795325112867 + i22 * 0.38268343236508984;
+    r22 = r6 - tr; i22 = i6 - ti; r6 += tr; i6 += ti;
+    tr = r23 * 0.19509032201612833 - i23 * -0.9807852804032304; ti = r23 * -0.9807852804032304 + i23 * 0.19509032201612833;
+    r23 = r7 - tr; i23 = i7 - ti; r7 += tr; i7 += ti;
+    tr = i24; ti = -r24;
+    r24 = r8 - tr; i24 = i8 - ti; r8 += tr; i8 += ti;
+    tr = r25 * -0.1950903220161282 - i25 * -0.9807852804032304; ti = r25 * -0.9807852804032304 + i25 * -0.1950903220161282;
+    r25 = r9 - tr; i25 = i9 - ti; r9 += tr; i9 += ti;
+    tr = r26 * -0.3826834323650897 - i26 * -0.9238795325112867; ti = r26 * -0.9238795325112867 + i26 * -0.3826834323650897;
+    r26 = r10 - tr; i26 = i10 - ti; r10 += tr; i10 += ti;
+    tr = r27 * -0.555570233019602 - i27 * -0.8314696123025455; ti = r27 * -0.8314696123025455 + i27 * -0.555570233019602;
+    r27 = r11 - tr; i27 = i11 - ti; r11 += tr; i11 += ti;
+    tr = r28 * -0.7071067811865475 - i28 * -0.7071067811865476; ti = r28 * -0.7071067811865476 + i28 * -0.7071067811865475;
+    r28 = r12 - tr; i28 = i12 - ti; r12 += tr; i12 += ti;
+    tr = r29 * -0.8314696123025453 - i29 * -0.5555702330196022; ti = r29 * -0.5555702330196022 + i29 * -0.8314696123025453;
+    r29 = r13 - tr; i29 = i13 - ti; r13 += tr; i13 += ti;
+    tr = r30 * -0.9238795325112867 - i30 * -0.3826834323650899; ti = r30 * -0.3826834323650899 + i30 * -0.9238795325112867;
+    r30 = r14 - tr; i30 = i14 - ti; r14 += tr; i14 += ti;
+    tr = r31 * -0.9807852804032304 - i31 * -0.1950903220161286; ti = r31 * -0.1950903220161286 + i31 * -0.9807852804032304;
+    r31 = r15 - tr; i31 = i15 - ti; r15 += tr; i15 += ti;
+
+    real[0] = r0; imag[0] = i0;
+    real[1] = r1; imag[1] = i1;
+    real[2] = r2; imag[2] = i2;
+    real[3] = r3; imag[3] = i3;
+    real[4] = r4; imag[4] = i4;
+    real[5] = r5; imag[5] = i5;
+    real[6] = r6; imag[6] = i6;
+    real[7] = r7; imag[7] = i7;
+    real[8] = r8; imag[8] = i8;
+    real[9] = r9; imag[9] = i9;
+    real[10] = r10; imag[10] = i10;
+    real[11] = r11; imag[11] = i11;
+    real[12] = r12; imag[12] = i12;
+    real[13] = r13; imag[13] = i13;
+    real[14] = r14; imag[14] = i14;
+    real[15] = r15; imag[15] = i15;
+    real[16] = r16; imag[16] = i16;
+    real[17] = r17; imag[17] = i17;
+    real[18] = r18; imag[18] = i18;
+    real[19] = r19; imag[19] = i19;
+    real[20] = r20; imag[20] = i20;
+    real[21] = r21; imag[21] = i21;
+    real[22] = r22; imag[22] = i22;
+    real[23] = r23; imag[23] = i23;
+    real[24] = r24; imag[24] = i24;
+    real[25] = r25; imag[25] = i25;
+    real[26] = r26; imag[26] = i26;
+    real[27] = r27; imag[27] = i27;
+    real[28] = r28; imag[28] = i28;
+    real[29] = r29; imag[29] = i29;
+    real[30] = r30; imag[30] = i30;
+    real[31] = r31; imag[31] = i31;
+}
+
+static void fft_codelet_32_reverse(double * real, double * imag)
+{
+    double r0 = real[0], i0 = imag[0];
+    double r1 = real[16], i1 = imag[16];
+    double r2 = real[8], i2 = imag[8];
+    double r3 = real[24], i3 = imag[24];
+    double r4 = real[4], i4 = imag[4];
+    double r5 = real[20], i5 = imag[20];
+    double r6 = real[12], i6 = imag[12];
+    double r7 = real[28], i7 = imag[28];
+    double r8 = real[2], i8 = imag[2];
+    double r9 = real[18], i9 = imag[18];
+    double r10 = real[10], i10 = imag[10];
+    double r11 = real[26], i11 = imag[26];
+    double r12 = real[6], i12 = imag[6];
+    double r13 = real[22], i13 = imag[22];
+    double r14 = real[14], i14 = imag[14];
+    double r15 = real[30], i15 = imag[30];
+    double r16 = real[1], i16 = imag[1];
+    double r17 = real[17], i17 = imag[17];
+    double r18 = real[9], i18 = imag[9];
+    double r19 = real[25], i19 = imag[25];
+    double r20 = real[5], i20 = imag[5];
+    double r21 = real[21], i21 = imag[21];
+    double r22 = real[13], i22 = imag[13];
+    double r23 = real[29], i23 = imag[29];
+    double r24 = real[3], i24 = imag[3];
+    double r25 = real[19], i25 = imag[19];
+    double r26 = real[11], i26 = imag[11];
+    double r27 = real[27], i27 = imag[27];
+    double r28 = real[7], i28 = imag[7];
+    double r29 = real[23], i29 = imag[23];
+    double r30 = real[15], i30 = imag[15];
+    double r31 = real[31], i31 = imag[31];
+    double tr, ti;
+
+    // stage of step 1
+    tr = r1; ti = i1;
+    r1 = r0 - tr; i1 = i0 - ti; r0 += tr; i0 += ti;
+    tr = r3; ti = i3;
+    r3 = r2 - tr; i3 = i2 - ti; r2 += tr; i2 += ti;
+    tr = r5; ti = i5;
+    r5 = r4 - tr; i5 = i4 - ti; r4 += tr; i4 += ti;
+    tr = r7; ti = i7;
+    r7 = r6 - tr; i7 = i6 - ti; r6 += tr; i6 += ti;
+    tr = r9; ti = i9;
+    r9 = r8 - tr; i9 = i8 - ti; r8 += tr; i8 += ti;
+    tr = r11; ti = i11;
+    r11 = r10 - tr; i11 = i10 - ti; r10 += tr; i10 += ti;
+    tr = r13; ti = i13;
+    r13 = r12 - tr; i13 = i12 - ti; r12 += tr; i12 += ti;
+    tr = r15; ti = i15;
+    r15 = r14 - tr; i15 = i14 - ti; r14 += tr; i14 += ti;
+    tr = r17; ti = i17;
+    r17 = r16 - tr; i17 = i16 - ti; r16 += tr; i16 += ti;
+    tr = r19; ti = i19;
+    r19 = r18 - tr; i19 = i18 - ti; r18 += tr; i18 += ti;
+    tr = r21; ti = i21;
+    r21 = r20 - tr; i21 = i20 - ti; r20 += tr; i20 += ti;
+    tr = r23; ti = i23;
+    r23 = r22 - tr; i23 = i22 - ti; r22 += tr; i22 += ti;
+    tr = r25; ti = i25;
+    r25 = r24 - tr; i25 = i24 - ti; r24 += tr; i24 += ti;
+    tr = r27; ti = i27;
+    r27 = r26 - tr; i27 = i26 - ti; r26 += tr; i26 += ti;
+    tr = r29; ti = i29;
+    r29 = r28 - tr; i29 = i28 - ti; r28 += tr; i28 += ti;
+    tr = r31; ti = i31;
+    r31 = r30 - tr; i31 = i30 - ti; r30 += tr; i30 += ti;
+    // stage of step 2
+    tr = r2; ti = i2;
+    r2 = r0 - tr; i2 = i0 - ti; r0 += tr; i0 += ti;
+    tr = -i3; ti = r3;
+    r3 = r1 - tr; i3 = i1 - ti; r1 += tr; i1 += ti;
+    tr = r6; ti = i6;
+    r6 = r4 - tr; i6 = i4 - ti; r4 += tr; i4 += ti;
+    tr = -i7; ti = r7;
+    r7 = r5 - tr; i7 = i5 - ti; r5 += tr; i5 += ti;
+    tr = r10; ti = i10;
+    r10 = r8 - tr; i10 = i8 - ti; r8 += tr; i8 += ti;
+    tr = -i11; ti = r11;
+    r11 = r9 - tr; i11 = i9 - ti; r9 += tr; i9 += ti;
+    tr = r14; ti = i14;
+    r14 = r12 - tr; i14 = i12 - ti; r12 += tr; i12 += ti;
+    tr = -i15; ti = r15;
+    r15 = r13 - tr; i15 = i13 - ti; r13 += tr; i13 += ti;
+    tr = r18; ti = i18;
+    r18 = r16 - tr; i18 = i16 - ti; r16 += tr; i16 += ti;
+    tr = -i19; ti = r19;
+    r19 = r17 - tr; i19 = i17 - ti; r17 += tr; i17 += ti;
+    tr = r22; ti = i22;
+    r22 = r20 - tr; i22 = i20 - ti; r20 += tr; i20 += ti;
+    tr = -i23; ti = r23;
+    r23 = r21 - tr; i23 = i21 - ti; r21 += tr; i21 += ti;
+    tr = r26; ti = i26;
+    r26 = r24 - tr; i26 = i24 - ti; r24 += tr; i24 += ti;
+    tr = -i27; ti = r27;
+    r27 = r25 - tr; i27 = i25 - ti; r25 += tr; i25 += ti;
+    tr = r30; ti = i30;
+    r30 = r28 - tr; i30 = i28 - ti; r28 += tr; i28 += ti;
+    tr = -i31; ti = r31;
+    r31 = r29 - tr; i31 = i29 - ti; r29 += tr; i29 += ti;
+    // stage of step 4
+    tr = r4; ti = i4;
+    r4 = r0 - tr; i4 = i0 - ti; r0 += tr; i0 += ti;
+    tr = r5 * 0.7071067811865476 - i5 * 0.7071067811865475; ti = r5 * 0.7071067811865475 + i5 * 0.7071067811865476;
+    r5 = r1 - tr; i5 = i1 - ti; r1 += tr; i1 += ti;
+    tr = -i6; ti = r6;
+    r6 = r2 - tr; i6 = i2 - ti; r2 += tr; i2 += ti;
+    tr = r7 * -0.7071067811865475 - i7 * 0.7071067811865476; ti = r7 * 0.7071067811865476 + i7 * -0.7071067811865475;
+    r7 = r3 - tr; i7 = i3 - ti; r3 += tr; i3 += ti;
+    tr = r12; ti = i12;
+    r12 = r8 - tr; i12 = i8 - ti; r8 += tr; i8 += ti;
+    tr = r13 * 0.7071067811865476 - i13 * 0.7071067811865475; ti = r13 * 0.7071067811865475 + i13 * 0.7071067811865476;
+    r13 = r9 - tr; i13 = i9 - ti; r9 += tr; i9 += ti;
+    tr = -i14; ti = r14;
+    r14 = r10 - tr; i14 = i10 - ti; r10 += tr; i10 += ti;
+    tr = r15 * -0.7071067811865475 - i15 * 0.7071067811865476; ti = r15 * 0.7071067811865476 + i15 * -0.7071067811865475;
+    r15 = r11 - tr; i15 = i11 - ti; r11 += tr; i11 += ti;
+    tr = r20; ti = i20;
+    r20 = r16 - tr; i20 = i16 - ti; r16 += tr; i16 += ti;
+    tr = r21 * 0.7071067811865476 - i21 * 0.7071067811865475; ti = r21 * 0.7071067811865475 + i21 * 0.7071067811865476;
+    r21 = r17 - tr; i21 = i17 - ti; r17 += tr; i17 += ti;
+    tr = -i22; ti = r22;
+    r22 = r18 - tr; i22 = i18 - ti; r18 += tr; i18 += ti;
+    tr = r23 * -0.7071067811865475 - i23 * 0.7071067811865476; ti = r23 * 0.7071067811865476 + i23 * -0.7071067811865475;
+    r23 = r19 - tr; i23 = i19 - ti; r19 += tr; i19 += ti;
+    tr = r28; ti = i28;
+    r28 = r24 - tr; i28 = i24 - ti; r24 += tr; i24 += ti;
+    tr = r29 * 0.7071067811865476 - i29 * 0.7071067811865475; ti = r29 * 0.7071067811865475 + i29 * 0.7071067811865476;
+    r29 = r25 - tr; i29 = i25 - ti; r25 += tr; i25 += ti;
+    tr = -i30; ti = r30;
+    r30 = r26 - tr; i30 = i26 - ti; r26 += tr; i26 += ti;
+    tr = r31 * -0.7071067811865475 - i31 * 0.7071067811865476; ti = r31 * 0.7071067811865476 + i31 * -0.7071067811865475;
+    r31 = r27 - tr; i31 = i27 - ti; r27 += tr; i27 += ti;
+    // stage of step 8
+    tr = r8; ti = i8;
+    r8 = r0 - tr; i8 = i0 - ti; r0 += tr; i0 += ti;
+    tr = r9 * 0.9238795325112867 - i9 * 0.3826834323650898; ti = r9 * 0.3826834323650898 + i9 * 0.9238795325112867;
+    r9 = r1 - tr; i9 = i1 - ti; r1 += tr; i1 += ti;
+    tr = r10 * 0.7071067811865476 - i10 * 0.7071067811865475; ti = r10 * 0.7071067811865475 + i10 * 0.7071067811865476;
+    r10 = r2 - tr; i10 = i2 - ti; r2 += tr; i2 += ti;
+    tr = r11 * 0.38268343236508984 - i11 * 0.9238795325112867; ti = r11 * 0.9238795325112867 + i11 * 0.38268343236508984;
+    r11 = r3 - tr; i11 = i3 - ti; r3 += tr; i3 += ti;
+    tr = -i12; ti = r12;
+    r12 = r4 - tr; i12 = i4 - ti; r4 += tr; i4 += ti;
+    tr = r13 * -0.3826834323650897 - i13 * 0.9238795325112867; ti = r13 * 0.9238795325112867 + i13 * -0.3826834323650897;
+    r13 = r5 - tr; i13 = i5 - ti; r5 += tr; i5 += ti;
+    tr = r14 * -0.7071067811865475 - i14 * 0.7071067811865476; ti = r14 * 0.7071067811865476 + i14 * -0.7071067811865475;
+    r14 = r6 - tr; i14 = i6 - ti; r6 += tr; i6 += ti;
+    tr = r15 * -0.9238795325112867 - i15 * 0.3826834323650899; ti = r15 * 0.3826834323650899 + i15 * -0.9238795325112867;
+    r15 = r7 - tr; i15 = i7 - ti; r7 += tr; i7 += ti;
+    tr = r24; ti = i24;
+    r24 = r16 - tr; i24 = i16 - ti; r16 += tr; i16 += ti;
+    tr = r25 * 0.9238795325112867 - i25 * 0.3826834323650898; ti = r25 * 0.3826834323650898 + i25 * 0.9238795325112867;
+    r25 = r17 - tr; i25 = i17 - ti; r17 += tr; i17 += ti;
+    tr = r26 * 0.7071067811865476 - i26 * 0.7071067811865475; ti = r26 * 0.7071067811865475 + i26 * 0.7071067811865476;
+    r26 = r18 - tr; i26 = i18 - ti; r18 += tr; i18 += ti;
+    tr = r27 * 0.38268343236508984 - i27 * 0.9238795325112867; ti = r27 * 0.9238795325112867 + i27 * 0.38268343236508984;
+    r27 = r19 - tr; i27 = i19 - ti; r19 += tr; i19 += ti;
+    tr = -i28; ti = r28;
+    r28 = r20 - tr; i28 = i20 - ti; r20 += tr; i20 += ti;
+    tr = r29 * -0.3826834323650897 - i29 * 0.9238795325112867; ti = r29 * 0.9238795325112867 + i29 * -0.3826834323650897;
+    r29 = r21 - tr; i29 = i21 - ti; r21 += tr; i21 += ti;
+    tr = r30 * -0.7071067811865475 - i30 * 0.7071067811865476; ti = r30 * 0.7071067811865476 + i30 * -0.7071067811865475;
+    r30 = r22 - tr; i30 = i22 - ti; r22 += tr; i22 += ti;
+    tr = r31 * -0.9238795325112867 - i31 * 0.3826834323650899; ti = r31 * 0.3826834323650899 + i31 * -0.9238795325112867;
+    r31 = r23 - tr; i31 = i23 - ti; r23 += tr; i23 += ti;
+    // stage of step 16
+    tr = r16; ti = i16;
+    r16 = r0 - tr; i16 = i0 - ti; r0 += tr; i0 += ti;
+    tr = r17 * 0.9807852804032304 - i17 * 0.19509032201612825; ti = r17 * 0.19509032201612825 + i17 * 0.9807852804032304;
+    r17 = r1 - tr; i17 = i1 - ti; r1 += tr; i1 += ti;
+    tr = r18 * 0.9238795325112867 - i18 * 0.3826834323650898; ti = r18 * 0.3826834323650898 + i18 * 0.9238795325112867;
+    r18 = r2 - tr; i18 = i2 - ti; r2 += tr; i2 += ti;
+    tr = r19 * 0.8314696123025452 - i19 * 0.5555702330196022; ti = r19 * 0.5555702330196022 + i19 * 0.8314696123025452;
+    r19 = r3 - tr; i19 = i3 - ti; r3 += tr; i3 += ti;
+    tr = r20 * 0.7071067811865476 - i20 * 0.7071067811865475; ti = r20 * 0.7071067811865475 + i20 * 0.7071067811865476;
+    r20 = r4 - tr; i20 = i4 - ti; r4 += tr; i4 += ti;
+    tr = r21 * 0.5555702330196023 - i21 * 0.8314696123025452; ti = r21 * 0.8314696123025452 + i21 * 0.5555702330196023;
+    r21 = r5 - tr; i21 = i5 - ti; r5 += tr; i5 += ti;
+    tr = r22 * 0.38268343236508984 - i22 * 0.9238795325112867; ti = r22 * 0.9238795325112867 + i22 * 0.38268343236508984;
+    r22 = r6 - tr; i22 = i6 - ti; r6 += tr; i6 += ti;
+    tr = r23 * 0.19509032201612833 - i23 * 0.9807852804032304; ti = r23 * 0.9807852804032304 + i23 * 0.19509032201612833;
+    r23 = r7 - tr; i23 = i7 - ti; r7 += tr; i7 += ti;
+    tr = -i24; ti = r24;
+    r24 = r8 - tr; i24 = i8 - ti; r8 += tr; i8 += ti;
+    tr = r25 * -0.1950903220161282 - i25 * 0.9807852804032304; ti = r25 * 0.9807852804032304 + i25 * -0.1950903220161282;
+    r25 = r9 - tr; i25 = i9 - ti; r9 += tr; i9 += ti;
+    tr = r26 * -0.3826834323650897 - i26 * 0.9238795325112867; ti = r26 * 0.9238795325112867 + i26 * -0.3826834323650897;
+    r26 = r10 - tr; i26 = i10 - ti; r10 += tr; i10 += ti;
+    tr = r27 * -0.555570233019602 - i27 * 0.8314696123025455; ti = r27 * 0.8314696123025455 + i27 * -0.555570233019602;
+    r27 = r11 - tr; i27 = i11 - ti; r11 += tr; i11 += ti;
+    tr = r28 * -0.7071067811865475 - i28 * 0.7071067811865476; ti = r28 * 0.7071067811865476 + i28 * -0.7071067811865475;
+    r28 = r12 - tr; i28 = i12 - ti; r12 += tr; i12 += ti;
+    tr = r29 * -0.8314696123025453 - i29 * 0.5555702330196022; ti = r29 * 0.5555702330196022 + i29 * -0.8314696123025453;
+    r29 = r13 - tr; i29 = i13 - ti; r13 += tr; i13 += ti;
+    tr = r30 * -0.9238795325112867 - i30 * 0.3826834323650899; ti = r30 * 0.3826834323650899 + i30 * -0.9238795325112867;
+    r30 = r14 - tr; i30 = i14 - ti; r14 += tr; i14 += ti;
+    tr = r31 * -0.9807852804032304 - i31 * 0.1950903220161286; ti = r31 * 0.1950903220161286 + i31 * -0.9807852804032304;
+    r31 = r15 - tr; i31 = i15 - ti; r15 += tr; i15 += ti;
+
+    real[0] = r0; imag[0] = i0;
+    real[1] = r1; imag[1] = i1;
+    real[2] = r2; imag[2] = i2;
+    real[3] = r3; imag[3] = i3;
+    real[4] = r4; imag[4] = i4;
+    real[5] = r5; imag[5] = i5;
+    real[6] = r6; imag[6] = i6;
+    real[7] = r7; imag[7] = i7;
+    real[8] = r8; imag[8] = i8;
+    real[9] = r9; imag[9] = i9;
+    real[10] = r10; imag[10] = i10;
+    real[11] = r11; imag[11] = i11;
+    real[12] = r12; imag[12] = i12;
+    real[13] = r13; imag[13] = i13;
+    real[14] = r14; imag[14] = i14;
+    real[15] = r15; imag[15] = i15;
+    real[16] = r16; imag[16] = i16;
+    real[17] = r17; imag[17] = i17;
+    real[18] = r18; imag[18] = i18;
+    real[19] = r19; imag[19] = i19;
+    real[20] = r20; imag[20] = i20;
+    real[21] = r21; imag[21] = i21;
+    real[22] = r22; imag[22] = i22;
+    real[23] = r23; imag[23] = i23;
+    real[24] = r24; imag[24] = i24;
+    real[25] = r25; imag[25] = i25;
+    real[26] = r26; imag[26] = i26;
+    real[27] = r27; imag[27] = i27;
+    real[28] = r28; imag[28] = i28;
+    real[29] = r29; imag[29] = i29;
+    real[30] = r30; imag[30] = i30;
+    real[31] = r31; imag[31] = i31;
+}
+
+static void fht_codelet_32(double * values)
+{
+    double v0 = values[0];
+    double v1 = values[16];
+    double v2 = values[8];
+    double v3 = values[24];
+    double v4 = values[4];
+    double v5 = values[20];
+    double v6 = values[12];
+    double v7 = values[28];
+    double v8 = values[2];
+    double v9 = values[18];
+    double v10 = values[10];
+    double v11 = values[26];
+    double v12 = values[6];
+    double v13 = values[22];
+    double v14 = values[14];
+    double v15 = values[30];
+    double v16 = values[1];
+    double v17 = values[17];
+    double v18 = values[9];
+    double v19 = values[25];
+    double v20 = values[5];
+    double v21 = values[21];
+    double v22 = values[13];
+    double v23 = values[29];
+    double v24 = values[3];
+    double v25 = values[19];
+    double v26 = values[11];
+    double v27 = values[27];
+    double v28 = values[7];
+    double v29 = values[23];
+    double v30 = values[15];
+    double v31 = values[31];
+    double a, b;
+
+    // level 2
+    a = v0; b = v1; v0 = a + b; v1 = a - b;
+    a = v2; b = v3; v2 = a + b; v3 = a - b;
+    a = v4; b = v5; v4 = a + b; v5 = a - b;
+    a = v6; b = v7; v6 = a + b; v7 = a - b;
+    a = v8; b = v9; v8 = a + b; v9 = a - b;
+    a = v10; b = v11; v10 = a + b; v11 = a - b;
+    a = v12; b = v13; v12 = a + b; v13 = a - b;
+    a = v14; b = v15; v14 = a + b; v15 = a - b;
+    a = v16; b = v17; v16 = a + b; v17 = a - b;
+    a = v18; b = v19; v18 = a + b; v19 = a - b;
+    a = v20; b = v21; v20 = a + b; v21 = a - b;
+    a = v22; b = v23; v22 = a + b; v23 = a - b;
+    a = v24; b = v25; v24 = a + b; v25 = a - b;
+    a = v26; b = v27; v26 = a + b; v27 = a - b;
+    a = v28; b = v29; v28 = a + b; v29 = a - b;
+    a = v30; b = v31; v30 = a + b; v31 = a - b;
+    // level 4
+    a = v0; b = v2; v0 = a + b; v2 = a - b;
+    a = v1; b = v3; v1 = a + b; v3 = a - b;
+    a = v4; b = v6; v4 = a + b; v6 = a - b;
+    a = v5; b = v7; v5 = a + b; v7 = a - b;
+    a = v8; b = v10; v8 = a + b; v10 = a - b;
+    a = v9; b = v11; v9 = a + b; v11 = a - b;
+    a = v12; b = v14; v12 = a + b; v14 = a - b;
+    a = v13; b = v15; v13 = a + b; v15 = a - b;
+    a = v16; b = v18; v16 = a + b; v18 = a - b;
+    a = v17; b = v19; v17 = a + b; v19 = a - b;
+    a = v20; b = v22; v20 = a + b; v22 = a - b;
+    a = v21; b = v23; v21 = a + b; v23 = a - b;
+    a = v24; b = v26; v24 = a + b; v26 = a - b;
+    a = v25; b = v27; v25 = a + b; v27 = a - b;
+    a = v28; b = v30; v28 = a + b; v30 = a - b;
+    a = v29; b = v31; v29 = a + b; v31 = a - b;
+    // level 8
+    a = v5; b = v7;
+    v5 = a * 0.7071067811865476 + b * 0.7071067811865475; v7 = a * 0.7071067811865475 - b * 0.7071067811865476;
+    a = v0; b = v4; v0 = a + b; v4 = a - b;
+    a = v1; b = v5; v1 = a + b; v5 = a - b;
+    a = v2; b = v6; v2 = a + b; v6 = a - b;
+    a = v3; b = v7; v3 = a + b; v7 = a - b;
+    a = v13; b = v15;
+    v13 = a * 0.7071067811865476 + b * 0.7071067811865475; v15 = a * 0.7071067811865475 - b * 0.7071067811865476;
+    a = v8; b = v12; v8 = a + b; v12 = a - b;
+    a = v9; b = v13; v9 = a + b; v13 = a - b;
+    a = v10; b = v14; v10 = a + b; v14 = a - b;
+    a = v11; b = v15; v11 = a + b; v15 = a - b;
+    a = v21; b = v23;
+    v21 = a * 0.7071067811865476 + b * 0.7071067811865475; v23 = a * 0.7071067811865475 - b * 0.7071067811865476;
+    a = v16; b = v20; v16 = a + b; v20 = a - b;
+    a = v17; b = v21; v17 = a + b; v21 = a - b;
+    a = v18; b = v22; v18 = a + b; v22 = a - b;
+    a = v19; b = v23; v19 = a + b; v23 = a - b;
+    a = v29; b = v31;
+    v29 = a * 0.7071067811865476 + b * 0.7071067811865475; v31 = a * 0.7071067811865475 - b * 0.7071067811865476;
+    a = v24; b = v28; v24 = a + b; v28 = a - b;
+    a = v25; b = v29; v25 = a + b; v29 = a - b;
+    a = v26; b = v30; v26 = a + b; v30 = a - b;
+    a = v27; b = v31; v27 = a + b; v31 = a - b;
+    // level 16
+    a = v9; b = v15;
+    v9 = a * 0.9238795325112867 + b * 0.3826834323650898; v15 = a * 0.3826834323650898 - b * 0.9238795325112867;
+    a = v10; b = v14;
+    v10 = a * 0.7071067811865476 + b * 0.7071067811865475; v14 = a * 0.7071067811865475 - b * 0.7071067811865476;
+    a = v11; b = v13;
+    v11 = a * 0.38268343236508984 + b * 0.9238795325112867; v13 = a * 0.9238795325112867 - b * 0.38268343236508984;
+    a = v0; b = v8; v0 = a + b; v8 = a - b;
+    a = v1; b = v9; v1 = a + b; v9 = a - b;
+    a = v2; b = v10; v2 = a + b; v10 = a - b;
+    a = v3; b = v11; v3 = a + b; v11 = a - b;
+    a = v4; b = v12; v4 = a + b; v12 = a - b;
+    a = v5; b = v13; v5 = a + b; v13 = a - b;
+    a = v6; b = v14; v6 = a + b; v14 = a - b;
+    a = v7; b = v15; v7 = a + b; v15 = a - b;
+    a = v25; b = v31;
+    v25 = a * 0.9238795325112867 + b * 0.3826834323650898; v31 = a * 0.3826834323650898 - b * 0.9238795325112867;
+    a = v26; b = v30;
+    v26 = a * 0.7071067811865476 + b * 0.7071067811865475; v30 = a * 0.7071067811865475 - b * 0.7071067811865476;
+    a = v27; b = v29;
+    v27 = a * 0.38268343236508984 + b * 0.9238795325112867; v29 = a * 0.9238795325112867 - b * 0.38268343236508984;
+    a = v16; b = v24; v16 = a + b; v24 = a - b;
+    a = v17; b = v25; v17 = a + b; v25 = a - b;
+    a = v18; b = v26; v18 = a + b; v26 = a - b;
+    a = v19; b = v27; v19 = a + b; v27 = a - b;
+    a = v20; b = v28; v20 = a + b; v28 = a - b;
+    a = v21; b = v29; v21 = a + b; v29 = a - b;
+    a = v22; b = v30; v22 = a + b; v30 = a - b;
+    a = v23; b = v31; v23 = a + b; v31 = a - b;
+    // level 32
+    a = v17; b = v31;
+    v17 = a * 0.9807852804032304 + b * 0.19509032201612825; v31 = a * 0.19509032201612825 - b * 0.9807852804032304;
+    a = v18; b = v30;
+    v18 = a * 0.9238795325112867 + b * 0.3826834323650898; v30 = a * 0.3826834323650898 - b * 0.9238795325112867;
+    a = v19; b = v29;
+    v19 = a * 0.8314696123025452 + b * 0.5555702330196022; v29 = a * 0.5555702330196022 - b * 0.8314696123025452;
+    a = v20; b = v28;
+    v20 = a * 0.7071067811865476 + b * 0.7071067811865475; v28 = a * 0.7071067811865475 - b * 0.7071067811865476;
+    a = v21; b = v27;
+    v21 = a * 0.5555702330196023 + b * 0.8314696123025452; v27 = a * 0.8314696123025452 - b * 0.5555702330196023;
+    a = v22; b = v26;
+    v22 = a * 0.38268343236508984 + b * 0.9238795325112867; v26 = a * 0.9238795325112867 - b * 0.38268343236508984;
+    a = v23; b = v25;
+    v23 = a * 0.19509032201612833 + b * 0.9807852804032304; v25 = a * 0.9807852804032304 - b * 0.19509032201612833;
+    a = v0; b = v16; v0 = a + b; v16 = a - b;
+    a = v1; b = v17; v1 = a + b; v17 = a - b;
+    a = v2; b = v18; v2 = a + b; v18 = a - b;
+    a = v3; b = v19; v3 = a + b; v19 = a - b;
+    a = v4; b = v20; v4 = a + b; v20 = a - b;
+    a = v5; b = v21; v5 = a + b; v21 = a - b;
+    a = v6; b = v22; v6 = a + b; v22 = a - b;
+    a = v7; b = v23; v7 = a + b; v23 = a - b;
+    a = v8; b = v24; v8 = a + b; v24 = a - b;
+    a = v9; b = v25; v9 = a + b; v25 = a - b;
+    a = v10; b = v26; v10 = a + b; v26 = a - b;
+    a = v11; b = v27; v11 = a + b; v27 = a - b;
+    a = v12; b = v28; v12 = a + b; v28 = a - b;
+    a = v13; b = v29; v13 = a + b; v29 = a - b;
+    a = v14; b = v30; v14 = a + b; v30 = a - b;
+    a = v15; b = v31; v15 = a + b; v31 = a - b;
+
+    values[0] = v0 * 0.17677669529663687;
+    values[1] = v1 * 0.17677669529663687;
+    values[2] = v2 * 0.17677669529663687;
+    values[3] = v3 * 0.17677669529663687;
+    values[4] = v4 * 0.17677669529663687;
+    values[5] = v5 * 0.17677669529663687;
+    values[6] = v6 * 0.17677669529663687;
+    values[7] = v7 * 0.17677669529663687;
+    values[8] = v8 * 0.17677669529663687;
+    values[9] = v9 * 0.17677669529663687;
+    values[10] = v10 * 0.17677669529663687;
+    values[11] = v11 * 0.17677669529663687;
+    values[12] = v12 * 0.17677669529663687;
+    values[13] = v13 * 0.17677669529663687;
+    values[14] = v14 * 0.17677669529663687;
+    values[15] = v15 * 0.17677669529663687;
+    values[16] = v16 * 0.17677669529663687;
+    values[17] = v17 * 0.17677669529663687;
+    values[18] = v18 * 0.17677669529663687;
+    values[19] = v19 * 0.17677669529663687;
+    values[20] = v20 * 0.17677669529663687;
+    values[21] = v21 * 0.17677669529663687;
+    values[22] = v22 * 0.17677669529663687;
+    values[23] = v23 * 0.17677669529663687;
+    values[24] = v24 * 0.17677669529663687;
+    values[25] = v25 * 0.17677669529663687;
+    values[26] = v26 * 0.17677669529663687;
+    values[27] = v27 * 0.17677669529663687;
+    values[28] = v28 * 0.17677669529663687;
+    values[29] = v29 * 0.17677669529663687;
+    values[30] = v30 * 0.17677669529663687;
+    values[31] = v31 * 0.17677669529663687;
+}
+
+static void fft_codelet_64_forward(double * real, double * imag)
+{
+    double r0 = real[0], i0 = imag[0];
+    double r1 = real[32], i1 = imag[32];
+    double r2 = real[16], i2 = imag[16];
+    double r3 = real[48], i3 = imag[48];
+    double r4 = real[8], i4 = imag[8];
+    double r5 = real[40], i5 = imag[40];
+    double r6 = real[24], i6 = imag[24];
+    double r7 = real[56], i7 = imag[56];
+    double r8 = real[4], i8 = imag[4];
+    double r9 = real[36], i9 = imag[36];
+    double r10 = real[20], i10 = imag[20];
+    double r11 = real[52], i11 = imag[52];
+    double r12 = real[12], i12 = imag[12];
+    double r13 = real[44], i13 = imag[44];
+    double r14 = real[28], i14 = imag[28];
+    double r15 = real[60], i15 = imag[60];
+    double r16 = real[2], i16 = imag[2];
+    double r17 = real[34], i17 = imag[34];
+    double r18 = real[18], i18 = imag[18];
+    double r19 = real[50], i19 = imag[50];
+    double r20 = real[10], i20 = imag[10];
+    double r21 = real[42], i21 = imag[42];
+    double r22 = real[26], i22 = imag[26];
+    double r23 = real[58], i23 = imag[58];
+    double r24 = real[6], i24 = imag[6];
+    double r25 = real[38], i25 = imag[38];
+    double r26 = real[22], i26 = imag[22];
+    double r27 = real[54], i27 = imag[54];
+    double r28 = real[14], i28 = imag[14];
+    double r29 = real[46], i29 = imag[46];
+    double r30 = real[30], i30 = imag[30];
+    double r31 = real[62], i31 = imag[62];
+    double r32 = real[1], i32 = imag[1];
+    double r33 = real[33], i33 = imag[33];
+    double r34 = real[17], i34 = imag[17];
+    double r35 = real[49], i35 = imag[49];
+    double r36 = real[9], i36 = imag[9];
+    double r37 = real[41], i37 = imag[41];
+    double r38 = real[25], i38 = imag[25];
+    double r39 = real[57], i39 = imag[57];
+    double r40 = real[5], i40 = imag[5];
+    double r41 = real[37], i41 = imag[37];
+    double r42 = real[21], i42 = imag[21];
+    double r43 = real[53], i43 = imag[53];
+    double r44 = real[13], i44 = imag[13];
+    double r45 = real[45], i45 = imag[45];
+    double r46 = real[29], i46 = imag[29];
+    double r47 = real[61], i47 = imag[61];
+    double r48 = real[3], i48 = imag[3];
+    double r49 = real[35], i49 = imag[35];
+    double r50 = real[19], i50 = imag[19];
+    double r51 = real[51], i51 = imag[51];
+    double r52 = real[11], i52 = imag[11];
+    double r53 = real[43], i53 = imag[43];
+    double r54 = real[27], i54 = imag[27];
+    double r55 = real[59], i55 = imag[59];
+    double r56 = real[7], i56 = imag[7];
+    double r57 = real[39], i57 = imag[39];
+    double r58 = real[23], i58 = imag[23];
+    double r59 = real[55], i59 = imag[55];
+    double r60 = real[15], i60 = imag[15];
+    double r61 = real[47], i61 = imag[47];
+    double r62 = real[31], i62 = imag[31];
+    double r63 = real[63], i63 = imag[63];
+    double tr, ti;
+
+    // stage of step 1
+    tr = r1; ti = i1;
+    r1 = r0 - tr; i1 = i0 - ti; r0 += tr; i0 += ti;
+    tr = r3; ti = i3;
+    r3 = r2 - tr; i3 = i2 - ti; r2 += tr; i2 += ti;
+    tr = r5; ti = i5;
+    r5 = r4 - tr; i5 = i4 - ti; r4 += tr; i4 += ti;
+    tr = r7; ti = i7;
+    r7 = r6 - tr; i7 = i6 - ti; r6 += tr; i6 += ti;
+    tr = r9; ti = i9;
+    r9 = r8 - tr; i9 = i8 - ti; r8 += tr; i8 += ti;
+    tr = r11; ti = i11;
+    r11 = r10 - tr; i11 = i10 - ti; r10 += tr; i10 += ti;
+    tr = r13; ti = i13;
+    r13 = r12 - tr; i13 = i12 - ti; r12 += tr; i12 += ti;
+    tr = r15; ti = i15;
+    r15 = r14 - tr; i15 = i14 - ti; r14 += tr; i14 += ti;
+    tr = r17; ti = i17;
+    r17 = r16 - tr; i17 = i16 - ti; r16 += tr; i16 += ti;
+    tr = r19; ti = i19;
+    r19 = r18 - tr; i19 = i18 - ti; r18 += tr; i18 += ti;
+    tr = r21; ti = i21;
+    r21 = r20 - tr; i21 = i20 - ti; r20 += tr; i20 += ti;
+    tr = r23; ti = i23;
+    r23 = r22 - tr; i23 = i22 - ti; r22 += tr; i22 += ti;
+    tr = r25; ti = i25;
+    r25 = r24 - tr; i25 = i24 - ti; r24 += tr; i24 += ti;
+    tr = r27; ti = i27;
+    r27 = r26 - tr; i27 = i26 - ti; r26 += tr; i26 += ti;
+    tr = r29; ti = i29;
+    r29 = r28 - tr; i29 = i28 - ti; r28 += tr; i28 += ti;
+    tr = r31; ti = i31;
+    r31 = r30 - tr; i31 = i30 - ti; r30 += tr; i30 += ti;
+    tr = r33; ti = i33;
+    r33 = r32 - tr; i33 = i32 - ti; r32 += tr; i32 += ti;
+    tr = r35; ti = i35;
+    r35 = r34 - tr; i35 = i34 - ti; r34 += tr; i34 += ti;
+    tr = r37; ti = i37;
+    r37 = r36 - tr; i37 = i36 - ti; r36 += tr; i36 += ti;
+    tr = r39; ti = i39;
+    r39 = r38 - tr; i39 = i38 - ti; r38 += tr; i38 += ti;
+    tr = r41; ti = i41;
+    r41 = r40 - tr; i41 = i40 - ti; r40 += tr; i40 += ti;
+    tr = r43; ti = i43;
+    r43 = r42 - tr; i43 = i42 - ti; r42 += tr; i42 += ti;
+    tr = r45; ti = i45;
+    r45 = r44 - tr; i45 = i44 - ti; r44 += tr; i44 += ti;
+    tr = r47; ti = i47;
+    r47 = r46 - tr; i47 = i46 - ti; r46 += tr; i46 += ti;
+    tr = r49; ti = i49;
+    r49 = r48 - tr; i49 = i48 - ti; r48 += tr; i48 += ti;
+    tr = r51; ti = i51;
+    r51 = r50 - tr; i51 = i50 - ti; r50 += tr; i50 += ti;
+    tr = r53; ti = i53;
+    r53 = r52 - tr; i53 = i52 - ti; r52 += tr; i52 += ti;
+    tr = r55; ti = i55;
+    r55 = r54 - tr; i55 = i54 - ti; r54 += tr; i54 += ti;
+    tr = r57; ti = i57;
+    r57 = r56 - tr; i57 = i56 - ti; r56 += tr; i56 += ti;
+    tr = r59; ti = i59;
+    r59 = r58 - tr; i59 = i58 - ti; r58 += tr; i58 += ti;
+    tr = r61; ti = i61;
+    r61 = r60 - tr; i61 = i60 - ti; r60 += tr; i60 += ti;
+    tr = r63; ti = i63;
+    r63 = r62 - tr; i63 = i62 - ti; r62 += tr; i62 += ti;
+    // stage of step 2
+    tr = r2; ti = i2;
+    r2 = r0 - tr; i2 = i0 - ti; r0 += tr; i0 += ti;
+    tr = i3; ti = -r3;
+    r3 = r1 - tr; i3 = i1 - ti; r1 += tr; i1 += ti;
+    tr = r6; ti = i6;
+    r6 = r4 - tr; i6 = i4 - ti; r4 += tr; i4 += ti;
+    tr = i7; ti = -r7;
+    r7 = r5 - tr; i7 = i5 - ti; r5 += tr; i5 += ti;
+    tr = r10; ti = i10;
+    r10 = r8 - tr; i10 = i8 - ti; r8 += tr; i8 += ti;
+    tr = i11; ti = -r11;
+    r11 = r9 - tr; i11 = i9 - ti; r9 += tr; i9 += ti;
+    tr = r14; ti = i14;
+    r14 = r12 - tr; i14 = i12 - ti; r12 += tr; i12 += ti;
+    tr = i15; ti = -r15;
+    r15 = r13 - tr; i15 = i13 - ti; r13 += tr; i13 += ti;
+    tr = r18; ti = i18;
+    r18 = r16 - tr; i18 = i16 - ti; r16 += tr; i16 += ti;
+    tr = i19; ti = -r19;
+    r19 = r17 - tr; i19 = i17 - ti; r17 += tr; i17 += ti;
+    tr = r22; ti = i22;
+    r22 = r20 - tr; i22 = i20 - ti; r20 += tr; i20 += ti;
+    tr = i23; ti = -r23;
+    r23 = r21 - tr; i23 = i21 - ti; r21 += tr; i21 += ti;
+    tr = r26; ti = i26;
+    r26 = r24 - tr; i26 = i24 - ti; r24 += tr; i24 += ti;
+    tr = i27; ti = -r27;
+    r27 = r25 - tr; i27 = i25 - ti; r25 += tr; i25 += ti;
+    tr = r30; ti = i30;
+    r30 = r28 - tr; i30 = i28 - ti; r28 += tr; i28 += ti;
+    tr = i31; ti = -r31;
+    r31 = r29 - tr; i31 = i29 - ti; r29 += tr; i29 += ti;
+    tr = r34; ti = i34;
+    r34 = r32 - tr; i34 = i32 - ti; r32 += tr; i32 += ti;
+    tr = i35; ti = -r35;
+    r35 = r33 - tr; i35 = i33 - ti; r33 += tr; i33 += ti;
+    tr = r38; ti = i38;
+    r38 = r36 - tr; i38 = i36 - ti; r36 += tr; i36 += ti;
+    tr = i39; ti = -r39;
+    r39 = r37 - tr; i39 = i37 - ti; r37 += tr; i37 += ti;
+    tr = r42; ti = i42;
+    r42 = r40 - tr; i42 = i40 - ti; r40 += tr; i40 += ti;
+    tr = i43; ti = -r43;
+    r43 = r41 - tr; i43 = i41 - ti; r41 += tr; i41 += ti;
+    tr = r46; ti = i46;
+    r46 = r44 - tr; i46 = i44 - ti; r44 += tr; i44 += ti;
+    tr = i47; ti = -r47;
+    r47 = r45 - tr; i47 = i45 - ti; r45 += tr; i45 += ti;
+    tr = r50; ti = i50;
+    r50 = r48 - tr; i50 = i48 - ti; r48 += tr; i48 += ti;
+    tr = i51; ti = -r51;
+    r51 = r49 - tr; i51 = i49 - ti; r49 += tr; i49 += ti;
+    tr = r54; ti = i54;
+    r54 = r52 - tr; i54 = i52 - ti; r52 += tr; i52 += ti;
+    tr = i55; ti = -r55;
+    r55 = r53 - tr; i55 = i53 - ti; r53 += tr; i53 += ti;
+    tr = r58; ti = i58;
+    r58 = r56 - tr; i58 = i56 - ti; r56 += tr; i56 += ti;
+    tr = i59; ti = -r59;
+    r59 = r57 - tr; i59 = i57 - ti; r57 += tr; i57 += ti;
+    tr = r62; ti = i62;
+    r62 = r60 - tr; i62 = i60 - ti; r60 += tr; i60 += ti;
+    tr = i63; ti = -r63;
+    r63 = r61 - tr; i63 = i61 - ti; r61 += tr; i61 += ti;
+    // stage of step 4
+    tr = r4; ti = i4;
+    r4 = r0 - tr; i4 = i0 - ti; r0 += tr; i0 += ti;
+    tr = r5 * 0.7071067811865476 - i5 * -0.7071067811865475; ti = r5 * -0.7071067811865475 + i5 * 0.7071067811865476;
+    r5 = r1 - tr; i5 = i1 - ti; r1 += tr; i1 += ti;
+    tr = i6; ti = -r6;
+    r6 = r2 - tr; i6 = i2 - ti; r2 += tr; i2 += ti;
+    tr = r7 * -0.7071067811865475 - i7 * -0.7071067811865476; ti = r7 * -0.7071067811865476 + i7 * -0.7071067811865475;
+    r7 = r3 - tr; i7 = i3 - ti; r3 += tr; i3 += ti;
+    tr = r12; ti = i12;
+    r12 = r8 - tr; i12 = i8 - ti; r8 += tr; i8 += ti;
+    tr = r13 * 0.7071067811865476 - i13 * -0.7071067811865475; ti = r13 * -0.7071067811865475 + i13 * 0.7071067811865476;
+    r13 = r9 - tr; i13 = i9 - ti; r9 += tr; i9 += ti;
+    tr = i14; ti = -r14;
+    r14 = r10 - tr; i14 = i10 - ti; r10 += tr; i10 += ti;
+    tr = r15 * -0.7071067811865475 - i15 * -0.7071067811865476; ti = r15 * -0.7071067811865476 + i15 * -0.7071067811865475;
+    r15 = r11 - tr; i15 = i11 - ti; r11 += tr; i11 += ti;
+    tr = r20; ti = i20;
+    r20 = r16 - tr; i20 = i16 - ti; r16 += tr; i16 += ti;
+    tr = r21 * 0.7071067811865476 - i21 * -0.7071067811865475; ti = r21 * -0.7071067811865475 + i21 * 0.7071067811865476;
+    r21 = r17 - tr; i21 = i17 - ti; r17 += tr; i17 += ti;
+    tr = i22; ti = -r22;
+    r22 = r18 - tr; i22 = i18 - ti; r18 += tr; i18 += ti;
+    tr = r23 * -0.7071067811865475 - i23 * -0.7071067811865476; ti = r23 * -0.7071067811865476 + i23 * -0.7071067811865475;
+    r23 = r19 - tr; i23 = i19 - ti; r19 += tr; i19 += ti;
+    tr = r28; ti = i28;
+    r28 = r24 - tr; i28 = i24 - ti; r24 += tr; i24 += ti;
+    tr = r29 * 0.7071067811865476 - i29 * -0.7071067811865475; ti = r29 * -0.7071067811865475 + i29 * 0.7071067811865476;
+    r29 = r25 - tr; i29 = i25 - ti; r25 += tr; i25 += ti;
+    tr = i30; ti = -r30;
+    r30 = r26 - tr; i30 = i26 - ti; r26 += tr; i26 += ti;
+    tr = r31 * -0.7071067811865475 - i31 * -0.7071067811865476; ti = r31 * -0.7071067811865476 + i31 * -0.7071067811865475;
+    r31 = r27 - tr; i31 = i27 - ti; r27 += tr; i27 += ti;
+    tr = r36; ti = i36;
+    r36 = r32 - tr; i36 = i32 - ti; r32 += tr; i32 += ti;
+    tr = r37 * 0.7071067811865476 - i37 * -0.7071067811865475; ti = r37 * -0.7071067811865475 + i37 * 0.7071067811865476;
+    r37 = r33 - tr; i37 = i33 - ti; r33 += tr; i33 += ti;
+    tr = i38; ti = -r38;
+    r38 = r34 - tr; i38 = i34 - ti; r34 += tr; i34 += ti;
+    tr = r39 * -0.7071067811865475 - i39 * -0.7071067811865476; ti = r39 * -0.7071067811865476 + i39 * -0.7071067811865475;
+    r39 = r35 - tr; i39 = i35 - ti; r35 += tr; i35 += ti;
+    tr = r44; ti = i44;
+    r44 = r40 - tr; i44 = i40 - ti; r40 += tr; i40 += ti;
+    tr = r45 * 0.7071067811865476 - i45 * -0.7071067811865475; ti = r45 * -0.7071067811865475 + i45 * 0.7071067811865476;
+    r45 = r41 - tr; i45 = i41 - ti; r41 += tr; i41 += ti;
+    tr = i46; ti = -r46;
+    r46 = r42 - tr; i46 = i42 - ti; r42 += tr; i42 += ti;
+    tr = r47 * -0.7071067811865475 - i47 * -0.7071067811865476; ti = r47 * -0.7071067811865476 + i47 * -0.7071067811865475;
+    r47 = r43 - tr; i47 = i43 - ti; r43 += tr; i43 += ti;
+    tr = r52; ti = i52;
+    r52 = r48 - tr; i52 = i48 - ti; r48 += tr; i48 += ti;
+    tr = r53 * 0.7071067811865476 - i53 * -0.7071067811865475; ti = r53 * -0.7071067811865475 + i53 * 0.7071067811865476;
+    r53 = r49 - tr; i53 = i49 - ti; r49 += tr; i49 += ti;
+    tr = i54; ti = -r54;
+    r54 = r50 - tr; i54 = i50 - ti; r50 += tr; i50 += ti;
+    tr = r55 * -0.7071067811865475 - i55 * -0.7071067811865476; ti = r55 * -0.7071067811865476 + i55 * -0.7071067811865475;
+    r55 = r51 - tr; i55 = i51 - ti; r51 += tr; i51 += ti;
+    tr = r60; ti = i60;
+    r60 = r56 - tr; i60 = i56 - ti; r56 += tr; i56 += ti;
+    tr = r61 * 0.7071067811865476 - i61 * -0.7071067811865475; ti = r61 * -0.7071067811865475 + i61 * 0.7071067811865476;
+    r61 = r57 - tr; i61 = i57 - ti; r57 += tr; i57 += ti;
+    tr = i62; ti = -r62;
+    r62 = r58 - tr; i62 = i58 - ti; r58 += tr; i58 += ti;
+    tr = r63 * -0.7071067811865475 - i63 * -0.7071067811865476; ti = r63 * -0.7071067811865476 + i63 * -0.7071067811865475;
+    r63 = r59 - tr; i63 = i59 - ti; r59 += tr; i59 += ti;
+    // stage of step 8
+    tr = r8; ti = i8;
+    r8 = r0 - tr; i8 = i0 - ti; r0 += tr; i0 += ti;
+    tr = r9 * 0.9238795325112867 - i9 * -0.3826834323650898; ti = r9 * -0.3826834323650898 + i9 * 0.9238795325112867;
+    r9 = r1 - tr; i9 = i1 - ti; r1 += tr; i1 += ti;
+    tr = r10 * 0.7071067811865476 - i10 * -0.7071067811865475; ti = r10 * -0.7071067811865475 + i10 * 0.7071067811865476;
+    r10 = r2 - tr; i10 = i2 - ti; r2 += tr; i2 += ti;
+    tr = r11 * 0.38268343236508984 - i11 * -0.9238795325112867; ti = r11 * -0.9238795325112867 + i11 * 0.38268343236508984;
+    r11 = r3 - tr; i11 = i3 - ti; r3 += tr; i3 += ti;
+    tr = i12; ti = -r12;
+    r12 = r4 - tr; i12 = i4 - ti; r4 += tr; i4 += ti;
+    tr = r13 * -0.3826834323650897 - i13 * -0.9238795325112867; ti = r13 * -0.9238795325112867 + i13 * -0.3826834323650897;
+    r13 = r5 - tr; i13 = i5 - ti; r5 += tr; i5 += ti;
+    tr = r14 * -0.7071067811865475 - i14 * -0.7071067811865476; ti = r14 * -0.7071067811865476 + i14 * -0.7071067811865475;
+    r14 = r6 - tr; i14 = i6 - ti; r6 += tr; i6 += ti;
+    tr = r15 * -0.9238795325112867 - i15 * -0.3826834323650899; ti = r15 * -0.3826834323650899 + i15 * -0.9238795325112867;
+    r15 = r7 - tr; i15 = i7 - ti; r7 += tr; i7 += ti;
+    tr = r24; ti = i24;
+    r24 = r16 - tr; i24 = i16 - ti; r16 += tr; i16 += ti;
+    tr = r25 * 0.9238795325112867 - i25 * -0.3826834323650898; ti = r25 * -0.3826834323650898 + i25 * 0.9238795325112867;
+    r25 = r17 - tr; i25 = i17 - ti; r17 += tr; i17 += ti;
+    tr = r26 * 0.7071067811865476 - i26 * -0.7071067811865475; ti = r26 * -0.7071067811865475 + i26 * 0.7071067811865476;
+    r26 = r18 - tr; i26 = i18 - ti; r18 += tr; i18 += ti;
+    tr = r27 * 0.38268343236508984 - i27 * -0.9238795325112867; ti = r27 * -0.9238795325112867 + i27 * 0.38268343236508984;
+    r27 = r19 - tr; i27 = i19 - ti; r19 += tr; i19 += ti;
+    tr = i28; ti = -r28;
+    r28 = r20 - tr; i28 = i20 - ti; r20 += tr; i20 += ti;
+    tr = r29 * -0.3826834323650897 - i29 * -0.9238795325112867; ti = r29 * -0.9238795325112867 + i29 * -0.3826834323650897;
+    r29 = r21 - tr; i29 = i21 - ti; r21 += tr; i21 += ti;
+    tr = r30 * -0.7071067811865475 - i30 * -0.7071067811865476; ti = r30 * -0.7071067811865476 + i30 * -0.7071067811865475;
+    r30 = r22 - tr; i30 = i22 - ti; r22 += tr; i22 += ti;
+    tr = r31 * -0.9238795325112867 - i31 * -0.3826834323650899; ti = r31 * -0.3826834323650899 + i31 * -0.9238795325112867;
+    r31 = r23 - tr; i31 = i23 - ti; r23 += tr; i23 += ti;
+    tr = r40; ti = i40;
+    r40 = r32 - tr; i40 = i32 - ti; r32 += tr; i32 += ti;
+    tr = r41 * 0.9238795325112867 - i41 * -0.3826834323650898; ti = r41 * -0.3826834323650898 + i41 * 0.9238795325112867;
+    r41 = r33 - tr; i41 = i33 - ti; r33 += tr; i33 += ti;
+    tr = r42 * 0.7071067811865476 - i42 * -0.7071067811865475; ti = r42 * -0.7071067811865475 + i42 * 0.7071067811865476;
+    r42 = r34 - tr; i42 = i34 - ti; r34 += tr; i34 += ti;
+    tr = r43 * 0.38268343236508984 - i43 * -0.9238795325112867; ti = r43 * -0.9238795325112867 + i43 * 0.38268343236508984;
+    r43 = r35 - tr; i43 = i35 - ti; r35 += tr; i35 += ti;
+    tr = i44; ti = -r44;
+    r44 = r36 - tr; i44 = i36 - ti; r36 += tr; i36 += ti;
+    tr = r45 * -0.3826834323650897 - i45 * -0.9238795325112867; ti = r45 * -0.9238795325112867 + i45 * -0.3826834323650897;
+    r45 = r37 - tr; i45 = i37 - ti; r37 += tr; i37 += ti;
+    tr = r46 * -0.7071067811865475 - i46 * -0.7071067811865476; ti = r46 * -0.7071067811865476 + i46 * -0.7071067811865475;
+    r46 = r38 - tr; i46 = i38 - ti; r38 += tr; i38 += ti;
+    tr = r47 * -0.9238795325112867 - i47 * -0.3826834323650899; ti = r47 * -0.3826834323650899 + i47 * -0.9238795325112867;
+    r47 = r39 - tr; i47 = i39 - ti; r39 += tr; i39 += ti;
+    tr = r56; ti = i56;
+    r56 = r48 - tr; i56 = i48 - ti; r48 += tr; i48 += ti;
+    tr = r57 * 0.9238795325112867 - i57 * -0.3826834323650898; ti = r57 * -0.3826834323650898 + i57 * 0.9238795325112867;
+    r57 = r49 - tr; i57 = i49 - ti; r49 += tr; i49 += ti;
+    tr = r58 * 0.7071067811865476 - i58 * -0.7071067811865475; ti = r58 * -0.7071067811865475 + i58 * 0.7071067811865476;
+    r58 = r50 - tr; i58 = i50 - ti; r50 += tr; i50 += ti;
+    tr = r59 * 0.38268343236508984 - i59 * -0.9238795325112867; ti = r59 * -0.9238795325112867 + i59 * 0.38268343236508984;
+    r59 = r51 - tr; i59 = i51 - ti; r51 += tr; i51 += ti;
+    tr = i60; ti = -r60;
+    r60 = r52 - tr; i60 = i52 - ti; r52 += tr; i52 += ti;
+    tr = r61 * -0.3826834323650897 - i61 * -0.9238795325112867; ti = r61 * -0.9238795325112867 + i61 * -0.3826834323650897;
+    r61 = r53 - tr; i61 = i53 - ti; r53 += tr; i53 += ti;
+    tr = r62 * -0.7071067811865475 - i62 * -0.7071067811865476; ti = r62 * -0.7071067811865476 + i62 * -0.7071067811865475;
+    r62 = r54 - tr; i62 = i54 - ti; r54 += tr; i54 += ti;
+    tr = r63 * -0.9238795325112867 - i63 * -0.3826834323650899; ti = r63 * -0.3826834323650899 + i63 * -0.9238795325112867;
+    r63 = r55 - tr; i63 = i55 - ti; r55 += tr; i55 += ti;
+    // stage of step 16
+    tr = r16; ti = i16;
+    r16 = r0 - tr; i16 = i0 - ti; r0 += tr; i0 += ti;
+    tr = r17 * 0.9807852804032304 - i17 * -0.19509032201612825; ti = r17 * -0.19509032201612825 + i17 * 0.9807852804032304;
+    r17 = r1 - tr; i17 = i1 - ti; r1 += tr; i1 += ti;
+    tr = r18 * 0.9238795325112867 - i18 * -0.3826834323650898; ti = r18 * -0.3826834323650898 + i18 * 0.9238795325112867;
+    r18 = r2 - tr; i18 = i2 - ti; r2 += tr; i2 += ti;
+    tr = r19 * 0.8314696123025452 - i19 * -0.5555702330196022; ti = r19 * -0.5555702330196022 + i19 * 0.8314696123025452;
+    r19 = r3 - tr; i19 = i3 - ti; r3 += tr; i3 += ti;
+    tr = r20 * 0.7071067811865476 - i20 * -0.7071067811865475; ti = r20 * -0.7071067811865475 + i20 * 0.7071067811865476;
+    r20 = r4 - tr; i20 = i4 - ti; r4 += tr; i4 += ti;
+    tr = r21 * 0.5555702330196023 - i21 * -0.8314696123025452; ti = r21 * -0.8314696123025452 + i21 * 0.5555702330196023;
+    r21 = r5 - tr; i21 = i5 - ti; r5 += tr; i5 += ti;
+    tr = r22 * 0.38268343236508984 - i22 * -0.9238795325112867; ti = r22 * -0.9238795325112867 + i22 * 0.38268343236508984;
+    r22 = r6 - tr; i22 = i6 - ti; r6 += tr; i6 += ti;
+    tr = r23 * 0.19509032201612833 - i23 * -0.9807852804032304; ti = r23 * -0.9807852804032304 + i23 * 0.19509032201612833;
+    r23 = r7 - tr; i23 = i7 - ti; r7 += tr; i7 += ti;
+    tr = i24; ti = -r24;
+    r24 = r8 - tr; i24 = i8 - ti; r8 += tr; i8 += ti;
+    tr = r25 * -0.1950903220161282 - i25 * -0.9807852804032304; ti = r25 * -0.9807852804032304 + i25 * -0.1950903220161282;
+    r25 = r9 - tr; i25 = i9 - ti; r9 += tr; i9 += ti;
+    tr = r26 * -0.3826834323650897 - i26 * -0.9238795325112867; ti = r26 * -0.9238795325112867 + i26 * -0.3826834323650897;
+    r26 = r10 - tr; i26 = i10 - ti; r10 += tr; i10 += ti;
+    tr = r27 * -0.555570233019602 - i27 * -0.8314696123025455; ti = r27 * -0.8314696123025455 + i27 * -0.555570233019602;
+    r27 = r11 - tr; i27 = i11 - ti; r11 += tr; i11 += ti;
+    tr = r28 * -0.7071067811865475 - i28 * -0.7071067811865476; ti = r28 * -0.7071067811865476 + i28 * -0.7071067811865475;
+    r28 = r12 - tr; i28 = i12 - ti; r12 += tr; i12 += ti;
+    tr = r29 * -0.8314696123025453 - i29 * -0.5555702330196022; ti = r29 * -0.5555702330196022 + i29 * -0.8314696123025453;
+    r29 = r13 - tr; i29 = i13 - ti; r13 += tr; i13 += ti;
+    tr = r30 * -0.9238795325112867 - i30 * -0.3826834323650899; ti = r30 * -0.3826834323650899 + i30 * -0.9238795325112867;
+    r30 = r14 - tr; i30 = i14 - ti; r14 += tr; i14 += ti;
+    tr = r31 * -0.9807852804032304 - i31 * -0.1950903220161286; ti = r31 * -0.1950903220161286 + i31 * -0.9807852804032304;
+    r31 = r15 - tr; i31 = i15 - ti; r15 += tr; i15 += ti;
+    tr = r48; ti = i48;
+    r48 = r32 - tr; i48 = i32 - ti; r32 += tr; i32 += ti;
+    tr = r49 * 0.9807852804032304 - i49 * -0.19509032201612825; ti = r49 * -0.19509032201612825 + i49 * 0.9807852804032304;
+    r49 = r33 - tr; i49 = i33 - ti; r33 += tr; i33 += ti;
+    tr = r50 * 0.9238795325112867 - i50 * -0.3826834323650898; ti = r50 * -0.3826834323650898 + i50 * 0.9238795325112867;
+    r50 = r34 - tr; i50 = i34 - ti; r34 += tr; i34 += ti;
+    tr = r51 * 0.8314696123025452 - i51 * -0.5555702330196022; ti = r51 * -0.5555702330196022 + i51 * 0.8314696123025452;
+    r51 = r35 - tr; i51 = i35 - ti; r35 += tr; i35 += ti;
+    tr = r52 * 0.7071067811865476 - i52 * -0.7071067811865475; ti = r52 * -0.7071067811865475 + i52 * 0.7071067811865476;
+    r52 = r36 - tr; i52 = i36 - ti; r36 += tr; i36 += ti;
+    tr = r53 * 0.5555702330196023 - i53 * -0.8314696123025452; ti = r53 * -0.8314696123025452 + i53 * 0.5555702330196023;
+    r53 = r37 - tr; i53 = i37 - ti; r37 += tr; i37 += ti;
+    tr = r54 * 0.38268343236508984 - i54 * -0.9238795325112867; ti = r54 * -0.9238795325112867 + i54 * 0.38268343236508984;
+    r54 = r38 - tr; i54 = i38 - ti; r38 += tr; i38 += ti;
+    tr = r55 * 0.19509032201612833 - i55 * -0.9807852804032304; ti = r55 * -0.9807852804032304 + i55 * 0.19509032201612833;
+    r55 = r39 - tr; i55 = i39 - ti; r39 += tr; i39 += ti;
+    tr = i56; ti = -r56;
+    r56 = r40 - tr; i56 = i40 - ti; r40 += tr; i40 += ti;
+    tr = r57 * -0.1950903220161282 - i57 * -0.9807852804032304; ti = r57 * -0.9807852804032304 + i57 * -0.1950903220161282;
+    r57 = r41 - tr; i57 = i41 - ti; r41 += tr; i41 += ti;
+    tr = r58 * -0.3826834323650897 - i58 * -0.9238795325112867; ti = r58 * -0.9238795325112867 + i58 * -0.3826834323650897;
+    r58 = r42 - tr; i58 = i42 - ti; r42 += tr; i42 += ti;
+    tr = r59 * -0.555570233019602 - i59 * -0.8314696123025455; ti = r59 * -0.8314696123025455 + i59 * -0.555570233019602;
+    r59 = r43 - tr; i59 = i43 - ti; r43 += tr; i43 += ti;
+    tr = r60 * -0.7071067811865475 - i60 * -0.7071067811865476; ti = r60 * -0.7071067811865476 + i60 * -0.7071067811865475;
+    r60 = r44 - tr; i60 = i44 - ti; r44 += tr; i44 += ti;
+    tr = r61 * -0.8314696123025453 - i61 * -0.5555702330196022; ti = r61 * -0.5555702330196022 + i61 * -0.8314696123025453;
+    r61 = r45 - tr; i61 = i45 - ti; r45 += tr; i45 += ti;
+    tr = r62 * -0.9238795325112867 - i62 * -0.3826834323650899; ti = r62 * -0.3826834323650899 + i62 * -0.9238795325112867;
+    r62 = r46 - tr; i62 = i46 - ti; r46 += tr; i46 += ti;
+    tr = r63 * -0.9807852804032304 - i63 * -0.1950903220161286; ti = r63 * -0.1950903220161286 + i63 * -0.9807852804032304;
+    r63 = r47 - tr; i63 = i47 - ti; r47 += tr; i47 += ti;
+    // stage of step 32
+    tr = r32; ti = i32;
+    r32 = r0 - tr; i32 = i0 - ti; r0 += tr; i0 += ti;
+    tr = r33 * 0.9951847266721969 - i33 * -0.0980171403295606; ti = r33 * -0.0980171403295606 + i33 * 0.9951847266721969;
+    r33 = r1 - tr; i33 = i1 - ti; r1 += tr; i1 += ti;
+    tr = r34 * 0.9807852804032304 - i34 * -0.19509032201612825; ti = r34 * -0.19509032201612825 + i34 * 0.9807852804032304;
+    r34 = r2 - tr; i34 = i2 - ti; r2 += tr; i2 += ti;
+    tr = r35 * 0.9569403357322088 - i35 * -0.29028467725446233; ti = r35 * -0.29028467725446233 + i35 * 0.9569403357322088;
+    r35 = r3 - tr; i35 = i3 - ti; r3 += tr; i3 += ti;
+    tr = r36 * 0.9238795325112867 - i36 * -0.3826834323650898; ti = r36 * -0.3826834323650898 + i36 * 0.9238795325112867;
+    r36 = r4 - tr; i36 = i4 - ti; r4 += tr; i4 += ti;
+    tr = r37 * 0.881921264348355 - i37 * -0.47139673682599764; ti = r37 * -0.47139673682599764 + i37 * 0.881921264348355;
+    r37 = r5 - tr; i37 = i5 - ti; r5 += tr; i5 += ti;
+    tr = r38 * 0.8314696123025452 - i38 * -0.5555702330196022; ti = r38 * -0.5555702330196022 + i38 * 0.8314696123025452;
+    r38 = r6 - tr; i38 = i6 - ti; r6 += tr; i6 += ti;
+    tr = r39 * 0.773010453362737 - i39 * -0.6343932841636455; ti = r39 * -0.6343932841636455 + i39 * 0.773010453362737;
+    r39 = r7 - tr; i39 = i7 - ti; r7 += tr; i7 += ti;
+    tr = r40 * 0.7071067811865476 - i40 * -0.7071067811865475; ti = r40 * -0.7071067811865475 + i40 * 0.7071067811865476;
+    r40 = r8 - tr; i40 = i8 - ti; r8 += tr; i8 += ti;
+    tr = r41 * 0.6343932841636455 - i41 * -0.773010453362737; ti = r41 * -0.773010453362737 + i41 * 0.6343932841636455;
+    r41 = r9 - tr; i41 = i9 - ti; r9 += tr; i9 += ti;
+    tr = r42 * 0.5555702330196023 - i42 * -0.8314696123025452; ti = r42 * -0.8314696123025452 + i42 * 0.5555702330196023;
+    r42 = r10 - tr; i42 = i10 - ti; r10 += tr; i10 += ti;
+    tr = r43 * 0.4713967368259978 - i43 * -0.8819212643483549; ti = r43 * -0.8819212643483549 + i43 * 0.4713967368259978;
+    r43 = r11 - tr; i43 = i11 - ti; r11 += tr; i11 += ti;
+    tr = r44 * 0.38268343236508984 - i44 * -0.9238795325112867; ti = r44 * -0.9238795325112867 + i44 * 0.38268343236508984;
+    r44 = r12 - tr; i44 = i12 - ti; r12 += tr; i12 += ti;
+    tr = r45 * 0.29028467725446233 - i45 * -0.9569403357322089; ti = r45 * -0.9569403357322089 + i45 * 0.29028467725446233;
+    r45 = r13 - tr; i45 = i13 - ti; r13 += tr; i13 += ti;
+    tr = r46 * 0.19509032201612833 - i46 * -0.9807852804032304; ti = r46 * -0.9807852804032304 + i46 * 0.19509032201612833;
+    r46 = r14 - tr; i46 = i14 - ti; r14 += tr; i14 += ti;
+    tr = r47 * 0.09801714032956077 - i47 * -0.9951847266721968; ti = r47 * -0.9951847266721968 + i47 * 0.09801714032956077;
+    r47 = r15 - tr; i47 = i15 - ti; r15 += tr; i15 += ti;
+    tr = i48; ti = -r48;
+    r48 = r16 - tr; i48 = i16 - ti; r16 += tr; i16 += ti;
+    tr = r49 * -0.09801714032956065 - i49 * -0.9951847266721969; ti = r49 * -0.9951847266721969 + i49 * -0.09801714032956065;
+    r49 = r17 - tr; i49 = i17 - ti; r17 += tr; i17 += ti;
+    tr = r50 * -0.1950903220161282 - i50 * -0.9807852804032304; ti = r50 * -0.9807852804032304 + i50 * -0.1950903220161282;
+    r50 = r18 - tr; i50 = i18 - ti; r18 += tr; i18 += ti;
+    tr = r51 * -0.29028467725446216 - i51 * -0.9569403357322089; ti = r51 * -0.9569403357322089 + i51 * -0.29028467725446216;
+    r51 = r19 - tr; i51 = i19 - ti; r19 += tr; i19 += ti;
+    tr = r52 * -0.3826834323650897 - i52 * -0.9238795325112867; ti = r52 * -0.9238795325112867 + i52 * -0.3826834323650897;
+    r52 = r20 - tr; i52 = i20 - ti; r20 += tr; i20 += ti;
+    tr = r53 * -0.4713967368259977 - i53 * -0.881921264348355; ti = r53 * -0.881921264348355 + i53 * -0.4713967368259977;
+    r53 = r21 - tr; i53 = i21 - ti; r21 += tr; i21 += ti;
+    tr = r54 * -0.555570233019602 - i54 * -0.8314696123025455; ti = r54 * -0.8314696123025455 + i54 * -0.555570233019602;
+    r54 = r22 - tr; i54 = i22 - ti; r22 += tr; i22 += ti;
+    tr = r55 * -0.6343932841636454 - i55 * -0.7730104533627371; ti = r55 * -0.7730104533627371 + i55 * -0.6343932841636454;
+    r55 = r23 - tr; i55 = i23 - ti; r23 += tr; i23 += ti;
+    tr = r56 * -0.7071067811865475 - i56 * -0.7071067811865476; ti = r56 * -0.7071067811865476 + i56 * -0.7071067811865475;
+    r56 = r24 - tr; i56 = i24 - ti; r24 += tr; i24 += ti;
+    tr = r57 * -0.773010453362737 - i57 * -0.6343932841636455; ti = r57 * -0.6343932841636455 + i57 * -0.773010453362737;
+    r57 = r25 - tr; i57 = i25 - ti; r25 += tr; i25 += ti;
+    tr = r58 * -0.8314696123025453 - i58 * -0.5555702330196022; ti = r58 * -0.5555702330196022 + i58 * -0.8314696123025453;
+    r58 = r26 - tr; i58 = i26 - ti; r26 += tr; i26 += ti;
+    tr = r59 * -0.8819212643483549 - i59 * -0.47139673682599786; ti = r59 * -0.47139673682599786 + i59 * -0.8819212643483549;
+    r59 = r27 - tr; i59 = i27 - ti; r27 += tr; i27 += ti;
+    tr = r60 * -0.9238795325112867 - i60 * -0.3826834323650899; ti = r60 * -0.3826834323650899 + i60 * -0.9238795325112867;
+    r60 = r28 - tr; i60 = i28 - ti; r28 += tr; i28 += ti;
+    tr = r61 * -0.9569403357322088 - i61 * -0.2902846772544624; ti = r61 * -0.2902846772544624 + i61 * -0.9569403357322088;
+    r61 = r29 - tr; i61 = i29 - ti; r29 += tr; i29 += ti;
+    tr = r62 * -0.9807852804032304 - i62 * -0.1950903220161286; ti = r62 * -0.1950903220161286 + i62 * -0.9807852804032304;
+    r62 = r30 - tr; i62 = i30 - ti; r30 += tr; i30 += ti;
+    tr = r63 * -0.9951847266721968 - i63 * -0.09801714032956083; ti = r63 * -0.09801714032956083 + i63 * -0.9951847266721968;
+    r63 = r31 - tr; i63 = i31 - ti; r31 += tr; i31 += ti;
+
+    real[0] = r0; imag[0] = i0;
+    real[1] = r1; imag[1] = i1;
+    real[2] = r2; imag[2] = i2;
+    real[3] = r3; imag[3] = i3;
+    real[4] = r4; imag[4] = i4;
+    real[5] = r5; imag[5] = i5;
+    real[6] = r6; imag[6] = i6;
+    real[7] = r7; imag[7] = i7;
+    real[8] = r8; imag[8] = i8;
+    real[9] = r9; imag[9] = i9;
+    real[10] = r10; imag[10] = i10;
+    real[11] = r11; imag[11] = i11;
+    real[12] = r12; imag[12] = i12;
+    real[13] = r13; imag[13] = i13;
+    real[14] = r14; imag[14] = i14;
+    real[15] = r15; imag[15] = i15;
+    real[16] = r16; imag[16] = i16;
+    real[17] = r17; imag[17] = i17;
+    real[18] = r18; imag[18] = i18;
+    real[19] = r19; imag[19] = i19;
+    real[20] = r20; imag[20] = i20;
+    real[21] = r21; imag[21] = i21;
+    real[22] = r22; imag[22] = i22;
+    real[23] = r23; imag[23] = i23;
+    real[24] = r24; imag[24] = i24;
+    real[25] = r25; imag[25] = i25;
+    real[26] = r26; imag[26] = i26;
+    real[27] = r27; imag[27] = i27;
+    real[28] = r28; imag[28] = i28;
+    real[29] = r29; imag[29] = i29;
+    real[30] = r30; imag[30] = i30;
+    real[31] = r31; imag[31] = i31;
+    real[32] = r32; imag[32] = i32;
+    real[33] = r33; imag[33] = i33;
+    real[34] = r34; imag[34] = i34;
+    real[35] = r35; imag[35] = i35;
+    real[36] = r36; imag[36] = i36;
+    real[37] = r37; imag[37] = i37;
+    real[38] = r38; imag[38] = i38;
+    real[39] = r39; imag[39] = i39;
+    real[40] = r40; imag[40] = i40;
+    real[41] = r41; imag[41] = i41;
+    real[42] = r42; imag[42] = i42;
+    real[43] = r43; imag[43] = i43;
+    real[44] = r44; imag[44] = i44;
+    real[45] = r45; imag[45] = i45;
+    real[46] = r46; imag[46] = i46;
+    real[47] = r47; imag[47] = i47;
+    real[48] = r48; imag[48] = i48;
+    real[49] = r49; imag[49] = i49;
+    real[50] = r50; imag[50] = i50;
+    real[51] = r51; imag[51] = i51;
+    real[52] = r52; imag[52] = i52;
+    real[53] = r53; imag[53] = i53;
+    real[54] = r54; imag[54] = i54;
+    real[55] = r55; imag[55] = i55;
+    real[56] = r56; imag[56] = i56;
+    real[57] = r57; imag[57] = i57;
+    real[58] = r58; imag[58] = i58;
+    real[59] = r59; imag[59] = i59;
+    real[60] = r60; imag[60] = i60;
+    real[61] = r61; imag[61] = i61;
+    real[62] = r62; imag[62] = i62;
+    real[63] = r63; imag[63] = i63;
+}
+
+static void fft_codelet_64_reverse(double * real, double * imag)
+{
+    double r0 = real[0], i0 = imag[0];
+    double r1 = real[32], i1 = imag[32];
+    double r2 = real[16], i2 = imag[16];
+    double r3 = real[48], i3 = imag[48];
+    double r4 = real[8], i4 = imag[8];
+    double r5 = real[40], i5 = imag[40];
+    double r6 = real[24], i6 = imag[24];
+    double r7 = real[56], i7 = imag[56];
+    double r8 = real[4], i8 = imag[4];
+    double r9 = real[36], i9 = imag[36];
+    double r10 = real[20], i10 = imag[20];
+    double r11 = real[52], i11 = imag[52];
+    double r12 = real[12], i12 = imag[12];
+    double r13 = real[44], i13 = imag[44];
+    double r14 = real[28], i14 = imag[28];
+    double r15 = real[60], i15 = imag[60];
+    double r16 = real[2], i16 = imag[2];
+    double r17 = real[34], i17 = imag[34];
+    double r18 = real[18], i18 = imag[18];
+    double r19 = real[50], i19 = imag[50];
+    double r20 = real[10], i20 = imag[10];
+    double r21 = real[42], i21 = imag[42];
+    double r22 = real[26], i22 = imag[26];
+    double r23 = real[58], i23 = imag[58];
+    double r24 = real[6], i24 = imag[6];
+    double r25 = real[38], i25 = imag[38];
+    double r26 = real[22], i26 = imag[22];
+    double r27 = real[54], i27 = imag[54];
+    double r28 = real[14], i28 = imag[14];
+    double r29 = real[46], i29 = imag[46];
+    double r30 = real[30], i30 = imag[30];
+    double r31 = real[62], i31 = imag[62];
+    double r32 = real[1], i32 = imag[1];
+    double r33 = real[33], i33 = imag[33];
+    double r34 = real[17], i34 = imag[17];
+    double r35 = real[49], i35 = imag[49];
+    double r36 = real[9], i36 = imag[9];
+    double r37 = real[41], i37 = imag[41];
+    double r38 = real[25], i38 = imag[25];
+    double r39 = real[57], i39 = imag[57];
+    double r40 = real[5], i40 = imag[5];
+    double r41 = real[37], i41 = imag[37];
+    double r42 = real[21], i42 = imag[21];
+    double r43 = real[53], i43 = imag[53];
+    double r44 = real[13], i44 = imag[13];
+    double r45 = real[45], i45 = imag[45];
+    double r46 = real[29], i46 = imag[29];
+    double r47 = real[61], i47 = imag[61];
+    double r48 = real[3], i48 = imag[3];
+    double r49 = real[35], i49 = imag[35];
+    double r50 = real[19], i50 = imag[19];
+    double r51 = real[51], i51 = imag[51];
+    double r52 = real[11], i52 = imag[11];
+    double r53 = real[43], i53 = imag[43];
+    double r54 = real[27], i54 = imag[27];
+    double r55 = real[59], i55 = imag[59];
+    double r56 = real[7], i56 = imag[7];
+    double r57 = real[39], i57 = imag[39];
+    double r58 = real[23], i58 = imag[23];
+    double r59 = real[55], i59 = imag[55];
+    double r60 = real[15], i60 = imag[15];
+    double r61 = real[47], i61 = imag[47];
+    double r62 = real[31], i62 = imag[31];
+    double r63 = real[63], i63 = imag[63];
+    double tr, ti;
+
+    // stage of step 1
+    tr = r1; ti = i1;
+    r1 = r0 - tr; i1 = i0 - ti; r0 += tr; i0 += ti;
+    tr = r3; ti = i3;
+    r3 = r2 - tr; i3 = i2 - ti; r2 += tr; i2 += ti;
+    tr = r5; ti = i5;
+    r5 = r4 - tr; i5 = i4 - ti; r4 += tr; i4 += ti;
+    tr = r7; ti = i7;
+    r7 = r6 - tr; i7 = i6 - ti; r6 += tr; i6 += ti;
+    tr = r9; ti = i9;
+    r9 = r8 - tr; i9 = i8 - ti; r8 += tr; i8 += ti;
+    tr = r11; ti = i11;
+    r11 = r10 - tr; i11 = i10 - ti; r10 += tr; i10 += ti;
+    tr = r13; ti = i13;
+    r13 = r12 - tr; i13 = i12 - ti; r12 += tr; i12 += ti;
+    tr = r15; ti = i15;
+    r15 = r14 - tr; i15 = i14 - ti; r14 += tr; i14 += ti;
+    tr = r17; ti = i17;
+    r17 = r16 - tr; i17 = i16 - ti; r16 += tr; i16 += ti;
+    tr = r19; ti = i19;
+    r19 = r18 - tr; i19 = i18 - ti; r18 += tr; i18 += ti;
+    tr = r21; ti = i21;
+    r21 = r20 - tr; i21 = i20 - ti; r20 += tr; i20 += ti;
+    tr = r23; ti = i23;
+    r23 = r22 - tr; i23 = i22 - ti; r22 += tr; i22 += ti;
+    tr = r25; ti = i25;
+    r25 = r24 - tr; i25 = i24 - ti; r24 += tr; i24 += ti;
+    tr = r27; ti = i27;
+    r27 = r26 - tr; i27 = i26 - ti; r26 += tr; i26 += ti;
+    tr = r29; ti = i29;
+    r29 = r28 - tr; i29 = i28 - ti; r28 += tr; i28 += ti;
+    tr = r31; ti = i31;
+    r31 = r30 - tr; i31 = i30 - ti; r30 += tr; i30 += ti;
+    tr = r33; ti = i33;
+    r33 = r32 - tr; i33 = i32 - ti; r32 += tr; i32 += ti;
+    tr = r35; ti = i35;
+    r35 = r34 - tr; i35 = i34 - ti; r34 += tr; i34 += ti;
+    tr = r37; ti = i37;
+    r37 = r36 - tr; i37 = i36 - ti; r36 += tr; i36 += ti;
+    tr = r39; ti = i39;
+    r39 = r38 - tr; i39 = i38 - ti; r38 += tr; i38 += ti;
+    tr = r41; ti = i41;
+    r41 = r40 - tr; i41 = i40 - ti; r40 += tr; i40 += ti;
+    tr = r43; ti = i43;
+    r43 = r42 - tr; i43 = i42 - ti; r42 += tr; i42 += ti;
+    tr = r45; ti = i45;
+    r45 = r44 - tr; i45 = i44 - ti; r44 += tr; i44 += ti;
+    tr = r47; ti = i47;
+    r47 = r46 - tr; i47 = i46 - ti; r46 += tr; i46 += ti;
+    tr = r49; ti = i49;
+    r49 = r48 - tr; i49 = i48 - ti; r48 += tr; i48 += ti;
+    tr = r51; ti = i51;
+    r51 = r50 - tr; i51 = i50 - ti; r50 += tr; i50 += ti;
+    tr = r53; ti = i53;
+    r53 = r52 - tr; i53 = i52 - ti; r52 += tr; i52 += ti;
+    tr = r55; ti = i55;
+    r55 = r54 - tr; i55 = i54 - ti; r54 += tr; i54 += ti;
+    tr = r57; ti = i57;
+    r57 = r56 - tr; i57 = i56 - ti; r56 += tr; i56 += ti;
+    tr = r59; ti = i59;
+    r59 = r58 - tr; i59 = i58 - ti; r58 += tr; i58 += ti;
+    tr = r61; ti = i61;
+    r61 = r60 - tr; i61 = i60 - ti; r60 += tr; i60 += ti;
+    tr = r63; ti = i63;
+    r63 = r62 - tr; i63 = i62 - ti; r62 += tr; i62 += ti;
+    // stage of step 2
+    tr = r2; ti = i2;
+    r2 = r0 - tr; i2 = i0 - ti; r0 += tr; i0 += ti;
+    tr = -i3; ti = r3;
+    r3 = r1 - tr; i3 = i1 - ti; r1 += tr; i1 += ti;
+    tr = r6; ti = i6;
+    r6 = r4 - tr; i6 = i4 - ti; r4 += tr; i4 += ti;
+    tr = -i7; ti = r7;
+    r7 = r5 - tr; i7 = i5 - ti; r5 += tr; i5 += ti;
+    tr = r10; ti = i10;
+    r10 = r8 - tr; i10 = i8 - ti; r8 += tr; i8 += ti;
+    tr = -i11; ti = r11;
+    r11 = r9 - tr; i11 = i9 - ti; r9 += tr; i9 += ti;
+    tr = r14; ti = i14;
+    r14 = r12 - tr; i14 = i12 - ti; r12 += tr; i12 += ti;
+    tr = -i15; ti = r15;
+    r15 = r13 - tr; i15 = i13 - ti; r13 += tr; i13 += ti;
+    tr = r18; ti = i18;
+    r18 = r16 - tr; i18 = i16 - ti; r16 += tr; i16 += ti;
+    tr = -i19; ti = r19;
+    r19 = r17 - tr; i19 = i17 - ti; r17 += tr; i17 += ti;
+    tr = r22; ti = i22;
+    r22 = r20 - tr; i22 = i20 - ti; r20 += tr; i20 += ti;
+    tr = -i23; ti = r23;
+    r23 = r21 - tr; i23 = i21 - ti; r21 += tr; i21 += ti;
+    tr = r26; ti = i26;
+    r26 = r24 - tr; i26 = i24 - ti; r24 += tr; i24 += ti;
+    tr = -i27; ti = r27;
+    r27 = r25 - tr; i27 = i25 - ti; r25 += tr; i25 += ti;
+    tr = r30; ti = i30;
+    r30 = r28 - tr; i30 = i28 - ti; r28 += tr; i28 += ti;
+    tr = -i31; ti = r31;
+    r31 = r29 - tr; i31 = i29 - ti; r29 += tr; i29 += ti;
+    tr = r34; ti = i34;
+    r34 = r32 - tr; i34 = i32 - ti; r32 += tr; i32 += ti;
+    tr = -i35; ti = r35;
+    r35 = r33 - tr; i35 = i33 - ti; r33 += tr; i33 += ti;
+    tr = r38; ti = i38;
+    r38 = r36 - tr; i38 = i36 - ti; r36 += tr; i36 += ti;
+    tr = -i39; ti = r39;
+    r39 = r37 - tr; i39 = i37 - ti; r37 += tr; i37 += ti;
+    tr = r42; ti = i42;
+    r42 = r40 - tr; i42 = i40 - ti; r40 += tr; i40 += ti;
+    tr = -i43; ti = r43;
+    r43 = r41 - tr; i43 = i41 - ti; r41 += tr; i41 += ti;
+    tr = r46; ti = i46;
+    r46 = r44 - tr; i46 = i44 - ti; r44 += tr; i44 += ti;
+    tr = -i47; ti = r47;
+    r47 = r45 - tr; i47 = i45 - ti; r45 += tr; i45 += ti;
+    tr = r50; ti = i50;
+    r50 = r48 - tr; i50 = i48 - ti; r48 += tr; i48 += ti;
+    tr = -i51; ti = r51;
+    r51 = r49 - tr; i51 = i49 - ti; r49 += tr; i49 += ti;
+    tr = r54; ti = i54;
+    r54 = r52 - tr; i54 = i52 - ti; r52 += tr; i52 += ti;
+    tr = -i55; ti = r55;
+    r55 = r53 - tr; i55 = i53 - ti; r53 += tr; i53 += ti;
+    tr = r58; ti = i58;
+    r58 = r56 - tr; i58 = i56 - ti; r56 += tr; i56 += ti;
+    tr = -i59; ti = r59;
+    r59 = r57 - tr; i59 = i57 - ti; r57 += tr; i57 += ti;
+    tr = r62; ti = i62;
+    r62 = r60 - tr; i62 = i60 - ti; r60 += tr; i60 += ti;
+    tr = -i63; ti = r63;
+    r63 = r61 - tr; i63 = i61 - ti; r61 += tr; i61 += ti;
+    // stage of step 4
+    tr = r4; ti = i4;
+    r4 = r0 - tr; i4 = i0 - ti; r0 += tr; i0 += ti;
+    tr = r5 * 0.7071067811865476 - i5 * 0.7071067811865475; ti = r5 * 0.7071067811865475 + i5 * 0.7071067811865476;
+    r5 = r1 - tr; i5 = i1 - ti; r1 += tr; i1 += ti;
+    tr = -i6; ti = r6;
+    r6 = r2 - tr; i6 = i2 - ti; r2 += tr; i2 += ti;
+    tr = r7 * -0.7071067811865475 - i7 * 0.7071067811865476; ti = r7 * 0.7071067811865476 + i7 * -0.7071067811865475;
+    r7 = r3 - tr; i7 = i3 - ti; r3 += tr; i3 += ti;
+    tr = r12; ti = i12;
+    r12 = r8 - tr; i12 = i8 - ti; r8 += tr; i8 += ti;
+    tr = r13 * 0.7071067811865476 - i13 * 0.7071067811865475; ti = r13 * 0.7071067811865475 + i13 * 0.7071067811865476;
+    r13 = r9 - tr; i13 = i9 - ti; r9 += tr; i9 += ti;
+    tr = -i14; ti = r14;
+    r14 = r10 - tr; i14 = i10 - ti; r10 += tr; i10 += ti;
+    tr = r15 * -0.7071067811865475 - i15 * 0.7071067811865476; ti = r15 * 0.7071067811865476 + i15 * -0.7071067811865475;
+    r15 = r11 - tr; i15 = i11 - ti; r11 += tr; i11 += ti;
+    tr = r20; ti = i20;
+    r20 = r16 - tr; i20 = i16 - ti; r16 += tr; i16 += ti;
+    tr = r21 * 0.7071067811865476 - i21 * 0.7071067811865475; ti = r21 * 0.7071067811865475 + i21 * 0.7071067811865476;
+    r21 = r17 - tr; i21 = i17 - ti; r17 += tr; i17 += ti;
+    tr = -i22; ti = r22;
+    r22 = r18 - tr; i22 = i18 - ti; r18 += tr; i18 += ti;
+    tr = r23 * -0.7071067811865475 - i23 * 0.7071067811865476; ti = r23 * 0.7071067811865476 + i23 * -0.7071067811865475;
+    r23 = r19 - tr; i23 = i19 - ti; r19 += tr; i19 += ti;
+    tr = r28; ti = i28;
+    r28 = r24 - tr; i28 = i24 - ti; r24 += tr; i24 += ti;
+    tr = r29 * 0.7071067811865476 - i29 * 0.7071067811865475; ti = r29 * 0.7071067811865475 + i29 * 0.7071067811865476;
+    r29 = r25 - tr; i29 = i25 - ti; r25 += tr; i25 += ti;
+    tr = -i30; ti = r30;
+    r30 = r26 - tr; i30 = i26 - ti; r26 += tr; i26 += ti;
+    tr = r31 * -0.7071067811865475 - i31 * 0.7071067811865476; ti = r31 * 0.7071067811865476 + i31 * -0.7071067811865475;
+    r31 = r27 - tr; i31 = i27 - ti; r27 += tr; i27 += ti;
+    tr = r36; ti = i36;
+    r36 = r32 - tr; i36 = i32 - ti; r32 += tr; i32 += ti;
+    tr = r37 * 0.7071067811865476 - i37 * 0.7071067811865475; ti = r37 * 0.7071067811865475 + i37 * 0.7071067811865476;
+    r37 = r33 - tr; i37 = i33 - ti; r33 += tr; i33 += ti;
+    tr = -i38; ti = r38;
+    r38 = r34 - tr; i38 = i34 - ti; r34 += tr; i34 += ti;
+    tr = r39 * -0.7071067811865475 - i39 * 0.7071067811865476; ti = r39 * 0.7071067811865476 + i39 * -0.7071067811865475;
+    r39 = r35 - tr; i39 = i35 - ti; r35 += tr; i35 += ti;
+    tr = r44; ti = i44;
+    r44 = r40 - tr; i44 = i40 - ti; r40 += tr; i40 += ti;
+    tr = r45 * 0.7071067811865476 - i45 * 0.7071067811865475; ti = r45 * 0.7071067811865475 + i45 * 0.7071067811865476;
+    r45 = r41 - tr; i45 = i41 - ti; r41 += tr; i41 += ti;
+    tr = -i46; ti = r46;
+    r46 = r42 - tr; i46 = i42 - ti; r42 += tr; i42 += ti;
+    tr = r47 * -0.7071067811865475 - i47 * 0.7071067811865476; ti = r47 * 0.7071067811865476 + i47 * -0.7071067811865475;
+    r47 = r43 - tr; i47 = i43 - ti; r43 += tr; i43 += ti;
+    tr = r52; ti = i52;
+    r52 = r48 - tr; i52 = i48 - ti; r48 += tr; i48 += ti;
+    tr = r53 * 0.7071067811865476 - i53 * 0.7071067811865475; ti = r53 * 0.7071067811865475 + i53 * 0.7071067811865476;
+    r53 = r49 - tr; i53 = i49 - ti; r49 += tr; i49 += ti;
+    tr = -i54; ti = r54;
+    r54 = r50 - tr; i54 = i50 - ti; r50 += tr; i50 += ti;
+    tr = r55 * -0.7071067811865475 - i55 * 0.7071067811865476; ti = r55 * 0.7071067811865476 + i55 * -0.7071067811865475;
+    r55 = r51 - tr; i55 = i51 - ti; r51 += tr; i51 += ti;
+    tr = r60; ti = i60;
+    r60 = r56 - tr; i60 = i56 - ti; r56 += tr; i56 += ti;
+    tr = r61 * 0.7071067811865476 - i61 * 0.7071067811865475; ti = r61 * 0.7071067811865475 + i61 * 0.7071067811865476;
+    r61 = r57 - tr; i61 = i57 - ti; r57 += tr; i57 += ti;
+    tr = -i62; ti = r62;
+    r62 = r58 - tr; i62 = i58 - ti; r58 += tr; i58 += ti;
+    tr = r63 * -0.7071067811865475 - i63 * 0.7071067811865476; ti = r63 * 0.7071067811865476 + i63 * -0.7071067811865475;
+    r63 = r59 - tr; i63 = i59 - ti; r59 += tr; i59 += ti;
+    // stage of step 8
+    tr = r8; ti = i8;
+    r8 = r0 - tr; i8 = i0 - ti; r0 += tr; i0 += ti;
+    tr = r9 * 0.9238795325112867 - i9 * 0.3826834323650898; ti = r9 * 0.3826834323650898 + i9 * 0.9238795325112867;
+    r9 = r1 - tr; i9 = i1 - ti; r1 += tr; i1 += ti;
+    tr = r10 * 0.7071067811865476 - i10 * 0.7071067811865475; ti = r10 * 0.7071067811865475 + i10 * 0.7071067811865476;
+    r10 = r2 - tr; i10 = i2 - ti; r2 += tr; i2 += ti;
+    tr = r11 * 0.38268343236508984 - i11 * 0.9238795325112867; ti = r11 * 0.9238795325112867 + i11 * 0.38268343236508984;
+    r11 = r3 - tr; i11 = i3 - ti; r3 += tr; i3 += ti;
+    tr = -i12; ti = r12;
+    r12 = r4 - tr; i12 = i4 - ti; r4 += tr; i4 += ti;
+    tr = r13 * -0.3826834323650897 - i13 * 0.9238795325112867; ti = r13 * 0.9238795325112867 + i13 * -0.3826834323650897;
+    r13 = r5 - tr; i13 = i5 - ti; r5 += tr; i5 += ti;
+    tr = r14 * -0.7071067811865475 - i14 * 0.7071067811865476; ti = r14 * 0.7071067811865476 + i14 * -0.7071067811865475;
+    r14 = r6 - tr; i14 = i6 - ti; r6 += tr; i6 += ti;
+    tr = r15 * -0.9238795325112867 - i15 * 0.3826834323650899; ti = r15 * 0.3826834323650899 + i15 * -0.9238795325112867;
+    r15 = r7 - tr; i15 = i7 - ti; r7 += tr; i7 += ti;
+    tr = r24; ti = i24;
+    r24 = r16 - tr; i24 = i16 - ti; r16 += tr; i16 += ti;
+    tr = r25 * 0.9238795325112867 - i25 * 0.3826834323650898; ti = r25 * 0.3826834323650898 + i25 * 0.9238795325112867;
+    r25 = r17 - tr; i25 = i17 - ti; r17 += tr; i17 += ti;
+    tr = r26 * 0.7071067811865476 - i26 * 0.7071067811865475; ti = r26 * 0.7071067811865475 + i26 * 0.7071067811865476;
+    r26 = r18 - tr; i26 = i18 - ti; r18 += tr; i18 += ti;
+    tr = r27 * 0.38268343236508984 - i27 * 0.9238795325112867; ti = r27 * 0.9238795325112867 + i27 * 0.38268343236508984;
+    r27 = r19 - tr; i27 = i19 - ti; r19 += tr; i19 += ti;
+    tr = -i28; ti = r28;
+    r28 = r20 - tr; i28 = i20 - ti; r20 += tr; i20 += ti;
+    tr = r29 * -0.3826834323650897 - i29 * 0.9238795325112867; ti = r29 * 0.9238795325112867 + i29 * -0.3826834323650897;
+    r29 = r21 - tr; i29 = i21 - ti; r21 += tr; i21 += ti;
+    tr = r30 * -0.7071067811865475 - i30 * 0.7071067811865476; ti = r30 * 0.7071067811865476 + i30 * -0.7071067811865475;
+    r30 = r22 - tr; i30 = i22 - ti; r22 += tr; i22 += ti;
+    tr = r31 * -0.9238795325112867 - i31 * 0.3826834323650899; ti = r31 * 0.3826834323650899 + i31 * -0.9238795325112867;
+    r31 = r23 - tr; i31 = i23 - ti; r23 += tr; i23 += ti;
+    tr = r40; ti = i40;
+    r40 = r32 - tr; i40 = i32 - ti; r32 += tr; i32 += ti;
+    tr = r41 * 0.9238795325112867 - i41 * 0.3826834323650898; ti = r41 * 0.3826834323650898 + i41 * 0.9238795325112867;
+    r41 = r33 - tr; i41 = i33 - ti; r33 += tr; i33 += ti;
+    tr = r42 * 0.7071067811865476 - i42 * 0.7071067811865475; ti = r42 * 0.7071067811865475 + i42 * 0.7071067811865476;
+    r42 = r34 - tr; i42 = i34 - ti; r34 += tr; i34 += ti;
+    tr = r43 * 0.38268343236508984 - i43 * 0.9238795325112867; ti = r43 * 0.9238795325112867 + i43 * 0.38268343236508984;
+    r43 = r35 - tr; i43 = i35 - ti; r35 += tr; i35 += ti;
+    tr = -i44; ti = r44;
+    r44 = r36 - tr; i44 = i36 - ti; r36 += tr; i36 += ti;
+    tr = r45 * -0.3826834323650897 - i45 * 0.9238795325112867; ti = r45 * 0.9238795325112867 + i45 * -0.3826834323650897;
+    r45 = r37 - tr; i45 = i37 - ti; r37 += tr; i37 += ti;
+    tr = r46 * -0.7071067811865475 - i46 * 0.7071067811865476; ti = r46 * 0.7071067811865476 + i46 * -0.7071067811865475;
+    r46 = r38 - tr; i46 = i38 - ti; r38 += tr; i38 += ti;
+    tr = r47 * -0.9238795325112867 - i47 * 0.3826834323650899; ti = r47 * 0.3826834323650899 + i47 * -0.9238795325112867;
+    r47 = r39 - tr; i47 = i39 - ti; r39 += tr; i39 += ti;
+    tr = r56; ti = i56;
+    r56 = r48 - tr; i56 = i48 - ti; r48 += tr; i48 += ti;
+    tr = r57 * 0.9238795325112867 - i57 * 0.3826834323650898; ti = r57 * 0.3826834323650898 + i57 * 0.9238795325112867;
+    r57 = r49 - tr; i57 = i49 - ti; r49 += tr; i49 += ti;
+    tr = r58 * 0.7071067811865476 - i58 * 0.7071067811865475; ti = r58 * 0.7071067811865475 + i58 * 0.7071067811865476;
+    r58 = r50 - tr; i58 = i50 - ti; r50 += tr; i50 += ti;
+    tr = r59 * 0.38268343236508984 - i59 * 0.9238795325112867; ti = r59 * 0.9238795325112867 + i59 * 0.38268343236508984;
+    r59 = r51 - tr; i59 = i51 - ti; r51 += tr; i51 += ti;
+    tr = -i60; ti = r60;
+    r60 = r52 - tr; i60 = i52 - ti; r52 += tr; i52 += ti;
+    tr = r61 * -0.3826834323650897 - i61 * 0.9238795325112867; ti = r61 * 0.9238795325112867 + i61 * -0.3826834323650897;
+    r61 = r53 - tr; i61 = i53 - ti; r53 += tr; i53 += ti;
+    tr = r62 * -0.7071067811865475 - i62 * 0.7071067811865476; ti = r62 * 0.7071067811865476 + i62 * -0.7071067811865475;
+    r62 = r54 - tr; i62 = i54 - ti; r54 += tr; i54 += ti;
+    tr = r63 * -0.9238795325112867 - i63 * 0.3826834323650899; ti = r63 * 0.3826834323650899 + i63 * -0.9238795325112867;
+    r63 = r55 - tr; i63 = i55 - ti; r55 += tr; i55 += ti;
+    // stage of step 16
+    tr = r16; ti = i16;
+    r16 = r0 - tr; i16 = i0 - ti; r0 += tr; i0 += ti;
+    tr = r17 * 0.9807852804032304 - i17 * 0.19509032201612825; ti = r17 * 0.19509032201612825 + i17 * 0.9807852804032304;
+    r17 = r1 - tr; i17 = i1 - ti; r1 += tr; i1 += ti;
+    tr = r18 * 0.9238795325112867 - i18 * 0.3826834323650898; ti = r18 * 0.3826834323650898 + i18 * 0.9238795325112867;
+    r18 = r2 - tr; i18 = i2 - ti; r2 += tr; i2 += ti;
+    tr = r19 * 0.8314696123025452 - i19 * 0.5555702330196022; ti = r19 * 0.5555702330196022 + i19 * 0.8314696123025452;
+    r19 = r3 - tr; i19 = i3 - ti; r3 += tr; i3 += ti;
+    tr = r20 * 0.7071067811865476 - i20 * 0.7071067811865475; ti = r20 * 0.7071067811865475 + i20 * 0.7071067811865476;
+    r20 = r4 - tr; i20 = i4 - ti; r4 += tr; i4 += ti;
+    tr = r21 * 0.5555702330196023 - i21 * 0.8314696123025452; ti = r21 * 0.8314696123025452 + i21 * 0.5555702330196023;
+    r21 = r5 - tr; i21 = i5 - ti; r5 += tr; i5 += ti;
+    tr = r22 * 0.38268343236508984 - i22 * 0.9238795325112867; ti = r22 * 0.9238795325112867 + i22 * 0.38268343236508984;
+    r22 = r6 - tr; i22 = i6 - ti; r6 += tr; i6 += ti;
+    tr = r23 * 0.19509032201612833 - i23 * 0.9807852804032304; ti = r23 * 0.9807852804032304 + i23 * 0.19509032201612833;
+    r23 = r7 - tr; i23 = i7 - ti; r7 += tr; i7 += ti;
+    tr = -i24; ti = r24;
+    r24 = r8 - tr; i24 = i8 - ti; r8 += tr; i8 += ti;
+    tr = r25 * -0.1950903220161282 - i25 * 0.9807852804032304; ti = r25 * 0.9807852804032304 + i25 * -0.1950903220161282;
+    r25 = r9 - tr; i25 = i9 - ti; r9 += tr; i9 += ti;
+    tr = r26 * -0.3826834323650897 - i26 * 0.9238795325112867; ti = r26 * 0.9238795325112867 + i26 * -0.3826834323650897;
+    r26 = r10 - tr; i26 = i10 - ti; r10 += tr; i10 += ti;
+    tr = r27 * -0.555570233019602 - i27 * 0.8314696123025455; ti = r27 * 0.8314696123025455 + i27 * -0.555570233019602;
+    r27 = r11 - tr; i27 = i11 - ti; r11 += tr; i11 += ti;
+    tr = r28 * -0.7071067811865475 - i28 * 0.7071067811865476; ti = r28 * 0.7071067811865476 + i28 * -0.7071067811865475;
+    r28 = r12 - tr; i28 = i12 - ti; r12 += tr; i12 += ti;
+    tr = r29 * -0.8314696123025453 - i29 * 0.5555702330196022; ti = r29 * 0.5555702330196022 + i29 * -0.8314696123025453;
+    r29 = r13 - tr; i29 = i13 - ti; r13 += tr; i13 += ti;
+    tr = r30 * -0.9238795325112867 - i30 * 0.3826834323650899; ti = r30 * 0.3826834323650899 + i30 * -0.9238795325112867;
+    r30 = r14 - tr; i30 = i14 - ti; r14 += tr; i14 += ti;
+    tr = r31 * -0.9807852804032304 - i31 * 0.1950903220161286; ti = r31 * 0.1950903220161286 + i31 * -0.9807852804032304;
+    r31 = r15 - tr; i31 = i15 - ti; r15 += tr; i15 += ti;
+    tr = r48; ti = i48;
+    r48 = r32 - tr; i48 = i32 - ti; r32 += tr; i32 += ti;
+    tr = r49 * 0.9807852804032304 - i49 * 0.19509032201612825; ti = r49 * 0.19509032201612825 + i49 * 0.9807852804032304;
+    r49 = r33 - tr; i49 = i33 - ti; r33 += tr; i33 += ti;
+    tr = r50 * 0.9238795325112867 - i50 * 0.3826834323650898; ti = r50 * 0.3826834323650898 + i50 * 0.9238795325112867;
+    r50 = r34 - tr; i50 = i34 - ti; r34 += tr; i34 += ti;
+    tr = r51 * 0.8314696123025452 - i51 * 0.5555702330196022; ti = r51 * 0.5555702330196022 + i51 * 0.8314696123025452;
+    r51 = r35 - tr; i51 = i35 - ti; r35 += tr; i35 += ti;
+    tr = r52 * 0.7071067811865476 - i52 * 0.7071067811865475; ti = r52 * 0.7071067811865475 + i52 * 0.7071067811865476;
+    r52 = r36 - tr; i52 = i36 - ti; r36 += tr; i36 += ti;
+    tr = r53 * 0.5555702330196023 - i53 * 0.8314696123025452; ti = r53 * 0.8314696123025452 + i53 * 0.5555702330196023;
+    r53 = r37 - tr; i53 = i37 - ti; r37 += tr; i37 += ti;
+    tr = r54 * 0.38268343236508984 - i54 * 0.9238795325112867; ti = r54 * 0.9238795325112867 + i54 * 0.38268343236508984;
+    r54 = r38 - tr; i54 = i38 - ti; r38 += tr; i38 += ti;
+    tr = r55 * 0.19509032201612833 - i55 * 0.9807852804032304; ti = r55 * 0.9807852804032304 + i55 * 0.19509032201612833;
+    r55 = r39 - tr; i55 = i39 - ti; r39 += tr; i39 += ti;
+    tr = -i56; ti = r56;
+    r56 = r40 - tr; i56 = i40 - ti; r40 += tr; i40 += ti;
+    tr = r57 * -0.1950903220161282 - i57 * 0.9807852804032304; ti = r57 * 0.9807852804032304 + i57 * -0.1950903220161282;
+    r57 = r41 - tr; i57 = i41 - ti; r41 += tr; i41 += ti;
+    tr = r58 * -0.3826834323650897 - i58 * 0.9238795325112867; ti = r58 * 0.9238795325112867 + i58 * -0.3826834323650897;
+    r58 = r42 - tr; i58 = i42 - ti; r42 += tr; i42 += ti;
+    tr = r59 * -0.555570233019602 - i59 * 0.8314696123025455; ti = r59 * 0.8314696123025455 + i59 * -0.555570233019602;
+    r59 = r43 - tr; i59 = i43 - ti; r43 += tr; i43 += ti;
+    tr = r60 * -0.7071067811865475 - i60 * 0.7071067811865476; ti = r60 * 0.7071067811865476 + i60 * -0.7071067811865475;
+    r60 = r44 - tr; i60 = i44 - ti; r44 += tr; i44 += ti;
+    tr = r61 * -0.8314696123025453 - i61 * 0.5555702330196022; ti = r61 * 0.5555702330196022 + i61 * -0.8314696123025453;
+    r61 = r45 - tr; i61 = i45 - ti; r45 += tr; i45 += ti;
+    tr = r62 * -0.9238795325112867 - i62 * 0.3826834323650899; ti = r62 * 0.3826834323650899 + i62 * -0.9238795325112867;
+    r62 = r46 - tr; i62 = i46 - ti; r46 += tr; i46 += ti;
+    tr = r63 * -0.9807852804032304 - i63 * 0.1950903220161286; ti = r63 * 0.1950903220161286 + i63 * -0.9807852804032304;
+    r63 = r47 - tr; i63 = i47 - ti; r47 += tr; i47 += ti;
+    // stage of step 32
+    tr = r32; ti = i32;
+    r32 = r0 - tr; i32 = i0 - ti; r0 += tr; i0 += ti;
+    tr = r33 * 0.9951847266721969 - i33 * 0.0980171403295606; ti = r33 * 0.0980171403295606 + i33 * 0.9951847266721969;
+    r33 = r1 - tr; i33 = i1 - ti; r1 += tr; i1 += ti;
+    tr = r34 * 0.9807852804032304 - i34 * 0.19509032201612825; ti = r34 * 0.19509032201612825 + i34 * 0.9807852804032304;
+    r34 = r2 - tr; i34 = i2 - ti; r2 += tr; i2 += ti;
+    tr = r35 * 0.9569403357322088 - i35 * 0.29028467725446233; ti = r35 * 0.29028467725446233 + i35 * 0.9569403357322088;
+    r35 = r3 - tr; i35 = i3 - ti; r3 += tr; i3 += ti;
+    tr = r36 * 0.9238795325112867 - i36 * 0.3826834323650898; ti = r36 * 0.3826834323650898 + i36 * 0.9238795325112867;
+    r36 = r4 - tr; i36 = i4 - ti; r4 += tr; i4 += ti;
+    tr = r37 * 0.881921264348355 - i37 * 0.47139673682599764; ti = r37 * 0.47139673682599764 + i37 * 0.881921264348355;
+    r37 = r5 - tr; i37 = i5 - ti; r5 += tr; i5 += ti;
+    tr = r38 * 0.8314696123025452 - i38 * 0.5555702330196022; ti = r38 * 0.5555702330196022 + i38 * 0.8314696123025452;
+    r38 = r6 - tr; i38 = i6 - ti; r6 += tr; i6 += ti;
+    tr = r39 * 0.773010453362737 - i39 * 0.6343932841636455; ti = r39 * 0.6343932841636455 + i39 * 0.773010453362737;
+    r39 = r7 - tr; i39 = i7 - ti; r7 += tr; i7 += ti;
+    tr = r40 * 0.7071067811865476 - i40 * 0.7071067811865475; ti = r40 * 0.7071067811865475 + i40 * 0.7071067811865476;
+    r40 = r8 - tr; i40 = i8 - ti; r8 += tr; i8 += ti;
+    tr = r41 * 0.6343932841636455 - i41 * 0.773010453362737; ti = r41 * 0.773010453362737 + i41 * 0.6343932841636455;
+    r41 = r9 - tr; i41 = i9 - ti; r9 += tr; i9 += ti;
+    tr = r42 * 0.5555702330196023 - i42 * 0.8314696123025452; ti = r42 * 0.8314696123025452 + i42 * 0.5555702330196023;
+    r42 = r10 - tr; i42 = i10 - ti; r10 += tr; i10 += ti;
+    tr = r43 * 0.4713967368259978 - i43 * 0.8819212643483549; ti = r43 * 0.8819212643483549 + i43 * 0.4713967368259978;
+    r43 = r11 - tr; i43 = i11 - ti; r11 += tr; i11 += ti;
+    tr = r44 * 0.38268343236508984 - i44 * 0.9238795325112867; ti = r44 * 0.9238795325112867 + i44 * 0.38268343236508984;
+    r44 = r12 - tr; i44 = i12 - ti; r12 += tr; i12 += ti;
+    tr = r45 * 0.29028467725446233 - i45 * 0.9569403357322089; ti = r45 * 0.9569403357322089 + i45 * 0.29028467725446233;
+    r45 = r13 - tr; i45 = i13 - ti; r13 += tr; i13 += ti;
+    tr = r46 * 0.19509032201612833 - i46 * 0.9807852804032304; ti = r46 * 0.9807852804032304 + i46 * 0.19509032201612833;
+    r46 = r14 - tr; i46 = i14 - ti; r14 += tr; i14 += ti;
+    tr = r47 * 0.09801714032956077 - i47 * 0.9951847266721968; ti = r47 * 0.9951847266721968 + i47 * 0.09801714032956077;
+    r47 = r15 - tr; i47 = i15 - ti; r15 += tr; i15 += ti;
+    tr = -i48; ti = r48;
+    r48 = r16 - tr; i48 = i16 - ti; r16 += tr; i16 += ti;
+    tr = r49 * -0.09801714032956065 - i49 * 0.9951847266721969; ti = r49 * 0.9951847266721969 + i49 * -0.09801714032956065;
+    r49 = r17 - tr; i49 = i17 - ti; r17 += tr; i17 += ti;
+    tr = r50 * -0.1950903220161282 - i50 * 0.9807852804032304; ti = r50 * 0.9807852804032304 + i50 * -0.1950903220161282;
+    r50 = r18 - tr; i50 = i18 - ti; r18 += tr; i18 += ti;
+    tr = r51 * -0.29028467725446216 - i51 * 0.9569403357322089; ti = r51 * 0.9569403357322089 + i51 * -0.29028467725446216;
+    r51 = r19 - tr; i51 = i19 - ti; r19 += tr; i19 += ti;
+    tr = r52 * -0.3826834323650897 - i52 * 0.9238795325112867; ti = r52 * 0.9238795325112867 + i52 * -0.3826834323650897;
+    r52 = r20 - tr; i52 = i20 - ti; r20 += tr; i20 += ti;
+    tr = r53 * -0.4713967368259977 - i53 * 0.881921264348355; ti = r53 * 0.881921264348355 + i53 * -0.4713967368259977;
+    r53 = r21 - tr; i53 = i21 - ti; r21 += tr; i21 += ti;
+    tr = r54 * -0.555570233019602 - i54 * 0.8314696123025455; ti = r54 * 0.8314696123025455 + i54 * -0.555570233019602;
+    r54 = r22 - tr; i54 = i22 - ti; r22 += tr; i22 += ti;
+    tr = r55 * -0.6343932841636454 - i55 * 0.7730104533627371; ti = r55 * 0.7730104533627371 + i55 * -0.6343932841636454;
+    r55 = r23 - tr; i55 = i23 - ti; r23 += tr; i23 += ti;
+    tr = r56 * -0.7071067811865475 - i56 * 0.7071067811865476; ti = r56 * 0.7071067811865476 + i56 * -0.7071067811865475;
+    r56 = r24 - tr; i56 = i24 - ti; r24 += tr; i24 += ti;
+    tr = r57 * -0.773010453362737 - i57 * 0.6343932841636455; ti = r57 * 0.6343932841636455 + i57 * -0.773010453362737;
+    r57 = r25 - tr; i57 = i25 - ti; r25 += tr; i25 += ti;
+    tr = r58 * -0.8314696123025453 - i58 * 0.5555702330196022; ti = r58 * 0.5555702330196022 + i58 * -0.8314696123025453;
+    r58 = r26 - tr; i58 = i26 - ti; r26 += tr; i26 += ti;
+    tr = r59 * -0.8819212643483549 - i59 * 0.47139673682599786; ti = r59 * 0.47139673682599786 + i59 * -0.8819212643483549;
+    r59 = r27 - tr; i59 = i27 - ti; r27 += tr; i27 += ti;
+    tr = r60 * -0.9238795325112867 - i60 * 0.3826834323650899; ti = r60 * 0.3826834323650899 + i60 * -0.9238795325112867;
+    r60 = r28 - tr; i60 = i28 - ti; r28 += tr; i28 += ti;
+    tr = r61 * -0.9569403357322088 - i61 * 0.2902846772544624; ti = r61 * 0.2902846772544624 + i61 * -0.9569403357322088;
+    r61 = r29 - tr; i61 = i29 - ti; r29 += tr; i29 += ti;
+    tr = r62 * -0.9807852804032304 - i62 * 0.1950903220161286; ti = r62 * 0.1950903220161286 + i62 * -0.9807852804032304;
+    r62 = r30 - tr; i62 = i30 - ti; r30 += tr; i30 += ti;
+    tr = r63 * -0.9951847266721968 - i63 * 0.09801714032956083; ti = r63 * 0.09801714032956083 + i63 * -0.9951847266721968;
+    r63 = r31 - tr; i63 = i31 - ti; r31 += tr; i31 += ti;
+
+    real[0] = r0; imag[0] = i0;
+    real[1] = r1; imag[1] = i1;
+    real[2] = r2; imag[2] = i2;
+    real[3] = r3; imag[3] = i3;
+    real[4] = r4; imag[4] = i4;
+    real[5] = r5; imag[5] = i5;
+    real[6] = r6; imag[6] = i6;
+    real[7] = r7; imag[7] = i7;
+    real[8] = r8; imag[8] = i8;
+    real[9] = r9; imag[9] = i9;
+    real[10] = r10; imag[10] = i10;
+    real[11] = r11; imag[11] = i11;
+    real[12] = r12; imag[12] = i12;
+    real[13] = r13; imag[13] = i13;
+    real[14] = r14; imag[14] = i14;
+    real[15] = r15; imag[15] = i15;
+    real[16] = r16; imag[16] = i16;
+    real[17] = r17; imag[17] = i17;
+    real[18] = r18; imag[18] = i18;
+    real[19] = r19; imag[19] = i19;
+    real[20] = r20; imag[20] = i20;
+    real[21] = r21; imag[21] = i21;
+    real[22] = r22; imag[22] = i22;
+    real[23] = r23; imag[23] = i23;
+    real[24] = r24; imag[24] = i24;
+    real[25] = r25; imag[25] = i25;
+    real[26] = r26; imag[26] = i26;
+    real[27] = r27; imag[27] = i27;
+    real[28] = r28; imag[28] = i28;
+    real[29] = r29; imag[29] = i29;
+    real[30] = r30; imag[30] = i30;
+    real[31] = r31; imag[31] = i31;
+    real[32] = r32; imag[32] = i32;
+    real[33] = r33; imag[33] = i33;
+    real[34] = r34; imag[34] = i34;
+    real[35] = r35; imag[35] = i35;
+    real[36] = r36; imag[36] = i36;
+    real[37] = r37; imag[37] = i37;
+    real[38] = r38; imag[38] = i38;
+    real[39] = r39; imag[39] = i39;
+    real[40] = r40; imag[40] = i40;
+    real[41] = r41; imag[41] = i41;
+    real[42] = r42; imag[42] = i42;
+    real[43] = r43; imag[43] = i43;
+    real[44] = r44; imag[44] = i44;
+    real[45] = r45; imag[45] = i45;
+    real[46] = r46; imag[46] = i46;
+    real[47] = r47; imag[47] = i47;
+    real[48] = r48; imag[48] = i48;
+    real[49] = r49; imag[49] = i49;
+    real[50] = r50; imag[50] = i50;
+    real[51] = r51; imag[51] = i51;
+    real[52] = r52; imag[52] = i52;
+    real[53] = r53; imag[53] = i53;
+    real[54] = r54; imag[54] = i54;
+    real[55] = r55; imag[55] = i55;
+    real[56] = r56; imag[56] = i56;
+    real[57] = r57; imag[57] = i57;
+    real[58] = r58; imag[58] = i58;
+    real[59] = r59; imag[59] = i59;
+    real[60] = r60; imag[60] = i60;
+    real[61] = r61; imag[61] = i61;
+    real[62] = r62; imag[62] = i62;
+    real[63] = r63; imag[63] = i63;
+}
+
+static void fht_codelet_64(double * values)
+{
+    double v0 = values[0];
+    double v1 = values[32];
+    double v2 = values[16];
+    double v3 = values[48];
+    double v4 = values[8];
+    double v5 = values[40];
+    double v6 = values[24];
+    double v7 = values[56];
+    double v8 = values[4];
+    double v9 = values[36];
+    double v10 = values[20];
+    double v11 = values[52];
+    double v12 = values[12];
+    double v13 = values[44];
+    double v14 = values[28];
+    double v15 = values[60];
+    double v16 = values[2];
+    double v17 = values[34];
+    double v18 = values[18];
+    double v19 = values[50];
+    double v20 = values[10];
+    double v21 = values[42];
+    double v22 = values[26];
+    double v23 = values[58];
+    double v24 = values[6];
+    double v25 = values[38];
+    double v26 = values[22];
+    double v27 = values[54];
+    double v28 = values[14];
+    double v29 = values[46];
+    double v30 = values[30];
+    double v31 = values[62];
+    double v32 = values[1];
+    double v33 = values[33];
+    double v34 = values[17];
+    double v35 = values[49];
+    double v36 = values[9];
+    double v37 = values[41];
+    double v38 = values[25];
+    double v39 = values[57];
+    double v40 = values[5];
+    double v41 = values[37];
+    double v42 = values[21];
+    double v43 = values[53];
+    double v44 = values[13];
+    double v45 = values[45];
+    double v46 = values[29];
+    double v47 = values[61];
+    double v48 = values[3];
+    double v49 = values[35];
+    double v50 = values[19];
+    double v51 = values[51];
+    double v52 = values[11];
+    double v53 = values[43];
+    double v54 = values[27];
+    double v55 = values[59];
+    double v56 = values[7];
+    double v57 = values[39];
+    double v58 = values[23];
+    double v59 = values[55];
+    double v60 = values[15];
+    double v61 = values[47];
+    double v62 = values[31];
+    double v63 = values[63];
+    double a, b;
+
+    // level 2
+    a = v0; b = v1; v0 = a + b; v1 = a - b;
+    a = v2; b = v3; v2 = a + b; v3 = a - b;
+    a = v4; b = v5; v4 = a + b; v5 = a - b;
+    a = v6; b = v7; v6 = a + b; v7 = a - b;
+    a = v8; b = v9; v8 = a + b; v9 = a - b;
+    a = v10; b = v11; v10 = a + b; v11 = a - b;
+    a = v12; b = v13; v12 = a + b; v13 = a - b;
+    a = v14; b = v15; v14 = a + b; v15 = a - b;
+    a = v16; b = v17; v16 = a + b; v17 = a - b;
+    a = v18; b = v19; v18 = a + b; v19 = a - b;
+    a = v20; b = v21; v20 = a + b; v21 = a - b;
+    a = v22; b = v23; v22 = a + b; v23 = a - b;
+    a = v24; b = v25; v24 = a + b; v25 = a - b;
+    a = v26; b = v27; v26 = a + b; v27 = a - b;
+    a = v28; b = v29; v28 = a + b; v29 = a - b;
+    a = v30; b = v31; v30 = a + b; v31 = a - b;
+    a = v32; b = v33; v32 = a + b; v33 = a - b;
+    a = v34; b = v35; v34 = a + b; v35 = a - b;
+    a = v36; b = v37; v36 = a + b; v37 = a - b;
+    a = v38; b = v39; v38 = a + b; v39 = a - b;
+    a = v40; b = v41; v40 = a + b; v41 = a - b;
+    a = v42; b = v43; v42 = a + b; v43 = a - b;
+    a = v44; b = v45; v44 = a + b; v45 = a - b;
+    a = v46; b = v47; v46 = a + b; v47 = a - b;
+    a = v48; b = v49; v48 = a + b; v49 = a - b;
+    a = v50; b = v51; v50 = a + b; v51 = a - b;
+    a = v52; b = v53; v52 = a + b; v53 = a - b;
+    a = v54; b = v55; v54 = a + b; v55 = a - b;
+    a = v56; b = v57; v56 = a + b; v57 = a - b;
+    a = v58; b = v59; v58 = a + b; v59 = a - b;
+    a = v60; b = v61; v60 = a + b; v61 = a - b;
+    a = v62; b = v63; v62 = a + b; v63 = a - b;
+    // level 4
+    a = v0; b = v2; v0 = a + b; v2 = a - b;
+    a = v1; b = v3; v1 = a + b; v3 = a - b;
+    a = v4; b = v6; v4 = a + b; v6 = a - b;
+    a = v5; b = v7; v5 = a + b; v7 = a - b;
+    a = v8; b = v10; v8 = a + b; v10 = a - b;
+    a = v9; b = v11; v9 = a + b; v11 = a - b;
+    a = v12; b = v14; v12 = a + b; v14 = a - b;
+    a = v13; b = v15; v13 = a + b; v15 = a - b;
+    a = v16; b = v18; v16 = a + b; v18 = a - b;
+    a = v17; b = v19; v17 = a + b; v19 = a - b;
+    a = v20; b = v22; v20 = a + b; v22 = a - b;
+    a = v21; b = v23; v21 = a + b; v23 = a - b;
+    a = v24; b = v26; v24 = a + b; v26 = a - b;
+    a = v25; b = v27; v25 = a + b; v27 = a - b;
+    a = v28; b = v30; v28 = a + b; v30 = a - b;
+    a = v29; b = v31; v29 = a + b; v31 = a - b;
+    a = v32; b = v34; v32 = a + b; v34 = a - b;
+    a = v33; b = v35; v33 = a + b; v35 = a - b;
+    a = v36; b = v38; v36 = a + b; v38 = a - b;
+    a = v37; b = v39; v37 = a + b; v39 = a - b;
+    a = v40; b = v42; v40 = a + b; v42 = a - b;
+    a = v41; b = v43; v41 = a + b; v43 = a - b;
+    a = v44; b = v46; v44 = a + b; v46 = a - b;
+    a = v45; b = v47; v45 = a + b; v47 = a - b;
+    a = v48; b = v50; v48 = a + b; v50 = a - b;
+    a = v49; b = v51; v49 = a + b; v51 = a - b;
+    a = v52; b = v54; v52 = a + b; v54 = a - b;
+    a = v53; b = v55; v53 = a + b; v55 = a - b;
+    a = v56; b = v58; v56 = a + b; v58 = a - b;
+    a = v57; b = v59; v57 = a + b; v59 = a - b;
+    a = v60; b = v62; v60 = a + b; v62 = a - b;
+    a = v61; b = v63; v61 = a + b; v63 = a - b;
+    // level 8
+    a = v5; b = v7;
+    v5 = a * 0.7071067811865476 + b * 0.7071067811865475; v7 = a * 0.7071067811865475 - b * 0.7071067811865476;
+    a = v0; b = v4; v0 = a + b; v4 = a - b;
+    a = v1; b = v5; v1 = a + b; v5 = a - b;
+    a = v2; b = v6; v2 = a + b; v6 = a - b;
+    a = v3; b = v7; v3 = a + b; v7 = a - b;
+    a = v13; b = v15;
+    v13 = a * 0.7071067811865476 + b * 0.7071067811865475; v15 = a * 0.7071067811865475 - b * 0.7071067811865476;
+    a = v8; b = v12; v8 = a + b; v12 = a - b;
+    a = v9; b = v13; v9 = a + b; v13 = a - b;
+    a = v10; b = v14; v10 = a + b; v14 = a - b;
+    a = v11; b = v15; v11 = a + b; v15 = a - b;
+    a = v21; b = v23;
+    v21 = a * 0.7071067811865476 + b * 0.7071067811865475; v23 = a * 0.7071067811865475 - b * 0.7071067811865476;
+    a = v16; b = v20; v16 = a + b; v20 = a - b;
+    a = v17; b = v21; v17 = a + b; v21 = a - b;
+    a = v18; b = v22; v18 = a + b; v22 = a - b;
+    a = v19; b = v23; v19 = a + b; v23 = a - b;
+    a = v29; b = v31;
+    v29 = a * 0.7071067811865476 + b * 0.7071067811865475; v31 = a * 0.7071067811865475 - b * 0.7071067811865476;
+    a = v24; b = v28; v24 = a + b; v28 = a - b;
+    a = v25; b = v29; v25 = a + b; v29 = a - b;
+    a = v26; b = v30; v26 = a + b; v30 = a - b;
+    a = v27; b = v31; v27 = a + b; v31 = a - b;
+    a = v37; b = v39;
+    v37 = a * 0.7071067811865476 + b * 0.7071067811865475; v39 = a * 0.7071067811865475 - b * 0.7071067811865476;
+    a = v32; b = v36; v32 = a + b; v36 = a - b;
+    a = v33; b = v37; v33 = a + b; v37 = a - b;
+    a = v34; b = v38; v34 = a + b; v38 = a - b;
+    a = v35; b = v39; v35 = a + b; v39 = a - b;
+    a = v45; b = v47;
+    v45 = a * 0.7071067811865476 + b * 0.7071067811865475; v47 = a * 0.7071067811865475 - b * 0.7071067811865476;
+    a = v40; b = v44; v40 = a + b; v44 = a - b;
+    a = v41; b = v45; v41 = a + b; v45 = a - b;
+    a = v42; b = v46; v42 = a + b; v46 = a - b;
+    a = v43; b = v47; v43 = a + b; v47 = a - b;
+    a = v53; b = v55;
+    v53 = a * 0.7071067811865476 + b * 0.7071067811865475; v55 = a * 0.7071067811865475 - b * 0.7071067811865476;
+    a = v48; b = v52; v48 = a + b; v52 = a - b;
+    a = v49; b = v53; v49 = a + b; v53 = a - b;
+    a = v50; b = v54; v50 = a + b; v54 = a - b;
+    a = v51; b = v55; v51 = a + b; v55 = a - b;
+    a = v61; b = v63;
+    v61 = a * 0.7071067811865476 + b * 0.7071067811865475; v63 = a * 0.7071067811865475 - b * 0.7071067811865476;
+    a = v56; b = v60; v56 = a + b; v60 = a - b;
+    a = v57; b = v61; v57 = a + b; v61 = a - b;
+    a = v58; b = v62; v58 = a + b; v62 = a - b;
+    a = v59; b = v63; v59 = a + b; v63 = a - b;
+    // level 16
+    a = v9; b = v15;
+    v9 = a * 0.9238795325112867 + b * 0.3826834323650898; v15 = a * 0.3826834323650898 - b * 0.9238795325112867;
+    a = v10; b = v14;
+    v10 = a * 0.7071067811865476 + b * 0.7071067811865475; v14 = a * 0.7071067811865475 - b * 0.7071067811865476;
+    a = v11; b = v13;
+    v11 = a * 0.38268343236508984 + b * 0.9238795325112867; v13 = a * 0.9238795325112867 - b * 0.38268343236508984;
+    a = v0; b = v8; v0 = a + b; v8 = a - b;
+    a = v1; b = v9; v1 = a + b; v9 = a - b;
+    a = v2; b = v10; v2 = a + b; v10 = a - b;
+    a = v3; b = v11; v3 = a + b; v11 = a - b;
+    a = v4; b = v12; v4 = a + b; v12 = a - b;
+    a = v5; b = v13; v5 = a + b; v13 = a - b;
+    a = v6; b = v14; v6 = a + b; v14 = a - b;
+    a = v7; b = v15; v7 = a + b; v15 = a - b;
+    a = v25; b = v31;
+    v25 = a * 0.9238795325112867 + b * 0.3826834323650898; v31 = a * 0.3826834323650898 - b * 0.9238795325112867;
+    a = v26; b = v30;
+    v26 = a * 0.7071067811865476 + b * 0.7071067811865475; v30 = a * 0.7071067811865475 - b * 0.7071067811865476;
+    a = v27; b = v29;
+    v27 = a * 0.38268343236508984 + b * 0.9238795325112867; v29 = a * 0.9238795325112867 - b * 0.38268343236508984;
+    a = v16; b = v24; v16 = a + b; v24 = a - b;
+    a = v17; b = v25; v17 = a + b; v25 = a - b;
+    a = v18; b = v26; v18 = a + b; v26 = a - b;
+    a = v19; b = v27; v19 = a + b; v27 = a - b;
+    a = v20; b = v28; v20 = a + b; v28 = a - b;
+    a = v21; b = v29; v21 = a + b; v29 = a - b;
+    a = v22; b = v30; v22 = a + b; v30 = a - b;
+    a = v23; b = v31; v23 = a + b; v31 = a - b;
+    a = v41; b = v47;
+    v41 = a * 0.9238795325112867 + b * 0.3826834323650898; v47 = a * 0.3826834323650898 - b * 0.9238795325112867;
+    a = v42; b = v46;
+    v42 = a * 0.7071067811865476 + b * 0.7071067811865475; v46 = a * 0.7071067811865475 - b * 0.7071067811865476;
+    a = v43; b = v45;
+    v43 = a * 0.38268343236508984 + b * 0.9238795325112867; v45 = a * 0.9238795325112867 - b * 0.38268343236508984;
+    a = v32; b = v40; v32 = a + b; v40 = a - b;
+    a = v33; b = v41; v33 = a + b; v41 = a - b;
+    a = v34; b = v42; v34 = a + b; v42 = a - b;
+    a = v35; b = v43; v35 = a + b; v43 = a - b;
+    a = v36; b = v44; v36 = a + b; v44 = a - b;
+    a = v37; b = v45; v37 = a + b; v45 = a - b;
+    a = v38; b = v46; v38 = a + b; v46 = a - b;
+    a = v39; b = v47; v39 = a + b; v47 = a - b;
+    a = v57; b = v63;
+    v57 = a * 0.9238795325112867 + b * 0.3826834323650898; v63 = a * 0.3826834323650898 - b * 0.9238795325112867;
+    a = v58; b = v62;
+    v58 = a * 0.7071067811865476 + b * 0.7071067811865475; v62 = a * 0.7071067811865475 - b * 0.7071067811865476;
+    a = v59; b = v61;
+    v59 = a * 0.38268343236508984 + b * 0.9238795325112867; v61 = a * 0.9238795325112867 - b * 0.38268343236508984;
+    a = v48; b = v56; v48 = a + b; v56 = a - b;
+    a = v49; b = v57; v49 = a + b; v57 = a - b;
+    a = v50; b = v58; v50 = a + b; v58 = a - b;
+    a = v51; b = v59; v51 = a + b; v59 = a - b;
+    a = v52; b = v60; v52 = a + b; v60 = a - b;
+    a = v53; b = v61; v53 = a + b; v61 = a - b;
+    a = v54; b = v62; v54 = a + b; v62 = a - b;
+    a = v55; b = v63; v55 = a + b; v63 = a - b;
+    // level 32
+    a = v17; b = v31;
+    v17 = a * 0.9807852804032304 + b * 0.19509032201612825; v31 = a * 0.19509032201612825 - b * 0.9807852804032304;
+    a = v18; b = v30;
+    v18 = a * 0.9238795325112867 + b * 0.3826834323650898; v30 = a * 0.3826834323650898 - b * 0.9238795325112867;
+    a = v19; b = v29;
+    v19 = a * 0.8314696123025452 + b * 0.5555702330196022; v29 = a * 0.5555702330196022 - b * 0.8314696123025452;
+    a = v20; b = v28;
+    v20 = a * 0.7071067811865476 + b * 0.7071067811865475; v28 = a * 0.7071067811865475 - b * 0.7071067811865476;
+    a = v21; b = v27;
+    v21 = a * 0.5555702330196023 + b * 0.8314696123025452; v27 = a * 0.8314696123025452 - b * 0.5555702330196023;
+    a = v22; b = v26;
+    v22 = a * 0.38268343236508984 + b * 0.9238795325112867; v26 = a * 0.9238795325112867 - b * 0.38268343236508984;
+    a = v23; b = v25;
+    v23 = a * 0.19509032201612833 + b * 0.9807852804032304; v25 = a * 0.9807852804032304 - b * 0.19509032201612833;
+    a = v0; b = v16; v0 = a + b; v16 = a - b;
+    a = v1; b = v17; v1 = a + b; v17 = a - b;
+    a = v2; b = v18; v2 = a + b; v18 = a - b;
+    a = v3; b = v19; v3 = a + b; v19 = a - b;
+    a = v4; b = v20; v4 = a + b; v20 = a - b;
+    a = v5; b = v21; v5 = a + b; v21 = a - b;
+    a = v6; b = v22; v6 = a + b; v22 = a - b;
+    a = v7; b = v23; v7 = a + b; v23 = a - b;
+    a = v8; b = v24; v8 = a + b; v24 = a - b;
+    a = v9; b = v25; v9 = a + b; v25 = a - b;
+    a = v10; b = v26; v10 = a + b; v26 = a - b;
+    a = v11; b = v27; v11 = a + b; v27 = a - b;
+    a = v12; b = v28; v12 = a + b; v28 = a - b;
+    a = v13; b = v29; v13 = a + b; v29 = a - b;
+    a = v14; b = v30; v14 = a + b; v30 = a - b;
+    a = v15; b = v31; v15 = a + b; v31 = a - b;
+    a = v49; b = v63;
+    v49 = a * 0.9807852804032304 + b * 0.19509032201612825; v63 = a * 0.19509032201612825 - b * 0.9807852804032304;
+    a = v50; b = v62;
+    v50 = a * 0.9238795325112867 + b * 0.3826834323650898; v62 = a * 0.3826834323650898 - b * 0.9238795325112867;
+    a = v51; b = v61;
+    v51 = a * 0.8314696123025452 + b * 0.5555702330196022; v61 = a * 0.5555702330196022 - b * 0.8314696123025452;
+    a = v52; b = v60;
+    v52 = a * 0.7071067811865476 + b * 0.7071067811865475; v60 = a * 0.7071067811865475 - b * 0.7071067811865476;
+    a = v53; b = v59;
+    v53 = a * 0.5555702330196023 + b * 0.8314696123025452; v59 = a * 0.8314696123025452 - b * 0.5555702330196023;
+    a = v54; b = v58;
+    v54 = a * 0.38268343236508984 + b * 0.9238795325112867; v58 = a * 0.9238795325112867 - b * 0.38268343236508984;
+    a = v55; b = v57;
+    v55 = a * 0.19509032201612833 + b * 0.9807852804032304; v57 = a * 0.9807852804032304 - b * 0.19509032201612833;
+    a = v32; b = v48; v32 = a + b; v48 = a - b;
+    a = v33; b = v49; v33 = a + b; v49 = a - b;
+    a = v34; b = v50; v34 = a + b; v50 = a - b;
+    a = v35; b = v51; v35 = a + b; v51 = a - b;
+    a = v36; b = v52; v36 = a + b; v52 = a - b;
+    a = v37; b = v53; v37 = a + b; v53 = a - b;
+    a = v38; b = v54; v38 = a + b; v54 = a - b;
+    a = v39; b = v55; v39 = a + b; v55 = a - b;
+    a = v40; b = v56; v40 = a + b; v56 = a - b;
+    a = v41; b = v57; v41 = a + b; v57 = a - b;
+    a = v42; b = v58; v42 = a + b; v58 = a - b;
+    a = v43; b = v59; v43 = a + b; v59 = a - b;
+    a = v44; b = v60; v44 = a + b; v60 = a - b;
+    a = v45; b = v61; v45 = a + b; v61 = a - b;
+    a = v46; b = v62; v46 = a + b; v62 = a - b;
+    a = v47; b = v63; v47 = a + b; v63 = a - b;
+    // level 64
+    a = v33; b = v63;
+    v33 = a * 0.9951847266721969 + b * 0.0980171403295606; v63 = a * 0.0980171403295606 - b * 0.9951847266721969;
+    a = v34; b = v62;
+    v34 = a * 0.9807852804032304 + b * 0.19509032201612825; v62 = a * 0.19509032201612825 - b * 0.9807852804032304;
+    a = v35; b = v61;
+    v35 = a * 0.9569403357322088 + b * 0.29028467725446233; v61 = a * 0.29028467725446233 - b * 0.9569403357322088;
+    a = v36; b = v60;
+    v36 = a * 0.9238795325112867 + b * 0.3826834323650898; v60 = a * 0.3826834323650898 - b * 0.9238795325112867;
+    a = v37; b = v59;
+    v37 = a * 0.881921264348355 + b * 0.47139673682599764; v59 = a * 0.47139673682599764 - b * 0.881921264348355;
+    a = v38; b = v58;
+    v38 = a * 0.8314696123025452 + b * 0.5555702330196022; v58 = a * 0.5555702330196022 - b * 0.8314696123025452;
+    a = v39; b = v57;
+    v39 = a * 0.773010453362737 + b * 0.6343932841636455; v57 = a * 0.6343932841636455 - b * 0.773010453362737;
+    a = v40; b = v56;
+    v40 = a * 0.7071067811865476 + b * 0.7071067811865475; v56 = a * 0.7071067811865475 - b * 0.7071067811865476;
+    a = v41; b = v55;
+    v41 = a * 0.6343932841636455 + b * 0.773010453362737; v55 = a * 0.773010453362737 - b * 0.6343932841636455;
+    a = v42; b = v54;
+    v42 = a * 0.5555702330196023 + b * 0.8314696123025452; v54 = a * 0.8314696123025452 - b * 0.5555702330196023;
+    a = v43; b = v53;
+    v43 = a * 0.4713967368259978 + b * 0.8819212643483549; v53 = a * 0.8819212643483549 - b * 0.4713967368259978;
+    a = v44; b = v52;
+    v44 = a * 0.38268343236508984 + b * 0.9238795325112867; v52 = a * 0.9238795325112867 - b * 0.38268343236508984;
+    a = v45; b = v51;
+    v45 = a * 0.29028467725446233 + b * 0.9569403357322089; v51 = a * 0.9569403357322089 - b * 0.29028467725446233;
+    a = v46; b = v50;
+    v46 = a * 0.19509032201612833 + b * 0.9807852804032304; v50 = a * 0.9807852804032304 - b * 0.19509032201612833;
+    a = v47; b = v49;
+    v47 = a * 0.09801714032956077 + b * 0.9951847266721968; v49 = a * 0.9951847266721968 - b * 0.09801714032956077;
+    a = v0; b = v32; v0 = a + b; v32 = a - b;
+    a = v1; b = v33; v1 = a + b; v33 = a - b;
+    a = v2; b = v34; v2 = a + b; v34 = a - b;
+    a = v3; b = v35; v3 = a + b; v35 = a - b;
+    a = v4; b = v36; v4 = a + b; v36 = a - b;
+    a = v5; b = v37; v5 = a + b; v37 = a - b;
+    a = v6; b = v38; v6 = a + b; v38 = a - b;
+    a = v7; b = v39; v7 = a + b; v39 = a - b;
+    a = v8; b = v40; v8 = a + b; v40 = a - b;
+    a = v9; b = v41; v9 = a + b; v41 = a - b;
+    a = v10; b = v42; v10 = a + b; v42 = a - b;
+    a = v11; b = v43; v11 = a + b; v43 = a - b;
+    a = v12; b = v44; v12 = a + b; v44 = a - b;
+    a = v13; b = v45; v13 = a + b; v45 = a - b;
+    a = v14; b = v46; v14 = a + b; v46 = a - b;
+    a = v15; b = v47; v15 = a + b; v47 = a - b;
+    a = v16; b = v48; v16 = a + b; v48 = a - b;
+    a = v17; b = v49; v17 = a + b; v49 = a - b;
+    a = v18; b = v50; v18 = a + b; v50 = a - b;
+    a = v19; b = v51; v19 = a + b; v51 = a - b;
+    a = v20; b = v52; v20 = a + b; v52 = a - b;
+    a = v21; b = v53; v21 = a + b; v53 = a - b;
+    a = v22; b = v54; v22 = a + b; v54 = a - b;
+    a = v23; b = v55; v23 = a + b; v55 = a - b;
+    a = v24; b = v56; v24 = a + b; v56 = a - b;
+    a = v25; b = v57; v25 = a + b; v57 = a - b;
+    a = v26; b = v58; v26 = a + b; v58 = a - b;
+    a = v27; b = v59; v27 = a + b; v59 = a - b;
+    a = v28; b = v60; v28 = a + b; v60 = a - b;
+    a = v29; b = v61; v29 = a + b; v61 = a - b;
+    a = v30; b = v62; v30 = a + b; v62 = a - b;
+    a = v31; b = v63; v31 = a + b; v63 = a - b;
+
+    values[0] = v0 * 0.125;
+    values[1] = v1 * 0.125;
+    values[2] = v2 * 0.125;
+    values[3] = v3 * 0.125;
+    values[4] = v4 * 0.125;
+    values[5] = v5 * 0.125;
+    values[6] = v6 * 0.125;
+    values[7] = v7 * 0.125;
+    values[8] = v8 * 0.125;
+    values[9] = v9 * 0.125;
+    values[10] = v10 * 0.125;
+    values[11] = v11 * 0.125;
+    values[12] = v12 * 0.125;
+    values[13] = v13 * 0.125;
+    values[14] = v14 * 0.125;
+    values[15] = v15 * 0.125;
+    values[16] = v16 * 0.125;
+    values[17] = v17 * 0.125;
+    values[18] = v18 * 0.125;
+    values[19] = v19 * 0.125;
+    values[20] = v20 * 0.125;
+    values[21] = v21 * 0.125;
+    values[22] = v22 * 0.125;
+    values[23] = v23 * 0.125;
+    values[24] = v24 * 0.125;
+    values[25] = v25 * 0.125;
+    values[26] = v26 * 0.125;
+    values[27] = v27 * 0.125;
+    values[28] = v28 * 0.125;
+    values[29] = v29 * 0.125;
+    values[30] = v30 * 0.125;
+    values[31] = v31 * 0.125;
+    values[32] = v32 * 0.125;
+    values[33] = v33 * 0.125;
+    values[34] = v34 * 0.125;
+    values[35] = v35 * 0.125;
+    values[36] = v36 * 0.125;
+    values[37] = v37 * 0.125;
+    values[38] = v38 * 0.125;
+    values[39] = v39 * 0.125;
+    values[40] = v40 * 0.125;
+    values[41] = v41 * 0.125;
+    values[42] = v42 * 0.125;
+    values[43] = v43 * 0.125;
+    values[44] = v44 * 0.125;
+    values[45] = v45 * 0.125;
+    values[46] = v46 * 0.125;
+    values[47] = v47 * 0.125;
+    values[48] = v48 * 0.125;
+    values[49] = v49 * 0.125;
+    values[50] = v50 * 0.125;
+    values[51] = v51 * 0.125;
+    values[52] = v52 * 0.125;
+    values[53] = v53 * 0.125;
+    values[54] = v54 * 0.125;
+    values[55] = v55 * 0.125;
+    values[56] = v56 * 0.125;
+    values[57] = v57 * 0.125;
+    values[58] = v58 * 0.125;
+    values[59] = v59 * 0.125;
+    values[60] = v60 * 0.125;
+    values[61] = v61 * 0.125;
+    values[62] = v62 * 0.125;
+    values[63] = v63 * 0.125;
+}
+
+// codelets indexed by log2 of the length (none for one point)
+static void (* const fft_codelets_forward[])(double *, double *) =
+{
+    NULL, fft_codelet_2_forward, fft_codelet_4_forward, fft_codelet_8_forward, fft_codelet_16_forward, fft_codelet_32_forward, fft_codelet_64_forward
+};
+
+static void (* const fft_codelets_reverse[])(double *, double *) =
+{
+    NULL, fft_codelet_2_reverse, fft_codelet_4_reverse, fft_codelet_8_reverse, fft_codelet_16_reverse, fft_codelet_32_reverse, fft_codelet_64_reverse
+};
+
+static void (* const fht_codelets[])(double *) =
+{
+    NULL, fht_codelet_2, fht_codelet_4, fht_codelet_8, fht_codelet_16, fht_codelet_32, fht_codelet_64
+};
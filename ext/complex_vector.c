@@ -0,0 +1,861 @@
+/**
+ * @file complex_vector.c
+ * @brief Complex data of any shape held in C memory.
+ * FT::ComplexVector keeps real and imaginary parts in two aligned C buffers
+ * (row-major, of one or more dimensions), so chains of transforms and
+ * elementwise operations run on them without converting anything into
+ * Ruby arrays; data is unboxed when a vector is created and boxed only
+ * when an Array (or Complex numbers) is asked for. Transforms go over all
+ * the axes (a vector of one axis is 1D data, of two axes 2D data and so
+ * on). Methods ending with ! change the vector and return it, the others
+ * return a new vector.
+ * @author placek@ragnarson.com
+ */
+#include "frequency_transformations.h"
+#include <string.h>
+
+/**
+ * @brief Alignment of the buffers (a cache line, the widest vector load).
+ */
+#define VECTOR_ALIGNMENT 64
+
+static VALUE cComplexVector;
+static ID id_real, id_imaginary;
+
+/**
+ * @brief Complex data in C memory.
+ */
+typedef struct
+{
+    long size;
+    long shape[FT_MAX_DIMS];
+    int dims;
+    double * real;
+    double * imag;
+} ft_vector;
+
+/**
+ * @brief Allocate an aligned buffer of doubles.
+ * @author placek@ragnarson.com
+ * @param count Number of doubles.
+ * @return The buffer (to be released with free()).
+ */
+static double * vector_buffer(long count)
+{
+    void * buffer = NULL;
+
+#ifdef HAVE_POSIX_MEMALIGN
+    if(posix_memalign(&buffer, VECTOR_ALIGNMENT, count * sizeof(double)))
+        rb_raise(rb_eNoMemError, "failed to allocate %ld values", count);
+#else
+    buffer = malloc(count * sizeof(double));
+    if(!buffer)
+        rb_raise(rb_eNoMemError, "failed to allocate %ld values", count);
+#endif
+    return buffer;
+}
+
+static void vector_free(void * ptr)
+{
+    ft_vector * vector = ptr;
+
+    if(!vector)
+        return;
+    free(vector->real);
+    free(vector->imag);
+    free(vector);
+}
+
+static size_t vector_memsize(const void * ptr)
+{
+    const ft_vector * vector = ptr;
+
+    if(!vector)
+        return 0;
+    return sizeof(ft_vector) + 2 * vector->size * sizeof(double);
+}
+
+static const rb_data_type_t vector_type = {
+    "FrequencyTransformations::ComplexVector",
+    { NULL, vector_free, vector_memsize, },
+    NULL, NULL, RUBY_TYPED_FREE_IMMEDIATELY
+};
+
+static VALUE vector_alloc(VALUE klass)
+{
+    return TypedData_Wrap_Struct(klass, &vector_type, NULL);
+}
+
+static ft_vector * get_vector(VALUE self)
+{
+    ft_vector * vector;
+    TypedData_Get_Struct(self, ft_vector, &vector_type, vector);
+    if(!vector)
+        rb_raise(rb_eRuntimeError, "uninitialized ComplexVector");
+    return vector;
+}
+
+/**
+ * @brief Prepare the buffers of a vector.
+ * @author placek@ragnarson.com
+ * @param self A ComplexVector being initialized.
+ * @param shape Lengths of the axes.
+ * @param dims Number of axes.
+ * @return The vector (with uninitialized values).
+ */
+static ft_vector * vector_setup(VALUE self, const long * shape, int dims)
+{
+    ft_vector * vector;
+    int d;
+
+    if(DATA_PTR(self))
+        rb_raise(rb_eRuntimeError, "ComplexVector already initialized");
+    vector = calloc(1, sizeof(ft_vector));
+    vector->dims = dims;
+    vector->size = 1;
+    for(d = 0; d < dims; d++)
+    {
+        vector->shape[d] = shape[d];
+        vector->size *= shape[d];
+    }
+    DATA_PTR(self) = vector;
+    vector->real = vector_buffer(vector->size);
+    vector->imag = vector_buffer(vector->size);
+
+    return vector;
+}
+
+/**
+ * @brief Create a vector of a shape.
+ * @author placek@ragnarson.com
+ * @param shape Lengths of the axes.
+ * @param dims Number of axes.
+ * @param result Place for the new vector.
+ * @return The new ComplexVector (with uninitialized values).
+ */
+static VALUE vector_new(const long * shape, int dims, ft_vector ** result)
+{
+    VALUE self = vector_alloc(cComplexVector);
+
+    *result = vector_setup(self, shape, dims);
+    return self;
+}
+
+/**
+ * @brief Copy a vector.
+ * @author placek@ragnarson.com
+ * @param vector A vector.
+ * @param result Place for the copy.
+ * @return The new ComplexVector.
+ */
+static VALUE vector_copy(const ft_vector * vector, ft_vector ** result)
+{
+    VALUE copy = vector_new(vector->shape, vector->dims, result);
+
+    memcpy((*result)->real, vector->real, vector->size * sizeof(double));
+    memcpy((*result)->imag, vector->imag, vector->size * sizeof(double));
+    return copy;
+}
+
+/**
+ * @brief Convert nested Ruby arrays of numbers or Complex numbers.
+ * @see ft_nd_from_ruby()
+ * @author placek@ragnarson.com
+ * @param inArray A Ruby array validated by ft_nd_shape().
+ * @param real Place for real parts.
+ * @param imag Place for imaginary parts.
+ * @param shape Lengths of the axes.
+ * @param dims Number of axes.
+ * @return Number of values written.
+ */
+static long vector_from_ruby(VALUE inArray, double * real, double * imag, const long * shape, int dims)
+{
+    long i, written = 0;
+    VALUE * items = RARRAY_PTR(inArray);
+
+    if(dims > 1)
+    {
+        for(i = 0; i < shape[0]; i++)
+            written += vector_from_ruby(items[i], real + written, imag + written, shape + 1, dims - 1);
+        return written;
+    }
+    for(i = 0; i < shape[0]; i++)
+    {
+        if(RB_TYPE_P(items[i], T_COMPLEX))
+        {
+            real[i] = NUM2DBL(rb_funcall(items[i], id_real, 0));
+            imag[i] = NUM2DBL(rb_funcall(items[i], id_imaginary, 0));
+        }
+        else
+        {
+            real[i] = NUM2DBL(items[i]);
+            imag[i] = 0.0;
+        }
+    }
+    return shape[0];
+}
+
+/**
+ * @brief Convert parts of a vector into nested Ruby arrays of Complex numbers.
+ * @see ft_nd_to_ruby()
+ * @author placek@ragnarson.com
+ */
+static VALUE vector_to_complex(const double * real, const double * imag, const long * shape, int dims)
+{
+    long i, stride = 1;
+    int d;
+    VALUE outArray = rb_ary_new2(shape[0]);
+
+    for(d = 1; d < dims; d++)
+        stride *= shape[d];
+    for(i = 0; i < shape[0]; i++)
+    {
+        if(dims == 1)
+            rb_ary_push(outArray, rb_Complex(DBL2NUM(real[i]), DBL2NUM(imag[i])));
+        else
+            rb_ary_push(outArray, vector_to_complex(real + i * stride, imag + i * stride, shape + 1, dims - 1));
+    }
+
+    return outArray;
+}
+
+/**
+ * @brief Initialize a vector.
+ * ComplexVector.new(real, imag = nil) takes nested arrays of real parts
+ * (Complex numbers are split into both parts) and optionally of imaginary
+ * parts of the same shape.
+ * @author placek@ragnarson.com
+ * @params argc Number of arguments.
+ * @params argv Arguments (real parts and optional imaginary parts).
+ * @params self A ComplexVector being initialized.
+ * @return The vector.
+ */
+static VALUE vector_initialize(int argc, VALUE * argv, VALUE self)
+{
+    VALUE real, imag, temp;
+    long shape[FT_MAX_DIMS], imag_shape[FT_MAX_DIMS];
+    int d, dims;
+    ft_vector * vector;
+    double * ignored;
+
+    rb_scan_args(argc, argv, "11", &real, &imag);
+    Check_Type(real, T_ARRAY);
+    dims = ft_nd_shape(real, shape);
+    if(dims == 0)
+        rb_raise(rb_eArgError, "data should be a non-empty rectangular array");
+    if(!NIL_P(imag))
+    {
+        Check_Type(imag, T_ARRAY);
+        if(ft_nd_shape(imag, imag_shape) != dims)
+            rb_raise(rb_eArgError, "imaginary parts should have the shape of real parts");
+        for(d = 0; d < dims; d++)
+            if(imag_shape[d] != shape[d])
+                rb_raise(rb_eArgError, "imaginary parts should have the shape of real parts");
+    }
+
+    vector = vector_setup(self, shape, dims);
+    vector_from_ruby(real, vector->real, vector->imag, shape, dims);
+    if(!NIL_P(imag))
+    {
+        // imaginary parts of Complex numbers among the imaginary parts are dropped
+        ignored = ALLOCV_N(double, temp, vector->size);
+        vector_from_ruby(imag, vector->imag, ignored, shape, dims);
+        ALLOCV_END(temp);
+    }
+
+    return self;
+}
+
+/**
+ * @brief Copy a vector (dup and clone).
+ * @author placek@ragnarson.com
+ */
+static VALUE vector_initialize_copy(VALUE self, VALUE other)
+{
+    ft_vector * source = get_vector(other), * vector;
+
+    if(self == other)
+        return self;
+    vector = vector_setup(self, source->shape, source->dims);
+    memcpy(vector->real, source->real, vector->size * sizeof(double));
+    memcpy(vector->imag, source->imag, vector->size * sizeof(double));
+
+    return self;
+}
+
+/**
+ * @brief Read a shape given from Ruby.
+ * @author placek@ragnarson.com
+ * @param rb_shape An Array of lengths of the axes.
+ * @param shape Place for the lengths.
+ * @return Number of axes.
+ */
+static int vector_shape(VALUE rb_shape, long * shape)
+{
+    int d, dims;
+
+    Check_Type(rb_shape, T_ARRAY);
+    dims = (int)RARRAY_LEN(rb_shape);
+    if(dims < 1 || dims > FT_MAX_DIMS)
+        rb_raise(rb_eArgError, "shape should have 1 to %d axes", FT_MAX_DIMS);
+    for(d = 0; d < dims; d++)
+        if((shape[d] = NUM2LONG(RARRAY_PTR(rb_shape)[d])) < 1)
+            rb_raise(rb_eArgError, "lengths of axes should be positive");
+    return dims;
+}
+
+/**
+ * @brief Create a vector of zeros.
+ * ComplexVector.zeros(4, 8) has 4 rows of 8 values.
+ * @author placek@ragnarson.com
+ * @return A new ComplexVector.
+ */
+static VALUE vector_zeros(int argc, VALUE * argv, VALUE klass)
+{
+    long shape[FT_MAX_DIMS];
+    ft_vector * vector;
+    VALUE result;
+
+    result = vector_new(shape, vector_shape(rb_ary_new4(argc, argv), shape), &vector);
+    memset(vector->real, 0, vector->size * sizeof(double));
+    memset(vector->imag, 0, vector->size * sizeof(double));
+
+    return result;
+}
+
+/**
+ * @brief Create a vector from a buffer.
+ * ComplexVector.from_buffer(string, shape = nil) reads interleaved complex
+ * doubles, like fft_buffer (a flat vector of all of them by default).
+ * @author placek@ragnarson.com
+ * @return A new ComplexVector.
+ */
+static VALUE vector_from_buffer(int argc, VALUE * argv, VALUE klass)
+{
+    VALUE input, rb_shape;
+    long shape[FT_MAX_DIMS], length, size;
+    int d, dims;
+    ft_buffer buffer;
+    ft_vector * vector;
+    VALUE result;
+
+    rb_scan_args(argc, argv, "11", &input, &rb_shape);
+    ft_buffer_open(input, &buffer, FT_FLOAT64);
+    length = buffer.size / (2 * sizeof(double));
+    if(NIL_P(rb_shape))
+    {
+        dims = 1;
+        shape[0] = length;
+    }
+    else
+        dims = vector_shape(rb_shape, shape);
+    for(d = 0, size = 1; d < dims; d++)
+        size *= shape[d];
+    if(length < 1 || buffer.size % (2 * sizeof(double)) || size != length)
+    {
+        ft_buffer_close(&buffer);
+        rb_raise(rb_eArgError, "buffer does not hold the shape");
+    }
+    result = vector_new(shape, dims, &vector);
+    ft_buffer_read_complex(&buffer, vector->real, vector->imag, length);
+    ft_buffer_close(&buffer);
+
+    return result;
+}
+
+/**
+ * @brief Get the shape.
+ * @author placek@ragnarson.com
+ * @return An Array of lengths of the axes.
+ */
+static VALUE vector_get_shape(VALUE self)
+{
+    ft_vector * vector = get_vector(self);
+    VALUE shape = rb_ary_new2(vector->dims);
+    int d;
+
+    for(d = 0; d < vector->dims; d++)
+        rb_ary_push(shape, LONG2NUM(vector->shape[d]));
+    return shape;
+}
+
+/**
+ * @brief Get the number of values.
+ * @author placek@ragnarson.com
+ * @return The product of the lengths of the axes.
+ */
+static VALUE vector_size(VALUE self)
+{
+    return LONG2NUM(get_vector(self)->size);
+}
+
+/**
+ * @brief Get a value.
+ * @author placek@ragnarson.com
+ * @params index Index in the row-major order (negative from the end).
+ * @return A Complex number (nil out of range).
+ */
+static VALUE vector_at(VALUE self, VALUE rb_index)
+{
+    ft_vector * vector = get_vector(self);
+    long index = NUM2LONG(rb_index);
+
+    if(index < 0)
+        index += vector->size;
+    if(index < 0 || index >= vector->size)
+        return Qnil;
+    return rb_Complex(DBL2NUM(vector->real[index]), DBL2NUM(vector->imag[index]));
+}
+
+/**
+ * @brief Get the real parts.
+ * @author placek@ragnarson.com
+ * @return Nested Ruby arrays of the shape.
+ */
+static VALUE vector_real(VALUE self)
+{
+    ft_vector * vector = get_vector(self);
+    return ft_nd_to_ruby(vector->real, vector->shape, vector->dims, NULL);
+}
+
+/**
+ * @brief Get the imaginary parts.
+ * @author placek@ragnarson.com
+ * @return Nested Ruby arrays of the shape.
+ */
+static VALUE vector_imag(VALUE self)
+{
+    ft_vector * vector = get_vector(self);
+    return ft_nd_to_ruby(vector->imag, vector->shape, vector->dims, NULL);
+}
+
+/**
+ * @brief Convert into the arrays used by the Array methods.
+ * @author placek@ragnarson.com
+ * @return An Array of real and imaginary parts (data.fft for data.to_complex_vector.fft.to_a).
+ */
+static VALUE vector_to_a(VALUE self)
+{
+    VALUE outArray = rb_ary_new2(2);
+
+    rb_ary_push(outArray, vector_real(self));
+    rb_ary_push(outArray, vector_imag(self));
+    return outArray;
+}
+
+/**
+ * @brief Convert into Complex numbers.
+ * @author placek@ragnarson.com
+ * @return Nested Ruby arrays of Complex numbers.
+ */
+static VALUE vector_to_complex_ruby(VALUE self)
+{
+    ft_vector * vector = get_vector(self);
+    return vector_to_complex(vector->real, vector->imag, vector->shape, vector->dims);
+}
+
+/**
+ * @brief Convert into a buffer of interleaved complex doubles.
+ * @author placek@ragnarson.com
+ * @params argc Number of arguments.
+ * @params argv Arguments (optional output String).
+ * @return The String.
+ */
+static VALUE vector_to_buffer(int argc, VALUE * argv, VALUE self)
+{
+    ft_vector * vector = get_vector(self);
+    VALUE output;
+
+    rb_scan_args(argc, argv, "01", &output);
+    output = ft_buffer_output(output, 2 * vector->size * sizeof(double));
+    ft_buffer_write_complex(RSTRING_PTR(output), vector->real, vector->imag, vector->size);
+    return output;
+}
+
+/**
+ * @brief Transform a vector in place.
+ * @author placek@ragnarson.com
+ * @param vector A vector.
+ * @param direction 1 - forward FFT, -1 - reverse FFT, 0 - FHT of both parts.
+ */
+static void vector_transform(ft_vector * vector, int direction)
+{
+    long strides[FT_MAX_DIMS], stride = 1;
+    int d;
+
+    for(d = vector->dims - 1; d >= 0; d--)
+    {
+        strides[d] = stride;
+        stride *= vector->shape[d];
+    }
+    if(direction == 0)
+    {
+        ft_transform_nd(vector->real, NULL, vector->shape, strides, vector->dims, 1);
+        ft_transform_nd(vector->imag, NULL, vector->shape, strides, vector->dims, 1);
+    }
+    else
+        ft_transform_nd(vector->real, vector->imag, vector->shape, strides, vector->dims, direction);
+}
+
+/**
+ * @brief Compute a forward FFT in place.
+ * @author placek@ragnarson.com
+ * @return The vector.
+ */
+static VALUE vector_fft_bang(VALUE self)
+{
+    vector_transform(get_vector(self), 1);
+    return self;
+}
+
+/**
+ * @brief Compute a reverse FFT in place.
+ * @author placek@ragnarson.com
+ * @return The vector.
+ */
+static VALUE vector_ifft_bang(VALUE self)
+{
+    vector_transform(get_vector(self), -1);
+    return self;
+}
+
+/**
+ * @brief Compute a FHT of real and imaginary parts in place.
+ * The transform is its own inverse.
+ * @author placek@ragnarson.com
+ * @return The vector.
+ */
+static VALUE vector_fht_bang(VALUE self)
+{
+    vector_transform(get_vector(self), 0);
+    return self;
+}
+
+/**
+ * @brief Compute a forward FFT.
+ * @author placek@ragnarson.com
+ * @return A new vector.
+ */
+static VALUE vector_fft(VALUE self)
+{
+    ft_vector * result;
+    VALUE copy = vector_copy(get_vector(self), &result);
+
+    vector_transform(result, 1);
+    return copy;
+}
+
+/**
+ * @brief Compute a reverse FFT.
+ * @author placek@ragnarson.com
+ * @return A new vector.
+ */
+static VALUE vector_ifft(VALUE self)
+{
+    ft_vector * result;
+    VALUE copy = vector_copy(get_vector(self), &result);
+
+    vector_transform(result, -1);
+    return copy;
+}
+
+/**
+ * @brief Compute a FHT of real and imaginary parts.
+ * @author placek@ragnarson.com
+ * @return A new vector.
+ */
+static VALUE vector_fht(VALUE self)
+{
+    ft_vector * result;
+    VALUE copy = vector_copy(get_vector(self), &result);
+
+    vector_transform(result, 0);
+    return copy;
+}
+
+/**
+ * @brief Multiply a vector in place.
+ * @author placek@ragnarson.com
+ * @param vector A vector.
+ * @param other A ComplexVector of the same shape (elementwise product), a Complex or a real number.
+ */
+static void vector_multiply(ft_vector * vector, VALUE other)
+{
+    const ft_vector * factor;
+    double factor_real, factor_imag, temp;
+    long i;
+    int d;
+
+    if(rb_typeddata_is_kind_of(other, &vector_type))
+    {
+        factor = get_vector(other);
+        if(factor->dims != vector->dims)
+            rb_raise(rb_eArgError, "vectors should have the same shape");
+        for(d = 0; d < vector->dims; d++)
+            if(factor->shape[d] != vector->shape[d])
+                rb_raise(rb_eArgError, "vectors should have the same shape");
+        for(i = 0; i < vector->size; i++)
+        {
+            temp = vector->real[i] * factor->real[i] - vector->imag[i] * factor->imag[i];
+            vector->imag[i] = vector->real[i] * factor->imag[i] + vector->imag[i] * factor->real[i];
+            vector->real[i] = temp;
+        }
+        return;
+    }
+
+    if(RB_TYPE_P(other, T_COMPLEX))
+    {
+        factor_real = NUM2DBL(rb_funcall(other, id_real, 0));
+        factor_imag = NUM2DBL(rb_funcall(other, id_imaginary, 0));
+    }
+    else
+    {
+        factor_real = NUM2DBL(other);
+        factor_imag = 0.0;
+    }
+    if(factor_imag == 0.0)
+    {
+        for(i = 0; i < vector->size; i++)
+        {
+            vector->real[i] *= factor_real;
+            vector->imag[i] *= factor_real;
+        }
+        return;
+    }
+    for(i = 0; i < vector->size; i++)
+    {
+        temp = vector->real[i] * factor_real - vector->imag[i] * factor_imag;
+        vector->imag[i] = vector->real[i] * factor_imag + vector->imag[i] * factor_real;
+        vector->real[i] = temp;
+    }
+}
+
+/**
+ * @brief Multiply in place.
+ * @see vector_multiply()
+ * @author placek@ragnarson.com
+ * @params other A ComplexVector of the same shape, a Complex or a real number.
+ * @return The vector.
+ */
+static VALUE vector_mul_bang(VALUE self, VALUE other)
+{
+    vector_multiply(get_vector(self), other);
+    return self;
+}
+
+/**
+ * @brief Multiply.
+ * v * w is the elementwise product of vectors of the same shape, v * 2.0
+ * and v * Complex(0, 1) scale every value.
+ * @see vector_multiply()
+ * @author placek@ragnarson.com
+ * @params other A ComplexVector of the same shape, a Complex or a real number.
+ * @return A new vector.
+ */
+static VALUE vector_mul(VALUE self, VALUE other)
+{
+    ft_vector * result;
+    VALUE copy = vector_copy(get_vector(self), &result);
+
+    vector_multiply(result, other);
+    return copy;
+}
+
+/**
+ * @brief Conjugate in place.
+ * @author placek@ragnarson.com
+ * @return The vector.
+ */
+static VALUE vector_conj_bang(VALUE self)
+{
+    ft_vector * vector = get_vector(self);
+    long i;
+
+    for(i = 0; i < vector->size; i++)
+        vector->imag[i] = -vector->imag[i];
+    return self;
+}
+
+/**
+ * @brief Conjugate.
+ * @author placek@ragnarson.com
+ * @return A new vector.
+ */
+static VALUE vector_conj(VALUE self)
+{
+    ft_vector * result;
+    VALUE copy = vector_copy(get_vector(self), &result);
+
+    return vector_conj_bang(copy);
+}
+
+/**
+ * @brief Get magnitudes.
+ * @author placek@ragnarson.com
+ * @return A new vector of magnitudes (with zero imaginary parts).
+ */
+static VALUE vector_magnitude(VALUE self)
+{
+    ft_vector * vector = get_vector(self), * result;
+    VALUE output = vector_new(vector->shape, vector->dims, &result);
+
+    ft_simd()->magnitude(vector->real, vector->imag, result->real, vector->size);
+    memset(result->imag, 0, result->size * sizeof(double));
+    return output;
+}
+
+/**
+ * @brief Get phases.
+ * Phases are the arguments atan2(imag, real) in (-pi, pi]; unlike
+ * Array#phase, which keeps atan2(real, imag) for compatibility.
+ * @author placek@ragnarson.com
+ * @return A new vector of phases (with zero imaginary parts).
+ */
+static VALUE vector_phase(VALUE self)
+{
+    ft_vector * vector = get_vector(self), * result;
+    VALUE output = vector_new(vector->shape, vector->dims, &result);
+    long i;
+
+    for(i = 0; i < vector->size; i++)
+        result->real[i] = atan2(vector->imag[i], vector->real[i]);
+    memset(result->imag, 0, result->size * sizeof(double));
+    return output;
+}
+
+/**
+ * @brief Move the zero frequency to the center in place.
+ * @author placek@ragnarson.com
+ * @return The vector.
+ */
+static VALUE vector_fftshift_bang(VALUE self)
+{
+    ft_vector * vector = get_vector(self);
+
+    ft_shift(vector->real, vector->shape, vector->dims, FALSE);
+    ft_shift(vector->imag, vector->shape, vector->dims, FALSE);
+    return self;
+}
+
+/**
+ * @brief Undo fftshift in place.
+ * @author placek@ragnarson.com
+ * @return The vector.
+ */
+static VALUE vector_ifftshift_bang(VALUE self)
+{
+    ft_vector * vector = get_vector(self);
+
+    ft_shift(vector->real, vector->shape, vector->dims, TRUE);
+    ft_shift(vector->imag, vector->shape, vector->dims, TRUE);
+    return self;
+}
+
+/**
+ * @brief Move the zero frequency to the center.
+ * @author placek@ragnarson.com
+ * @return A new vector.
+ */
+static VALUE vector_fftshift(VALUE self)
+{
+    ft_vector * result;
+    VALUE copy = vector_copy(get_vector(self), &result);
+
+    return vector_fftshift_bang(copy);
+}
+
+/**
+ * @brief Undo fftshift.
+ * @author placek@ragnarson.com
+ * @return A new vector.
+ */
+static VALUE vector_ifftshift(VALUE self)
+{
+    ft_vector * result;
+    VALUE copy = vector_copy(get_vector(self), &result);
+
+    return vector_ifftshift_bang(copy);
+}
+
+/**
+ * @brief Describe a vector.
+ * @author placek@ragnarson.com
+ * @return A String with the class and the shape.
+ */
+static VALUE vector_inspect(VALUE self)
+{
+    return rb_sprintf("#<%"PRIsVALUE" shape=%"PRIsVALUE">", rb_class_name(CLASS_OF(self)), vector_get_shape(self));
+}
+
+/**
+ * @brief Convert complex data into a vector.
+ * @author placek@ragnarson.com
+ * @params self A Ruby input data array (arrays of real and imaginary parts of the same shape).
+ * @return A new ComplexVector (nil for invalid data).
+ */
+static VALUE to_complex_vector(VALUE self)
+{
+    long shape[FT_MAX_DIMS], imag_shape[FT_MAX_DIMS];
+    int d, dims;
+    VALUE * parts;
+
+    Check_Type(self, T_ARRAY);
+    if(RARRAY_LEN(self) != 2)
+        return Qnil;
+    parts = RARRAY_PTR(self);
+    dims = ft_nd_shape(parts[0], shape);
+    if(dims == 0 || ft_nd_shape(parts[1], imag_shape) != dims)
+        return Qnil;
+    for(d = 0; d < dims; d++)
+        if(shape[d] != imag_shape[d])
+            return Qnil;
+
+    return rb_class_new_instance(2, parts, cComplexVector);
+}
+
+/**
+ * @brief Define the ComplexVector class.
+ * @author placek@ragnarson.com
+ */
+void Init_complex_vector(void)
+{
+    id_real = rb_intern("real");
+    id_imaginary = rb_intern("imaginary");
+
+    cComplexVector = rb_define_class_under(FT, "ComplexVector", rb_cObject);
+    rb_define_alloc_func(cComplexVector, vector_alloc);
+    rb_define_method(cComplexVector, "initialize", vector_initialize, -1);
+    rb_define_method(cComplexVector, "initialize_copy", vector_initialize_copy, 1);
+    rb_define_singleton_method(cComplexVector, "zeros", vector_zeros, -1);
+    rb_define_singleton_method(cComplexVector, "from_buffer", vector_from_buffer, -1);
+    rb_define_method(cComplexVector, "shape", vector_get_shape, 0);
+    rb_define_method(cComplexVector, "size", vector_size, 0);
+    rb_define_method(cComplexVector, "length", vector_size, 0);
+    rb_define_method(cComplexVector, "[]", vector_at, 1);
+    rb_define_method(cComplexVector, "real", vector_real, 0);
+    rb_define_method(cComplexVector, "imag", vector_imag, 0);
+    rb_define_method(cComplexVector, "to_a", vector_to_a, 0);
+    rb_define_method(cComplexVector, "to_complex", vector_to_complex_ruby, 0);
+    rb_define_method(cComplexVector, "to_buffer", vector_to_buffer, -1);
+    rb_define_method(cComplexVector, "fft", vector_fft, 0);
+    rb_define_method(cComplexVector, "ifft", vector_ifft, 0);
+    rb_define_method(cComplexVector, "fht", vector_fht, 0);
+    rb_define_method(cComplexVector, "fft!", vector_fft_bang, 0);
+    rb_define_method(cComplexVector, "ifft!", vector_ifft_bang, 0);
+    rb_define_method(cComplexVector, "fht!", vector_fht_bang, 0);
+    rb_define_method(cComplexVector, "*", vector_mul, 1);
+    rb_define_method(cComplexVector, "mul!", vector_mul_bang, 1);
+    rb_define_method(cComplexVector, "scale", vector_mul, 1);
+    rb_define_method(cComplexVector, "scale!", vector_mul_bang, 1);
+    rb_define_method(cComplexVector, "conj", vector_conj, 0);
+    rb_define_method(cComplexVector, "conj!", vector_conj_bang, 0);
+    rb_define_method(cComplexVector, "magnitude", vector_magnitude, 0);
+    rb_define_method(cComplexVector, "phase", vector_phase, 0);
+    rb_define_method(cComplexVector, "fftshift", vector_fftshift, 0);
+    rb_define_method(cComplexVector, "ifftshift", vector_ifftshift, 0);
+    rb_define_method(cComplexVector, "fftshift!", vector_fftshift_bang, 0);
+    rb_define_method(cComplexVector, "ifftshift!", vector_ifftshift_bang, 0);
+    rb_define_method(cComplexVector, "inspect", vector_inspect, 0);
+
+    rb_define_method(FT, "to_complex_vector", to_complex_vector, 0);
+}
@@ -0,0 +1,513 @@
+/**
+ * @file convolution.c
+ * @brief Convolution and cross-correlation of real data.
+ * Both are computed by overlap-save: the input goes through blocks holding
+ * the last kernel length - 1 samples of the previous block followed by new
+ * samples. Short kernels are applied directly to a block, longer ones by
+ * multiplying the spectrum of the block by the spectrum of the kernel,
+ * which is computed once. FT::Convolver keeps the blocks between calls, so
+ * a long signal can be filtered in chunks in constant memory; its calls are
+ * serialized by a mutex, since large ones run without the GVL.
+ * @author placek@ragnarson.com
+ */
+#include "frequency_transformations.h"
+
+#ifndef FT_DIRECT_CONVOLUTION
+#define FT_DIRECT_CONVOLUTION 32
+#endif
+
+#define DIRECT_BLOCK 1024
+
+static VALUE cConvolver;
+static ID id_lock;
+
+/**
+ * @brief A convolution by a fixed kernel.
+ */
+typedef struct
+{
+    long kernel_length;
+    long block;
+    long step;
+    long filled;
+    int direct;
+    double * kernel;
+    double * buffer;
+    double * work;
+    double * kernel_spectrum[2];
+    double * spectrum[2];
+    ft_real_plan * forward;
+    ft_real_plan * inverse;
+} ft_convolver;
+
+/**
+ * @brief Create a convolver.
+ * Kernels up to FT_DIRECT_CONVOLUTION values are applied directly. Longer
+ * ones use FFT blocks of a power of 2 at least four times the kernel, or
+ * just long enough for the whole result when the length of the signal is
+ * known and short.
+ * @author placek@ragnarson.com
+ * @param kernel Values of the kernel.
+ * @param kernel_length Length of the kernel.
+ * @param signal_length Length of the signal (0 for a stream).
+ * @return A new convolver (to be released with convolver_free()).
+ */
+static ft_convolver * convolver_create(const double * kernel, long kernel_length, long signal_length)
+{
+    long i, block, bins;
+    ft_convolver * conv = calloc(1, sizeof(ft_convolver));
+
+    conv->kernel_length = kernel_length;
+    conv->kernel = malloc(kernel_length * sizeof(double));
+    for(i = 0; i < kernel_length; i++)
+        conv->kernel[i] = kernel[i];
+
+    if(kernel_length <= FT_DIRECT_CONVOLUTION)
+    {
+        conv->direct = TRUE;
+        conv->block = kernel_length - 1 + DIRECT_BLOCK;
+    }
+    else
+    {
+        for(block = 64; block < 4 * kernel_length; block <<= 1);
+        if(signal_length > 0)
+            while(block / 2 >= signal_length + kernel_length - 1)
+                block >>= 1;
+        conv->block = block;
+        bins = block / 2 + 1;
+        conv->forward = ft_real_plan_create(block, 1);
+        conv->inverse = ft_real_plan_create(block, -1);
+        conv->work = malloc(block * sizeof(double));
+        conv->spectrum[0] = malloc(bins * sizeof(double));
+        conv->spectrum[1] = malloc(bins * sizeof(double));
+        conv->kernel_spectrum[0] = malloc(bins * sizeof(double));
+        conv->kernel_spectrum[1] = malloc(bins * sizeof(double));
+
+        // the spectrum of the kernel padded to the block
+        for(i = 0; i < block; i++)
+            conv->work[i] = i < kernel_length ? kernel[i] : 0.0;
+        ft_real_plan_forward(conv->forward, conv->work, conv->kernel_spectrum[0], conv->kernel_spectrum[1]);
+    }
+
+    conv->step = conv->block - kernel_length + 1;
+    conv->buffer = calloc(conv->block, sizeof(double));
+    return conv;
+}
+
+/**
+ * @brief Release a convolver.
+ * @author placek@ragnarson.com
+ */
+static void convolver_free(ft_convolver * conv)
+{
+    if(!conv)
+        return;
+    ft_real_plan_free(conv->forward);
+    ft_real_plan_free(conv->inverse);
+    free(conv->kernel);
+    free(conv->buffer);
+    free(conv->work);
+    free(conv->spectrum[0]);
+    free(conv->spectrum[1]);
+    free(conv->kernel_spectrum[0]);
+    free(conv->kernel_spectrum[1]);
+    free(conv);
+}
+
+/**
+ * @brief Compute the outputs of the new samples of the block.
+ * The last kernel length - 1 samples are moved to the front afterwards.
+ * @author placek@ragnarson.com
+ * @param conv A convolver.
+ * @param out Place for conv->filled outputs.
+ */
+static void convolver_block(ft_convolver * conv, double * out)
+{
+    long i, k, history = conv->kernel_length - 1;
+    double sum, re, im;
+    const double * x;
+
+    if(conv->direct)
+    {
+        for(i = 0; i < conv->filled; i++)
+        {
+            x = conv->buffer + history + i;
+            sum = 0.0;
+            for(k = 0; k < conv->kernel_length; k++)
+                sum += conv->kernel[k] * x[-k];
+            out[i] = sum;
+        }
+    }
+    else
+    {
+        for(i = history + conv->filled; i < conv->block; i++)
+            conv->buffer[i] = 0.0;
+        ft_real_plan_forward(conv->forward, conv->buffer, conv->spectrum[0], conv->spectrum[1]);
+        for(k = 0; k <= conv->block / 2; k++)
+        {
+            re = conv->spectrum[0][k] * conv->kernel_spectrum[0][k] - conv->spectrum[1][k] * conv->kernel_spectrum[1][k];
+            im = conv->spectrum[0][k] * conv->kernel_spectrum[1][k] + conv->spectrum[1][k] * conv->kernel_spectrum[0][k];
+            conv->spectrum[0][k] = re;
+            conv->spectrum[1][k] = im;
+        }
+        ft_real_plan_inverse(conv->inverse, conv->spectrum[0], conv->spectrum[1], conv->work);
+        for(i = 0; i < conv->filled; i++)
+            out[i] = conv->work[history + i];
+    }
+
+    // keep the history for the next block
+    for(i = 0; i < history; i++)
+        conv->buffer[i] = conv->buffer[conv->filled + i];
+    conv->filled = 0;
+}
+
+/**
+ * @brief Feed samples to a convolver.
+ * @author placek@ragnarson.com
+ * @param conv A convolver.
+ * @param values New samples.
+ * @param count Number of new samples.
+ * @param out Place for outputs (at least count + conv->step values).
+ * @return Number of outputs of the blocks completed by the samples.
+ */
+static long convolver_feed(ft_convolver * conv, const double * values, long count, double * out)
+{
+    long i, written = 0, history = conv->kernel_length - 1;
+
+    for(i = 0; i < count; i++)
+    {
+        conv->buffer[history + conv->filled++] = values[i];
+        if(conv->filled == conv->step)
+        {
+            convolver_block(conv, out + written);
+            written += conv->step;
+        }
+    }
+    return written;
+}
+
+/**
+ * @brief Finish a stream.
+ * Feeds kernel length - 1 zeros to get the tail of the convolution and
+ * computes the partial block. The convolver starts over afterwards.
+ * @author placek@ragnarson.com
+ * @param conv A convolver.
+ * @param out Place for outputs (at least kernel length + conv->step values).
+ * @return Number of outputs.
+ */
+static long convolver_flush(ft_convolver * conv, double * out)
+{
+    long i, written = 0, history = conv->kernel_length - 1;
+
+    for(i = 0; i < history; i++)
+    {
+        conv->buffer[history + conv->filled++] = 0.0;
+        if(conv->filled == conv->step)
+        {
+            convolver_block(conv, out + written);
+            written += conv->step;
+        }
+    }
+    if(conv->filled > 0)
+    {
+        written += conv->filled;
+        convolver_block(conv, out + written - conv->filled);
+    }
+    for(i = 0; i < conv->block; i++)
+        conv->buffer[i] = 0.0;
+    return written;
+}
+
+/**
+ * @brief A call of a convolver on data held in C memory.
+ */
+typedef struct
+{
+    ft_convolver * conv;
+    const double * values;
+    long count;
+    int flush;
+    double * out;
+    long written;
+} convolver_call;
+
+static void * convolver_call_run(void * data)
+{
+    convolver_call * call = data;
+
+    call->written = convolver_feed(call->conv, call->values, call->count, call->out);
+    if(call->flush)
+        call->written += convolver_flush(call->conv, call->out + call->written);
+    return NULL;
+}
+
+/**
+ * @brief Feed samples to a convolver, releasing the GVL for large calls.
+ * @author placek@ragnarson.com
+ * @return A Ruby Array with the outputs.
+ */
+static VALUE convolver_run(ft_convolver * conv, const double * values, long count, int flush)
+{
+    convolver_call call;
+    VALUE outArray;
+
+    call.conv = conv;
+    call.values = values;
+    call.count = count;
+    call.flush = flush;
+    call.out = malloc((count + conv->kernel_length + 2 * conv->step) * sizeof(double));
+    ft_without_gvl(convolver_call_run, &call,
+        conv->direct ? count * conv->kernel_length : count * 64);
+    outArray = real_to_ruby(call.out, call.written);
+    free(call.out);
+
+    return outArray;
+}
+
+/**
+ * @brief Convert a Ruby Array of numbers into a C array.
+ * @author placek@ragnarson.com
+ * @param inArray A Ruby Array.
+ * @param reverse TRUE to reverse the order.
+ * @return A new C array (to be released with free()).
+ */
+static double * convolution_values(VALUE inArray, int reverse)
+{
+    long i, length = RARRAY_LEN(inArray);
+    double * values = malloc((length + 1) * sizeof(double));
+
+    for(i = 0; i < length; i++)
+        values[reverse ? length - 1 - i : i] = NUM2DBL(RARRAY_PTR(inArray)[i]);
+    return values;
+}
+
+/**
+ * @brief Compute the full convolution of two arrays of real data.
+ * The shorter array is used as the kernel.
+ * @author placek@ragnarson.com
+ * @return A Ruby Array of length signal + kernel - 1 (nil for empty data).
+ */
+static VALUE perform_convolution(VALUE self, VALUE kernel, int reverse)
+{
+    long length, kernel_length;
+    double * values[2];
+    ft_convolver * conv;
+    VALUE outArray;
+
+    Check_Type(self, T_ARRAY);
+    Check_Type(kernel, T_ARRAY);
+    length = RARRAY_LEN(self);
+    kernel_length = RARRAY_LEN(kernel);
+    if(length < 1 || kernel_length < 1)
+        return Qnil;
+
+    values[0] = convolution_values(self, FALSE);
+    values[1] = convolution_values(kernel, reverse);
+    if(kernel_length <= length)
+    {
+        conv = convolver_create(values[1], kernel_length, length);
+        outArray = convolver_run(conv, values[0], length, TRUE);
+    }
+    else
+    {
+        conv = convolver_create(values[0], length, kernel_length);
+        outArray = convolver_run(conv, values[1], kernel_length, TRUE);
+    }
+
+    // no memory leaks
+    convolver_free(conv);
+    free(values[0]);
+    free(values[1]);
+
+    return outArray;
+}
+
+/**
+ * @brief Compute a convolution.
+ * data.convolve(kernel)[n] is the sum of data[m] * kernel[n - m].
+ * @author placek@ragnarson.com
+ * @params self A Ruby input data array (real numbers).
+ * @params kernel A Ruby array of real numbers.
+ * @return The output Ruby Array of length data + kernel - 1.
+ */
+static VALUE convolve(VALUE self, VALUE kernel)
+{
+    return perform_convolution(self, kernel, FALSE);
+}
+
+/**
+ * @brief Compute a cross-correlation.
+ * data.correlate(kernel)[n] is the sum of data[m + n - (kernel.length - 1)]
+ * * kernel[m], so the lag 0 is at kernel.length - 1.
+ * @author placek@ragnarson.com
+ * @params self A Ruby input data array (real numbers).
+ * @params kernel A Ruby array of real numbers.
+ * @return The output Ruby Array of length data + kernel - 1.
+ */
+static VALUE correlate(VALUE self, VALUE kernel)
+{
+    return perform_convolution(self, kernel, TRUE);
+}
+
+static void convolver_type_free(void * ptr)
+{
+    convolver_free((ft_convolver *)ptr);
+}
+
+static size_t convolver_memsize(const void * ptr)
+{
+    const ft_convolver * conv = ptr;
+
+    if(!conv)
+        return 0;
+    return sizeof(ft_convolver) + (conv->kernel_length + 4 * conv->block) * sizeof(double);
+}
+
+static const rb_data_type_t convolver_type = {
+    "FrequencyTransformations::Convolver",
+    { NULL, convolver_type_free, convolver_memsize, },
+    NULL, NULL, RUBY_TYPED_FREE_IMMEDIATELY
+};
+
+static VALUE convolver_alloc(VALUE klass)
+{
+    return TypedData_Wrap_Struct(klass, &convolver_type, NULL);
+}
+
+static ft_convolver * get_convolver(VALUE self)
+{
+    ft_convolver * conv;
+    TypedData_Get_Struct(self, ft_convolver, &convolver_type, conv);
+    if(!conv)
+        rb_raise(rb_eRuntimeError, "uninitialized convolver");
+    return conv;
+}
+
+/**
+ * @brief A call of a FT::Convolver made while holding its mutex.
+ */
+typedef struct
+{
+    VALUE self;
+    const double * values;
+    long count;
+    int flush;
+} convolver_locked_call;
+
+static VALUE convolver_locked_run(VALUE data)
+{
+    convolver_locked_call * call = (convolver_locked_call *)data;
+
+    return convolver_run(get_convolver(call->self), call->values, call->count, call->flush);
+}
+
+/**
+ * @brief Feed samples to a FT::Convolver holding its mutex.
+ * The blocks of the stream are shared, so calls from other threads wait
+ * (the GVL is released during large ones).
+ * @author placek@ragnarson.com
+ * @return A Ruby Array with the outputs.
+ */
+static VALUE convolver_synchronize(VALUE self, const double * values, long count, int flush)
+{
+    convolver_locked_call call;
+
+    get_convolver(self);
+    call.self = self;
+    call.values = values;
+    call.count = count;
+    call.flush = flush;
+    return rb_mutex_synchronize(rb_ivar_get(self, id_lock), convolver_locked_run, (VALUE)&call);
+}
+
+/**
+ * @brief Initialize a convolver.
+ * Convolver.new(kernel) computes the spectrum of the kernel once; use
+ * kernel.reverse for a streaming cross-correlation.
+ * @author placek@ragnarson.com
+ * @params self A convolver being initialized.
+ * @params kernel A Ruby array of real numbers.
+ * @return The convolver.
+ */
+static VALUE convolver_initialize(VALUE self, VALUE kernel)
+{
+    double * values;
+
+    Check_Type(kernel, T_ARRAY);
+    if(RARRAY_LEN(kernel) < 1)
+        rb_raise(rb_eArgError, "kernel should not be empty");
+    if(DATA_PTR(self))
+        rb_raise(rb_eRuntimeError, "convolver already initialized");
+
+    values = convolution_values(kernel, FALSE);
+    DATA_PTR(self) = convolver_create(values, RARRAY_LEN(kernel), 0);
+    rb_ivar_set(self, id_lock, rb_mutex_new());
+    free(values);
+
+    return self;
+}
+
+/**
+ * @brief Feed samples to a convolver.
+ * Outputs are returned block by block, so there may be fewer (or more) of
+ * them than samples; all of them are out after flush.
+ * @author placek@ragnarson.com
+ * @params self A convolver.
+ * @params samples An Array of real samples.
+ * @return An Array of outputs completed by the samples.
+ */
+static VALUE convolver_push(VALUE self, VALUE samples)
+{
+    double * values;
+    VALUE outArray;
+
+    get_convolver(self);
+    Check_Type(samples, T_ARRAY);
+    values = convolution_values(samples, FALSE);
+    outArray = convolver_synchronize(self, values, RARRAY_LEN(samples), FALSE);
+    free(values);
+
+    return outArray;
+}
+
+/**
+ * @brief Finish a stream.
+ * @author placek@ragnarson.com
+ * @params self A convolver.
+ * @return An Array of the remaining outputs (the convolver starts over).
+ */
+static VALUE convolver_flush_ruby(VALUE self)
+{
+    return convolver_synchronize(self, NULL, 0, TRUE);
+}
+
+/**
+ * @brief Get the length of the kernel.
+ * @author placek@ragnarson.com
+ * @params self A convolver.
+ * @return Number of values of the kernel.
+ */
+static VALUE convolver_length(VALUE self)
+{
+    return LONG2NUM(get_convolver(self)->kernel_length);
+}
+
+/**
+ * @brief Define convolution methods and the FrequencyTransformations::Convolver class.
+ * @author placek@ragnarson.com
+ */
+void Init_convolution(void)
+{
+    id_lock = rb_intern("lock");
+
+    rb_define_method(FT, "convolve", convolve, 1);
+    rb_define_method(FT, "correlate", correlate, 1);
+
+    cConvolver = rb_define_class_under(FT, "Convolver", rb_cObject);
+    rb_define_alloc_func(cConvolver, convolver_alloc);
+    rb_define_method(cConvolver, "initialize", convolver_initialize, 1);
+    rb_define_method(cConvolver, "push", convolver_push, 1);
+    rb_define_method(cConvolver, "<<", convolver_push, 1);
+    rb_define_method(cConvolver, "flush", convolver_flush_ruby, 0);
+    rb_define_method(cConvolver, "kernel_length", convolver_length, 0);
+}
@@ -0,0 +1,744 @@
+/**
+ * @file dct.c
+ * @brief Discrete cosine and sine transforms of types II, III and IV.
+ * All the transforms are orthonormal, so DCT-III is the inverse of DCT-II,
+ * and DCT-IV and DST-IV are their own inverses. They are computed in
+ * O(N log N) by the standard reorderings on top of the FFT plans:
+ * DCT-II reorders the data (even samples first, odd ones reversed after
+ * them) and rotates the bins of one real FFT of the same length, DCT-III
+ * runs the same steps backwards with the inverse real FFT, DCT-IV of even
+ * lengths packs pairs of samples into a complex FFT of half the length
+ * (odd lengths use a complex FFT of twice the length). The sine transforms
+ * are cosine transforms of the data with alternated signs and reversed
+ * order. Short transforms (8x8 blocks of images) are plain products with a
+ * precomputed matrix, which is faster than any FFT at that size.
+ * @author placek@ragnarson.com
+ */
+#include "frequency_transformations.h"
+
+/**
+ * @brief Longest transform computed as a product with a matrix.
+ */
+#define DCT_DIRECT 16
+
+static ID ids[3];
+
+/**
+ * @brief A precomputed cosine or sine transform of one length.
+ */
+typedef struct
+{
+    long length;
+    int type;
+    int sine;
+    double * matrix;
+    ft_real_plan * real;
+    ft_plan * complex;
+    double * factor[4];
+    double * work[3];
+} dct_plan;
+
+/**
+ * @brief A cosine or sine transform of data held in C memory.
+ */
+typedef struct
+{
+    double * values;
+    long rows;
+    long columns;
+    long block;
+    int type;
+    int sine;
+} dct_call;
+
+/**
+ * @brief Compute an element of the matrix of a transform.
+ * @author placek@ragnarson.com
+ * @param type Type of the transform (2, 3 or 4).
+ * @param sine TRUE for DST, FALSE for DCT.
+ * @param k Index of the output value.
+ * @param n Index of the input value.
+ * @param length Length of the transform.
+ * @return The element.
+ */
+static double dct_element(int type, int sine, long k, long n, long length)
+{
+    double full = sqrt(2.0 / (double)length), half = sqrt(1.0 / (double)length), t;
+
+    // type III is the transpose of type II
+    if(type == 3)
+    {
+        t = k;
+        k = n;
+        n = (long)t;
+    }
+    if(type == 4)
+    {
+        t = M_PI * (2 * n + 1) * (2 * k + 1) / (4.0 * length);
+        return full * (sine ? sin(t) : cos(t));
+    }
+    if(sine)
+        return (k == length - 1 ? half : full) * sin(M_PI * (k + 1) * (2 * n + 1) / (2.0 * length));
+    return (k == 0 ? half : full) * cos(M_PI * k * (2 * n + 1) / (2.0 * length));
+}
+
+/**
+ * @brief Prepare a transform.
+ * @author placek@ragnarson.com
+ * @param length Length of the transform.
+ * @param type Type of the transform (2, 3 or 4).
+ * @param sine TRUE for DST, FALSE for DCT.
+ * @return A new plan (free it with dct_plan_free()).
+ */
+static dct_plan * dct_plan_create(long length, int type, int sine)
+{
+    dct_plan * plan = calloc(1, sizeof(dct_plan));
+    long k, n, half = length / 2;
+    double arg;
+
+    plan->length = length;
+    plan->type = type;
+    plan->sine = sine;
+    plan->work[0] = malloc(2 * length * sizeof(double) + sizeof(double));
+    plan->work[1] = malloc(2 * length * sizeof(double) + sizeof(double));
+    plan->work[2] = malloc(2 * length * sizeof(double) + sizeof(double));
+
+    if(length <= DCT_DIRECT)
+    {
+        plan->matrix = malloc(length * length * sizeof(double));
+        for(k = 0; k < length; k++)
+            for(n = 0; n < length; n++)
+                plan->matrix[k * length + n] = dct_element(type, sine, k, n, length);
+        return plan;
+    }
+
+    if(type != 4)
+    {
+        // exp(-i pi k / 2N) rotating the bins of the reordered data
+        plan->real = ft_real_plan_create(length, type == 2 ? 1 : -1);
+        plan->factor[0] = malloc(length * sizeof(double));
+        plan->factor[1] = malloc(length * sizeof(double));
+        for(k = 0; k < length; k++)
+        {
+            arg = M_PI * k / (2.0 * length);
+            plan->factor[0][k] = cos(arg);
+            plan->factor[1][k] = sin(arg);
+        }
+        return plan;
+    }
+
+    if(length % 2 == 0)
+    {
+        // exp(-i pi (4n + 1) / 4N) before and exp(-i pi k / N) after the FFT of half the length
+        plan->complex = ft_plan_create(half, 1);
+        for(k = 0; k < 4; k++)
+            plan->factor[k] = malloc(half * sizeof(double));
+        for(k = 0; k < half; k++)
+        {
+            arg = M_PI * (4 * k + 1) / (4.0 * length);
+            plan->factor[0][k] = cos(arg);
+            plan->factor[1][k] = -sin(arg);
+            arg = M_PI * k / (double)length;
+            plan->factor[2][k] = cos(arg);
+            plan->factor[3][k] = -sin(arg);
+        }
+        return plan;
+    }
+
+    // exp(-i pi n / 2N) before and exp(-i pi (2k + 1) / 4N) after the FFT of twice the length
+    plan->complex = ft_plan_create(2 * length, 1);
+    for(k = 0; k < 4; k++)
+        plan->factor[k] = malloc(length * sizeof(double));
+    for(k = 0; k < length; k++)
+    {
+        arg = M_PI * k / (2.0 * length);
+        plan->factor[0][k] = cos(arg);
+        plan->factor[1][k] = -sin(arg);
+        arg = M_PI * (2 * k + 1) / (4.0 * length);
+        plan->factor[2][k] = cos(arg);
+        plan->factor[3][k] = -sin(arg);
+    }
+    return plan;
+}
+
+static void dct_plan_free(dct_plan * plan)
+{
+    int i;
+
+    if(!plan)
+        return;
+    ft_real_plan_free(plan->real);
+    ft_plan_free(plan->complex);
+    free(plan->matrix);
+    for(i = 0; i < 4; i++)
+        free(plan->factor[i]);
+    for(i = 0; i < 3; i++)
+        free(plan->work[i]);
+    free(plan);
+}
+
+/**
+ * @brief Compute a DCT-II in place by a real FFT of the reordered data.
+ * X[k] = Re(exp(-i pi k / 2N) V[k]), where V is the FFT of the even
+ * samples followed by the odd samples in reverse order.
+ * @author placek@ragnarson.com
+ * @param plan A plan of type 2.
+ * @param values Processing data.
+ */
+static void dct2_fft(const dct_plan * plan, double * values)
+{
+    long k, n = plan->length, half = n / 2;
+    double * v = plan->work[0], * real = plan->work[1], * imag = plan->work[2];
+    double * c = plan->factor[0], * s = plan->factor[1];
+    double full = sqrt(2.0 / (double)n);
+
+    for(k = 0; k < (n + 1) / 2; k++)
+        v[k] = values[2 * k];
+    for(k = 0; k < half; k++)
+        v[n - 1 - k] = values[2 * k + 1];
+
+    ft_real_plan_forward(plan->real, v, real, imag);
+
+    // the upper bins are the complex conjugates of the lower ones
+    values[0] = real[0] * sqrt(1.0 / (double)n);
+    for(k = 1; k <= half; k++)
+        values[k] = (real[k] * c[k] + imag[k] * s[k]) * full;
+    for(; k < n; k++)
+        values[k] = (real[n - k] * c[k] - imag[n - k] * s[k]) * full;
+}
+
+/**
+ * @brief Compute a DCT-III (the inverse DCT-II) in place by an inverse real FFT.
+ * The spectrum V[k] = exp(i pi k / 2N) (X[k] - i X[N - k]) of the
+ * unnormalized coefficients is transformed back and the data reordered.
+ * @author placek@ragnarson.com
+ * @param plan A plan of type 3.
+ * @param values Processing data.
+ */
+static void dct3_fft(const dct_plan * plan, double * values)
+{
+    long k, n = plan->length, half = n / 2;
+    double * v = plan->work[0], * real = plan->work[1], * imag = plan->work[2];
+    double * c = plan->factor[0], * s = plan->factor[1];
+    double full = sqrt((double)n / 2.0), x, y;
+
+    real[0] = values[0] * sqrt((double)n);
+    imag[0] = 0.0;
+    for(k = 1; k <= half; k++)
+    {
+        x = values[k] * full;
+        y = values[n - k] * full;
+        real[k] = x * c[k] + y * s[k];
+        imag[k] = x * s[k] - y * c[k];
+    }
+
+    ft_real_plan_inverse(plan->real, real, imag, v);
+
+    for(k = 0; k < (n + 1) / 2; k++)
+        values[2 * k] = v[k];
+    for(k = 0; k < half; k++)
+        values[2 * k + 1] = v[n - 1 - k];
+}
+
+/**
+ * @brief Compute a DCT-IV in place by a complex FFT.
+ * Even lengths pack x[2n] + i x[N - 1 - 2n] into N / 2 complex values,
+ * odd lengths take the real part of an FFT of twice the length.
+ * @author placek@ragnarson.com
+ * @param plan A plan of type 4.
+ * @param values Processing data.
+ */
+static void dct4_fft(const dct_plan * plan, double * values)
+{
+    long k, n = plan->length, half = n / 2;
+    double * real = plan->work[1], * imag = plan->work[2];
+    double * c = plan->factor[0], * s = plan->factor[1], * post_c = plan->factor[2], * post_s = plan->factor[3];
+    double full = sqrt(2.0 / (double)n), x, y;
+
+    if(n % 2 == 1)
+    {
+        for(k = 0; k < n; k++)
+        {
+            real[k] = values[k] * c[k];
+            imag[k] = values[k] * s[k];
+            real[n + k] = imag[n + k] = 0.0;
+        }
+        ft_plan_execute(plan->complex, real, imag);
+        for(k = 0; k < n; k++)
+            values[k] = (real[k] * post_c[k] - imag[k] * post_s[k]) * full;
+        return;
+    }
+
+    for(k = 0; k < half; k++)
+    {
+        x = values[2 * k];
+        y = values[n - 1 - 2 * k];
+        real[k] = x * c[k] - y * s[k];
+        imag[k] = x * s[k] + y * c[k];
+    }
+    ft_plan_execute(plan->complex, real, imag);
+    for(k = 0; k < half; k++)
+    {
+        x = real[k] * post_c[k] - imag[k] * post_s[k];
+        y = real[k] * post_s[k] + imag[k] * post_c[k];
+        values[2 * k] = x * full;
+        values[n - 1 - 2 * k] = -y * full;
+    }
+}
+
+/**
+ * @brief Reverse the order of values.
+ * @author placek@ragnarson.com
+ * @param values Processing data.
+ * @param length Length of data.
+ */
+static void dct_reverse(double * values, long length)
+{
+    long k;
+    double t;
+
+    for(k = 0; k < length / 2; k++)
+    {
+        t = values[k];
+        values[k] = values[length - 1 - k];
+        values[length - 1 - k] = t;
+    }
+}
+
+/**
+ * @brief Negate the values of odd indices.
+ * @author placek@ragnarson.com
+ * @param values Processing data.
+ * @param length Length of data.
+ */
+static void dct_alternate(double * values, long length)
+{
+    long k;
+
+    for(k = 1; k < length; k += 2)
+        values[k] = -values[k];
+}
+
+/**
+ * @brief Compute a transform in place.
+ * DST-II is DCT-II of the data with alternated signs in reverse order,
+ * DST-III and DST-IV are related the same way to DCT-III and DCT-IV.
+ * Uses the work memory of the plan.
+ * @author placek@ragnarson.com
+ * @param plan A plan of the transform.
+ * @param values Processing data (length of the plan).
+ */
+static void dct_execute(const dct_plan * plan, double * values)
+{
+    long k, j, n = plan->length;
+    double * out = plan->work[0], sum;
+
+    if(plan->matrix)
+    {
+        for(k = 0; k < n; k++)
+        {
+            for(j = 0, sum = 0.0; j < n; j++)
+                sum += plan->matrix[k * n + j] * values[j];
+            out[k] = sum;
+        }
+        memcpy(values, out, n * sizeof(double));
+        return;
+    }
+
+    if(plan->sine)
+    {
+        if(plan->type == 2)
+            dct_alternate(values, n);
+        else
+            dct_reverse(values, n);
+    }
+
+    switch(plan->type)
+    {
+        case 2: dct2_fft(plan, values); break;
+        case 3: dct3_fft(plan, values); break;
+        default: dct4_fft(plan, values); break;
+    }
+
+    if(plan->sine)
+    {
+        if(plan->type == 2)
+            dct_reverse(values, n);
+        else
+            dct_alternate(values, n);
+    }
+}
+
+/**
+ * @brief Transform every row of a matrix.
+ * @author placek@ragnarson.com
+ * @param plan A plan of the length of rows.
+ * @param values A row-major matrix.
+ * @param rows Number of rows.
+ */
+static void dct_rows(const dct_plan * plan, double * values, long rows)
+{
+    long j;
+
+    for(j = 0; j < rows; j++)
+        dct_execute(plan, values + j * plan->length);
+}
+
+/**
+ * @brief Compute a transform of a call (run without the GVL).
+ * One row is a one dimensional transform, more rows are transformed along
+ * both axes: all at once, or every block x block tile on its own.
+ * @author placek@ragnarson.com
+ * @param data A call (dct_call).
+ * @return NULL.
+ */
+static void * dct_run(void * data)
+{
+    dct_call * call = data;
+    long rows = call->rows, columns = call->columns, b = call->block, i, j, r;
+    double * values = call->values, * tile[2];
+    dct_plan * plan[2];
+
+    if(rows == 1)
+    {
+        plan[0] = dct_plan_create(columns, call->type, call->sine);
+        dct_execute(plan[0], values);
+        dct_plan_free(plan[0]);
+        return NULL;
+    }
+
+    if(!b)
+    {
+        plan[0] = dct_plan_create(columns, call->type, call->sine);
+        plan[1] = rows == columns ? plan[0] : dct_plan_create(rows, call->type, call->sine);
+        tile[0] = malloc(rows * columns * sizeof(double));
+        dct_rows(plan[0], values, rows);
+        transpose_blocked(values, tile[0], rows, columns);
+        dct_rows(plan[1], tile[0], columns);
+        transpose_blocked(tile[0], values, columns, rows);
+        free(tile[0]);
+        if(plan[1] != plan[0])
+            dct_plan_free(plan[1]);
+        dct_plan_free(plan[0]);
+        return NULL;
+    }
+
+    // tiles: rows of the tile, then rows of the transposed tile
+    plan[0] = dct_plan_create(b, call->type, call->sine);
+    tile[0] = malloc(b * b * sizeof(double));
+    tile[1] = malloc(b * b * sizeof(double));
+    for(i = 0; i < rows; i += b)
+        for(j = 0; j < columns; j += b)
+        {
+            for(r = 0; r < b; r++)
+                memcpy(tile[0] + r * b, values + (i + r) * columns + j, b * sizeof(double));
+            dct_rows(plan[0], tile[0], b);
+            transpose_blocked(tile[0], tile[1], b, b);
+            dct_rows(plan[0], tile[1], b);
+            transpose_blocked(tile[1], tile[0], b, b);
+            for(r = 0; r < b; r++)
+                memcpy(values + (i + r) * columns + j, tile[0] + r * b, b * sizeof(double));
+        }
+    free(tile[0]);
+    free(tile[1]);
+    dct_plan_free(plan[0]);
+
+    return NULL;
+}
+
+/**
+ * @brief Compute a transform of a call, releasing the GVL for large ones.
+ * @author placek@ragnarson.com
+ * @param call A call (dct_call).
+ */
+static void dct_perform(dct_call * call)
+{
+    ft_job job;
+
+    job.kind = FT_JOB_FFT;
+    job.length = call->rows * call->columns;
+    ft_without_gvl(dct_run, call, ft_job_work(&job));
+}
+
+/**
+ * @brief Read the options of a transform.
+ * @author placek@ragnarson.com
+ * @param options A Hash of keyword arguments (or nil).
+ * @param count Number of accepted options (type:, block: and precision: in this order).
+ * @param inverse TRUE for the inverse transform.
+ * @param call Place for the type and the block size.
+ * @return FT_FLOAT64 or FT_FLOAT32 (precision: option).
+ */
+static int dct_options(VALUE options, int count, int inverse, dct_call * call)
+{
+    VALUE values[3] = { Qundef, Qundef, Qundef };
+
+    call->type = 2;
+    call->block = 0;
+    if(!NIL_P(options))
+        rb_get_kwargs(options, ids, 0, count, values);
+    if(values[0] != Qundef)
+    {
+        call->type = NUM2INT(values[0]);
+        if(call->type < 2 || call->type > 4)
+            rb_raise(rb_eArgError, "type should be 2, 3 or 4");
+    }
+    if(values[1] != Qundef && !NIL_P(values[1]))
+    {
+        call->block = NUM2LONG(values[1]);
+        if(call->block < 1)
+            rb_raise(rb_eArgError, "block should be positive");
+    }
+
+    // the inverse of type II is type III and the other way round
+    if(inverse && call->type != 4)
+        call->type = 5 - call->type;
+
+    return values[2] != Qundef ? ft_precision_value(values[2]) : FT_FLOAT64;
+}
+
+/**
+ * @brief Compute a transform of 1D or 2D data.
+ * @author placek@ragnarson.com
+ * @params argc Number of arguments.
+ * @params argv Arguments (type: option, block: for 2D).
+ * @params self A Ruby input data array.
+ * @params dims Number of axes (1 or 2).
+ * @params sine TRUE for DST, FALSE for DCT.
+ * @params inverse TRUE for the inverse transform.
+ * @return The output Ruby Array with processed data (nil for invalid data).
+ */
+static VALUE prepare_dct(int argc, VALUE * argv, VALUE self, int dims, int sine, int inverse)
+{
+    VALUE options, outArray;
+    long shape[FT_MAX_DIMS];
+    dct_call call;
+
+    rb_scan_args(argc, argv, "0:", &options);
+    dct_options(options, dims, inverse, &call);
+    call.sine = sine;
+    if(ft_nd_shape(self, shape) != dims)
+        return Qnil;
+    call.rows = dims == 2 ? shape[0] : 1;
+    call.columns = shape[dims - 1];
+    if(call.block && (call.rows % call.block || call.columns % call.block))
+        return Qnil;
+
+    call.values = malloc(call.rows * call.columns * sizeof(double));
+    ft_nd_from_ruby(self, call.values, shape, dims);
+
+    // do the actual transform
+    dct_perform(&call);
+
+    outArray = ft_nd_to_ruby(call.values, shape, dims, NULL);
+
+    // no memory leaks
+    free(call.values);
+
+    return outArray;
+}
+
+/**
+ * @brief Compute a DCT.
+ * dct(type: 2) computes the orthonormal DCT-II of real data
+ * (type: 3 or 4 for the other types).
+ * @author placek@ragnarson.com
+ * @return A result of DCT (nil for invalid data).
+ */
+static VALUE forward_dct(int argc, VALUE * argv, VALUE self)
+{
+    return prepare_dct(argc, argv, self, 1, FALSE, FALSE);
+}
+
+/**
+ * @brief Compute an inverse DCT.
+ * idct(type: 2) is the inverse of dct(type: 2), so the DCT-III.
+ * @author placek@ragnarson.com
+ * @return A result of inverse DCT (nil for invalid data).
+ */
+static VALUE inverse_dct(int argc, VALUE * argv, VALUE self)
+{
+    return prepare_dct(argc, argv, self, 1, FALSE, TRUE);
+}
+
+/**
+ * @brief Compute a DST.
+ * @see forward_dct()
+ * @author placek@ragnarson.com
+ * @return A result of DST (nil for invalid data).
+ */
+static VALUE forward_dst(int argc, VALUE * argv, VALUE self)
+{
+    return prepare_dct(argc, argv, self, 1, TRUE, FALSE);
+}
+
+/**
+ * @brief Compute an inverse DST.
+ * @see inverse_dct()
+ * @author placek@ragnarson.com
+ * @return A result of inverse DST (nil for invalid data).
+ */
+static VALUE inverse_dst(int argc, VALUE * argv, VALUE self)
+{
+    return prepare_dct(argc, argv, self, 1, TRUE, TRUE);
+}
+
+/**
+ * @brief Compute a DCT for 2D data.
+ * dct2d(type: 2, block: nil) transforms the rows and the columns of
+ * a matrix; with block: 8 every 8x8 tile is transformed on its own
+ * (the size of the matrix should be a multiple of the block).
+ * @author placek@ragnarson.com
+ * @return A result of DCT for 2D data (nil for invalid data).
+ */
+static VALUE forward_dct2d(int argc, VALUE * argv, VALUE self)
+{
+    return prepare_dct(argc, argv, self, 2, FALSE, FALSE);
+}
+
+/**
+ * @brief Compute an inverse DCT for 2D data.
+ * @see forward_dct2d()
+ * @author placek@ragnarson.com
+ * @return A result of inverse DCT for 2D data (nil for invalid data).
+ */
+static VALUE inverse_dct2d(int argc, VALUE * argv, VALUE self)
+{
+    return prepare_dct(argc, argv, self, 2, FALSE, TRUE);
+}
+
+/**
+ * @brief Compute a DST for 2D data.
+ * @see forward_dct2d()
+ * @author placek@ragnarson.com
+ * @return A result of DST for 2D data (nil for invalid data).
+ */
+static VALUE forward_dst2d(int argc, VALUE * argv, VALUE self)
+{
+    return prepare_dct(argc, argv, self, 2, TRUE, FALSE);
+}
+
+/**
+ * @brief Compute an inverse DST for 2D data.
+ * @see forward_dct2d()
+ * @author placek@ragnarson.com
+ * @return A result of inverse DST for 2D data (nil for invalid data).
+ */
+static VALUE inverse_dst2d(int argc, VALUE * argv, VALUE self)
+{
+    return prepare_dct(argc, argv, self, 2, TRUE, TRUE);
+}
+
+/**
+ * @brief Compute a 2D DCT of a packed buffer.
+ * @author placek@ragnarson.com
+ * @params argc Number of arguments.
+ * @params argv Arguments (input, number of rows, optional output String and
+ * type:, block: and precision: options).
+ * @params inverse TRUE for the inverse transform.
+ * @return The output String (nil for empty data or data that is not a whole number of rows).
+ */
+static VALUE prepare_dct2d_buffer(int argc, VALUE * argv, int inverse)
+{
+    VALUE input, rb_rows, output, options;
+    ft_buffer buffer;
+    dct_call call;
+    int precision;
+    long k, count;
+    float * single;
+
+    rb_scan_args(argc, argv, "21:", &input, &rb_rows, &output, &options);
+    precision = dct_options(options, 3, inverse, &call);
+    call.sine = FALSE;
+    call.rows = NUM2LONG(rb_rows);
+    if(call.rows < 1)
+        rb_raise(rb_eArgError, "number of rows should be positive");
+    ft_buffer_open(input, &buffer, precision);
+    count = buffer.size / (precision == FT_FLOAT32 ? sizeof(float) : sizeof(double));
+    call.columns = count / call.rows;
+    if(count < 1 || count % call.rows || (call.block && (call.rows % call.block || call.columns % call.block)))
+    {
+        ft_buffer_close(&buffer);
+        return Qnil;
+    }
+
+    call.values = malloc(count * sizeof(double));
+    if(precision == FT_FLOAT32)
+    {
+        single = malloc(count * sizeof(float));
+        ft_buffer_read_real_single(&buffer, single, count);
+        for(k = 0; k < count; k++)
+            call.values[k] = single[k];
+    }
+    else
+        ft_buffer_read_real(&buffer, call.values, count);
+    ft_buffer_close(&buffer);
+
+    // do the actual transform
+    dct_perform(&call);
+
+    if(precision == FT_FLOAT32)
+    {
+        output = ft_buffer_output(output, count * sizeof(float));
+        for(k = 0; k < count; k++)
+            single[k] = (float)call.values[k];
+        ft_buffer_write_real_single(RSTRING_PTR(output), single, count);
+        free(single);
+    }
+    else
+    {
+        output = ft_buffer_output(output, count * sizeof(double));
+        ft_buffer_write_real(RSTRING_PTR(output), call.values, count);
+    }
+
+    // no memory leaks
+    free(call.values);
+
+    return output;
+}
+
+/**
+ * @brief Compute a 2D DCT of a buffer.
+ * FT.dct2d_buffer(input, rows, output = nil, type: 2, block: nil,
+ * precision: :float64) transforms a row-major matrix of packed real values
+ * (like dct2d, block: 8 for JPEG-style tiles).
+ * @author placek@ragnarson.com
+ * @return A String with the transformed matrix.
+ */
+static VALUE dct2d_buffer(int argc, VALUE * argv, VALUE self)
+{
+    return prepare_dct2d_buffer(argc, argv, FALSE);
+}
+
+/**
+ * @brief Compute an inverse 2D DCT of a buffer.
+ * @see dct2d_buffer()
+ * @author placek@ragnarson.com
+ * @return A String with the transformed matrix.
+ */
+static VALUE idct2d_buffer(int argc, VALUE * argv, VALUE self)
+{
+    return prepare_dct2d_buffer(argc, argv, TRUE);
+}
+
+/**
+ * @brief Define the cosine and sine transform methods.
+ * @author placek@ragnarson.com
+ */
+void Init_dct(void)
+{
+    ids[0] = rb_intern("type");
+    ids[1] = rb_intern("block");
+    ids[2] = rb_intern("precision");
+
+    rb_define_method(FT, "dct", forward_dct, -1);
+    rb_define_method(FT, "idct", inverse_dct, -1);
+    rb_define_method(FT, "dst", forward_dst, -1);
+    rb_define_method(FT, "idst", inverse_dst, -1);
+    rb_define_method(FT, "dct2d", forward_dct2d, -1);
+    rb_define_method(FT, "idct2d", inverse_dct2d, -1);
+    rb_define_method(FT, "dst2d", forward_dst2d, -1);
+    rb_define_method(FT, "idst2d", inverse_dst2d, -1);
+    rb_define_singleton_method(FT, "dct2d_buffer", dct2d_buffer, -1);
+    rb_define_singleton_method(FT, "idct2d_buffer", idct2d_buffer, -1);
+}
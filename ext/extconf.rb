@@ -5,4 +5,11 @@ def error msg
   abort
 end
 
+have_header('ruby/memory_view.h')
+have_header('ruby/thread.h')
+have_header('unistd.h')
+have_header('sys/mman.h')
+have_func('posix_memalign', 'stdlib.h')
+have_library('pthread', 'pthread_create') && have_header('pthread.h')
+
 create_makefile('frequency_transformations')
@@ -0,0 +1,542 @@
+/**
+ * @file file_fft.c
+ * @brief FFT of memory-mapped binary files.
+ * The input file is mapped read-only and the output file (created or
+ * truncated to the same size) read-write, both holding little-endian
+ * complex values, interleaved (real, imaginary, real, ...) or split (all
+ * real parts, then all imaginary parts), as doubles or floats. Data that
+ * fits in the memory budget is transformed in one piece. Larger data is
+ * transformed out of core with the four-step algorithm: the length is
+ * split into rows x columns (R x C, both near its square root) and
+ *  1. panels of whole columns are read (a short contiguous run per row),
+ *     transformed with R-point FFTs, multiplied by the twiddle factors and
+ *     written into the output file transposed (each column contiguous),
+ *  2. panels of whole rows are gathered from the output file, transformed
+ *     with C-point FFTs and written back to the very places they were read
+ *     from, which are the places of the result.
+ * Only the panels live in allocated memory and the mapped pages of every
+ * run are released right after it is read or written, so the resident
+ * memory stays bounded by the budget however large the file is, as long
+ * as a whole row of C points fits in it. Lengths without such a split
+ * (primes, or ones like 2p with a large prime p, whose rows are about N
+ * points) are transformed in memory with a warning.
+ * @author placek@ragnarson.com
+ */
+#include "frequency_transformations.h"
+
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+
+/**
+ * @brief Memory budget when the size of the physical memory is unknown.
+ */
+#define FILE_MEMORY (1L << 30)
+
+/**
+ * @brief Alignment of the released pages.
+ * A page fault of a mapped file maps the neighbouring pages of an aligned
+ * window too (64 KB on Linux), which are released along with a run.
+ */
+#define FILE_WINDOW (1L << 16)
+
+static ID ids[3], id_interleaved, id_split;
+
+#ifdef HAVE_SYS_MMAN_H
+
+/**
+ * @brief A transform of a mapped file.
+ */
+typedef struct
+{
+    const char * input;
+    char * output;
+    size_t size;
+    long length;
+    int precision;
+    int split;
+    int direction;
+    long memory;
+    long rows;
+    long columns;
+    const ft_plan * plan;
+    double * panel[2];
+    long first;
+    long count;
+    long chunk;
+} file_transform;
+
+/**
+ * @brief Find the place of a value in a file.
+ * @author placek@ragnarson.com
+ * @param t A transform.
+ * @param index Index of a complex value.
+ * @param part 0 for the real part, 1 for the imaginary part.
+ * @return Offset in bytes.
+ */
+static size_t file_offset(const file_transform * t, long index, int part)
+{
+    size_t value = t->precision == FT_FLOAT32 ? sizeof(float) : sizeof(double);
+
+    if(t->split)
+        return (part * t->length + index) * value;
+    return (2 * index + part) * value;
+}
+
+/**
+ * @brief Read a contiguous run of complex values of a file.
+ * @author placek@ragnarson.com
+ * @param t A transform.
+ * @param data The mapped file.
+ * @param first Index of the first value.
+ * @param count Number of values.
+ * @param stride Distance between the values in memory.
+ * @param real Place for real parts.
+ * @param imag Place for imaginary parts.
+ */
+static void file_load(const file_transform * t, const char * data, long first, long count, long stride,
+    double * real, double * imag)
+{
+    long i;
+
+    for(i = 0; i < count; i++)
+    {
+        real[i * stride] = ft_buffer_load(data + file_offset(t, first + i, 0), t->precision);
+        imag[i * stride] = ft_buffer_load(data + file_offset(t, first + i, 1), t->precision);
+    }
+}
+
+/**
+ * @brief Write a contiguous run of complex values of a file.
+ * @see file_load()
+ * @author placek@ragnarson.com
+ */
+static void file_store(const file_transform * t, char * data, long first, long count, long stride,
+    const double * real, const double * imag)
+{
+    long i;
+
+    for(i = 0; i < count; i++)
+    {
+        ft_buffer_store(data + file_offset(t, first + i, 0), real[i * stride], t->precision);
+        ft_buffer_store(data + file_offset(t, first + i, 1), imag[i * stride], t->precision);
+    }
+}
+
+/**
+ * @brief Release the mapped pages of a run of values.
+ * Runs are released (with their window, see FILE_WINDOW) as soon as they
+ * are read or written; written pages stay in the page cache of the output
+ * file.
+ * @author placek@ragnarson.com
+ * @param t A transform.
+ * @param data The mapped file.
+ * @param first Index of the first value.
+ * @param count Number of values.
+ */
+static void file_drop(const file_transform * t, const char * data, long first, long count)
+{
+    size_t start, end;
+    int part;
+
+    for(part = 0; part < (t->split ? 2 : 1); part++)
+    {
+        start = file_offset(t, first, part) / FILE_WINDOW * FILE_WINDOW;
+        end = file_offset(t, first + count - 1, t->split ? part : 1) + 1;
+        end = (end + FILE_WINDOW - 1) / FILE_WINDOW * FILE_WINDOW;
+        if(end > t->size)
+            end = t->size;
+        madvise((void *)(data + start), end - start, MADV_DONTNEED);
+    }
+}
+
+/**
+ * @brief Transform a whole file in memory.
+ * @author placek@ragnarson.com
+ * @param t A transform.
+ */
+static void file_in_core(const file_transform * t)
+{
+    double * real = malloc(t->length * sizeof(double));
+    double * imag = malloc(t->length * sizeof(double));
+    ft_plan * plan = ft_plan_create(t->length, t->direction);
+    double * scratch = malloc((ft_plan_scratch_length(plan) + 1) * sizeof(double));
+
+    file_load(t, t->input, 0, t->length, 1, real, imag);
+    ft_plan_execute_scratch(plan, real, imag, scratch);
+    file_store(t, t->output, 0, t->length, 1, real, imag);
+
+    // no memory leaks
+    free(scratch);
+    ft_plan_free(plan);
+    free(real);
+    free(imag);
+}
+
+/**
+ * @brief Transform a column of a panel and multiply it by the twiddle factors.
+ * Element k of column c is multiplied by exp(-+2 pi i c k / length).
+ * @author placek@ragnarson.com
+ * @param t A transform.
+ * @param index Index of the column in the panel.
+ * @param scratch Scratch memory of the plan.
+ */
+static void file_column(const file_transform * t, long index, double * scratch)
+{
+    double * real = t->panel[0] + index * t->rows;
+    double * imag = t->panel[1] + index * t->rows;
+    double arg, w_real, w_imag, temp;
+    long k, column = t->first + index;
+
+    ft_plan_execute_scratch(t->plan, real, imag, scratch);
+    for(k = 1; k < t->rows; k++)
+    {
+        // column * k is below the length
+        arg = 2.0 * M_PI * (double)(column * k) / (double)t->length;
+        w_real = cos(arg);
+        w_imag = -t->direction * sin(arg);
+        temp = real[k] * w_real - imag[k] * w_imag;
+        imag[k] = real[k] * w_imag + imag[k] * w_real;
+        real[k] = temp;
+    }
+}
+
+/**
+ * @brief Transform a chunk of the columns or rows of a panel.
+ * The panel is split into one chunk per worker thread, so the scratch
+ * memory is allocated once per chunk instead of once per FFT.
+ * @author placek@ragnarson.com
+ * @param index Index of the chunk.
+ * @param data A transform (file_transform), first is the column of the
+ * panel in the first step and -1 in the second.
+ */
+static void file_chunk(long index, void * data)
+{
+    const file_transform * t = data;
+    long i, last = (index + 1) * t->chunk < t->count ? (index + 1) * t->chunk : t->count;
+    double * scratch = malloc((ft_plan_scratch_length(t->plan) + 1) * sizeof(double));
+
+    for(i = index * t->chunk; i < last; i++)
+        if(t->first >= 0)
+            file_column(t, i, scratch);
+        else
+            ft_plan_execute_scratch(t->plan, t->panel[0] + i * t->columns, t->panel[1] + i * t->columns, scratch);
+    free(scratch);
+}
+
+/**
+ * @brief Transform the columns or rows of a panel in parallel.
+ * @see file_chunk()
+ * @author placek@ragnarson.com
+ * @param t A transform with the plan and first set.
+ * @param count Number of columns or rows of the panel.
+ */
+static void file_panel(file_transform * t, long count)
+{
+    long threads = ft_thread_count();
+
+    t->count = count;
+    t->chunk = (count + threads - 1) / threads;
+    ft_parallel_for((count + t->chunk - 1) / t->chunk, file_chunk, t);
+}
+
+/**
+ * @brief Transform a file with the four-step algorithm.
+ * Value r * C + c of the input is at row r and column c, value k + R * j
+ * of the result at row k and column j of the transposed intermediate data.
+ * @author placek@ragnarson.com
+ * @param t A transform with rows and columns set.
+ */
+static void file_out_of_core(file_transform * t)
+{
+    long c, k, r, width, height, count;
+    // half of the budget for the panel (two doubles per value), half for the plans
+    long points = t->memory / (4 * (long)sizeof(double));
+    ft_plan * plan;
+
+    width = points / t->rows;
+    width = width < 1 ? 1 : width > t->columns ? t->columns : width;
+    height = points / t->columns;
+    height = height < 1 ? 1 : height > t->rows ? t->rows : height;
+    count = width * t->rows > height * t->columns ? width * t->rows : height * t->columns;
+    t->panel[0] = malloc(count * sizeof(double));
+    t->panel[1] = malloc(count * sizeof(double));
+
+    // columns: a run of width values from every row, written out column by column
+    plan = ft_plan_create(t->rows, t->direction);
+    t->plan = plan;
+    for(c = 0; c < t->columns; c += width)
+    {
+        count = t->columns - c < width ? t->columns - c : width;
+        for(r = 0; r < t->rows; r++)
+        {
+            file_load(t, t->input, r * t->columns + c, count, t->rows, t->panel[0] + r, t->panel[1] + r);
+            file_drop(t, t->input, r * t->columns + c, count);
+        }
+        t->first = c;
+        file_panel(t, count);
+        file_store(t, t->output, c * t->rows, count * t->rows, 1, t->panel[0], t->panel[1]);
+        file_drop(t, t->output, c * t->rows, count * t->rows);
+    }
+    ft_plan_free(plan);
+
+    // rows: a run of height values from every column, written back in place
+    plan = ft_plan_create(t->columns, t->direction);
+    t->plan = plan;
+    t->first = -1;
+    for(k = 0; k < t->rows; k += height)
+    {
+        count = t->rows - k < height ? t->rows - k : height;
+        for(c = 0; c < t->columns; c++)
+        {
+            file_load(t, t->output, c * t->rows + k, count, t->columns, t->panel[0] + c, t->panel[1] + c);
+            file_drop(t, t->output, c * t->rows + k, count);
+        }
+        file_panel(t, count);
+        for(c = 0; c < t->columns; c++)
+        {
+            file_store(t, t->output, c * t->rows + k, count, t->columns, t->panel[0] + c, t->panel[1] + c);
+            file_drop(t, t->output, c * t->rows + k, count);
+        }
+    }
+    ft_plan_free(plan);
+
+    // no memory leaks
+    free(t->panel[0]);
+    free(t->panel[1]);
+}
+
+/**
+ * @brief Split the length of a file transformed out of core.
+ * Rows are the largest divisor up to the square root of the length, so
+ * the C-point rows are as short as they can be; they should still fit in
+ * the memory budget.
+ * @author placek@ragnarson.com
+ * @param t A transform with the length and memory budget set, rows and
+ * columns are set (0 rows to transform in memory).
+ * @return FALSE if the data above the budget has no such split.
+ */
+static int file_layout(file_transform * t)
+{
+    long r, points = t->memory / (4 * (long)sizeof(double));
+
+    t->rows = t->columns = 0;
+
+    // in memory: the data and the tables of the plan take about four doubles per value
+    // (a single value needs no split whatever the budget)
+    if(t->length <= points || t->length < 2)
+        return TRUE;
+    for(r = (long)sqrt((double)t->length); r > 1 && t->length % r; r--);
+    if(r < 2 || t->length / r > points)
+        return FALSE;
+    t->rows = r;
+    t->columns = t->length / r;
+
+    return TRUE;
+}
+
+/**
+ * @brief Transform a file (run without the GVL).
+ * @see file_layout()
+ * @author placek@ragnarson.com
+ * @param data A transform (file_transform).
+ * @return NULL.
+ */
+static void * file_run(void * data)
+{
+    file_transform * t = data;
+
+    if(t->rows)
+        file_out_of_core(t);
+    else
+        file_in_core(t);
+
+    return NULL;
+}
+
+/**
+ * @brief Get the default memory budget.
+ * @author placek@ragnarson.com
+ * @return Half of the physical memory (in bytes).
+ */
+static long file_default_memory(void)
+{
+#if defined(_SC_PHYS_PAGES) && defined(_SC_PAGESIZE)
+    long pages = sysconf(_SC_PHYS_PAGES), page = sysconf(_SC_PAGESIZE);
+
+    if(pages > 0 && page > 0)
+        return pages / 2 * page;
+#endif
+    return FILE_MEMORY;
+}
+
+/**
+ * @brief Close the files and raise the error of a system call.
+ * @author placek@ragnarson.com
+ * @param input Descriptor of the input file.
+ * @param output Descriptor of the output file (or -1).
+ * @param path Path of the failing file.
+ */
+static void file_fail(int input, int output, VALUE path)
+{
+    int error = errno;
+
+    close(input);
+    if(output >= 0)
+        close(output);
+    errno = error;
+    rb_sys_fail_str(path);
+}
+
+/**
+ * @brief Read the options of a file transform.
+ * @author placek@ragnarson.com
+ * @param options A Hash of keyword arguments (or nil).
+ * @param t Place for the layout, precision and memory budget.
+ */
+static void file_options(VALUE options, file_transform * t)
+{
+    VALUE values[3] = { Qundef, Qundef, Qundef };
+
+    if(!NIL_P(options))
+        rb_get_kwargs(options, ids, 0, 3, values);
+    t->precision = ft_precision_value(values[0]);
+    if(values[1] == Qundef || values[1] == ID2SYM(id_interleaved))
+        t->split = FALSE;
+    else if(values[1] == ID2SYM(id_split))
+        t->split = TRUE;
+    else
+        rb_raise(rb_eArgError, "layout should be :interleaved or :split");
+    t->memory = values[2] == Qundef ? file_default_memory() : NUM2LONG(values[2]);
+    if(t->memory < 1)
+        rb_raise(rb_eArgError, "memory should be positive");
+}
+
+/**
+ * @brief Compute a FFT of a file into another file.
+ * @author placek@ragnarson.com
+ * @params argc Number of arguments.
+ * @params argv Arguments (input and output paths, layout:, precision: and memory: options).
+ * @params direction An FFT direction (1 - forward FFT, -1 - reverse FFT).
+ * @return Number of transformed values (nil for empty or uneven files).
+ */
+static VALUE prepare_file(int argc, VALUE * argv, int direction)
+{
+    VALUE input, output, options;
+    file_transform t;
+    struct stat input_stat, output_stat;
+    size_t value;
+    int in, out, fits;
+    void * map;
+
+    rb_scan_args(argc, argv, "2:", &input, &output, &options);
+    FilePathValue(input);
+    FilePathValue(output);
+    file_options(options, &t);
+    t.direction = direction;
+    value = 2 * (t.precision == FT_FLOAT32 ? sizeof(float) : sizeof(double));
+
+    in = open(StringValueCStr(input), O_RDONLY);
+    if(in < 0)
+        rb_sys_fail_str(input);
+    if(fstat(in, &input_stat) < 0)
+        file_fail(in, -1, input);
+    t.size = input_stat.st_size;
+    t.length = t.size / value;
+    if(t.length < 1 || t.size % value)
+    {
+        close(in);
+        return Qnil;
+    }
+    if(stat(StringValueCStr(output), &output_stat) == 0 &&
+        output_stat.st_dev == input_stat.st_dev && output_stat.st_ino == input_stat.st_ino)
+    {
+        close(in);
+        rb_raise(rb_eArgError, "output should be another file than input");
+    }
+
+    out = open(StringValueCStr(output), O_RDWR | O_CREAT | O_TRUNC, 0666);
+    if(out < 0)
+        file_fail(in, -1, output);
+    if(ftruncate(out, t.size) < 0)
+        file_fail(in, out, output);
+    map = mmap(NULL, t.size, PROT_READ, MAP_SHARED, in, 0);
+    if(map == MAP_FAILED)
+        file_fail(in, out, input);
+    t.input = map;
+    map = mmap(NULL, t.size, PROT_READ | PROT_WRITE, MAP_SHARED, out, 0);
+    if(map == MAP_FAILED)
+    {
+        munmap((void *)t.input, t.size);
+        file_fail(in, out, output);
+    }
+    t.output = map;
+    // the mappings outlive the descriptors
+    close(in);
+    close(out);
+
+    // do the actual transform
+    fits = file_layout(&t);
+    ft_without_gvl(file_run, &t, t.length);
+
+    munmap((void *)t.input, t.size);
+    munmap(t.output, t.size);
+    if(!fits)
+        rb_warn("no split of %ld points fits in %ld bytes, the file was transformed in memory",
+            t.length, t.memory);
+
+    return LONG2NUM(t.length);
+}
+
+/**
+ * @brief Compute a forward FFT of a file.
+ * FT.fft_file(input, output, layout: :interleaved, precision: :float64, memory: nil)
+ * writes the spectrum of the input file into the output file in the same
+ * layout and precision. Data above the memory budget (in bytes, half of the
+ * physical memory by default) is transformed out of core, unless its length
+ * has no split into rows that fit the budget (a warning tells then).
+ * @author placek@ragnarson.com
+ * @return Number of transformed values.
+ */
+static VALUE fft_file(int argc, VALUE * argv, VALUE self)
+{
+    return prepare_file(argc, argv, 1);
+}
+
+/**
+ * @brief Compute a reverse FFT of a file.
+ * @see fft_file()
+ * @author placek@ragnarson.com
+ * @return Number of transformed values.
+ */
+static VALUE rfft_file(int argc, VALUE * argv, VALUE self)
+{
+    return prepare_file(argc, argv, -1);
+}
+
+#endif
+
+/**
+ * @brief Define the file transforms.
+ * @author placek@ragnarson.com
+ */
+void Init_file_fft(void)
+{
+    ids[0] = rb_intern("precision");
+    ids[1] = rb_intern("layout");
+    ids[2] = rb_intern("memory");
+    id_interleaved = rb_intern("interleaved");
+    id_split = rb_intern("split");
+
+#ifdef HAVE_SYS_MMAN_H
+    rb_define_singleton_method(FT, "fft_file", fft_file, -1);
+    rb_define_singleton_method(FT, "rfft_file", rfft_file, -1);
+#else
+    rb_define_singleton_method(FT, "fft_file", rb_f_notimplement, -1);
+    rb_define_singleton_method(FT, "rfft_file", rb_f_notimplement, -1);
+#endif
+}
@@ -5,42 +5,38 @@
  * @author jude.sutton@gmail.com, placek@ragnarson.com
  * @date 15.05.2012
  */
-#include "ruby.h"
-#include <math.h>
-#include <stdlib.h>
-
-#ifndef TRUE
-#define TRUE 1
-#define FALSE 0
-#endif
+#include "frequency_transformations.h"
 
 /**
  * @brief This function validates the incoming array for Fourier transforms.
  * The array of data should contain two arrays: the first one with real parts
  * and the second one with imaginary parts of processing data.
- * The function validates the length of incoming data, the length of inner arrays
- * and reasures that the length is a power of 2.
+ * The function validates the length of incoming data and the length of inner
+ * arrays. Any length is accepted, the FFT is computed with the mixed-radix
+ * or Bluestein algorithm when it is not a power of 2.
  * @author jude.sutton@gmail.com
- * @param self An array we work on.
+ * @param self An array we work on (raises TypeError for other objects).
  * @return A validation result (1 if passed, 0 if failed).
  */
-static int fourier_validate(VALUE self)
+int fourier_validate(VALUE self)
 {
     long length;
-    VALUE * values = RARRAY_PTR(self);
+    VALUE * values;
 
     // check if instance of Array
     Check_Type(self, T_ARRAY);
 
     // make sure we have an array of two arrays
     if(RARRAY_LEN(self) != 2) return FALSE;
+    values = RARRAY_PTR(self);
+    if(TYPE(values[0]) != T_ARRAY || TYPE(values[1]) != T_ARRAY) return FALSE;
 
     // make sure the arrays are of the same length
     if(RARRAY_LEN( values[0]) != RARRAY_LEN(values[1])) return FALSE;
 
-    // make sure the size of the array is a power of 2
+    // make sure the arrays are not empty
     length = RARRAY_LEN(values[0]);
-    if((length < 2) || (length & (length - 1))) return FALSE;
+    if(length < 1) return FALSE;
 
     return TRUE;
 }
@@ -50,14 +46,11 @@ static int fourier_validate(VALUE self)
  * The array of data should contain only numbers. The length of array
  * should be a multiplication of 2.
  * @author placek@ragnarson.com
- * @param self An array we work on.
+ * @param self An array we work on (raises TypeError for other objects).
  * @return A validation result (1 if passed, 0 if failed).
  */
-static int hartley_validate(VALUE self)
+int hartley_validate(VALUE self)
 {
-    long length;
-    VALUE * values = RARRAY_PTR(self);
-
     // check if instance of Array
     Check_Type(self, T_ARRAY);
 
@@ -71,40 +64,65 @@ static int hartley_validate(VALUE self)
 }
 
 /**
- * @brief Compute a FFT.
- * This function computes the FFT and returns the Ruby Array with the same size
- * and structure as input.
- * @see fourier_validate()
+ * @brief Scale the result of a reverse FFT.
  * @author placek@ragnarson.com
- * @param values An array of processing data.
- * @params length Length of processing data.
- * @params direction An FFT direction (1 - forward FFT, -1 - reverse FFT).
- * @return An Ruby Array with FFT processed data.
+ * @param real Real parts of processing data.
+ * @param imag Imaginary parts of processing data.
+ * @param length Length of processing data.
+ * @param direction An FFT direction (1 - forward FFT, -1 - reverse FFT).
  */
-static VALUE perform_fft(double ** values, long length, int direction)
+static void fft_scale(double * real, double * imag, long length, int direction)
 {
-    VALUE outArray = rb_ary_new2(2);
-    VALUE xArray = rb_ary_new2(length);
-    VALUE yArray = rb_ary_new2(length);
+    long i;
 
-    unsigned int position, target, mask, jump;
-    unsigned int step, group, pair, i;
+    if(direction != -1)
+        return;
+    for(i = 0; i < length; i++)
+    {
+        real[i] /= length;
+        imag[i] /= length;
+    }
+}
+
+/**
+ * @brief Compute a FFT in place.
+ * This function computes the radix-2 FFT of the data held in two C arrays
+ * (real and imaginary parts). The length should be a power of 2. Lengths up
+ * to FT_CODELET_MAX are computed by the unrolled codelets.
+ * @see fourier_validate()
+ * @author placek@ragnarson.com
+ * @param real Real parts of processing data.
+ * @param imag Imaginary parts of processing data.
+ * @param length Length of processing data.
+ * @param direction An FFT direction (1 - forward FFT, -1 - reverse FFT).
+ */
+void fft_kernel(double * real, double * imag, long length, int direction)
+{
+    unsigned long position, target, mask, jump;
+    unsigned long step, group, pair;
     double multiplier_real, multiplier_imag, factor_real, factor_imag, product_real, product_imag;
     double temp_real, temp_imag, delta, sine, pi = direction * (-M_PI);
     double old_factor_real;
 
+    // short transforms are unrolled
+    if(ft_codelet_fft(real, imag, length, direction))
+    {
+        fft_scale(real, imag, length, direction);
+        return;
+    }
+
     // do the bit reversal
     target = 0;
-    for(position = 0; position < length; ++position)
+    for(position = 0; position < (unsigned long)length; ++position)
     {
         if(target > position)
         {
-            temp_real = values[0][position];
-            temp_imag = values[1][position];
-            values[0][position] = values[0][target];
-            values[1][position] = values[1][target];
-            values[0][target] = temp_real;
-            values[1][target] = temp_imag;
+            temp_real = real[position];
+            temp_imag = imag[position];
+            real[position] = real[target];
+            imag[position] = imag[target];
+            real[target] = temp_real;
+            imag[target] = temp_imag;
         }
         mask = length;
         while(target & (mask >>= 1))
@@ -113,7 +131,7 @@ static VALUE perform_fft(double ** values, long length, int direction)
     }
 
     // compute the FFT
-    for(step = 1; step < length; step <<= 1)
+    for(step = 1; step < (unsigned long)length; step <<= 1)
     {
         // jump to the next entry of the same transform factor
         jump = step << 1;
@@ -131,18 +149,18 @@ static VALUE perform_fft(double ** values, long length, int direction)
         for(group = 0; group < step; ++group)
         {
             // iteration within group
-            for(pair = group; pair < length; pair += jump)
+            for(pair = group; pair < (unsigned long)length; pair += jump)
             {
                 position = pair + step;
                 // second term of two-point transform
-                product_real = factor_real * values[0][position] - factor_imag * values[1][position];
-                product_imag = factor_imag * values[0][position] + factor_real * values[1][position];
+                product_real = factor_real * real[position] - factor_imag * imag[position];
+                product_imag = factor_imag * real[position] + factor_real * imag[position];
                 // transform for fi + pi
-                values[0][position] = values[0][pair] - product_real;
-                values[1][position] = values[1][pair] - product_imag;
+                real[position] = real[pair] - product_real;
+                imag[position] = imag[pair] - product_imag;
                 // transform for fi
-                values[0][pair] += product_real;
-                values[1][pair] += product_imag;
+                real[pair] += product_real;
+                imag[pair] += product_imag;
             }
             // successive transform factor via trigonometric recurrence
             old_factor_real = factor_real;
@@ -152,50 +170,28 @@ static VALUE perform_fft(double ** values, long length, int direction)
     }
 
     // scaling for inverse transform
-    if(direction == -1)
-    {
-        for(i = 0; i < length; i++)
-        {
-            values[0][i] /= length;
-            values[1][i] /= length;
-        }
-    }
-
-    // convert the doubles into ruby numbers and stick them into a ruby array
-    for(i = 0; i < length; i++)
-    {
-        rb_ary_push(xArray, DBL2NUM(values[0][i]));
-        rb_ary_push(yArray, DBL2NUM(values[1][i]));
-    }
-
-    rb_ary_push(outArray, xArray);
-    rb_ary_push(outArray, yArray);
-
-    return outArray;
+    fft_scale(real, imag, length, direction);
 }
 
 /**
- * @brief Compute a DFT.
- * This function computes the DFT and returns the Ruby Array with the same size
- * and structure as input.
+ * @brief Compute a DFT in place.
+ * This function computes the DFT of the data held in two C arrays
+ * (real and imaginary parts).
  * @see fourier_validate()
  * @author placek@ragnarson.com
- * @param values An array of processing data.
- * @params length Length of processing data.
- * @params direction An DFT direction (1 - forward DFT, -1 - reverse DFT).
- * @return An Ruby Array with DFT processed data.
+ * @param real Real parts of processing data.
+ * @param imag Imaginary parts of processing data.
+ * @param length Length of processing data.
+ * @param direction An DFT direction (1 - forward DFT, -1 - reverse DFT).
  */
-static VALUE perform_dft(double ** values, long length, int direction)
+void dft_kernel(double * real, double * imag, long length, int direction)
 {
     long i, k;
     double arg;
     double cosarg, sinarg;
     double * temp_values[2];
 
-    // prepare memory and result arrays
-    VALUE outArray = rb_ary_new2(2);
-    VALUE xArray = rb_ary_new2(length);
-    VALUE yArray = rb_ary_new2(length);
+    // prepare memory
     temp_values[0] = malloc(length * sizeof(double));
     temp_values[1] = malloc(length * sizeof(double));
 
@@ -209,57 +205,49 @@ static VALUE perform_dft(double ** values, long length, int direction)
         {
             cosarg = cos(k * arg);
             sinarg = sin(k * arg);
-            temp_values[0][i] += (values[0][k] * cosarg - values[1][k] * sinarg);
-            temp_values[1][i] += (values[0][k] * sinarg + values[1][k] * cosarg);
+            temp_values[0][i] += (real[k] * cosarg - imag[k] * sinarg);
+            temp_values[1][i] += (real[k] * sinarg + imag[k] * cosarg);
         }
     }
 
-    // copy data to final arrays, process for inverse transform
-    if(direction == -1)
+    // copy data back, process for inverse transform
+    for(i = 0; i < length; i++)
     {
-        for(i = 0; i < length; i++)
-        {
-            rb_ary_push(xArray, DBL2NUM(temp_values[0][i] / (double)length));
-            rb_ary_push(yArray, DBL2NUM(temp_values[1][i] / (double)length));
-        }
-    } else {
-        for(i = 0; i < length; i++)
-        {
-            rb_ary_push(xArray, DBL2NUM(temp_values[0][i]));
-            rb_ary_push(yArray, DBL2NUM(temp_values[1][i]));
-        }
+        real[i] = direction == -1 ? temp_values[0][i] / (double)length : temp_values[0][i];
+        imag[i] = direction == -1 ? temp_values[1][i] / (double)length : temp_values[1][i];
     }
 
     // free the memory
     free(temp_values[0]);
     free(temp_values[1]);
-
-    // prepare result and return it
-    rb_ary_push(outArray, xArray);
-    rb_ary_push(outArray, yArray);
-
-    return outArray;
 }
 
 /**
- * @brief Compute a FHT.
- * This function computes the FHT and returns the Ruby Array with the same size
- * as input.
+ * @brief Compute a FHT in place.
+ * This function computes the FHT of the data held in a C array. The radix-2
+ * algorithm needs a power of 2, other lengths are computed by dht_kernel(),
+ * lengths up to FT_CODELET_MAX by the unrolled codelets.
  * @see hartley_validate()
  * @author placek@ragnarson.com
- * @param values An array of processing data.
- * @params length Length of processing data.
- * @return An Ruby Array with FHT processed data.
-zo */
-static VALUE perform_fht(double * values, long length)
+ * @param values Processing data.
+ * @param length Length of processing data.
+ */
+void fht_kernel(double * values, long length)
 {
     long i, k, scale = 1;
-    long level, group, position, match, arg;
-    double a, b, sqrt_length = sqrt(length);
+    long level, group, position, match;
+    double a, b, arg, sqrt_length = sqrt(length);
     double * C, * S;
 
-    // prepare memory and result array
-    VALUE outArray = rb_ary_new2(length);
+    if(length & (length - 1))
+    {
+        dht_kernel(values, length);
+        return;
+    }
+
+    // short transforms are unrolled
+    if(ft_codelet_fht(values, length))
+        return;
 
     // prepare table of cosines and sines
     C = malloc(length / 2 * sizeof(double));
@@ -271,6 +259,20 @@ static VALUE perform_fht(double * values, long length)
         S[k] = sin(arg * (double)k);
     }
 
+    // do the bit reversal
+    for(i = 1, k = 0; i < length; i++)
+    {
+        for(level = length >> 1; k & level; level >>= 1)
+            k ^= level;
+        k |= level;
+        if(k > i)
+        {
+            a = values[i];
+            values[i] = values[k];
+            values[k] = a;
+        }
+    }
+
     // calculate scale
     for(i = length; i > 2; i >>= 1)
         scale <<= 1;
@@ -300,61 +302,271 @@ static VALUE perform_fht(double * values, long length)
         scale >>= 1;
     }
 
-    // put values into ruby array
+    // normalize
     for(i = 0; i < length; i++)
-        rb_ary_push(outArray, DBL2NUM(values[i] / sqrt_length));
+        values[i] /= sqrt_length;
 
     // free the memory
     free(C);
     free(S);
-
-    return outArray;
 }
 
 /**
- * @brief Compute a DHT.
- * This function computes the DHT and returns the Ruby Array with the same size
- * as input.
+ * @brief Compute a DHT in place.
+ * This function computes the DHT of the data held in a C array in
+ * O(N log N) for any length. Powers of 2 go to fht_kernel(), other lengths
+ * take the FFT of real data F, as H[k] = Re F[k] - Im F[k] and the other
+ * half of F is its complex conjugate.
  * @see hartley_validate()
+ * @see ft_real_plan_forward()
  * @author placek@ragnarson.com
- * @param values An array of processing data.
- * @params length Length of processing data.
- * @return An Ruby Array with DHT processed data.
-zo */
-static VALUE perform_dht(double * values, long length)
+ * @param values Processing data.
+ * @param length Length of processing data.
+ */
+void dht_kernel(double * values, long length)
 {
-    long i, k;
-    double arg, cos_arg, sin_arg, sqrt_length = sqrt(length);
-    double * temp_values;
-
-    // prepare memory and result array
-    VALUE outArray = rb_ary_new2(length);
-    temp_values = malloc(length * sizeof(double));
+    long k, half = length / 2;
+    double scale = 1.0 / sqrt(length);
+    double * spectrum[2];
+    ft_real_plan * plan;
+
+    if(length < 1)
+        return;
+    if(!(length & (length - 1)))
+    {
+        fht_kernel(values, length);
+        return;
+    }
 
     // do the calculations
+    spectrum[0] = malloc((half + 1) * sizeof(double));
+    spectrum[1] = malloc((half + 1) * sizeof(double));
+    plan = ft_real_plan_create(length, 1);
+    ft_real_plan_forward(plan, values, spectrum[0], spectrum[1]);
+    ft_real_plan_free(plan);
+    for(k = 0; k <= half; k++)
+        values[k] = (spectrum[0][k] - spectrum[1][k]) * scale;
+    for(k = half + 1; k < length; k++)
+        values[k] = (spectrum[0][length - k] + spectrum[1][length - k]) * scale;
+
+    // free the memory
+    free(spectrum[0]);
+    free(spectrum[1]);
+}
+
+/**
+ * @brief Convert complex C data into a Ruby Array.
+ * @author placek@ragnarson.com
+ * @param real Real parts of data.
+ * @param imag Imaginary parts of data.
+ * @param length Length of data.
+ * @return An Ruby Array of real and imaginary parts.
+ */
+VALUE complex_to_ruby(const double * real, const double * imag, long length)
+{
+    long i;
+    VALUE outArray = rb_ary_new2(2);
+    VALUE xArray = rb_ary_new2(length);
+    VALUE yArray = rb_ary_new2(length);
+
+    // convert the doubles into ruby numbers and stick them into a ruby array
     for(i = 0; i < length; i++)
     {
-        temp_values[i] = 0.0;
-        arg = 2.0 * M_PI * (double)i / (double)length;
-        for(k = 0; k < length; k++)
-        {
-            cos_arg = cos((double)k * arg);
-            sin_arg = sin((double)k * arg);
-            temp_values[i] += values[k] * (sin_arg + cos_arg);
-        }
-        temp_values[i] /= sqrt_length;
+        rb_ary_push(xArray, DBL2NUM(real[i]));
+        rb_ary_push(yArray, DBL2NUM(imag[i]));
     }
 
-    // put values into ruby array
+    rb_ary_push(outArray, xArray);
+    rb_ary_push(outArray, yArray);
+
+    return outArray;
+}
+
+/**
+ * @brief Convert real C data into a Ruby Array.
+ * @author placek@ragnarson.com
+ * @param values Data.
+ * @param length Length of data.
+ * @return An Ruby Array of numbers.
+ */
+VALUE real_to_ruby(const double * values, long length)
+{
+    long i;
+    VALUE outArray = rb_ary_new2(length);
+
     for(i = 0; i < length; i++)
-        rb_ary_push(outArray, DBL2NUM(temp_values[i]));
+        rb_ary_push(outArray, DBL2NUM(values[i]));
 
-    // free the memory
-    free(temp_values);
+    return outArray;
+}
+
+/**
+ * @brief Estimate the number of operations of a job.
+ * Used to decide whether it is worth to release the GVL for the job.
+ * @author placek@ragnarson.com
+ * @param job A job.
+ * @return Rough number of butterfly operations.
+ */
+long ft_job_work(const ft_job * job)
+{
+    long bits = 1, i;
+
+    if(job->kind == FT_JOB_DFT)
+        return job->length * job->length;
+    for(i = job->length; i > 1; i >>= 1)
+        bits++;
+    return job->length * bits;
+}
+
+/**
+ * @brief Run a job.
+ * Computes the transform of the job in place. The function does not touch
+ * any Ruby object, so it can be called without the GVL.
+ * For FFT powers of 2 go straight to fft_kernel(), other lengths (and
+ * lengths with wisdom, except the ones of the codelets) through a
+ * temporary plan.
+ * @see fft_kernel()
+ * @see ft_plan_create()
+ * @author placek@ragnarson.com
+ * @param data A job (ft_job).
+ * @return NULL.
+ */
+void * ft_job_run(void * data)
+{
+    ft_job * job = data;
+    ft_plan * plan;
+
+    switch(job->kind)
+    {
+        case FT_JOB_FFT:
+            // other lengths need the mixed-radix or Bluestein tables of a plan,
+            // vector butterfly passes and the four-step algorithm need a plan too
+            // (but short powers of 2 go to the codelets of fft_kernel() without
+            // looking for wisdom, which takes a lock), and so do lengths with wisdom
+            if(job->length & (job->length - 1) || job->length >= FT_FOUR_STEP_THRESHOLD
+                || (job->length > FT_CODELET_MAX
+                    && (ft_simd()->isa != FT_SIMD_SCALAR || ft_wisdom_lookup(job->length, NULL))))
+            {
+                plan = ft_plan_create(job->length, job->direction);
+                ft_plan_execute(plan, job->real, job->imag);
+                ft_plan_free(plan);
+            }
+            else
+                fft_kernel(job->real, job->imag, job->length, job->direction);
+            break;
+        case FT_JOB_DFT:
+            dft_kernel(job->real, job->imag, job->length, job->direction);
+            break;
+        case FT_JOB_FHT:
+            fht_kernel(job->real, job->length);
+            break;
+        case FT_JOB_DHT:
+            dht_kernel(job->real, job->length);
+            break;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Run a job, releasing the GVL for large ones.
+ * @see ft_job_run()
+ * @author placek@ragnarson.com
+ * @param kind A transform (FT_JOB_FFT, FT_JOB_DFT, FT_JOB_FHT or FT_JOB_DHT).
+ * @param real Real parts (or values for Hartley transforms).
+ * @param imag Imaginary parts (NULL for Hartley transforms).
+ * @param length Length of processing data.
+ * @param direction A direction (1 - forward, -1 - reverse).
+ */
+void ft_perform_job(int kind, double * real, double * imag, long length, int direction)
+{
+    ft_job job;
+
+    job.kind = kind;
+    job.direction = direction;
+    job.length = length;
+    job.real = real;
+    job.imag = imag;
+    ft_without_gvl(ft_job_run, &job, ft_job_work(&job));
+}
+
+/**
+ * @brief Compute a FFT.
+ * This function computes the FFT and returns the Ruby Array with the same size
+ * and structure as input.
+ * @see ft_job_run()
+ * @author placek@ragnarson.com
+ * @param values An array of processing data.
+ * @params length Length of processing data.
+ * @params direction An FFT direction (1 - forward FFT, -1 - reverse FFT).
+ * @params shift TRUE to return the spectrum shifted like by fftshift.
+ * @return An Ruby Array with FFT processed data.
+ */
+static VALUE perform_fft(double ** values, long length, int direction, int shift)
+{
+    long offset;
+    VALUE outArray;
 
+    ft_perform_job(FT_JOB_FFT, values[0], values[1], length, direction);
+    if(!shift)
+        return complex_to_ruby(values[0], values[1], length);
+
+    offset = ft_shift_offset(length, FALSE);
+    outArray = rb_ary_new2(2);
+    rb_ary_push(outArray, ft_nd_to_ruby(values[0], &length, 1, &offset));
+    rb_ary_push(outArray, ft_nd_to_ruby(values[1], &length, 1, &offset));
     return outArray;
 }
 
+/**
+ * @brief Compute a DFT.
+ * This function computes the DFT and returns the Ruby Array with the same size
+ * and structure as input.
+ * @see dft_kernel()
+ * @author placek@ragnarson.com
+ * @param values An array of processing data.
+ * @params length Length of processing data.
+ * @params direction An DFT direction (1 - forward DFT, -1 - reverse DFT).
+ * @return An Ruby Array with DFT processed data.
+ */
+static VALUE perform_dft(double ** values, long length, int direction)
+{
+    ft_perform_job(FT_JOB_DFT, values[0], values[1], length, direction);
+    return complex_to_ruby(values[0], values[1], length);
+}
+
+/**
+ * @brief Compute a FHT.
+ * This function computes the FHT and returns the Ruby Array with the same size
+ * as input.
+ * @see fht_kernel()
+ * @author placek@ragnarson.com
+ * @param values An array of processing data.
+ * @params length Length of processing data.
+ * @return An Ruby Array with FHT processed data.
+ */
+static VALUE perform_fht(double * values, long length)
+{
+    ft_perform_job(FT_JOB_FHT, values, NULL, length, 1);
+    return real_to_ruby(values, length);
+}
+
+/**
+ * @brief Compute a DHT.
+ * This function computes the DHT and returns the Ruby Array with the same size
+ * as input.
+ * @see dht_kernel()
+ * @author placek@ragnarson.com
+ * @param values An array of processing data.
+ * @params length Length of processing data.
+ * @return An Ruby Array with DHT processed data.
+ */
+static VALUE perform_dht(double * values, long length)
+{
+    ft_perform_job(FT_JOB_DHT, values, NULL, length, 1);
+    return real_to_ruby(values, length);
+}
+
 /**
  * @brief Prepare data to be processed.
  * This function converts a Ruby Array values into a C values to be processed
@@ -363,9 +575,10 @@ static VALUE perform_dht(double * values, long length)
  * @author jude.sutton@gmail.com
  * @params inArray A Ruby input data array.
  * @params direction An FFT direction (1 - forward FFT, -1 - reverse FFT).
+ * @params shift TRUE to return the spectrum shifted like by fftshift.
  * @return The output Ruby Array with FFT processed data.
  */
-static VALUE prepare_fft(VALUE inArray, int direction)
+static VALUE prepare_fft(VALUE inArray, int direction, int shift)
 {
     long i, length;
     VALUE * values;
@@ -388,7 +601,7 @@ static VALUE prepare_fft(VALUE inArray, int direction)
     }
 
     // do the actual transform
-    outArray = perform_fft(transformed, length, direction);
+    outArray = perform_fft(transformed, length, direction, shift);
 
     // no memory leaks
     free(transformed[0]);
@@ -577,73 +790,31 @@ static VALUE magnitude(VALUE inArray)
 
 /**
  * @brief Prepare data and switch quarters.
- * This function switches quarters for further frequency processing.
+ * This function switches quarters for further frequency processing. It is
+ * the two dimensional fftshift, so odd sizes are handled too.
+ * @see ft_shift_ruby()
  * @author placek@ragnarson.com
  * @params inArray A Ruby input data array.
  * @return The output Ruby Array with switched data.
  */
 static VALUE switch_quarters(VALUE inArray)
 {
-    long length_x, length_y;
-    long i, j;
-    VALUE * values, outArray;
-    double ** temp_values, temp;
-
-    // get dimensions
-    values = RARRAY_PTR(inArray);
-    length_y = RARRAY_LEN(inArray);
-    length_x = RARRAY_LEN(values[0]);
-
-    // get values
-    temp_values = (double**)malloc(length_y * sizeof(double*));
-    for(j = 0; j < length_y; j++)
-    {
-        temp_values[j] = (double*)malloc(length_x * sizeof(double));
-        for(i = 0; i < length_x; i++)
-            temp_values[j][i] = NUM2DBL(RARRAY_PTR(values[j])[i]);
-    }
-    outArray = rb_ary_new2(length_y);
-
-    // process switching
-    for(i = 0; i < length_x / 2; i++)
-        for(j = 0; j < length_y / 2; j++)
-        {
-            temp = temp_values[j][i];
-            temp_values[j][i] = temp_values[j + length_y / 2][i + length_x / 2];
-            temp_values[j + length_y / 2][i + length_x / 2] = temp;
-        }
-
-    for(i = length_x / 2; i < length_x; i++)
-        for(j = 0; j < length_y / 2; j++)
-        {
-            temp = temp_values[j][i];
-            temp_values[j][i] = temp_values[j + length_y / 2][i - length_x / 2];
-            temp_values[j + length_y / 2][i - length_x / 2] = temp;
-        }
-
-    // rewrite values to ruby table
-    for(j = 0; j < length_y; j++)
-    {
-        VALUE tempArray = rb_ary_new2(length_x);
-        for(i = 0; i < length_x; i++)
-            rb_ary_push(tempArray, DBL2NUM(temp_values[j][i]));
-        rb_ary_push(outArray, tempArray);
-        free(temp_values[j]);
-    }
-    free(temp_values);
-
-    return outArray;
+    return ft_shift_ruby(inArray, FALSE);
 }
 
 /**
  * @brief Compute a forward FFT.
+ * fft(shift: true) returns the spectrum shifted like by fftshift.
  * @author jude.sutton@gmail.com
  * @params self A Ruby input data array.
  * @return A result of forward FFT.
  */
-static VALUE forward_fft(VALUE self)
+static VALUE forward_fft(int argc, VALUE * argv, VALUE self)
 {
-    return prepare_fft(self, 1);
+    VALUE options;
+
+    rb_scan_args(argc, argv, "0:", &options);
+    return prepare_fft(self, 1, ft_shift_option(options));
 }
 
 /**
@@ -654,7 +825,7 @@ static VALUE forward_fft(VALUE self)
  */
 static VALUE reverse_fft(VALUE self)
 {
-    return prepare_fft(self, -1);
+    return prepare_fft(self, -1, FALSE);
 }
 
 /**
@@ -701,6 +872,31 @@ static VALUE forward_dht(VALUE self)
     return prepare_dht(self);
 }
 
+/**
+ * @brief Compute a reverse FHT.
+ * The Hartley transform scaled by 1 / sqrt(length) is its own inverse,
+ * so this is the same computation as the forward one.
+ * @author placek@ragnarson.com
+ * @params self A Ruby input data array.
+ * @return A result of reverse FHT.
+ */
+static VALUE reverse_fht(VALUE self)
+{
+    return prepare_fht(self);
+}
+
+/**
+ * @brief Compute a reverse DHT.
+ * @see reverse_fht()
+ * @author placek@ragnarson.com
+ * @params self A Ruby input data array.
+ * @return A result of reverse DHT.
+ */
+static VALUE reverse_dht(VALUE self)
+{
+    return prepare_dht(self);
+}
+
 /**
  * @brief Initialize the FrequencyTransformations module.
  * Initializes the module and defines methods.
@@ -710,13 +906,36 @@ VALUE FT;
 void Init_frequency_transformations()
 {
     FT = rb_define_module("FrequencyTransformations");
-    rb_define_method(FT, "fft", forward_fft, 0);
+    rb_define_method(FT, "fft", forward_fft, -1);
     rb_define_method(FT, "rfft", reverse_fft, 0);
     rb_define_method(FT, "dft", forward_dft, 0);
     rb_define_method(FT, "rdft", reverse_dft, 0);
     rb_define_method(FT, "dht", forward_dht, 0);
     rb_define_method(FT, "fht", forward_fht, 0);
+    rb_define_method(FT, "rdht", reverse_dht, 0);
+    rb_define_method(FT, "rfht", reverse_fht, 0);
     rb_define_method(FT, "switch_quarters", switch_quarters, 0);
     rb_define_method(FT, "magnitude", magnitude, 0);
     rb_define_method(FT, "phase", phase, 0);
+
+    Init_plan();
+    Init_transform2d();
+    Init_real_fft();
+    Init_buffer();
+    Init_parallel();
+    Init_simd();
+    Init_single();
+    Init_goertzel();
+    Init_stft();
+    Init_convolution();
+    Init_spectrum();
+    Init_shift();
+    Init_transform_nd();
+    Init_file_fft();
+    Init_batch_fft();
+    Init_complex_vector();
+    Init_sliding_dft();
+    Init_zoom_fft();
+    Init_dct();
+    Init_wisdom();
 }
@@ -0,0 +1,305 @@
+/**
+ * @file frequency_transformations.h
+ * @brief Declarations shared between the translation units of the extension.
+ * @author placek@ragnarson.com
+ */
+#ifndef FREQUENCY_TRANSFORMATIONS_H
+#define FREQUENCY_TRANSFORMATIONS_H
+
+#include "ruby.h"
+#include <math.h>
+#include <stdlib.h>
+
+#ifdef HAVE_RUBY_MEMORY_VIEW_H
+#include "ruby/memory_view.h"
+#endif
+
+#ifdef WORDS_BIGENDIAN
+#define FT_BIG_ENDIAN 1
+#else
+#define FT_BIG_ENDIAN 0
+#endif
+
+#ifndef TRUE
+#define TRUE 1
+#define FALSE 0
+#endif
+
+/**
+ * @brief The FrequencyTransformations module.
+ */
+extern VALUE FT;
+
+#define FT_RADIX2 0
+#define FT_MIXED_RADIX 1
+#define FT_BLUESTEIN 2
+#define FT_FOUR_STEP 3
+
+/**
+ * @brief Power of 2 length from which plans use the four-step algorithm.
+ * Below it the data fits in the last level cache of most machines and the
+ * radix-2 passes are faster; can be set at build time.
+ */
+#ifndef FT_FOUR_STEP_THRESHOLD
+#define FT_FOUR_STEP_THRESHOLD (1L << 22)
+#endif
+
+#define FT_MAX_FACTORS 64
+
+#define FT_FLOAT64 0
+#define FT_FLOAT32 1
+
+/**
+ * @brief A precomputed FFT plan.
+ * Holds everything that depends only on the transform size and direction:
+ * the bit-reversal permutation or the factorization of the length, the table
+ * of transform factors and the scratch buffers used to unbox data of the
+ * Ruby calls (allocated by the first call of a FT::Plan). Radix-2 plans
+ * keep the factors of every stage in a row (the step s at s - 1), so
+ * butterfly passes read them contiguously.
+ * Lengths with a prime factor above 7 are computed with the Bluestein
+ * algorithm on top of two power of 2 plans, large powers of 2 with the
+ * four-step algorithm on top of two plans of about the square root length.
+ * Plans prepared for single precision also keep float copies of the radix-2
+ * factors and float buffers. Plans of lengths with wisdom (see wisdom.c)
+ * use the measured algorithm, and radix-2 ones the measured butterfly
+ * passes (kernels, NULL for the instruction set in use) and codelets.
+ */
+struct ft_simd_kernels;
+
+typedef struct ft_plan
+{
+    long length;
+    int direction;
+    int algorithm;
+    double scale;
+    long * reversed;
+    double * twiddle_real;
+    double * twiddle_imag;
+    long factors[2 * FT_MAX_FACTORS];
+    long padded_length;
+    double * chirp_real;
+    double * chirp_imag;
+    double * filter_real;
+    double * filter_imag;
+    struct ft_plan * inner[2];
+    double * scratch;
+    double * buffer[2];
+    int busy;
+    int precision;
+    float * single_twiddle_real;
+    float * single_twiddle_imag;
+    float * single_buffer[2];
+    const struct ft_simd_kernels * kernels;
+    int codelet;
+} ft_plan;
+
+/**
+ * @brief The fastest way to compute FFTs of one length, measured by FT.tune.
+ * simd is an instruction set (FT_SIMD_*) of radix-2 plans, -1 for the one
+ * in use; time is the measured seconds per transform.
+ */
+typedef struct
+{
+    long length;
+    int algorithm;
+    int simd;
+    int codelet;
+    double time;
+} ft_wisdom;
+
+ft_plan * ft_plan_create(long length, int direction);
+ft_plan * ft_plan_create_with(long length, int direction, const ft_wisdom * wisdom);
+int ft_plan_supports(long length, int algorithm);
+int ft_wisdom_lookup(long length, ft_wisdom * wisdom);
+VALUE ft_algorithm_to_ruby(int algorithm);
+void ft_plan_execute(const ft_plan * plan, double * real, double * imag);
+void ft_plan_execute_scratch(const ft_plan * plan, double * real, double * imag, double * scratch);
+long ft_plan_scratch_length(const ft_plan * plan);
+void ft_plan_execute_without_gvl(ft_plan * plan, double * real, double * imag);
+void ft_plan_free(ft_plan * plan);
+size_t ft_plan_memsize(const ft_plan * plan);
+
+void ft_plan_make_single(ft_plan * plan);
+void ft_plan_execute_single(const ft_plan * plan, float * real, float * imag);
+void ft_plan_execute_single_without_gvl(const ft_plan * plan, float * real, float * imag, int hartley);
+void ft_fht_single(const ft_plan * plan, float * values, float * work);
+int ft_precision(VALUE options);
+int ft_precision_value(VALUE precision);
+VALUE ft_precision_to_ruby(int precision);
+
+/**
+ * @brief A precomputed FFT plan of real data.
+ * Even lengths are computed by a complex plan of half the length,
+ * odd lengths by a complex plan of the full length.
+ */
+typedef struct
+{
+    long length;
+    int direction;
+    ft_plan * complex;
+    double * twiddle_real;
+    double * twiddle_imag;
+    double * work[2];
+} ft_real_plan;
+
+ft_real_plan * ft_real_plan_create(long length, int direction);
+void ft_real_plan_forward(const ft_real_plan * plan, const double * values, double * real, double * imag);
+void ft_real_plan_inverse(const ft_real_plan * plan, const double * real, const double * imag, double * values);
+void ft_real_plan_free(ft_real_plan * plan);
+void ft_real_plan_forward_without_gvl(const ft_real_plan * plan, const double * values, double * real, double * imag);
+void ft_real_plan_inverse_without_gvl(const ft_real_plan * plan, const double * real, const double * imag, double * values);
+
+/**
+ * @brief A packed buffer of doubles (or floats) opened for reading.
+ * Points either into a String (little-endian values) or into a memory
+ * view of native values.
+ */
+typedef struct
+{
+    VALUE object;
+    const char * data;
+    long size;
+    int precision;
+    int swap;
+    int view_taken;
+#ifdef HAVE_RUBY_MEMORY_VIEW_H
+    rb_memory_view_t view;
+#endif
+} ft_buffer;
+
+void ft_buffer_open(VALUE object, ft_buffer * buffer, int precision);
+void ft_buffer_close(ft_buffer * buffer);
+VALUE ft_buffer_output(VALUE output, long size);
+void ft_buffer_read_complex(const ft_buffer * buffer, double * real, double * imag, long length);
+void ft_buffer_read_real(const ft_buffer * buffer, double * values, long length);
+void ft_buffer_write_complex(char * data, const double * real, const double * imag, long length);
+void ft_buffer_write_real(char * data, const double * values, long length);
+void ft_buffer_read_complex_single(const ft_buffer * buffer, float * real, float * imag, long length);
+void ft_buffer_read_real_single(const ft_buffer * buffer, float * values, long length);
+void ft_buffer_write_complex_single(char * data, const float * real, const float * imag, long length);
+void ft_buffer_write_real_single(char * data, const float * values, long length);
+double ft_buffer_load(const char * data, int precision);
+void ft_buffer_store(char * data, double value, int precision);
+
+int fourier_validate(VALUE self);
+int hartley_validate(VALUE self);
+
+void fft_kernel(double * real, double * imag, long length, int direction);
+void dft_kernel(double * real, double * imag, long length, int direction);
+void fht_kernel(double * values, long length);
+void dht_kernel(double * values, long length);
+/**
+ * @brief Longest transform computed by an unrolled codelet (see codelets.c).
+ */
+#define FT_CODELET_MAX 64
+
+int ft_codelet_fft(double * real, double * imag, long length, int direction);
+int ft_codelet_fht(double * values, long length);
+void ft_goertzel(const double * real, const double * imag, long length, double bin,
+    double * out_real, double * out_imag);
+
+#define FT_JOB_FFT 0
+#define FT_JOB_DFT 1
+#define FT_JOB_FHT 2
+#define FT_JOB_DHT 3
+
+/**
+ * @brief A single transform of data held in C memory.
+ * Hartley transforms use only the real parts.
+ */
+typedef struct
+{
+    int kind;
+    int direction;
+    long length;
+    double * real;
+    double * imag;
+} ft_job;
+
+void * ft_job_run(void * data);
+long ft_job_work(const ft_job * job);
+void ft_perform_job(int kind, double * real, double * imag, long length, int direction);
+
+void ft_without_gvl(void * (* func)(void *), void * data, long work);
+void ft_parallel_for(long count, void (* func)(long index, void * data), void * data);
+int ft_thread_count(void);
+
+#define FT_SIMD_SCALAR 0
+#define FT_SIMD_SSE2 1
+#define FT_SIMD_AVX2 2
+#define FT_SIMD_AVX512 3
+
+/**
+ * @brief Butterfly passes of the radix-2 plans for one instruction set.
+ * A radix-2 pass computes one stage of the decimation in time, a radix-4
+ * pass two consecutive stages at once. Both walk each group of butterflies
+ * with contiguous loads of data and of the per stage table of factors.
+ * Single precision passes fit twice as many values in a vector. The
+ * magnitude pass turns a spectrum into its magnitudes. Batch passes compute
+ * a stage of batch_width transforms interleaved element by element.
+ */
+typedef struct ft_simd_kernels
+{
+    int isa;
+    void (* radix2)(double * real, double * imag, long length, long step,
+        const double * factor_real, const double * factor_imag);
+    void (* radix4)(double * real, double * imag, long length, long step,
+        const double * factor_real, const double * factor_imag,
+        const double * next_real, const double * next_imag);
+    void (* radix2_float)(float * real, float * imag, long length, long step,
+        const float * factor_real, const float * factor_imag);
+    void (* radix4_float)(float * real, float * imag, long length, long step,
+        const float * factor_real, const float * factor_imag,
+        const float * next_real, const float * next_imag);
+    void (* magnitude)(const double * real, const double * imag, double * out, long length);
+    long batch_width;
+    void (* batch_radix2)(double * real, double * imag, long length, long step,
+        const double * factor_real, const double * factor_imag);
+    long batch_width_float;
+    void (* batch_radix2_float)(float * real, float * imag, long length, long step,
+        const float * factor_real, const float * factor_imag);
+} ft_simd_kernels;
+
+const ft_simd_kernels * ft_simd(void);
+const ft_simd_kernels * ft_simd_kernels_for(int isa);
+
+VALUE complex_to_ruby(const double * real, const double * imag, long length);
+VALUE real_to_ruby(const double * values, long length);
+VALUE complex_single_to_ruby(const float * real, const float * imag, long length);
+
+void transpose_blocked(const double * in, double * out, long rows, long columns);
+
+#define FT_MAX_DIMS 32
+
+long ft_shift_offset(long length, int inverse);
+void ft_shift(double * values, const long * shape, int dims, int inverse);
+int ft_shift_option(VALUE options);
+VALUE ft_shift_ruby(VALUE inArray, int inverse);
+int ft_nd_shape(VALUE inArray, long * shape);
+long ft_nd_from_ruby(VALUE inArray, double * values, const long * shape, int dims);
+VALUE ft_nd_to_ruby(const double * values, const long * shape, int dims, const long * offsets);
+void ft_transform_nd(double * real, double * imag, const long * shape, const long * strides, int dims, int direction);
+
+void Init_plan(void);
+void Init_transform2d(void);
+void Init_real_fft(void);
+void Init_buffer(void);
+void Init_parallel(void);
+void Init_simd(void);
+void Init_single(void);
+void Init_goertzel(void);
+void Init_stft(void);
+void Init_convolution(void);
+void Init_spectrum(void);
+void Init_shift(void);
+void Init_transform_nd(void);
+void Init_file_fft(void);
+void Init_batch_fft(void);
+void Init_complex_vector(void);
+void Init_sliding_dft(void);
+void Init_zoom_fft(void);
+void Init_dct(void);
+void Init_wisdom(void);
+
+#endif
@@ -0,0 +1,137 @@
+# Generates codelets.h: straight-line FFT and FHT kernels of powers of 2
+# from 2 to 64 points with the transform factors as constants.
+#
+#   ruby ext/generate_codelets.rb > ext/codelets.h    # or: rake codelets
+#
+# The FFT codelets are the radix-2 decimation in time of fft_kernel() and
+# the FHT codelets the algorithm of fht_kernel(), unrolled: the data is
+# loaded into locals in bit-reversed order, every butterfly is written out
+# (factors 1 and -+i without multiplications) and the results are stored.
+MAX_LOG2 = 6
+
+def reversed(index, bits)
+  index.to_s(2).rjust(bits, '0').reverse.to_i(2)
+end
+
+def constant(value)
+  value = 0.0 if value.abs < 1.0e-15
+  value.to_s
+end
+
+def fft_codelet(log2, direction)
+  n = 1 << log2
+  name = "fft_codelet_#{n}_#{direction == 1 ? 'forward' : 'reverse'}"
+  lines = []
+  lines << "static void #{name}(double * real, double * imag)"
+  lines << '{'
+  n.times { |k| lines << "    double r#{k} = real[#{reversed(k, log2)}], i#{k} = imag[#{reversed(k, log2)}];" }
+  lines << '    double tr, ti;'
+  lines << ''
+  step = 1
+  while step < n
+    lines << "    // stage of step #{step}"
+    (0...n).step(2 * step) do |base|
+      step.times do |k|
+        a = base + k
+        b = a + step
+        # factor exp(-+2 pi i k / (2 step))
+        if k == 0
+          lines << "    tr = r#{b}; ti = i#{b};"
+        elsif 2 * k == step
+          # -i (forward) or i (reverse)
+          lines << (direction == 1 ? "    tr = i#{b}; ti = -r#{b};" : "    tr = -i#{b}; ti = r#{b};")
+        else
+          arg = Math::PI * k / step
+          c = constant(Math.cos(arg))
+          s = constant(-direction * Math.sin(arg))
+          lines << "    tr = r#{b} * #{c} - i#{b} * #{s}; ti = r#{b} * #{s} + i#{b} * #{c};"
+        end
+        lines << "    r#{b} = r#{a} - tr; i#{b} = i#{a} - ti; r#{a} += tr; i#{a} += ti;"
+      end
+    end
+    step <<= 1
+  end
+  lines << ''
+  n.times { |k| lines << "    real[#{k}] = r#{k}; imag[#{k}] = i#{k};" }
+  lines << '}'
+  [name, lines]
+end
+
+def fht_codelet(log2)
+  n = 1 << log2
+  name = "fht_codelet_#{n}"
+  lines = []
+  lines << "static void #{name}(double * values)"
+  lines << '{'
+  n.times { |k| lines << "    double v#{k} = values[#{reversed(k, log2)}];" }
+  lines << '    double a, b;'
+  lines << ''
+  scale = n / 2
+  level = 2
+  while level <= n
+    lines << "    // level #{level}"
+    (0...n).step(level) do |group|
+      i = 1
+      position = group + level / 2 + 1
+      match = group + level - 1
+      while position < match
+        arg = 2.0 * Math::PI * (i * scale) / n
+        c = constant(Math.cos(arg))
+        s = constant(Math.sin(arg))
+        lines << "    a = v#{position}; b = v#{match};"
+        lines << "    v#{position} = a * #{c} + b * #{s}; v#{match} = a * #{s} - b * #{c};"
+        i += 1
+        position += 1
+        match -= 1
+      end
+      (level / 2).times do |k|
+        position = group + k
+        match = position + level / 2
+        lines << "    a = v#{position}; b = v#{match}; v#{position} = a + b; v#{match} = a - b;"
+      end
+    end
+    scale >>= 1
+    level <<= 1
+  end
+  lines << ''
+  n.times { |k| lines << "    values[#{k}] = v#{k} * #{constant(1.0 / Math.sqrt(n))};" }
+  lines << '}'
+  [name, lines]
+end
+
+puts <<HEADER
+/**
+ * @file codelets.h
+ * @brief Unrolled FFT and FHT kernels of 2 to #{1 << MAX_LOG2} points.
+ * Generated by generate_codelets.rb, do not edit. Included by codelets.c.
+ * @author placek@ragnarson.com
+ */
+HEADER
+
+tables = { 'forward' => [], 'reverse' => [], 'fht' => [] }
+(1..MAX_LOG2).each do |log2|
+  [[1, 'forward'], [-1, 'reverse']].each do |direction, table|
+    name, lines = fft_codelet(log2, direction)
+    tables[table] << name
+    puts
+    puts lines
+  end
+  name, lines = fht_codelet(log2)
+  tables['fht'] << name
+  puts
+  puts lines
+end
+
+puts
+puts '// codelets indexed by log2 of the length (none for one point)'
+%w(forward reverse).each do |table|
+  puts "static void (* const fft_codelets_#{table}[])(double *, double *) ="
+  puts '{'
+  puts "    NULL, #{tables[table].join(', ')}"
+  puts '};'
+  puts
+end
+puts 'static void (* const fht_codelets[])(double *) ='
+puts '{'
+puts "    NULL, #{tables['fht'].join(', ')}"
+puts '};'
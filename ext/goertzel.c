@@ -0,0 +1,147 @@
+/**
+ * @file goertzel.c
+ * @brief Selected bins of a DFT computed with the Goertzel algorithm.
+ * Each bin is a second order recurrence over the data with a single real
+ * coefficient, so k bins of N values cost O(N * k) multiplications and
+ * additions and two trigonometric calls per bin. That beats a full FFT
+ * when only a few bins (tones, carriers) are needed, for any length.
+ * @author placek@ragnarson.com
+ */
+#include "frequency_transformations.h"
+
+/**
+ * @brief Compute one bin of the DFT of complex data.
+ * The recurrence s[n] = x[n] + 2 cos(w) s[n - 1] - s[n - 2] runs on the
+ * real and imaginary parts at once, then
+ * X(w) = exp(-i w (N - 1)) (s[N - 1] - exp(-i w) s[N - 2]).
+ * The bin does not need to be an integer.
+ * @author placek@ragnarson.com
+ * @param real Real parts of data.
+ * @param imag Imaginary parts of data.
+ * @param length Length of data.
+ * @param bin An index of the bin (frequency in cycles per length).
+ * @param out_real Place for the real part of the bin.
+ * @param out_imag Place for the imaginary part of the bin.
+ */
+void ft_goertzel(const double * real, const double * imag, long length, double bin,
+    double * out_real, double * out_imag)
+{
+    long n;
+    double w = 2.0 * M_PI * bin / (double)length;
+    double coeff = 2.0 * cos(w);
+    double re1 = 0.0, re2 = 0.0, im1 = 0.0, im2 = 0.0, re, im;
+    double y_re, y_im, c, s;
+
+    for(n = 0; n < length; n++)
+    {
+        re = real[n] + coeff * re1 - re2;
+        im = imag[n] + coeff * im1 - im2;
+        re2 = re1;
+        re1 = re;
+        im2 = im1;
+        im1 = im;
+    }
+
+    // y = s[N - 1] - exp(-i w) s[N - 2]
+    c = cos(w);
+    s = sin(w);
+    y_re = re1 - (c * re2 + s * im2);
+    y_im = im1 - (c * im2 - s * re2);
+
+    // rotate by exp(-i w (N - 1))
+    c = cos(w * (double)(length - 1));
+    s = sin(w * (double)(length - 1));
+    *out_real = y_re * c + y_im * s;
+    *out_imag = y_im * c - y_re * s;
+}
+
+/**
+ * @brief Selected bins of data held in C memory.
+ */
+typedef struct
+{
+    const double * real;
+    const double * imag;
+    long length;
+    const double * bins;
+    long count;
+    double * out[2];
+} goertzel_call;
+
+static void * goertzel_run(void * data)
+{
+    goertzel_call * call = data;
+    long k;
+
+    for(k = 0; k < call->count; k++)
+        ft_goertzel(call->real, call->imag, call->length, call->bins[k], call->out[0] + k, call->out[1] + k);
+    return NULL;
+}
+
+/**
+ * @brief Compute selected bins of a DFT.
+ * [real, imag].dft_bins(indices) gives the same values as
+ * [real, imag].dft at the indices, in the order of the indices.
+ * @see ft_goertzel()
+ * @author placek@ragnarson.com
+ * @params self A Ruby input data array (real and imaginary parts).
+ * @params indices An Array of bins (fractional bins are allowed).
+ * @return The output Ruby Array with real and imaginary parts of the bins
+ * (nil for invalid data).
+ */
+static VALUE dft_bins(VALUE self, VALUE indices)
+{
+    long i, length, count;
+    VALUE * values;
+    double * data[2], * bins;
+    goertzel_call call;
+    VALUE outArray;
+
+    Check_Type(indices, T_ARRAY);
+    if(!fourier_validate(self))
+        return Qnil;
+
+    // convert the ruby arrays into C arrays
+    values = RARRAY_PTR(self);
+    length = RARRAY_LEN(values[0]);
+    count = RARRAY_LEN(indices);
+    data[0] = malloc(length * sizeof(double));
+    data[1] = malloc(length * sizeof(double));
+    bins = malloc((count + 1) * sizeof(double));
+    call.out[0] = malloc((count + 1) * sizeof(double));
+    call.out[1] = malloc((count + 1) * sizeof(double));
+    for(i = 0; i < length; i++)
+    {
+        data[0][i] = NUM2DBL(RARRAY_PTR(values[0])[i]);
+        data[1][i] = NUM2DBL(RARRAY_PTR(values[1])[i]);
+    }
+    for(i = 0; i < count; i++)
+        bins[i] = NUM2DBL(RARRAY_PTR(indices)[i]);
+
+    // do the actual transform
+    call.real = data[0];
+    call.imag = data[1];
+    call.length = length;
+    call.bins = bins;
+    call.count = count;
+    ft_without_gvl(goertzel_run, &call, length * count);
+    outArray = complex_to_ruby(call.out[0], call.out[1], count);
+
+    // no memory leaks
+    free(data[0]);
+    free(data[1]);
+    free(bins);
+    free(call.out[0]);
+    free(call.out[1]);
+
+    return outArray;
+}
+
+/**
+ * @brief Define the selected bins method.
+ * @author placek@ragnarson.com
+ */
+void Init_goertzel(void)
+{
+    rb_define_method(FT, "dft_bins", dft_bins, 1);
+}
@@ -0,0 +1,471 @@
+/**
+ * @file parallel.c
+ * @brief Running transforms without the GVL and on native worker threads.
+ * Large transforms release the GVL, so other Ruby threads can run meanwhile.
+ * FT.batch computes many independent transforms on a pool of native threads
+ * sized to the number of cores. The workers are started by the first loop
+ * that needs them and then sleep between loops, so short batches do not
+ * pay for creating threads.
+ * @author placek@ragnarson.com
+ */
+#include "frequency_transformations.h"
+
+#ifdef HAVE_RUBY_THREAD_H
+#include "ruby/thread.h"
+#endif
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+#endif
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Number of operations above which the GVL is released.
+ */
+#define FT_GVL_THRESHOLD 32768
+
+static int threads = 0;
+static ID id_fft, id_rfft, id_dft, id_rdft, id_fht, id_rfht, id_dht, id_rdht;
+
+/**
+ * @brief Call a function without the GVL.
+ * Small amounts of work are done with the GVL held, as releasing and
+ * acquiring it again would cost more than the work itself.
+ * @author placek@ragnarson.com
+ * @param func A function which does not touch any Ruby object.
+ * @param data An argument of the function.
+ * @param work Rough number of operations done by the function.
+ */
+void ft_without_gvl(void * (* func)(void *), void * data, long work)
+{
+#ifdef HAVE_RUBY_THREAD_H
+    if(work >= FT_GVL_THRESHOLD)
+    {
+        rb_thread_call_without_gvl(func, data, NULL, NULL);
+        return;
+    }
+#endif
+    func(data);
+}
+
+/**
+ * @brief Get the number of worker threads.
+ * @author placek@ragnarson.com
+ * @return Number set by FT.threads= or the number of online processors.
+ */
+int ft_thread_count(void)
+{
+    long count = 1;
+
+    if(threads > 0)
+        return threads;
+#ifdef _SC_NPROCESSORS_ONLN
+    count = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    return count > 0 ? (int)count : 1;
+}
+
+/**
+ * @brief A loop shared by worker threads.
+ */
+typedef struct
+{
+    long count;
+    long next;
+    void (* func)(long index, void * data);
+    void * data;
+#ifdef HAVE_PTHREAD_H
+    pthread_mutex_t mutex;
+#endif
+} parallel_loop;
+
+/**
+ * @brief Take iterations of a loop until all are done.
+ * @author placek@ragnarson.com
+ * @param ptr A loop (parallel_loop).
+ * @return NULL.
+ */
+static void * parallel_worker(void * ptr)
+{
+    parallel_loop * loop = ptr;
+    long index;
+
+    for(;;)
+    {
+#ifdef HAVE_PTHREAD_H
+        pthread_mutex_lock(&loop->mutex);
+#endif
+        index = loop->next++;
+#ifdef HAVE_PTHREAD_H
+        pthread_mutex_unlock(&loop->mutex);
+#endif
+        if(index >= loop->count)
+            break;
+        loop->func(index, loop->data);
+    }
+
+    return NULL;
+}
+
+#ifdef HAVE_PTHREAD_H
+/**
+ * @brief The pool of worker threads.
+ * A loop on the pool offers seats to the sleeping workers; a worker takes
+ * a seat, works on the loop until it is done and sleeps again. One loop
+ * runs on the pool at a time (owner).
+ */
+typedef struct
+{
+    pthread_mutex_t mutex;
+    pthread_cond_t wake;
+    pthread_cond_t done;
+    pthread_mutex_t owner;
+    parallel_loop * loop;
+    long size;
+    long seats;
+    long running;
+} worker_pool;
+
+static worker_pool pool = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER,
+    PTHREAD_COND_INITIALIZER, PTHREAD_MUTEX_INITIALIZER, NULL, 0, 0, 0 };
+
+/**
+ * @brief Work on the loops of the pool (a worker thread).
+ * @author placek@ragnarson.com
+ * @param ptr Not used.
+ * @return Never returns.
+ */
+static void * pool_worker(void * ptr)
+{
+    parallel_loop * loop;
+
+    pthread_mutex_lock(&pool.mutex);
+    for(;;)
+    {
+        while(!pool.loop || !pool.seats)
+            pthread_cond_wait(&pool.wake, &pool.mutex);
+        pool.seats--;
+        pool.running++;
+        loop = pool.loop;
+        pthread_mutex_unlock(&pool.mutex);
+
+        parallel_worker(loop);
+
+        pthread_mutex_lock(&pool.mutex);
+        if(--pool.running == 0)
+            pthread_cond_signal(&pool.done);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Start workers until the pool has the given size (pool locked).
+ * @author placek@ragnarson.com
+ * @param size Number of workers.
+ */
+static void pool_grow(long size)
+{
+    pthread_t id;
+
+    while(pool.size < size && pthread_create(&id, NULL, pool_worker, NULL) == 0)
+    {
+        pthread_detach(id);
+        pool.size++;
+    }
+}
+
+/**
+ * @brief Forget the workers of the parent in a forked process.
+ * @author placek@ragnarson.com
+ */
+static void pool_after_fork(void)
+{
+    pthread_mutex_init(&pool.mutex, NULL);
+    pthread_cond_init(&pool.wake, NULL);
+    pthread_cond_init(&pool.done, NULL);
+    pthread_mutex_init(&pool.owner, NULL);
+    pool.loop = NULL;
+    pool.size = pool.seats = pool.running = 0;
+}
+#endif
+
+/**
+ * @brief Run iterations of a loop on worker threads.
+ * The calling thread works too. Iterations are handed out one by one,
+ * so jobs of different sizes are balanced between threads. A loop started
+ * while the pool is busy with another one (from another Ruby thread or
+ * inside an iteration) is run by the calling thread alone, and so is every
+ * loop where threads are not available.
+ * @author placek@ragnarson.com
+ * @param count Number of iterations.
+ * @param func A function called for each index (must not touch Ruby objects).
+ * @param data An argument of the function.
+ */
+void ft_parallel_for(long count, void (* func)(long index, void * data), void * data)
+{
+    parallel_loop loop;
+    long workers = ft_thread_count();
+
+    loop.count = count;
+    loop.next = 0;
+    loop.func = func;
+    loop.data = data;
+
+    if(workers > count)
+        workers = count;
+
+#ifdef HAVE_PTHREAD_H
+    pthread_mutex_init(&loop.mutex, NULL);
+    if(workers > 1 && pthread_mutex_trylock(&pool.owner) == 0)
+    {
+        pthread_mutex_lock(&pool.mutex);
+        pool_grow(workers - 1);
+        pool.loop = &loop;
+        pool.seats = workers - 1 < pool.size ? workers - 1 : pool.size;
+        pthread_cond_broadcast(&pool.wake);
+        pthread_mutex_unlock(&pool.mutex);
+
+        parallel_worker(&loop);
+
+        // the loop lives on this stack, so wait for the workers that took a seat
+        pthread_mutex_lock(&pool.mutex);
+        pool.loop = NULL;
+        pool.seats = 0;
+        while(pool.running)
+            pthread_cond_wait(&pool.done, &pool.mutex);
+        pthread_mutex_unlock(&pool.mutex);
+        pthread_mutex_unlock(&pool.owner);
+    }
+    else
+        parallel_worker(&loop);
+    pthread_mutex_destroy(&loop.mutex);
+#else
+    parallel_worker(&loop);
+#endif
+}
+
+/**
+ * @brief Jobs of a batch.
+ */
+typedef struct
+{
+    VALUE list;
+    long count;
+    long work;
+    ft_job * jobs;
+} batch;
+
+static void batch_job(long index, void * data)
+{
+    batch * jobs = data;
+    if(jobs->jobs[index].real)
+        ft_job_run(&jobs->jobs[index]);
+}
+
+static void * batch_run(void * data)
+{
+    batch * jobs = data;
+    long i;
+
+    // small batches are not worth starting threads
+    if(jobs->work < FT_GVL_THRESHOLD)
+        for(i = 0; i < jobs->count; i++)
+            batch_job(i, jobs);
+    else
+        ft_parallel_for(jobs->count, batch_job, jobs);
+
+    return NULL;
+}
+
+/**
+ * @brief Release memory of a batch.
+ */
+static VALUE batch_free(VALUE data)
+{
+    batch * jobs = (batch *)data;
+    long i;
+
+    for(i = 0; i < jobs->count; i++)
+    {
+        free(jobs->jobs[i].real);
+        free(jobs->jobs[i].imag);
+    }
+    free(jobs->jobs);
+
+    return Qnil;
+}
+
+/**
+ * @brief Unbox data of a single job of a batch.
+ * Invalid data leaves the job empty (its result will be nil).
+ * @author placek@ragnarson.com
+ * @param job A job with kind and direction set.
+ * @param inArray A Ruby input data array.
+ */
+static void batch_prepare(ft_job * job, VALUE inArray)
+{
+    long i, length;
+    VALUE * values;
+
+    // other objects than arrays leave the job empty as well
+    if(TYPE(inArray) != T_ARRAY)
+        return;
+
+    if(job->kind == FT_JOB_FHT || job->kind == FT_JOB_DHT)
+    {
+        if(!hartley_validate(inArray))
+            return;
+        length = RARRAY_LEN(inArray);
+        values = RARRAY_PTR(inArray);
+        job->real = malloc(length * sizeof(double));
+        job->length = length;
+        for(i = 0; i < length; i++)
+            job->real[i] = NUM2DBL(values[i]);
+        return;
+    }
+
+    if(!fourier_validate(inArray))
+        return;
+    values = RARRAY_PTR(inArray);
+    length = RARRAY_LEN(values[0]);
+    job->real = malloc(length * sizeof(double));
+    job->imag = malloc(length * sizeof(double));
+    job->length = length;
+    for(i = 0; i < length; i++)
+    {
+        job->real[i] = NUM2DBL(RARRAY_PTR(values[0])[i]);
+        job->imag[i] = NUM2DBL(RARRAY_PTR(values[1])[i]);
+    }
+}
+
+/**
+ * @brief Unbox data of a batch, run it and box the results.
+ */
+static VALUE batch_body(VALUE data)
+{
+    batch * jobs = (batch *)data;
+    ft_job * job;
+    VALUE outArray = rb_ary_new2(jobs->count);
+    long i;
+
+    jobs->work = 0;
+    for(i = 0; i < jobs->count; i++)
+    {
+        job = &jobs->jobs[i];
+        batch_prepare(job, rb_ary_entry(jobs->list, i));
+        if(job->real)
+            jobs->work += ft_job_work(job);
+    }
+
+    ft_without_gvl(batch_run, jobs, jobs->work);
+
+    for(i = 0; i < jobs->count; i++)
+    {
+        job = &jobs->jobs[i];
+        if(!job->real)
+            rb_ary_push(outArray, Qnil);
+        else if(job->imag)
+            rb_ary_push(outArray, complex_to_ruby(job->real, job->imag, job->length));
+        else
+            rb_ary_push(outArray, real_to_ruby(job->real, job->length));
+    }
+
+    return outArray;
+}
+
+/**
+ * @brief Compute many independent transforms at once.
+ * FT.batch(method, list) computes the transform (:fft, :rfft, :dft, :rdft,
+ * :fht, :rfht, :dht or :rdht) of every element of the list on native worker threads
+ * without the GVL.
+ * @author placek@ragnarson.com
+ * @params self The module.
+ * @params method A symbol of the transform.
+ * @params list An Array of input data arrays.
+ * @return An Array of results (nil for invalid data, like the single calls).
+ */
+static VALUE ft_batch(VALUE self, VALUE method, VALUE list)
+{
+    batch jobs;
+    ID id;
+    int kind, direction = 1;
+    long i;
+
+    Check_Type(method, T_SYMBOL);
+    Check_Type(list, T_ARRAY);
+    id = SYM2ID(method);
+    if(id == id_fft || id == id_rfft)
+        kind = FT_JOB_FFT;
+    else if(id == id_dft || id == id_rdft)
+        kind = FT_JOB_DFT;
+    else if(id == id_fht || id == id_rfht)
+        kind = FT_JOB_FHT;
+    else if(id == id_dht || id == id_rdht)
+        kind = FT_JOB_DHT;
+    else
+        rb_raise(rb_eArgError, "unknown transform %s", rb_id2name(id));
+    if(id == id_rfft || id == id_rdft)
+        direction = -1;
+
+    jobs.list = list;
+    jobs.count = RARRAY_LEN(list);
+    jobs.jobs = calloc(jobs.count ? jobs.count : 1, sizeof(ft_job));
+    for(i = 0; i < jobs.count; i++)
+    {
+        jobs.jobs[i].kind = kind;
+        jobs.jobs[i].direction = direction;
+    }
+
+    // unboxing may raise, so memory is released in ensure
+    return rb_ensure(batch_body, (VALUE)&jobs, batch_free, (VALUE)&jobs);
+}
+
+/**
+ * @brief Get the number of worker threads.
+ * @author placek@ragnarson.com
+ * @return Number of threads used by FT.batch.
+ */
+static VALUE ft_threads(VALUE self)
+{
+    return INT2NUM(ft_thread_count());
+}
+
+/**
+ * @brief Set the number of worker threads.
+ * @author placek@ragnarson.com
+ * @params count Number of threads (0 or nil - number of processors).
+ * @return The count.
+ */
+static VALUE ft_set_threads(VALUE self, VALUE count)
+{
+    threads = NIL_P(count) ? 0 : NUM2INT(count);
+    if(threads < 0)
+        threads = 0;
+    return count;
+}
+
+/**
+ * @brief Define the batch methods.
+ * @author placek@ragnarson.com
+ */
+void Init_parallel(void)
+{
+    id_fft = rb_intern("fft");
+    id_rfft = rb_intern("rfft");
+    id_dft = rb_intern("dft");
+    id_rdft = rb_intern("rdft");
+    id_fht = rb_intern("fht");
+    id_rfht = rb_intern("rfht");
+    id_dht = rb_intern("dht");
+    id_rdht = rb_intern("rdht");
+
+    rb_define_singleton_method(FT, "batch", ft_batch, 2);
+    rb_define_singleton_method(FT, "threads", ft_threads, 0);
+    rb_define_singleton_method(FT, "threads=", ft_set_threads, 1);
+
+#ifdef HAVE_PTHREAD_H
+    pthread_atfork(NULL, NULL, pool_after_fork);
+#endif
+}
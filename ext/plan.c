@@ -0,0 +1,1142 @@
+/**
+ * @file plan.c
+ * @brief Reusable FFT plans with precomputed permutation and transform factors.
+ * Powers of 2 are computed with the radix-2 decimation in time, lengths built
+ * of factors 2, 3, 4, 5 and 7 with the mixed-radix decimation in time and any
+ * other length with the Bluestein (chirp-z) algorithm. Powers of 2 that do not
+ * fit in the cache go through the four-step algorithm.
+ * @author placek@ragnarson.com
+ */
+#include "frequency_transformations.h"
+
+/**
+ * @brief Number of columns transformed at once by the four-step algorithm.
+ */
+#define FOUR_STEP_BLOCK 8
+
+static VALUE cPlan;
+static ID id_forward, id_reverse;
+
+/**
+ * @brief Factorize the length for the mixed-radix transform.
+ * Stores pairs of a radix and the remaining length in the factors table.
+ * Radix 4 goes first as the cheapest one.
+ * @author placek@ragnarson.com
+ * @param length Length of processing data.
+ * @param factors The table for factors.
+ * @return The part of length that is not built of radices 2, 3, 4, 5 and 7.
+ */
+static long factorize(long length, long * factors)
+{
+    static const long radices[] = { 4, 2, 3, 5, 7 };
+    long i, count = 0;
+
+    for(i = 0; i < 5; i++)
+        while(length % radices[i] == 0 && length > 1)
+        {
+            length /= radices[i];
+            factors[count++] = radices[i];
+            factors[count++] = length;
+        }
+
+    return length;
+}
+
+/**
+ * @brief Create an FFT plan.
+ * This function computes the bit-reversal permutation (or the factorization)
+ * and the table of transform factors for the given length and direction.
+ * The factors are computed directly with cos() and sin() instead of the
+ * trigonometric recurrence, so they do not lose accuracy as the length grows.
+ * Lengths with wisdom (see wisdom.c) get the measured algorithm.
+ * @author placek@ragnarson.com
+ * @param length Length of processing data.
+ * @param direction An FFT direction (1 - forward FFT, -1 - reverse FFT).
+ * @return A new plan (to be released with ft_plan_free()).
+ */
+ft_plan * ft_plan_create(long length, int direction)
+{
+    ft_wisdom wisdom;
+
+    if(ft_wisdom_lookup(length, &wisdom))
+        return ft_plan_create_with(length, direction, &wisdom);
+    return ft_plan_create_with(length, direction, NULL);
+}
+
+/**
+ * @brief Check whether an algorithm can compute FFTs of a length.
+ * Powers of 2 are computed by the radix-2, the mixed-radix or (from 256
+ * points, so the columns fill the blocks) the four-step algorithm, lengths
+ * built of factors 2, 3, 4, 5 and 7 by the mixed-radix or the Bluestein
+ * algorithm and the others only by the Bluestein algorithm.
+ * @author placek@ragnarson.com
+ * @param length Length of processing data.
+ * @param algorithm An algorithm (FT_RADIX2, FT_MIXED_RADIX, FT_BLUESTEIN or FT_FOUR_STEP).
+ * @return TRUE if the algorithm can be used.
+ */
+int ft_plan_supports(long length, int algorithm)
+{
+    long factors[2 * FT_MAX_FACTORS];
+    int power = !(length & (length - 1));
+
+    switch(algorithm)
+    {
+        case FT_RADIX2: return power;
+        case FT_FOUR_STEP: return power && length >= 256;
+        case FT_MIXED_RADIX: return length > 1 && factorize(length, factors) == 1;
+        case FT_BLUESTEIN: return !power;
+    }
+    return FALSE;
+}
+
+/**
+ * @brief Create an FFT plan with the given algorithm.
+ * @see ft_plan_create()
+ * @author placek@ragnarson.com
+ * @param length Length of processing data.
+ * @param direction An FFT direction (1 - forward FFT, -1 - reverse FFT).
+ * @param wisdom The algorithm, instruction set and codelets to use (NULL - the defaults).
+ * @return A new plan (to be released with ft_plan_free()).
+ */
+ft_plan * ft_plan_create_with(long length, int direction, const ft_wisdom * wisdom)
+{
+    long position, target, mask, k, padded, twiddles, half, step, rows, columns;
+    double arg;
+    ft_plan * plan;
+
+    plan = calloc(1, sizeof(ft_plan));
+    plan->length = length;
+    plan->direction = direction;
+    plan->scale = direction == -1 ? 1.0 / (double)length : 1.0;
+    plan->codelet = TRUE;
+
+    if(wisdom && ft_plan_supports(length, wisdom->algorithm))
+    {
+        plan->algorithm = wisdom->algorithm;
+        plan->kernels = wisdom->simd >= 0 ? ft_simd_kernels_for(wisdom->simd) : NULL;
+        plan->codelet = wisdom->codelet;
+        if(plan->algorithm == FT_MIXED_RADIX)
+            factorize(length, plan->factors);
+    }
+    else if(!(length & (length - 1)) && length >= FT_FOUR_STEP_THRESHOLD)
+        plan->algorithm = FT_FOUR_STEP;
+    else if(!(length & (length - 1)))
+        plan->algorithm = FT_RADIX2;
+    else if(factorize(length, plan->factors) == 1)
+        plan->algorithm = FT_MIXED_RADIX;
+    else
+        plan->algorithm = FT_BLUESTEIN;
+
+    if(plan->algorithm == FT_BLUESTEIN)
+    {
+        // the linear convolution of length 2N - 1 is computed by a power of 2 FFT
+        for(padded = 1; padded < 2 * length - 1; padded <<= 1);
+        plan->padded_length = padded;
+        plan->inner[0] = ft_plan_create(padded, 1);
+        plan->inner[1] = ft_plan_create(padded, -1);
+        plan->chirp_real = malloc(length * sizeof(double));
+        plan->chirp_imag = malloc(length * sizeof(double));
+        plan->filter_real = calloc(padded, sizeof(double));
+        plan->filter_imag = calloc(padded, sizeof(double));
+        plan->scratch = malloc(ft_plan_scratch_length(plan) * sizeof(double));
+
+        // chirp exp(-i pi n^2 / N), n^2 taken modulo 2N to keep the argument small
+        for(k = 0; k < length; k++)
+        {
+            arg = M_PI * (double)((k * k) % (2 * length)) / (double)length;
+            plan->chirp_real[k] = cos(arg);
+            plan->chirp_imag[k] = -direction * sin(arg);
+        }
+
+        // spectrum of the conjugated chirp wrapped around the padded length
+        plan->filter_real[0] = plan->chirp_real[0];
+        plan->filter_imag[0] = -plan->chirp_imag[0];
+        for(k = 1; k < length; k++)
+        {
+            plan->filter_real[k] = plan->filter_real[padded - k] = plan->chirp_real[k];
+            plan->filter_imag[k] = plan->filter_imag[padded - k] = -plan->chirp_imag[k];
+        }
+        ft_plan_execute(plan->inner[0], plan->filter_real, plan->filter_imag);
+
+        return plan;
+    }
+
+    if(plan->algorithm == FT_FOUR_STEP)
+    {
+        // rows and columns of about the square root length, scaled once at the end
+        for(columns = 1; columns * columns * 4 <= length; columns <<= 1);
+        rows = length / columns;
+        plan->factors[0] = rows;
+        plan->factors[1] = columns;
+        plan->inner[0] = ft_plan_create(rows, direction);
+        plan->inner[1] = ft_plan_create(columns, direction);
+        plan->inner[0]->scale = plan->inner[1]->scale = 1.0;
+        plan->scratch = malloc(ft_plan_scratch_length(plan) * sizeof(double));
+
+        // factors exp(-2 pi i m / N) split into m = a * columns + b, a < rows and b < columns
+        plan->twiddle_real = malloc((rows + columns) * sizeof(double));
+        plan->twiddle_imag = malloc((rows + columns) * sizeof(double));
+        arg = 2.0 * M_PI / (double)length;
+        for(k = 0; k < columns; k++)
+        {
+            plan->twiddle_real[k] = cos(arg * (double)k);
+            plan->twiddle_imag[k] = -direction * sin(arg * (double)k);
+        }
+        for(k = 0; k < rows; k++)
+        {
+            plan->twiddle_real[columns + k] = cos(arg * (double)(k * columns));
+            plan->twiddle_imag[columns + k] = -direction * sin(arg * (double)(k * columns));
+        }
+
+        return plan;
+    }
+
+    if(plan->algorithm == FT_RADIX2)
+    {
+        // prepare the bit reversal table
+        plan->reversed = malloc(length * sizeof(long));
+        target = 0;
+        for(position = 0; position < length; position++)
+        {
+            plan->reversed[position] = target;
+            mask = length;
+            while(target & (mask >>= 1))
+                target &= ~mask;
+            target |= mask;
+        }
+        twiddles = length - 1;
+    }
+    else
+    {
+        plan->scratch = malloc(ft_plan_scratch_length(plan) * sizeof(double));
+        twiddles = length;
+    }
+
+    // prepare table of transform factors
+    plan->twiddle_real = malloc(twiddles * sizeof(double));
+    plan->twiddle_imag = malloc(twiddles * sizeof(double));
+    arg = 2.0 * M_PI / (double)length;
+    if(plan->algorithm == FT_RADIX2)
+    {
+        // factors of the step s are stored at s - 1, the last step holds all of them
+        half = length / 2;
+        for(k = 0; k < half; k++)
+        {
+            plan->twiddle_real[half - 1 + k] = cos(arg * (double)k);
+            plan->twiddle_imag[half - 1 + k] = -direction * sin(arg * (double)k);
+        }
+        for(step = half / 2; step >= 1; step >>= 1)
+            for(k = 0; k < step; k++)
+            {
+                plan->twiddle_real[step - 1 + k] = plan->twiddle_real[half - 1 + k * (half / step)];
+                plan->twiddle_imag[step - 1 + k] = plan->twiddle_imag[half - 1 + k * (half / step)];
+            }
+        return plan;
+    }
+    for(k = 0; k < twiddles; k++)
+    {
+        plan->twiddle_real[k] = cos(arg * (double)k);
+        plan->twiddle_imag[k] = -direction * sin(arg * (double)k);
+    }
+
+    return plan;
+}
+
+/**
+ * @brief Release an FFT plan.
+ * @author placek@ragnarson.com
+ * @param plan A plan created by ft_plan_create().
+ */
+void ft_plan_free(ft_plan * plan)
+{
+    if(!plan)
+        return;
+    ft_plan_free(plan->inner[0]);
+    ft_plan_free(plan->inner[1]);
+    free(plan->reversed);
+    free(plan->twiddle_real);
+    free(plan->twiddle_imag);
+    free(plan->chirp_real);
+    free(plan->chirp_imag);
+    free(plan->filter_real);
+    free(plan->filter_imag);
+    free(plan->scratch);
+    free(plan->buffer[0]);
+    free(plan->buffer[1]);
+    free(plan->single_twiddle_real);
+    free(plan->single_twiddle_imag);
+    free(plan->single_buffer[0]);
+    free(plan->single_buffer[1]);
+    free(plan);
+}
+
+/**
+ * @brief Get the memory used by an FFT plan.
+ * @author placek@ragnarson.com
+ * @param plan A plan.
+ * @return Number of bytes.
+ */
+size_t ft_plan_memsize(const ft_plan * plan)
+{
+    size_t size;
+
+    if(!plan)
+        return 0;
+    size = sizeof(ft_plan);
+    if(plan->buffer[0])
+        size += 2 * plan->length * sizeof(double);
+    if(plan->algorithm == FT_RADIX2)
+        size += plan->length * (sizeof(long) + 2 * sizeof(double));
+    else if(plan->algorithm == FT_MIXED_RADIX)
+        size += 4 * plan->length * sizeof(double);
+    else if(plan->algorithm == FT_FOUR_STEP)
+        size += (ft_plan_scratch_length(plan) + 2 * (plan->factors[0] + plan->factors[1])) * sizeof(double)
+            + ft_plan_memsize(plan->inner[0]) + ft_plan_memsize(plan->inner[1]);
+    else
+        size += (2 * plan->length + 2 * plan->padded_length + ft_plan_scratch_length(plan)) * sizeof(double)
+            + ft_plan_memsize(plan->inner[0]) + ft_plan_memsize(plan->inner[1]);
+    if(plan->precision == FT_FLOAT32)
+        size += (plan->algorithm == FT_RADIX2 ? 4 : 2) * plan->length * sizeof(float);
+
+    return size;
+}
+
+/**
+ * @brief Compute a radix-2 FFT in place.
+ * The same radix-2 decimation in time as fft_kernel(), but the permutation
+ * and transform factors are read from the plan tables. Stages are computed
+ * two at a time by the butterfly passes of the instruction set chosen at
+ * load time (see simd.c) or measured for the length (see wisdom.c), an odd
+ * one first with a single stage pass.
+ * @author placek@ragnarson.com
+ * @param plan A plan of the transform.
+ * @param real Real parts of processing data.
+ * @param imag Imaginary parts of processing data.
+ */
+static void radix2_execute(const ft_plan * plan, double * real, double * imag)
+{
+    const ft_simd_kernels * kernels = plan->kernels ? plan->kernels : ft_simd();
+    long length = plan->length;
+    long position, target, step, stages = 0;
+    double temp;
+
+    // do the bit reversal
+    for(position = 0; position < length; position++)
+    {
+        target = plan->reversed[position];
+        if(target > position)
+        {
+            temp = real[position];
+            real[position] = real[target];
+            real[target] = temp;
+            temp = imag[position];
+            imag[position] = imag[target];
+            imag[target] = temp;
+        }
+    }
+
+    // compute the FFT
+    for(step = 1; step < length; step <<= 1)
+        stages++;
+    step = 1;
+    if(stages % 2)
+    {
+        kernels->radix2(real, imag, length, step, plan->twiddle_real, plan->twiddle_imag);
+        step = 2;
+    }
+    for(; step < length; step <<= 2)
+        kernels->radix4(real, imag, length, step,
+            plan->twiddle_real + step - 1, plan->twiddle_imag + step - 1,
+            plan->twiddle_real + 2 * step - 1, plan->twiddle_imag + 2 * step - 1);
+}
+
+/**
+ * @brief Multiply a complex number by a transform factor.
+ */
+#define TWIDDLE(plan, index, re, im, out_re, out_im) \
+    do { \
+        double tw_re = (plan)->twiddle_real[index], tw_im = (plan)->twiddle_imag[index]; \
+        (out_re) = (re) * tw_re - (im) * tw_im; \
+        (out_im) = (re) * tw_im + (im) * tw_re; \
+    } while(0)
+
+/**
+ * @brief Radix-2 butterflies of the mixed-radix transform.
+ * @author placek@ragnarson.com
+ * @param plan A plan of the transform.
+ * @param real Real parts of m interleaved 2-point transforms.
+ * @param imag Imaginary parts of m interleaved 2-point transforms.
+ * @param stride Distance between transform factors of this stage.
+ * @param m Number of butterflies.
+ */
+static void butterfly2(const ft_plan * plan, double * real, double * imag, long stride, long m)
+{
+    long k;
+    double t_re, t_im;
+
+    for(k = 0; k < m; k++)
+    {
+        TWIDDLE(plan, k * stride, real[k + m], imag[k + m], t_re, t_im);
+        real[k + m] = real[k] - t_re;
+        imag[k + m] = imag[k] - t_im;
+        real[k] += t_re;
+        imag[k] += t_im;
+    }
+}
+
+/**
+ * @brief Radix-3 butterflies of the mixed-radix transform.
+ * @see butterfly2()
+ */
+static void butterfly3(const ft_plan * plan, double * real, double * imag, long stride, long m)
+{
+    long k;
+    double s0_re, s0_im, s1_re, s1_im, s2_re, s2_im, s3_re, s3_im;
+    double epsilon = plan->twiddle_imag[stride * m];
+
+    for(k = 0; k < m; k++)
+    {
+        TWIDDLE(plan, k * stride, real[k + m], imag[k + m], s1_re, s1_im);
+        TWIDDLE(plan, 2 * k * stride, real[k + 2 * m], imag[k + 2 * m], s2_re, s2_im);
+        s3_re = s1_re + s2_re;
+        s3_im = s1_im + s2_im;
+        s0_re = (s1_re - s2_re) * epsilon;
+        s0_im = (s1_im - s2_im) * epsilon;
+        real[k + m] = real[k] - 0.5 * s3_re;
+        imag[k + m] = imag[k] - 0.5 * s3_im;
+        real[k] += s3_re;
+        imag[k] += s3_im;
+        real[k + 2 * m] = real[k + m] + s0_im;
+        imag[k + 2 * m] = imag[k + m] - s0_re;
+        real[k + m] -= s0_im;
+        imag[k + m] += s0_re;
+    }
+}
+
+/**
+ * @brief Radix-4 butterflies of the mixed-radix transform.
+ * @see butterfly2()
+ */
+static void butterfly4(const ft_plan * plan, double * real, double * imag, long stride, long m)
+{
+    long k;
+    double s0_re, s0_im, s1_re, s1_im, s2_re, s2_im, s3_re, s3_im, s4_re, s4_im, s5_re, s5_im;
+
+    for(k = 0; k < m; k++)
+    {
+        TWIDDLE(plan, k * stride, real[k + m], imag[k + m], s0_re, s0_im);
+        TWIDDLE(plan, 2 * k * stride, real[k + 2 * m], imag[k + 2 * m], s1_re, s1_im);
+        TWIDDLE(plan, 3 * k * stride, real[k + 3 * m], imag[k + 3 * m], s2_re, s2_im);
+        s5_re = real[k] - s1_re;
+        s5_im = imag[k] - s1_im;
+        real[k] += s1_re;
+        imag[k] += s1_im;
+        s3_re = s0_re + s2_re;
+        s3_im = s0_im + s2_im;
+        s4_re = (s0_re - s2_re) * plan->direction;
+        s4_im = (s0_im - s2_im) * plan->direction;
+        real[k + 2 * m] = real[k] - s3_re;
+        imag[k + 2 * m] = imag[k] - s3_im;
+        real[k] += s3_re;
+        imag[k] += s3_im;
+        real[k + m] = s5_re + s4_im;
+        imag[k + m] = s5_im - s4_re;
+        real[k + 3 * m] = s5_re - s4_im;
+        imag[k + 3 * m] = s5_im + s4_re;
+    }
+}
+
+/**
+ * @brief Radix-5 butterflies of the mixed-radix transform.
+ * @see butterfly2()
+ */
+static void butterfly5(const ft_plan * plan, double * real, double * imag, long stride, long m)
+{
+    long k;
+    double s0_re, s0_im, s1_re, s1_im, s2_re, s2_im, s3_re, s3_im, s4_re, s4_im;
+    double s5_re, s5_im, s6_re, s6_im, s7_re, s7_im, s8_re, s8_im, s9_re, s9_im;
+    double s10_re, s10_im, s11_re, s11_im, s12_re, s12_im;
+    double ya_re = plan->twiddle_real[stride * m], ya_im = plan->twiddle_imag[stride * m];
+    double yb_re = plan->twiddle_real[2 * stride * m], yb_im = plan->twiddle_imag[2 * stride * m];
+
+    for(k = 0; k < m; k++)
+    {
+        s0_re = real[k];
+        s0_im = imag[k];
+        TWIDDLE(plan, k * stride, real[k + m], imag[k + m], s1_re, s1_im);
+        TWIDDLE(plan, 2 * k * stride, real[k + 2 * m], imag[k + 2 * m], s2_re, s2_im);
+        TWIDDLE(plan, 3 * k * stride, real[k + 3 * m], imag[k + 3 * m], s3_re, s3_im);
+        TWIDDLE(plan, 4 * k * stride, real[k + 4 * m], imag[k + 4 * m], s4_re, s4_im);
+
+        s7_re = s1_re + s4_re;
+        s7_im = s1_im + s4_im;
+        s10_re = s1_re - s4_re;
+        s10_im = s1_im - s4_im;
+        s8_re = s2_re + s3_re;
+        s8_im = s2_im + s3_im;
+        s9_re = s2_re - s3_re;
+        s9_im = s2_im - s3_im;
+
+        real[k] = s0_re + s7_re + s8_re;
+        imag[k] = s0_im + s7_im + s8_im;
+
+        s5_re = s0_re + s7_re * ya_re + s8_re * yb_re;
+        s5_im = s0_im + s7_im * ya_re + s8_im * yb_re;
+        s6_re = s10_im * ya_im + s9_im * yb_im;
+        s6_im = -s10_re * ya_im - s9_re * yb_im;
+        real[k + m] = s5_re - s6_re;
+        imag[k + m] = s5_im - s6_im;
+        real[k + 4 * m] = s5_re + s6_re;
+        imag[k + 4 * m] = s5_im + s6_im;
+
+        s11_re = s0_re + s7_re * yb_re + s8_re * ya_re;
+        s11_im = s0_im + s7_im * yb_re + s8_im * ya_re;
+        s12_re = -s10_im * yb_im + s9_im * ya_im;
+        s12_im = s10_re * yb_im - s9_re * ya_im;
+        real[k + 2 * m] = s11_re + s12_re;
+        imag[k + 2 * m] = s11_im + s12_im;
+        real[k + 3 * m] = s11_re - s12_re;
+        imag[k + 3 * m] = s11_im - s12_im;
+    }
+}
+
+/**
+ * @brief Generic butterflies of the mixed-radix transform (used for radix 7).
+ * @see butterfly2()
+ * @param p The radix.
+ */
+static void butterfly_generic(const ft_plan * plan, double * real, double * imag, long stride, long m, long p)
+{
+    long u, q, q1, k, index;
+    double scratch_real[7], scratch_imag[7], t_re, t_im;
+
+    for(u = 0; u < m; u++)
+    {
+        for(q1 = 0, k = u; q1 < p; q1++, k += m)
+        {
+            scratch_real[q1] = real[k];
+            scratch_imag[q1] = imag[k];
+        }
+        for(q1 = 0, k = u; q1 < p; q1++, k += m)
+        {
+            index = 0;
+            real[k] = scratch_real[0];
+            imag[k] = scratch_imag[0];
+            for(q = 1; q < p; q++)
+            {
+                index += stride * k;
+                if(index >= plan->length)
+                    index %= plan->length;
+                TWIDDLE(plan, index, scratch_real[q], scratch_imag[q], t_re, t_im);
+                real[k] += t_re;
+                imag[k] += t_im;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Compute one level of the mixed-radix transform.
+ * Recursively transforms p decimated subsequences of the input into the
+ * consecutive parts of the output and combines them with radix-p butterflies.
+ * @author placek@ragnarson.com
+ * @param plan A plan of the transform.
+ * @param out_real Output real parts.
+ * @param out_imag Output imaginary parts.
+ * @param in_real Input real parts.
+ * @param in_imag Input imaginary parts.
+ * @param stride Distance between the input entries of this level.
+ * @param factors Remaining factors of the length.
+ */
+static void mixed_radix_work(const ft_plan * plan, double * out_real, double * out_imag,
+    const double * in_real, const double * in_imag, long stride, const long * factors)
+{
+    long p = factors[0], m = factors[1], k;
+
+    if(m == 1)
+        for(k = 0; k < p; k++)
+        {
+            out_real[k] = in_real[k * stride];
+            out_imag[k] = in_imag[k * stride];
+        }
+    else
+        for(k = 0; k < p; k++)
+            mixed_radix_work(plan, out_real + k * m, out_imag + k * m,
+                in_real + k * stride, in_imag + k * stride, stride * p, factors + 2);
+
+    switch(p)
+    {
+        case 2: butterfly2(plan, out_real, out_imag, stride, m); break;
+        case 3: butterfly3(plan, out_real, out_imag, stride, m); break;
+        case 4: butterfly4(plan, out_real, out_imag, stride, m); break;
+        case 5: butterfly5(plan, out_real, out_imag, stride, m); break;
+        default: butterfly_generic(plan, out_real, out_imag, stride, m, p); break;
+    }
+}
+
+/**
+ * @brief Compute a Bluestein FFT in place.
+ * The transform is rewritten as a convolution with a chirp, which is
+ * computed with power of 2 FFTs of the padded length.
+ * @author placek@ragnarson.com
+ * @param plan A plan of the transform.
+ * @param real Real parts of processing data.
+ * @param imag Imaginary parts of processing data.
+ * @param scratch Scratch memory (ft_plan_scratch_length() doubles), the part
+ * after the padded data is lent to the inner plans.
+ */
+static void bluestein_execute(const ft_plan * plan, double * real, double * imag, double * scratch)
+{
+    long k, length = plan->length, padded = plan->padded_length;
+    double * work_real = scratch, * work_imag = scratch + padded, * inner = scratch + 2 * padded;
+    double re, im;
+
+    // multiply by the chirp and pad with zeros
+    for(k = 0; k < length; k++)
+    {
+        work_real[k] = real[k] * plan->chirp_real[k] - imag[k] * plan->chirp_imag[k];
+        work_imag[k] = real[k] * plan->chirp_imag[k] + imag[k] * plan->chirp_real[k];
+    }
+    for(k = length; k < padded; k++)
+        work_real[k] = work_imag[k] = 0.0;
+
+    // convolve with the conjugated chirp
+    ft_plan_execute_scratch(plan->inner[0], work_real, work_imag, inner);
+    for(k = 0; k < padded; k++)
+    {
+        re = work_real[k] * plan->filter_real[k] - work_imag[k] * plan->filter_imag[k];
+        im = work_real[k] * plan->filter_imag[k] + work_imag[k] * plan->filter_real[k];
+        work_real[k] = re;
+        work_imag[k] = im;
+    }
+    ft_plan_execute_scratch(plan->inner[1], work_real, work_imag, inner);
+
+    // multiply by the chirp again
+    for(k = 0; k < length; k++)
+    {
+        real[k] = work_real[k] * plan->chirp_real[k] - work_imag[k] * plan->chirp_imag[k];
+        imag[k] = work_real[k] * plan->chirp_imag[k] + work_imag[k] * plan->chirp_real[k];
+    }
+}
+
+/**
+ * @brief Compute a four-step FFT in place.
+ * The data is seen as a matrix of rows x columns. Columns are transformed
+ * a block at a time (copied into a short buffer that stays in the cache),
+ * multiplied by the factors exp(-2 pi i n1 k2 / N) and stored in the
+ * scratch memory, then rows are transformed in place and the result is
+ * transposed back into the data. Every short transform fits in the cache
+ * and the transpose is blocked, so no pass strides through the whole data
+ * as the late radix-2 stages do.
+ * @author placek@ragnarson.com
+ * @param plan A plan of the transform.
+ * @param real Real parts of processing data.
+ * @param imag Imaginary parts of processing data.
+ * @param scratch Scratch memory (ft_plan_scratch_length() doubles), the part
+ * after the block is lent to the inner plans.
+ */
+static void four_step_execute(const ft_plan * plan, double * real, double * imag, double * scratch)
+{
+    long rows = plan->factors[0], columns = plan->factors[1], length = plan->length;
+    long n1, n2, k2, b, m, shift, mask = columns - 1;
+    double * work_real = scratch, * work_imag = scratch + length;
+    double * block_real = scratch + 2 * length, * block_imag = block_real + FOUR_STEP_BLOCK * rows;
+    double * inner = block_imag + FOUR_STEP_BLOCK * rows;
+    double * column_real, * column_imag;
+    double w_re, w_im, lo_re, lo_im, hi_re, hi_im, re;
+
+    for(shift = 0; (1L << shift) < columns; shift++);
+
+    // transform the columns a block at a time
+    for(n1 = 0; n1 < columns; n1 += FOUR_STEP_BLOCK)
+    {
+        for(n2 = 0; n2 < rows; n2++)
+            for(b = 0; b < FOUR_STEP_BLOCK; b++)
+            {
+                block_real[b * rows + n2] = real[n2 * columns + n1 + b];
+                block_imag[b * rows + n2] = imag[n2 * columns + n1 + b];
+            }
+        for(b = 0; b < FOUR_STEP_BLOCK; b++)
+        {
+            column_real = block_real + b * rows;
+            column_imag = block_imag + b * rows;
+            ft_plan_execute_scratch(plan->inner[0], column_real, column_imag, inner);
+            // multiply by the factors while the column is in the cache
+            for(k2 = 1, m = n1 + b; k2 < rows; k2++, m += n1 + b)
+            {
+                lo_re = plan->twiddle_real[m & mask];
+                lo_im = plan->twiddle_imag[m & mask];
+                hi_re = plan->twiddle_real[columns + (m >> shift)];
+                hi_im = plan->twiddle_imag[columns + (m >> shift)];
+                w_re = lo_re * hi_re - lo_im * hi_im;
+                w_im = lo_re * hi_im + lo_im * hi_re;
+                re = column_real[k2] * w_re - column_imag[k2] * w_im;
+                column_imag[k2] = column_real[k2] * w_im + column_imag[k2] * w_re;
+                column_real[k2] = re;
+            }
+        }
+        // store whole cache lines of the block
+        for(k2 = 0; k2 < rows; k2++)
+            for(b = 0; b < FOUR_STEP_BLOCK; b++)
+            {
+                work_real[k2 * columns + n1 + b] = block_real[b * rows + k2];
+                work_imag[k2 * columns + n1 + b] = block_imag[b * rows + k2];
+            }
+    }
+
+    // transform the rows and read the result out by columns
+    for(k2 = 0; k2 < rows; k2++)
+        ft_plan_execute_scratch(plan->inner[1], work_real + k2 * columns, work_imag + k2 * columns, inner);
+    transpose_blocked(work_real, real, rows, columns);
+    transpose_blocked(work_imag, imag, rows, columns);
+}
+
+/**
+ * @brief Get the size of scratch memory needed to execute a plan.
+ * The inner plans run one after another on the scratch memory of the plan
+ * (not on their own), so the longest of their scratch memories is included.
+ * @author placek@ragnarson.com
+ * @param plan A plan.
+ * @return Number of doubles.
+ */
+long ft_plan_scratch_length(const ft_plan * plan)
+{
+    long inner = 0;
+
+    if(plan->inner[0])
+    {
+        inner = ft_plan_scratch_length(plan->inner[0]);
+        if(ft_plan_scratch_length(plan->inner[1]) > inner)
+            inner = ft_plan_scratch_length(plan->inner[1]);
+    }
+    switch(plan->algorithm)
+    {
+        case FT_MIXED_RADIX: return 2 * plan->length;
+        case FT_BLUESTEIN: return 2 * plan->padded_length + inner;
+        case FT_FOUR_STEP: return 2 * plan->length + 2 * FOUR_STEP_BLOCK * plan->factors[0] + inner;
+        default: return 0;
+    }
+}
+
+/**
+ * @brief Compute a FFT in place using a plan.
+ * Uses the scratch memory of the plan, so a plan should not be executed
+ * by two threads at once this way.
+ * @see ft_plan_execute_scratch()
+ * @author placek@ragnarson.com
+ * @param plan A plan of the transform.
+ * @param real Real parts of processing data.
+ * @param imag Imaginary parts of processing data.
+ */
+void ft_plan_execute(const ft_plan * plan, double * real, double * imag)
+{
+    ft_plan_execute_scratch(plan, real, imag, plan->scratch);
+}
+
+/**
+ * @brief Compute a FFT in place using a plan and the given scratch memory.
+ * The plan itself is only read, so many threads can execute it at once
+ * with their own scratch memory.
+ * @see ft_plan_create()
+ * @author placek@ragnarson.com
+ * @param plan A plan of the transform.
+ * @param real Real parts of processing data.
+ * @param imag Imaginary parts of processing data.
+ * @param scratch Scratch memory (ft_plan_scratch_length() doubles).
+ */
+void ft_plan_execute_scratch(const ft_plan * plan, double * real, double * imag, double * scratch)
+{
+    long i, length = plan->length;
+
+    if(length == 1)
+        return;
+
+    switch(plan->algorithm)
+    {
+        case FT_RADIX2:
+            if(!plan->codelet || !ft_codelet_fft(real, imag, length, plan->direction))
+                radix2_execute(plan, real, imag);
+            break;
+        case FT_MIXED_RADIX:
+            for(i = 0; i < length; i++)
+            {
+                scratch[i] = real[i];
+                scratch[length + i] = imag[i];
+            }
+            mixed_radix_work(plan, real, imag, scratch, scratch + length, 1, plan->factors);
+            break;
+        case FT_FOUR_STEP:
+            four_step_execute(plan, real, imag, scratch);
+            break;
+        default:
+            bluestein_execute(plan, real, imag, scratch);
+            break;
+    }
+
+    // scaling for inverse transform (parts of a four-step plan are not scaled)
+    if(plan->scale != 1.0)
+    {
+        for(i = 0; i < length; i++)
+        {
+            real[i] *= plan->scale;
+            imag[i] *= plan->scale;
+        }
+    }
+}
+
+static void plan_free(void * ptr)
+{
+    ft_plan_free((ft_plan *)ptr);
+}
+
+static size_t plan_memsize(const void * ptr)
+{
+    return ft_plan_memsize((const ft_plan *)ptr);
+}
+
+static const rb_data_type_t plan_type = {
+    "FrequencyTransformations::Plan",
+    { NULL, plan_free, plan_memsize, },
+    NULL, NULL, RUBY_TYPED_FREE_IMMEDIATELY
+};
+
+static VALUE plan_alloc(VALUE klass)
+{
+    return TypedData_Wrap_Struct(klass, &plan_type, NULL);
+}
+
+static ft_plan * get_plan(VALUE self)
+{
+    ft_plan * plan;
+    TypedData_Get_Struct(self, ft_plan, &plan_type, plan);
+    if(!plan)
+        rb_raise(rb_eRuntimeError, "uninitialized plan");
+    return plan;
+}
+
+/**
+ * @brief Initialize a plan.
+ * Plan.new(length, direction = :forward, precision: :float64) precomputes
+ * the tables for transforms of the given length. The direction is :forward
+ * or :reverse, the precision :float64 or :float32 (single precision plans
+ * compute in floats and their buffers hold floats).
+ * @author placek@ragnarson.com
+ * @params argc Number of arguments.
+ * @params argv Arguments (length, optional direction and precision: option).
+ * @params self A plan being initialized.
+ * @return The plan.
+ */
+static VALUE plan_initialize(int argc, VALUE * argv, VALUE self)
+{
+    VALUE rb_length, rb_direction, options;
+    long length;
+    int direction = 1, precision;
+
+    rb_scan_args(argc, argv, "11:", &rb_length, &rb_direction, &options);
+    length = NUM2LONG(rb_length);
+    precision = ft_precision(options);
+
+    if(length < 1)
+        rb_raise(rb_eArgError, "length should be positive");
+
+    if(!NIL_P(rb_direction))
+    {
+        Check_Type(rb_direction, T_SYMBOL);
+        if(SYM2ID(rb_direction) == id_reverse)
+            direction = -1;
+        else if(SYM2ID(rb_direction) != id_forward)
+            rb_raise(rb_eArgError, "direction should be :forward or :reverse");
+    }
+
+    if(DATA_PTR(self))
+        rb_raise(rb_eRuntimeError, "plan already initialized");
+    DATA_PTR(self) = ft_plan_create(length, direction);
+    if(precision == FT_FLOAT32)
+        ft_plan_make_single((ft_plan *)DATA_PTR(self));
+
+    return self;
+}
+
+/**
+ * @brief A call of a plan from Ruby.
+ * The first call uses the buffers of the plan, calls made at the same time
+ * from other threads (the GVL is released during the transform) get their
+ * own temporary buffers.
+ */
+typedef struct
+{
+    ft_plan * plan;
+    int owned;
+    double * real;
+    double * imag;
+    double * scratch;
+    float * single[2];
+    VALUE input;
+    VALUE output;
+} plan_call;
+
+static void plan_call_acquire(plan_call * call, ft_plan * plan, VALUE input, VALUE output)
+{
+    call->plan = plan;
+    call->input = input;
+    call->output = output;
+    call->owned = !plan->busy;
+    if(call->owned)
+    {
+        // the buffers are only needed by FT::Plan objects, not temporary plans
+        if(plan->precision != FT_FLOAT32 && !plan->buffer[0])
+        {
+            plan->buffer[0] = malloc(plan->length * sizeof(double));
+            plan->buffer[1] = malloc(plan->length * sizeof(double));
+        }
+        plan->busy = TRUE;
+        call->real = plan->buffer[0];
+        call->imag = plan->buffer[1];
+        call->scratch = plan->scratch;
+        call->single[0] = plan->single_buffer[0];
+        call->single[1] = plan->single_buffer[1];
+    }
+    else if(plan->precision == FT_FLOAT32)
+    {
+        call->single[0] = malloc(plan->length * sizeof(float));
+        call->single[1] = malloc(plan->length * sizeof(float));
+        call->real = call->imag = call->scratch = NULL;
+    }
+    else
+    {
+        call->real = malloc(plan->length * sizeof(double));
+        call->imag = malloc(plan->length * sizeof(double));
+        call->scratch = malloc((ft_plan_scratch_length(plan) + 1) * sizeof(double));
+        call->single[0] = call->single[1] = NULL;
+    }
+}
+
+static VALUE plan_call_release(VALUE data)
+{
+    plan_call * call = (plan_call *)data;
+
+    if(call->owned)
+        call->plan->busy = FALSE;
+    else
+    {
+        free(call->real);
+        free(call->imag);
+        free(call->scratch);
+        free(call->single[0]);
+        free(call->single[1]);
+    }
+
+    return Qnil;
+}
+
+static void * plan_call_run(void * data)
+{
+    plan_call * call = data;
+
+    if(call->plan->precision == FT_FLOAT32)
+        ft_plan_execute_single(call->plan, call->single[0], call->single[1]);
+    else
+        ft_plan_execute_scratch(call->plan, call->real, call->imag, call->scratch);
+    return NULL;
+}
+
+static long plan_work(const ft_plan * plan)
+{
+    ft_job job;
+
+    job.kind = FT_JOB_FFT;
+    job.length = plan->algorithm == FT_BLUESTEIN ? 2 * plan->padded_length : plan->length;
+    return ft_job_work(&job);
+}
+
+/**
+ * @brief Compute a FFT in place using a plan, releasing the GVL for large ones.
+ * Uses the scratch memory of the plan.
+ * @see ft_plan_execute()
+ * @author placek@ragnarson.com
+ * @param plan A plan of the transform.
+ * @param real Real parts of processing data.
+ * @param imag Imaginary parts of processing data.
+ */
+void ft_plan_execute_without_gvl(ft_plan * plan, double * real, double * imag)
+{
+    plan_call call;
+
+    call.plan = plan;
+    call.real = real;
+    call.imag = imag;
+    call.scratch = plan->scratch;
+    ft_without_gvl(plan_call_run, &call, plan_work(plan));
+}
+
+static VALUE plan_execute_body(VALUE data)
+{
+    plan_call * call = (plan_call *)data;
+    long i, length = call->plan->length;
+    VALUE * values = RARRAY_PTR(call->input);
+
+    // unbox the values into the buffers
+    if(call->plan->precision == FT_FLOAT32)
+        for(i = 0; i < length; i++)
+        {
+            call->single[0][i] = (float)NUM2DBL(rb_ary_entry(values[0], i));
+            call->single[1][i] = (float)NUM2DBL(rb_ary_entry(values[1], i));
+        }
+    else
+        for(i = 0; i < length; i++)
+        {
+            call->real[i] = NUM2DBL(rb_ary_entry(values[0], i));
+            call->imag[i] = NUM2DBL(rb_ary_entry(values[1], i));
+        }
+
+    // do the actual transform
+    ft_without_gvl(plan_call_run, call, plan_work(call->plan));
+
+    if(call->plan->precision == FT_FLOAT32)
+        return complex_single_to_ruby(call->single[0], call->single[1], length);
+    return complex_to_ruby(call->real, call->imag, length);
+}
+
+/**
+ * @brief Execute a plan.
+ * Computes the FFT of the data (an array of real and imaginary parts, like
+ * for Array#fft) with the precomputed tables.
+ * @author placek@ragnarson.com
+ * @params self A plan.
+ * @params inArray A Ruby input data array.
+ * @return The output Ruby Array with FFT processed data (nil if the data does
+ * not match the plan).
+ */
+static VALUE plan_execute(VALUE self, VALUE inArray)
+{
+    ft_plan * plan = get_plan(self);
+    plan_call call;
+
+    if(!fourier_validate(inArray))
+        return Qnil;
+    if(RARRAY_LEN(RARRAY_PTR(inArray)[0]) != plan->length)
+        return Qnil;
+
+    plan_call_acquire(&call, plan, inArray, Qnil);
+    return rb_ensure(plan_execute_body, (VALUE)&call, plan_call_release, (VALUE)&call);
+}
+
+static VALUE plan_execute_buffer_body(VALUE data)
+{
+    plan_call * call = (plan_call *)data;
+    ft_buffer buffer;
+    long length = call->plan->length;
+    int single = call->plan->precision == FT_FLOAT32;
+    long size = 2 * length * (single ? sizeof(float) : sizeof(double));
+
+    ft_buffer_open(call->input, &buffer, call->plan->precision);
+    if(buffer.size != size)
+    {
+        ft_buffer_close(&buffer);
+        return Qnil;
+    }
+    if(single)
+        ft_buffer_read_complex_single(&buffer, call->single[0], call->single[1], length);
+    else
+        ft_buffer_read_complex(&buffer, call->real, call->imag, length);
+    ft_buffer_close(&buffer);
+
+    // do the actual transform
+    ft_without_gvl(plan_call_run, call, plan_work(call->plan));
+
+    call->output = ft_buffer_output(call->output, size);
+    if(single)
+        ft_buffer_write_complex_single(RSTRING_PTR(call->output), call->single[0], call->single[1], length);
+    else
+        ft_buffer_write_complex(RSTRING_PTR(call->output), call->real, call->imag, length);
+
+    return call->output;
+}
+
+/**
+ * @brief Execute a plan on a packed buffer.
+ * Plan#execute_buffer(input, output = nil) reads interleaved complex
+ * little-endian doubles (floats for single precision plans) from a String
+ * (or a memory view) and writes the result into the output String, reused
+ * when given.
+ * @see ft_buffer_open()
+ * @author placek@ragnarson.com
+ * @params argc Number of arguments.
+ * @params argv Arguments (input and optional output String).
+ * @params self A plan.
+ * @return The output String (nil if the data does not match the plan).
+ */
+static VALUE plan_execute_buffer(int argc, VALUE * argv, VALUE self)
+{
+    ft_plan * plan = get_plan(self);
+    VALUE input, output;
+    plan_call call;
+
+    rb_scan_args(argc, argv, "11", &input, &output);
+    plan_call_acquire(&call, plan, input, output);
+    return rb_ensure(plan_execute_buffer_body, (VALUE)&call, plan_call_release, (VALUE)&call);
+}
+
+/**
+ * @brief Get the length of a plan.
+ * @author placek@ragnarson.com
+ * @params self A plan.
+ * @return The length of transformed data.
+ */
+static VALUE plan_length(VALUE self)
+{
+    return LONG2NUM(get_plan(self)->length);
+}
+
+/**
+ * @brief Get the direction of a plan.
+ * @author placek@ragnarson.com
+ * @params self A plan.
+ * @return :forward or :reverse.
+ */
+static VALUE plan_direction(VALUE self)
+{
+    return ID2SYM(get_plan(self)->direction == -1 ? id_reverse : id_forward);
+}
+
+/**
+ * @brief Get the precision of a plan.
+ * @author placek@ragnarson.com
+ * @params self A plan.
+ * @return :float64 or :float32.
+ */
+static VALUE plan_precision(VALUE self)
+{
+    return ft_precision_to_ruby(get_plan(self)->precision);
+}
+
+/**
+ * @brief Get the algorithm of a plan.
+ * @author placek@ragnarson.com
+ * @params self A plan.
+ * @return :radix2, :mixed_radix, :bluestein or :four_step.
+ */
+static VALUE plan_algorithm(VALUE self)
+{
+    return ft_algorithm_to_ruby(get_plan(self)->algorithm);
+}
+
+/**
+ * @brief Initialize the FrequencyTransformations::Plan class.
+ * @author placek@ragnarson.com
+ */
+void Init_plan(void)
+{
+    id_forward = rb_intern("forward");
+    id_reverse = rb_intern("reverse");
+
+    cPlan = rb_define_class_under(FT, "Plan", rb_cObject);
+    rb_define_alloc_func(cPlan, plan_alloc);
+    rb_define_method(cPlan, "initialize", plan_initialize, -1);
+    rb_define_method(cPlan, "execute", plan_execute, 1);
+    rb_define_method(cPlan, "execute_buffer", plan_execute_buffer, -1);
+    rb_define_method(cPlan, "length", plan_length, 0);
+    rb_define_method(cPlan, "direction", plan_direction, 0);
+    rb_define_method(cPlan, "precision", plan_precision, 0);
+    rb_define_method(cPlan, "algorithm", plan_algorithm, 0);
+}
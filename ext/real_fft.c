@@ -0,0 +1,354 @@
+/**
+ * @file real_fft.c
+ * @brief FFT of real data returning the non-negative half of the spectrum.
+ * The N real values are packed into N/2 complex numbers (even samples as real
+ * parts, odd samples as imaginary parts), transformed with an N/2 point FFT
+ * and split into the spectrum of length N/2 + 1. The rest of the spectrum
+ * is the complex conjugate of it.
+ * @author placek@ragnarson.com
+ */
+#include "frequency_transformations.h"
+
+/**
+ * @brief Create a real FFT plan.
+ * Even lengths get a complex plan of half the length and the table of
+ * factors used to split its result, odd lengths fall back to a complex plan
+ * of the full length.
+ * @author placek@ragnarson.com
+ * @param length Length of real data.
+ * @param direction An FFT direction (1 - forward FFT, -1 - reverse FFT).
+ * @return A new plan (to be released with ft_real_plan_free()).
+ */
+ft_real_plan * ft_real_plan_create(long length, int direction)
+{
+    long k, half = length / 2;
+    double arg;
+    ft_real_plan * plan;
+
+    plan = calloc(1, sizeof(ft_real_plan));
+    plan->length = length;
+    plan->direction = direction;
+
+    if(length % 2 == 1)
+    {
+        plan->complex = ft_plan_create(length, direction);
+        plan->work[0] = malloc(length * sizeof(double));
+        plan->work[1] = malloc(length * sizeof(double));
+        return plan;
+    }
+
+    plan->complex = ft_plan_create(half, direction);
+    plan->work[0] = malloc(half * sizeof(double));
+    plan->work[1] = malloc(half * sizeof(double));
+    plan->twiddle_real = malloc(half * sizeof(double));
+    plan->twiddle_imag = malloc(half * sizeof(double));
+    arg = 2.0 * M_PI / (double)length;
+    for(k = 0; k < half; k++)
+    {
+        plan->twiddle_real[k] = cos(arg * (double)k);
+        plan->twiddle_imag[k] = -sin(arg * (double)k);
+    }
+
+    return plan;
+}
+
+/**
+ * @brief Release a real FFT plan.
+ * @author placek@ragnarson.com
+ * @param plan A plan created by ft_real_plan_create().
+ */
+void ft_real_plan_free(ft_real_plan * plan)
+{
+    if(!plan)
+        return;
+    ft_plan_free(plan->complex);
+    free(plan->twiddle_real);
+    free(plan->twiddle_imag);
+    free(plan->work[0]);
+    free(plan->work[1]);
+    free(plan);
+}
+
+/**
+ * @brief Compute the FFT of real data.
+ * @author placek@ragnarson.com
+ * @param plan A forward real FFT plan.
+ * @param values Real data (length of the plan).
+ * @param real Place for real parts of the spectrum (length / 2 + 1).
+ * @param imag Place for imaginary parts of the spectrum (length / 2 + 1).
+ */
+void ft_real_plan_forward(const ft_real_plan * plan, const double * values, double * real, double * imag)
+{
+    long k, length = plan->length, half = length / 2;
+    double * z_real = plan->work[0], * z_imag = plan->work[1];
+    double zk_real, zk_imag, zc_real, zc_imag, even_real, even_imag, odd_real, odd_imag;
+
+    // odd lengths: complex FFT of the full length
+    if(length % 2 == 1)
+    {
+        for(k = 0; k < length; k++)
+        {
+            z_real[k] = values[k];
+            z_imag[k] = 0.0;
+        }
+        ft_plan_execute(plan->complex, z_real, z_imag);
+        for(k = 0; k <= half; k++)
+        {
+            real[k] = z_real[k];
+            imag[k] = z_imag[k];
+        }
+        return;
+    }
+
+    // pack even and odd samples into one complex sequence
+    for(k = 0; k < half; k++)
+    {
+        z_real[k] = values[2 * k];
+        z_imag[k] = values[2 * k + 1];
+    }
+    ft_plan_execute(plan->complex, z_real, z_imag);
+
+    // split the spectra of even and odd samples and combine them
+    real[0] = z_real[0] + z_imag[0];
+    imag[0] = 0.0;
+    real[half] = z_real[0] - z_imag[0];
+    imag[half] = 0.0;
+    for(k = 1; k < half; k++)
+    {
+        zk_real = z_real[k];
+        zk_imag = z_imag[k];
+        zc_real = z_real[half - k];
+        zc_imag = -z_imag[half - k];
+        even_real = 0.5 * (zk_real + zc_real);
+        even_imag = 0.5 * (zk_imag + zc_imag);
+        odd_real = 0.5 * (zk_imag - zc_imag);
+        odd_imag = -0.5 * (zk_real - zc_real);
+        real[k] = even_real + plan->twiddle_real[k] * odd_real - plan->twiddle_imag[k] * odd_imag;
+        imag[k] = even_imag + plan->twiddle_real[k] * odd_imag + plan->twiddle_imag[k] * odd_real;
+    }
+}
+
+/**
+ * @brief Compute the inverse FFT of the half of a spectrum of real data.
+ * @author placek@ragnarson.com
+ * @param plan A reverse real FFT plan.
+ * @param real Real parts of the spectrum (length / 2 + 1).
+ * @param imag Imaginary parts of the spectrum (length / 2 + 1).
+ * @param values Place for real data (length of the plan).
+ */
+void ft_real_plan_inverse(const ft_real_plan * plan, const double * real, const double * imag, double * values)
+{
+    long k, length = plan->length, half = length / 2;
+    double * z_real = plan->work[0], * z_imag = plan->work[1];
+    double even_real, even_imag, diff_real, diff_imag, odd_real, odd_imag;
+
+    // odd lengths: complex inverse FFT of the conjugate symmetric spectrum
+    if(length % 2 == 1)
+    {
+        for(k = 0; k <= half; k++)
+        {
+            z_real[k] = real[k];
+            z_imag[k] = imag[k];
+        }
+        for(k = half + 1; k < length; k++)
+        {
+            z_real[k] = real[length - k];
+            z_imag[k] = -imag[length - k];
+        }
+        ft_plan_execute(plan->complex, z_real, z_imag);
+        for(k = 0; k < length; k++)
+            values[k] = z_real[k];
+        return;
+    }
+
+    // rebuild the packed spectrum of even and odd samples
+    for(k = 0; k < half; k++)
+    {
+        even_real = 0.5 * (real[k] + real[half - k]);
+        even_imag = 0.5 * (imag[k] - imag[half - k]);
+        diff_real = 0.5 * (real[k] - real[half - k]);
+        diff_imag = 0.5 * (imag[k] + imag[half - k]);
+        // divide by the factor, which is multiplying by its conjugate
+        odd_real = diff_real * plan->twiddle_real[k] + diff_imag * plan->twiddle_imag[k];
+        odd_imag = diff_imag * plan->twiddle_real[k] - diff_real * plan->twiddle_imag[k];
+        z_real[k] = even_real - odd_imag;
+        z_imag[k] = even_imag + odd_real;
+    }
+    ft_plan_execute(plan->complex, z_real, z_imag);
+
+    // unpack even and odd samples
+    for(k = 0; k < half; k++)
+    {
+        values[2 * k] = z_real[k];
+        values[2 * k + 1] = z_imag[k];
+    }
+}
+
+/**
+ * @brief A call of a real FFT plan.
+ */
+typedef struct
+{
+    const ft_real_plan * plan;
+    const double * in[2];
+    double * out[2];
+} real_plan_call;
+
+static void * real_plan_forward_run(void * data)
+{
+    real_plan_call * call = data;
+    ft_real_plan_forward(call->plan, call->in[0], call->out[0], call->out[1]);
+    return NULL;
+}
+
+static void * real_plan_inverse_run(void * data)
+{
+    real_plan_call * call = data;
+    ft_real_plan_inverse(call->plan, call->in[0], call->in[1], call->out[0]);
+    return NULL;
+}
+
+static long real_plan_work(const ft_real_plan * plan)
+{
+    ft_job job;
+
+    job.kind = FT_JOB_FFT;
+    job.length = plan->length;
+    return ft_job_work(&job) / 2;
+}
+
+/**
+ * @brief Compute the FFT of real data, releasing the GVL for large ones.
+ * @see ft_real_plan_forward()
+ * @author placek@ragnarson.com
+ */
+void ft_real_plan_forward_without_gvl(const ft_real_plan * plan, const double * values, double * real, double * imag)
+{
+    real_plan_call call;
+
+    call.plan = plan;
+    call.in[0] = values;
+    call.out[0] = real;
+    call.out[1] = imag;
+    ft_without_gvl(real_plan_forward_run, &call, real_plan_work(plan));
+}
+
+/**
+ * @brief Compute the inverse FFT of real data, releasing the GVL for large ones.
+ * @see ft_real_plan_inverse()
+ * @author placek@ragnarson.com
+ */
+void ft_real_plan_inverse_without_gvl(const ft_real_plan * plan, const double * real, const double * imag, double * values)
+{
+    real_plan_call call;
+
+    call.plan = plan;
+    call.in[0] = real;
+    call.in[1] = imag;
+    call.out[0] = values;
+    ft_without_gvl(real_plan_inverse_run, &call, real_plan_work(plan));
+}
+
+/**
+ * @brief Compute a FFT of real data.
+ * @author placek@ragnarson.com
+ * @params self A Ruby input data array (real numbers).
+ * @return The output Ruby Array with real and imaginary parts of length / 2 + 1 bins
+ * (nil for empty data).
+ */
+static VALUE real_fft(VALUE self)
+{
+    long i, length;
+    VALUE * values;
+    double * transformed, * spectrum[2];
+    ft_real_plan * plan;
+    VALUE outArray;
+
+    Check_Type(self, T_ARRAY);
+    length = RARRAY_LEN(self);
+    if(length < 1)
+        return Qnil;
+
+    // convert the ruby array into a C array
+    values = RARRAY_PTR(self);
+    transformed = malloc(length * sizeof(double));
+    spectrum[0] = malloc((length / 2 + 1) * sizeof(double));
+    spectrum[1] = malloc((length / 2 + 1) * sizeof(double));
+    for(i = 0; i < length; i++)
+        transformed[i] = NUM2DBL(values[i]);
+
+    // do the actual transform
+    plan = ft_real_plan_create(length, 1);
+    ft_real_plan_forward_without_gvl(plan, transformed, spectrum[0], spectrum[1]);
+    ft_real_plan_free(plan);
+    outArray = complex_to_ruby(spectrum[0], spectrum[1], length / 2 + 1);
+
+    // no memory leaks
+    free(transformed);
+    free(spectrum[0]);
+    free(spectrum[1]);
+
+    return outArray;
+}
+
+/**
+ * @brief Compute a reverse FFT of the half of a spectrum of real data.
+ * The length of the result is 2 * (bins - 1) unless given explicitly
+ * (only needed for odd lengths).
+ * @author placek@ragnarson.com
+ * @params argc Number of arguments.
+ * @params argv Arguments (optional length of the result).
+ * @params self A Ruby input data array (real and imaginary parts of bins).
+ * @return The output Ruby Array with real data (nil if the spectrum does not match the length).
+ */
+static VALUE inverse_real_fft(int argc, VALUE * argv, VALUE self)
+{
+    long i, bins, length;
+    VALUE * values, rb_length;
+    double * transformed, * spectrum[2];
+    ft_real_plan * plan;
+    VALUE outArray;
+
+    rb_scan_args(argc, argv, "01", &rb_length);
+    if(!fourier_validate(self))
+        return Qnil;
+
+    values = RARRAY_PTR(self);
+    bins = RARRAY_LEN(values[0]);
+    length = NIL_P(rb_length) ? 2 * (bins - 1) : NUM2LONG(rb_length);
+    if(length < 1 || length / 2 + 1 != bins)
+        return Qnil;
+
+    // convert the ruby array into a C array
+    transformed = malloc(length * sizeof(double));
+    spectrum[0] = malloc(bins * sizeof(double));
+    spectrum[1] = malloc(bins * sizeof(double));
+    for(i = 0; i < bins; i++)
+    {
+        spectrum[0][i] = NUM2DBL(RARRAY_PTR(values[0])[i]);
+        spectrum[1][i] = NUM2DBL(RARRAY_PTR(values[1])[i]);
+    }
+
+    // do the actual transform
+    plan = ft_real_plan_create(length, -1);
+    ft_real_plan_inverse_without_gvl(plan, spectrum[0], spectrum[1], transformed);
+    ft_real_plan_free(plan);
+    outArray = real_to_ruby(transformed, length);
+
+    // no memory leaks
+    free(transformed);
+    free(spectrum[0]);
+    free(spectrum[1]);
+
+    return outArray;
+}
+
+/**
+ * @brief Define the real data FFT methods.
+ * @author placek@ragnarson.com
+ */
+void Init_real_fft(void)
+{
+    rb_define_method(FT, "real_fft", real_fft, 0);
+    rb_define_method(FT, "inverse_real_fft", inverse_real_fft, -1);
+}
@@ -0,0 +1,281 @@
+/**
+ * @file shift.c
+ * @brief Moving the zero frequency to the center of a spectrum.
+ * fftshift rotates every axis of a row-major buffer by half of its length
+ * (rounded up), ifftshift rotates it back. Each axis is rotated in place by
+ * three reversals of blocks (the lines below the axis), so only contiguous
+ * runs of memory are swapped and odd lengths are handled exactly. The same
+ * rotation can be applied while converting a result into Ruby arrays, which
+ * makes it free as an output stage of the transforms (shift: true).
+ * @author placek@ragnarson.com
+ */
+#include "frequency_transformations.h"
+
+static ID id_shift;
+
+/**
+ * @brief Get the rotation of an axis.
+ * Element i of the shifted axis is element (i + offset) % length of the
+ * input.
+ * @author placek@ragnarson.com
+ * @param length Length of the axis.
+ * @param inverse FALSE for fftshift, TRUE for ifftshift.
+ * @return The offset (0 for an empty axis).
+ */
+long ft_shift_offset(long length, int inverse)
+{
+    if(length < 1)
+        return 0;
+    return inverse ? length / 2 : (length - length / 2) % length;
+}
+
+/**
+ * @brief Reverse the order of blocks.
+ * @author placek@ragnarson.com
+ * @param values The first block.
+ * @param count Number of blocks.
+ * @param block Length of a block.
+ */
+static void reverse_blocks(double * values, long count, long block)
+{
+    long i, k;
+    double temp, * a, * b;
+
+    for(i = 0; i < count / 2; i++)
+    {
+        a = values + i * block;
+        b = values + (count - 1 - i) * block;
+        for(k = 0; k < block; k++)
+        {
+            temp = a[k];
+            a[k] = b[k];
+            b[k] = temp;
+        }
+    }
+}
+
+/**
+ * @brief Shift a row-major buffer in place.
+ * @author placek@ragnarson.com
+ * @param values Processing data.
+ * @param shape Lengths of the axes (the last one is contiguous).
+ * @param dims Number of axes.
+ * @param inverse FALSE for fftshift, TRUE for ifftshift.
+ */
+void ft_shift(double * values, const long * shape, int dims, int inverse)
+{
+    long i, outer = 1, inner, size = 1, offset;
+    int d;
+
+    for(d = 0; d < dims; d++)
+        size *= shape[d];
+
+    for(d = 0; d < dims; d++)
+    {
+        inner = size / outer / shape[d];
+        offset = ft_shift_offset(shape[d], inverse);
+        if(offset > 0)
+            for(i = 0; i < outer; i++)
+            {
+                // rotate left by offset blocks: reverse both parts, then the whole
+                reverse_blocks(values + i * shape[d] * inner, offset, inner);
+                reverse_blocks(values + (i * shape[d] + offset) * inner, shape[d] - offset, inner);
+                reverse_blocks(values + i * shape[d] * inner, shape[d], inner);
+            }
+        outer *= shape[d];
+    }
+}
+
+/**
+ * @brief Get the shape of nested Ruby arrays.
+ * The array should be rectangular: all the arrays at a level have the same
+ * length and the innermost ones hold numbers.
+ * @author placek@ragnarson.com
+ * @param inArray A Ruby input data array.
+ * @param shape Place for lengths of the axes (FT_MAX_DIMS entries).
+ * @return Number of axes (0 for empty or irregular data).
+ */
+int ft_nd_shape(VALUE inArray, long * shape)
+{
+    VALUE level = inArray;
+    int d, dims = 0;
+    long i, count = 1, total = 0;
+    VALUE * items, * next;
+
+    while(TYPE(level) == T_ARRAY)
+    {
+        if(dims == FT_MAX_DIMS || RARRAY_LEN(level) < 1)
+            return 0;
+        shape[dims++] = RARRAY_LEN(level);
+        level = RARRAY_PTR(level)[0];
+    }
+
+    // check every array of every level
+    items = malloc(sizeof(VALUE));
+    items[0] = inArray;
+    for(d = 0; d < dims - 1; d++)
+    {
+        next = malloc(count * shape[d] * sizeof(VALUE));
+        for(i = 0, total = 0; i < count; i++)
+        {
+            if(TYPE(items[i]) != T_ARRAY || RARRAY_LEN(items[i]) != shape[d])
+            {
+                free(items);
+                free(next);
+                return 0;
+            }
+            MEMCPY(next + total, RARRAY_PTR(items[i]), VALUE, shape[d]);
+            total += shape[d];
+        }
+        free(items);
+        items = next;
+        count = total;
+    }
+    for(i = 0; i < count; i++)
+        if(TYPE(items[i]) != T_ARRAY || RARRAY_LEN(items[i]) != shape[dims - 1])
+        {
+            free(items);
+            return 0;
+        }
+    free(items);
+
+    return dims;
+}
+
+/**
+ * @brief Convert nested Ruby arrays into a row-major C buffer.
+ * @author placek@ragnarson.com
+ * @param inArray A Ruby array validated by ft_nd_shape().
+ * @param values Place for the values.
+ * @param shape Lengths of the axes.
+ * @param dims Number of axes.
+ * @return Number of values written.
+ */
+long ft_nd_from_ruby(VALUE inArray, double * values, const long * shape, int dims)
+{
+    long i, written = 0;
+    VALUE * items = RARRAY_PTR(inArray);
+
+    if(dims == 1)
+    {
+        for(i = 0; i < shape[0]; i++)
+            values[i] = NUM2DBL(items[i]);
+        return shape[0];
+    }
+    for(i = 0; i < shape[0]; i++)
+        written += ft_nd_from_ruby(items[i], values + written, shape + 1, dims - 1);
+    return written;
+}
+
+/**
+ * @brief Convert a row-major C buffer into nested Ruby arrays.
+ * With offsets every axis is rotated on the way (element i of an axis is
+ * element (i + offset) % length of the buffer).
+ * @see ft_shift_offset()
+ * @author placek@ragnarson.com
+ * @param values A row-major buffer.
+ * @param shape Lengths of the axes.
+ * @param dims Number of axes.
+ * @param offsets Rotations of the axes (or NULL).
+ * @return Nested Ruby arrays.
+ */
+VALUE ft_nd_to_ruby(const double * values, const long * shape, int dims, const long * offsets)
+{
+    long i, source, stride = 1;
+    int d;
+    VALUE outArray = rb_ary_new2(shape[0]);
+
+    for(d = 1; d < dims; d++)
+        stride *= shape[d];
+    for(i = 0; i < shape[0]; i++)
+    {
+        source = offsets ? (i + offsets[0]) % shape[0] : i;
+        if(dims == 1)
+            rb_ary_push(outArray, DBL2NUM(values[source]));
+        else
+            rb_ary_push(outArray, ft_nd_to_ruby(values + source * stride, shape + 1, dims - 1,
+                offsets ? offsets + 1 : NULL));
+    }
+
+    return outArray;
+}
+
+/**
+ * @brief Read the shift option of a transform.
+ * @author placek@ragnarson.com
+ * @param options A Hash of keyword arguments (or nil).
+ * @return TRUE for shift: true.
+ */
+int ft_shift_option(VALUE options)
+{
+    VALUE shift = Qundef;
+
+    if(NIL_P(options))
+        return FALSE;
+    rb_get_kwargs(options, &id_shift, 0, 1, &shift);
+    return shift != Qundef && RTEST(shift);
+}
+
+/**
+ * @brief Shift nested Ruby arrays of any number of dimensions.
+ * @author placek@ragnarson.com
+ * @params inArray A Ruby input data array.
+ * @params inverse FALSE for fftshift, TRUE for ifftshift.
+ * @return The output Ruby Array (nil for empty or irregular data).
+ */
+VALUE ft_shift_ruby(VALUE inArray, int inverse)
+{
+    long shape[FT_MAX_DIMS], size = 1;
+    double * values;
+    int d, dims;
+    VALUE outArray;
+
+    Check_Type(inArray, T_ARRAY);
+    dims = ft_nd_shape(inArray, shape);
+    if(dims == 0)
+        return Qnil;
+    for(d = 0; d < dims; d++)
+        size *= shape[d];
+
+    values = malloc(size * sizeof(double));
+    ft_nd_from_ruby(inArray, values, shape, dims);
+    ft_shift(values, shape, dims, inverse);
+    outArray = ft_nd_to_ruby(values, shape, dims, NULL);
+    free(values);
+
+    return outArray;
+}
+
+/**
+ * @brief Move the zero frequency to the center.
+ * @author placek@ragnarson.com
+ * @params self A Ruby input data array (real numbers, any number of dimensions).
+ * @return The shifted Ruby Array.
+ */
+static VALUE fftshift(VALUE self)
+{
+    return ft_shift_ruby(self, FALSE);
+}
+
+/**
+ * @brief Undo fftshift.
+ * @author placek@ragnarson.com
+ * @params self A Ruby input data array (real numbers, any number of dimensions).
+ * @return The shifted Ruby Array.
+ */
+static VALUE ifftshift(VALUE self)
+{
+    return ft_shift_ruby(self, TRUE);
+}
+
+/**
+ * @brief Define the shift methods.
+ * @author placek@ragnarson.com
+ */
+void Init_shift(void)
+{
+    id_shift = rb_intern("shift");
+
+    rb_define_method(FT, "fftshift", fftshift, 0);
+    rb_define_method(FT, "ifftshift", ifftshift, 0);
+}
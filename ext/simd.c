@@ -0,0 +1,318 @@
+/**
+ * @file simd.c
+ * @brief Butterfly passes of the radix-2 plans with runtime CPU dispatch.
+ * The passes (in double and single precision) are compiled for SSE2, AVX2
+ * (with FMA) and AVX-512 through function target attributes, so the
+ * extension itself needs no special compiler flags. The best instruction
+ * set supported by the CPU is chosen when the extension is loaded; FT.simd=
+ * forces another one (for example to check each of them against the scalar
+ * passes).
+ * @author placek@ragnarson.com
+ */
+#include "frequency_transformations.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define FT_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+static ID id_scalar, id_sse2, id_avx2, id_avx512;
+
+// portable passes, also used for steps shorter than a vector
+#define SIMD_NAME(name) scalar_##name
+#define SIMD_FALLBACK(name) scalar_##name
+#define SIMD_TARGET
+#define SIMD_REAL double
+#define SIMD_WIDTH 1
+#define VEC double
+#define VSET1(a) (a)
+#define VLOAD(p) (*(p))
+#define VSTORE(p, a) (*(p) = (a))
+#define VADD(a, b) ((a) + (b))
+#define VSUB(a, b) ((a) - (b))
+#define VMUL(a, b) ((a) * (b))
+#define VMADD(a, b, c) ((a) * (b) + (c))
+#define VMSUB(a, b, c) ((a) * (b) - (c))
+#define VSQRT(a) sqrt(a)
+#include "simd_passes.h"
+
+#define SIMD_NAME(name) scalar_float_##name
+#define SIMD_FALLBACK(name) scalar_float_##name
+#define SIMD_TARGET
+#define SIMD_REAL float
+#define SIMD_WIDTH 1
+#define VEC float
+#define VSET1(a) (a)
+#define VLOAD(p) (*(p))
+#define VSTORE(p, a) (*(p) = (a))
+#define VADD(a, b) ((a) + (b))
+#define VSUB(a, b) ((a) - (b))
+#define VMUL(a, b) ((a) * (b))
+#define VMADD(a, b, c) ((a) * (b) + (c))
+#define VMSUB(a, b, c) ((a) * (b) - (c))
+#include "simd_passes.h"
+
+#ifdef FT_X86_SIMD
+
+#define SIMD_NAME(name) sse2_##name
+#define SIMD_FALLBACK(name) scalar_##name
+#define SIMD_TARGET __attribute__((target("sse2")))
+#define SIMD_REAL double
+#define SIMD_WIDTH 2
+#define VEC __m128d
+#define VSET1(a) _mm_set1_pd(a)
+#define VLOAD(p) _mm_loadu_pd(p)
+#define VSTORE(p, a) _mm_storeu_pd((p), (a))
+#define VADD(a, b) _mm_add_pd((a), (b))
+#define VSUB(a, b) _mm_sub_pd((a), (b))
+#define VMUL(a, b) _mm_mul_pd((a), (b))
+#define VMADD(a, b, c) _mm_add_pd(_mm_mul_pd((a), (b)), (c))
+#define VMSUB(a, b, c) _mm_sub_pd(_mm_mul_pd((a), (b)), (c))
+#define VSQRT(a) _mm_sqrt_pd(a)
+#include "simd_passes.h"
+
+#define SIMD_NAME(name) sse2_float_##name
+#define SIMD_FALLBACK(name) scalar_float_##name
+#define SIMD_TARGET __attribute__((target("sse2")))
+#define SIMD_REAL float
+#define SIMD_WIDTH 4
+#define VEC __m128
+#define VSET1(a) _mm_set1_ps(a)
+#define VLOAD(p) _mm_loadu_ps(p)
+#define VSTORE(p, a) _mm_storeu_ps((p), (a))
+#define VADD(a, b) _mm_add_ps((a), (b))
+#define VSUB(a, b) _mm_sub_ps((a), (b))
+#define VMUL(a, b) _mm_mul_ps((a), (b))
+#define VMADD(a, b, c) _mm_add_ps(_mm_mul_ps((a), (b)), (c))
+#define VMSUB(a, b, c) _mm_sub_ps(_mm_mul_ps((a), (b)), (c))
+#include "simd_passes.h"
+
+#define SIMD_NAME(name) avx2_##name
+#define SIMD_FALLBACK(name) scalar_##name
+#define SIMD_TARGET __attribute__((target("avx2,fma")))
+#define SIMD_REAL double
+#define SIMD_WIDTH 4
+#define VEC __m256d
+#define VSET1(a) _mm256_set1_pd(a)
+#define VLOAD(p) _mm256_loadu_pd(p)
+#define VSTORE(p, a) _mm256_storeu_pd((p), (a))
+#define VADD(a, b) _mm256_add_pd((a), (b))
+#define VSUB(a, b) _mm256_sub_pd((a), (b))
+#define VMUL(a, b) _mm256_mul_pd((a), (b))
+#define VMADD(a, b, c) _mm256_fmadd_pd((a), (b), (c))
+#define VMSUB(a, b, c) _mm256_fmsub_pd((a), (b), (c))
+#define VSQRT(a) _mm256_sqrt_pd(a)
+#include "simd_passes.h"
+
+#define SIMD_NAME(name) avx2_float_##name
+#define SIMD_FALLBACK(name) scalar_float_##name
+#define SIMD_TARGET __attribute__((target("avx2,fma")))
+#define SIMD_REAL float
+#define SIMD_WIDTH 8
+#define VEC __m256
+#define VSET1(a) _mm256_set1_ps(a)
+#define VLOAD(p) _mm256_loadu_ps(p)
+#define VSTORE(p, a) _mm256_storeu_ps((p), (a))
+#define VADD(a, b) _mm256_add_ps((a), (b))
+#define VSUB(a, b) _mm256_sub_ps((a), (b))
+#define VMUL(a, b) _mm256_mul_ps((a), (b))
+#define VMADD(a, b, c) _mm256_fmadd_ps((a), (b), (c))
+#define VMSUB(a, b, c) _mm256_fmsub_ps((a), (b), (c))
+#include "simd_passes.h"
+
+#define SIMD_NAME(name) avx512_##name
+#define SIMD_FALLBACK(name) scalar_##name
+#define SIMD_TARGET __attribute__((target("avx512f")))
+#define SIMD_REAL double
+#define SIMD_WIDTH 8
+#define VEC __m512d
+#define VSET1(a) _mm512_set1_pd(a)
+#define VLOAD(p) _mm512_loadu_pd(p)
+#define VSTORE(p, a) _mm512_storeu_pd((p), (a))
+#define VADD(a, b) _mm512_add_pd((a), (b))
+#define VSUB(a, b) _mm512_sub_pd((a), (b))
+#define VMUL(a, b) _mm512_mul_pd((a), (b))
+#define VMADD(a, b, c) _mm512_fmadd_pd((a), (b), (c))
+#define VMSUB(a, b, c) _mm512_fmsub_pd((a), (b), (c))
+#define VSQRT(a) _mm512_sqrt_pd(a)
+#include "simd_passes.h"
+
+#define SIMD_NAME(name) avx512_float_##name
+#define SIMD_FALLBACK(name) scalar_float_##name
+#define SIMD_TARGET __attribute__((target("avx512f")))
+#define SIMD_REAL float
+#define SIMD_WIDTH 16
+#define VEC __m512
+#define VSET1(a) _mm512_set1_ps(a)
+#define VLOAD(p) _mm512_loadu_ps(p)
+#define VSTORE(p, a) _mm512_storeu_ps((p), (a))
+#define VADD(a, b) _mm512_add_ps((a), (b))
+#define VSUB(a, b) _mm512_sub_ps((a), (b))
+#define VMUL(a, b) _mm512_mul_ps((a), (b))
+#define VMADD(a, b, c) _mm512_fmadd_ps((a), (b), (c))
+#define VMSUB(a, b, c) _mm512_fmsub_ps((a), (b), (c))
+#include "simd_passes.h"
+
+#endif
+
+/**
+ * @brief Passes of every instruction set, indexed by FT_SIMD_*.
+ */
+static const ft_simd_kernels kernels[] =
+{
+    { FT_SIMD_SCALAR, scalar_radix2_pass, scalar_radix4_pass, scalar_float_radix2_pass, scalar_float_radix4_pass, scalar_magnitude_pass,
+        1, scalar_batch_radix2_pass, 1, scalar_float_batch_radix2_pass },
+#ifdef FT_X86_SIMD
+    { FT_SIMD_SSE2, sse2_radix2_pass, sse2_radix4_pass, sse2_float_radix2_pass, sse2_float_radix4_pass, sse2_magnitude_pass,
+        2, sse2_batch_radix2_pass, 4, sse2_float_batch_radix2_pass },
+    { FT_SIMD_AVX2, avx2_radix2_pass, avx2_radix4_pass, avx2_float_radix2_pass, avx2_float_radix4_pass, avx2_magnitude_pass,
+        4, avx2_batch_radix2_pass, 8, avx2_float_batch_radix2_pass },
+    { FT_SIMD_AVX512, avx512_radix2_pass, avx512_radix4_pass, avx512_float_radix2_pass, avx512_float_radix4_pass, avx512_magnitude_pass,
+        8, avx512_batch_radix2_pass, 16, avx512_float_batch_radix2_pass },
+#endif
+};
+
+static const ft_simd_kernels * current = &kernels[FT_SIMD_SCALAR];
+
+/**
+ * @brief Check whether the CPU supports an instruction set.
+ * @author placek@ragnarson.com
+ * @param isa An instruction set (FT_SIMD_*).
+ * @return TRUE if its passes can run here.
+ */
+static int simd_supported(int isa)
+{
+    if(isa == FT_SIMD_SCALAR)
+        return TRUE;
+#ifdef FT_X86_SIMD
+    __builtin_cpu_init();
+    switch(isa)
+    {
+        case FT_SIMD_SSE2:
+            return __builtin_cpu_supports("sse2");
+        case FT_SIMD_AVX2:
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        case FT_SIMD_AVX512:
+            return __builtin_cpu_supports("avx512f");
+    }
+#endif
+    return FALSE;
+}
+
+/**
+ * @brief Choose the best instruction set supported by the CPU.
+ * @author placek@ragnarson.com
+ */
+static void simd_detect(void)
+{
+    int isa;
+
+    for(isa = FT_SIMD_AVX512; isa > FT_SIMD_SCALAR; isa--)
+        if(isa < (int)(sizeof(kernels) / sizeof(kernels[0])) && simd_supported(isa))
+            break;
+    current = &kernels[isa];
+}
+
+/**
+ * @brief Get the butterfly passes in use.
+ * @author placek@ragnarson.com
+ * @return Passes of the chosen instruction set.
+ */
+const ft_simd_kernels * ft_simd(void)
+{
+    return current;
+}
+
+/**
+ * @brief Get the butterfly passes of an instruction set.
+ * @author placek@ragnarson.com
+ * @param isa An instruction set (FT_SIMD_*).
+ * @return Its passes (NULL if the CPU or the build does not support it).
+ */
+const ft_simd_kernels * ft_simd_kernels_for(int isa)
+{
+    if(isa < 0 || isa >= (int)(sizeof(kernels) / sizeof(kernels[0])) || !simd_supported(isa))
+        return NULL;
+    return &kernels[isa];
+}
+
+static VALUE isa_to_ruby(int isa)
+{
+    static const ID * ids[] = { &id_scalar, &id_sse2, &id_avx2, &id_avx512 };
+    return ID2SYM(*ids[isa]);
+}
+
+/**
+ * @brief Get the instruction set of the butterfly passes.
+ * @author placek@ragnarson.com
+ * @return One of :scalar, :sse2, :avx2 and :avx512.
+ */
+static VALUE ft_get_simd(VALUE self)
+{
+    return isa_to_ruby(current->isa);
+}
+
+/**
+ * @brief Force the instruction set of the butterfly passes.
+ * @author placek@ragnarson.com
+ * @params isa One of :scalar, :sse2, :avx2 and :avx512 (nil - the best supported one).
+ * @return The isa.
+ */
+static VALUE ft_set_simd(VALUE self, VALUE isa)
+{
+    long i, count = sizeof(kernels) / sizeof(kernels[0]);
+
+    if(NIL_P(isa))
+    {
+        simd_detect();
+        return isa;
+    }
+
+    Check_Type(isa, T_SYMBOL);
+    for(i = 0; i < count; i++)
+        if(isa_to_ruby(kernels[i].isa) == isa)
+        {
+            if(!simd_supported(kernels[i].isa))
+                break;
+            current = &kernels[i];
+            return isa;
+        }
+
+    rb_raise(rb_eArgError, "instruction set %s is not supported", rb_id2name(SYM2ID(isa)));
+    return Qnil;
+}
+
+/**
+ * @brief List the instruction sets that can be forced.
+ * @author placek@ragnarson.com
+ * @return An Array of symbols, :scalar first.
+ */
+static VALUE ft_simd_available(VALUE self)
+{
+    long i, count = sizeof(kernels) / sizeof(kernels[0]);
+    VALUE list = rb_ary_new();
+
+    for(i = 0; i < count; i++)
+        if(simd_supported(kernels[i].isa))
+            rb_ary_push(list, isa_to_ruby(kernels[i].isa));
+
+    return list;
+}
+
+/**
+ * @brief Detect the CPU and define the dispatch methods.
+ * @author placek@ragnarson.com
+ */
+void Init_simd(void)
+{
+    id_scalar = rb_intern("scalar");
+    id_sse2 = rb_intern("sse2");
+    id_avx2 = rb_intern("avx2");
+    id_avx512 = rb_intern("avx512");
+
+    simd_detect();
+
+    rb_define_singleton_method(FT, "simd", ft_get_simd, 0);
+    rb_define_singleton_method(FT, "simd=", ft_set_simd, 1);
+    rb_define_singleton_method(FT, "simd_available", ft_simd_available, 0);
+}
@@ -0,0 +1,231 @@
+/**
+ * @file simd_passes.h
+ * @brief Butterfly passes of the radix-2 plans.
+ * Included by simd.c once per instruction set and precision, with SIMD_NAME,
+ * SIMD_TARGET, SIMD_REAL (double or float), SIMD_WIDTH and the vector
+ * operations (VEC, VLOAD, VSTORE, VADD, VSUB, VMUL, VMADD for a * b + c and
+ * VMSUB for a * b - c, VSET1 for a vector of one value) defined. The scalar
+ * passes are the same code with a width of 1. Steps shorter than the vector
+ * width go to SIMD_FALLBACK. The magnitude pass is compiled only when VSQRT
+ * is defined too.
+ * All the parameters are undefined at the end.
+ * @author placek@ragnarson.com
+ */
+
+/**
+ * @brief Multiply vectors of complex numbers.
+ */
+#define VCMUL(a_re, a_im, b_re, b_im, out_re, out_im) \
+    do { \
+        (out_re) = VMSUB(a_re, b_re, VMUL(a_im, b_im)); \
+        (out_im) = VMADD(a_re, b_im, VMUL(a_im, b_re)); \
+    } while(0)
+
+/**
+ * @brief One stage of the radix-2 decimation in time.
+ * Butterflies of a group are walked in order, so the data and the factors
+ * of the stage are read contiguously.
+ * @author placek@ragnarson.com
+ * @param real Real parts of processing data (in bit-reversed order).
+ * @param imag Imaginary parts of processing data (in bit-reversed order).
+ * @param length Length of processing data.
+ * @param step Distance between terms of a butterfly.
+ * @param factor_real Real parts of transform factors of the stage (step entries).
+ * @param factor_imag Imaginary parts of transform factors of the stage (step entries).
+ */
+static SIMD_TARGET void SIMD_NAME(radix2_pass)(SIMD_REAL * real, SIMD_REAL * imag, long length, long step,
+    const SIMD_REAL * factor_real, const SIMD_REAL * factor_imag)
+{
+    long base, k, jump = step << 1;
+    VEC w_re, w_im, a_re, a_im, b_re, b_im, t_re, t_im;
+
+#if SIMD_WIDTH > 1
+    if(step < SIMD_WIDTH)
+    {
+        SIMD_FALLBACK(radix2_pass)(real, imag, length, step, factor_real, factor_imag);
+        return;
+    }
+#endif
+
+    for(base = 0; base < length; base += jump)
+        for(k = 0; k < step; k += SIMD_WIDTH)
+        {
+            w_re = VLOAD(factor_real + k);
+            w_im = VLOAD(factor_imag + k);
+            a_re = VLOAD(real + base + k);
+            a_im = VLOAD(imag + base + k);
+            b_re = VLOAD(real + base + step + k);
+            b_im = VLOAD(imag + base + step + k);
+            VCMUL(w_re, w_im, b_re, b_im, t_re, t_im);
+            VSTORE(real + base + k, VADD(a_re, t_re));
+            VSTORE(imag + base + k, VADD(a_im, t_im));
+            VSTORE(real + base + step + k, VSUB(a_re, t_re));
+            VSTORE(imag + base + step + k, VSUB(a_im, t_im));
+        }
+}
+
+/**
+ * @brief Two stages of the radix-2 decimation in time at once.
+ * Each group of four terms goes through the stage of the given step and
+ * the stage of the doubled step while it is loaded, which halves the
+ * passes over the data.
+ * @see radix2_pass()
+ * @author placek@ragnarson.com
+ * @param next_real Real parts of transform factors of the doubled step (2 * step entries).
+ * @param next_imag Imaginary parts of transform factors of the doubled step (2 * step entries).
+ */
+static SIMD_TARGET void SIMD_NAME(radix4_pass)(SIMD_REAL * real, SIMD_REAL * imag, long length, long step,
+    const SIMD_REAL * factor_real, const SIMD_REAL * factor_imag,
+    const SIMD_REAL * next_real, const SIMD_REAL * next_imag)
+{
+    long base, k, jump = step << 2;
+    SIMD_REAL * r0, * r1, * r2, * r3, * i0, * i1, * i2, * i3;
+    VEC w_re, w_im, a0_re, a0_im, a1_re, a1_im, a2_re, a2_im, a3_re, a3_im;
+    VEC b0_re, b0_im, b1_re, b1_im, b2_re, b2_im, b3_re, b3_im, t_re, t_im;
+
+#if SIMD_WIDTH > 1
+    if(step < SIMD_WIDTH)
+    {
+        SIMD_FALLBACK(radix4_pass)(real, imag, length, step, factor_real, factor_imag, next_real, next_imag);
+        return;
+    }
+#endif
+
+    for(base = 0; base < length; base += jump)
+    {
+        r0 = real + base;
+        r1 = r0 + step;
+        r2 = r1 + step;
+        r3 = r2 + step;
+        i0 = imag + base;
+        i1 = i0 + step;
+        i2 = i1 + step;
+        i3 = i2 + step;
+        for(k = 0; k < step; k += SIMD_WIDTH)
+        {
+            // first stage: pairs (0, 1) and (2, 3) with the same factor
+            w_re = VLOAD(factor_real + k);
+            w_im = VLOAD(factor_imag + k);
+            a0_re = VLOAD(r0 + k);
+            a0_im = VLOAD(i0 + k);
+            a1_re = VLOAD(r1 + k);
+            a1_im = VLOAD(i1 + k);
+            a2_re = VLOAD(r2 + k);
+            a2_im = VLOAD(i2 + k);
+            a3_re = VLOAD(r3 + k);
+            a3_im = VLOAD(i3 + k);
+            VCMUL(w_re, w_im, a1_re, a1_im, t_re, t_im);
+            b0_re = VADD(a0_re, t_re);
+            b0_im = VADD(a0_im, t_im);
+            b1_re = VSUB(a0_re, t_re);
+            b1_im = VSUB(a0_im, t_im);
+            VCMUL(w_re, w_im, a3_re, a3_im, t_re, t_im);
+            b2_re = VADD(a2_re, t_re);
+            b2_im = VADD(a2_im, t_im);
+            b3_re = VSUB(a2_re, t_re);
+            b3_im = VSUB(a2_im, t_im);
+
+            // second stage: pairs (0, 2) and (1, 3) with factors of the next step
+            w_re = VLOAD(next_real + k);
+            w_im = VLOAD(next_imag + k);
+            VCMUL(w_re, w_im, b2_re, b2_im, t_re, t_im);
+            VSTORE(r0 + k, VADD(b0_re, t_re));
+            VSTORE(i0 + k, VADD(b0_im, t_im));
+            VSTORE(r2 + k, VSUB(b0_re, t_re));
+            VSTORE(i2 + k, VSUB(b0_im, t_im));
+            w_re = VLOAD(next_real + step + k);
+            w_im = VLOAD(next_imag + step + k);
+            VCMUL(w_re, w_im, b3_re, b3_im, t_re, t_im);
+            VSTORE(r1 + k, VADD(b1_re, t_re));
+            VSTORE(i1 + k, VADD(b1_im, t_im));
+            VSTORE(r3 + k, VSUB(b1_re, t_re));
+            VSTORE(i3 + k, VSUB(b1_im, t_im));
+        }
+    }
+}
+
+/**
+ * @brief One stage of the radix-2 decimation in time of a batch of transforms.
+ * The data holds SIMD_WIDTH transforms interleaved (element k of transform j
+ * at k * SIMD_WIDTH + j), so a vector holds the same element of different
+ * transforms and every butterfly fills whole vectors, however short the
+ * step is.
+ * @see radix2_pass()
+ * @author placek@ragnarson.com
+ * @param length Length of each transform.
+ */
+static SIMD_TARGET void SIMD_NAME(batch_radix2_pass)(SIMD_REAL * real, SIMD_REAL * imag, long length, long step,
+    const SIMD_REAL * factor_real, const SIMD_REAL * factor_imag)
+{
+    long base, k, a, b, jump = step << 1;
+    VEC w_re, w_im, a_re, a_im, b_re, b_im, t_re, t_im;
+
+    for(base = 0; base < length; base += jump)
+        for(k = 0; k < step; k++)
+        {
+            a = (base + k) * SIMD_WIDTH;
+            b = (base + step + k) * SIMD_WIDTH;
+            w_re = VSET1(factor_real[k]);
+            w_im = VSET1(factor_imag[k]);
+            a_re = VLOAD(real + a);
+            a_im = VLOAD(imag + a);
+            b_re = VLOAD(real + b);
+            b_im = VLOAD(imag + b);
+            VCMUL(w_re, w_im, b_re, b_im, t_re, t_im);
+            VSTORE(real + a, VADD(a_re, t_re));
+            VSTORE(imag + a, VADD(a_im, t_im));
+            VSTORE(real + b, VSUB(a_re, t_re));
+            VSTORE(imag + b, VSUB(a_im, t_im));
+        }
+}
+
+#ifdef VSQRT
+/**
+ * @brief Magnitudes of complex numbers.
+ * @author placek@ragnarson.com
+ * @param real Real parts.
+ * @param imag Imaginary parts.
+ * @param out Place for magnitudes (may be the real parts).
+ * @param length Number of complex numbers.
+ */
+static SIMD_TARGET void SIMD_NAME(magnitude_pass)(const SIMD_REAL * real, const SIMD_REAL * imag, SIMD_REAL * out, long length)
+{
+    long k = 0;
+    VEC a_re, a_im;
+
+#if SIMD_WIDTH > 1
+    for(; k + SIMD_WIDTH <= length; k += SIMD_WIDTH)
+    {
+        a_re = VLOAD(real + k);
+        a_im = VLOAD(imag + k);
+        VSTORE(out + k, VSQRT(VMADD(a_re, a_re, VMUL(a_im, a_im))));
+    }
+    if(k < length)
+        SIMD_FALLBACK(magnitude_pass)(real + k, imag + k, out + k, length - k);
+#else
+    for(; k < length; k++)
+    {
+        a_re = real[k];
+        a_im = imag[k];
+        out[k] = VSQRT(VMADD(a_re, a_re, VMUL(a_im, a_im)));
+    }
+#endif
+}
+#endif
+
+#undef VCMUL
+#undef SIMD_NAME
+#undef SIMD_FALLBACK
+#undef SIMD_TARGET
+#undef SIMD_REAL
+#undef SIMD_WIDTH
+#undef VEC
+#undef VLOAD
+#undef VSTORE
+#undef VADD
+#undef VSUB
+#undef VMUL
+#undef VMADD
+#undef VMSUB
+#undef VSQRT
+#undef VSET1
@@ -0,0 +1,273 @@
+/**
+ * @file single.c
+ * @brief Single precision (float32) transforms.
+ * A plan prepared for single precision keeps float copies of its radix-2
+ * transform factors and float buffers, and runs the single precision
+ * butterfly passes, so float data is read, transformed and written without
+ * going through doubles. That halves the memory traffic and doubles the
+ * number of values in a vector. Lengths that are not powers of 2 (and the
+ * four-step lengths) are computed in double precision and rounded.
+ * @author placek@ragnarson.com
+ */
+#include "frequency_transformations.h"
+
+static ID id_precision, id_float32, id_float64;
+
+/**
+ * @brief Prepare a plan for single precision transforms.
+ * @author placek@ragnarson.com
+ * @param plan A plan created by ft_plan_create().
+ */
+void ft_plan_make_single(ft_plan * plan)
+{
+    long k, twiddles = plan->length - 1;
+
+    plan->precision = FT_FLOAT32;
+    plan->single_buffer[0] = malloc(plan->length * sizeof(float));
+    plan->single_buffer[1] = malloc(plan->length * sizeof(float));
+    if(plan->algorithm != FT_RADIX2)
+        return;
+
+    plan->single_twiddle_real = malloc(twiddles * sizeof(float));
+    plan->single_twiddle_imag = malloc(twiddles * sizeof(float));
+    for(k = 0; k < twiddles; k++)
+    {
+        plan->single_twiddle_real[k] = (float)plan->twiddle_real[k];
+        plan->single_twiddle_imag[k] = (float)plan->twiddle_imag[k];
+    }
+}
+
+/**
+ * @brief Compute a single precision radix-2 FFT in place.
+ * @see radix2_execute()
+ * @author placek@ragnarson.com
+ */
+static void single_radix2_execute(const ft_plan * plan, float * real, float * imag)
+{
+    const ft_simd_kernels * kernels = ft_simd();
+    long length = plan->length;
+    long position, target, step, stages = 0;
+    float temp;
+
+    // do the bit reversal
+    for(position = 0; position < length; position++)
+    {
+        target = plan->reversed[position];
+        if(target > position)
+        {
+            temp = real[position];
+            real[position] = real[target];
+            real[target] = temp;
+            temp = imag[position];
+            imag[position] = imag[target];
+            imag[target] = temp;
+        }
+    }
+
+    // compute the FFT
+    for(step = 1; step < length; step <<= 1)
+        stages++;
+    step = 1;
+    if(stages % 2)
+    {
+        kernels->radix2_float(real, imag, length, step, plan->single_twiddle_real, plan->single_twiddle_imag);
+        step = 2;
+    }
+    for(; step < length; step <<= 2)
+        kernels->radix4_float(real, imag, length, step,
+            plan->single_twiddle_real + step - 1, plan->single_twiddle_imag + step - 1,
+            plan->single_twiddle_real + 2 * step - 1, plan->single_twiddle_imag + 2 * step - 1);
+}
+
+/**
+ * @brief Compute a single precision FFT in place using a plan.
+ * Only reads the plan, so many threads can execute it at once.
+ * @author placek@ragnarson.com
+ * @param plan A plan prepared by ft_plan_make_single().
+ * @param real Real parts of processing data.
+ * @param imag Imaginary parts of processing data.
+ */
+void ft_plan_execute_single(const ft_plan * plan, float * real, float * imag)
+{
+    long i, length = plan->length;
+    double * work, * scratch;
+    float scale = (float)plan->scale;
+
+    if(length == 1)
+        return;
+
+    if(plan->algorithm == FT_RADIX2)
+    {
+        single_radix2_execute(plan, real, imag);
+        if(plan->scale != 1.0)
+            for(i = 0; i < length; i++)
+            {
+                real[i] *= scale;
+                imag[i] *= scale;
+            }
+        return;
+    }
+
+    // other algorithms work in double precision
+    work = malloc(2 * length * sizeof(double));
+    scratch = malloc((ft_plan_scratch_length(plan) + 1) * sizeof(double));
+    for(i = 0; i < length; i++)
+    {
+        work[i] = real[i];
+        work[length + i] = imag[i];
+    }
+    ft_plan_execute_scratch(plan, work, work + length, scratch);
+    for(i = 0; i < length; i++)
+    {
+        real[i] = (float)work[i];
+        imag[i] = (float)work[length + i];
+    }
+    free(work);
+    free(scratch);
+}
+
+/**
+ * @brief Compute a single precision FHT in place.
+ * The Hartley transform is the difference of the real and imaginary parts
+ * of the Fourier transform of real data, scaled by 1 / sqrt(length) like
+ * fht_kernel().
+ * @author placek@ragnarson.com
+ * @param plan A forward plan of the length prepared by ft_plan_make_single().
+ * @param values Processing data.
+ * @param work Working memory (length floats).
+ */
+void ft_fht_single(const ft_plan * plan, float * values, float * work)
+{
+    long i, length = plan->length;
+    float scale = (float)(1.0 / sqrt((double)length));
+
+    for(i = 0; i < length; i++)
+        work[i] = 0.0f;
+    ft_plan_execute_single(plan, values, work);
+    for(i = 0; i < length; i++)
+        values[i] = (values[i] - work[i]) * scale;
+}
+
+/**
+ * @brief A single precision transform.
+ */
+typedef struct
+{
+    const ft_plan * plan;
+    int hartley;
+    float * real;
+    float * imag;
+} single_call;
+
+static void * single_call_run(void * data)
+{
+    single_call * call = data;
+
+    if(call->hartley)
+        ft_fht_single(call->plan, call->real, call->imag);
+    else
+        ft_plan_execute_single(call->plan, call->real, call->imag);
+    return NULL;
+}
+
+/**
+ * @brief Compute a single precision FFT (or FHT), releasing the GVL for large ones.
+ * @see ft_plan_execute_single()
+ * @see ft_fht_single()
+ * @author placek@ragnarson.com
+ * @param plan A plan prepared by ft_plan_make_single().
+ * @param real Real parts (or values of the FHT).
+ * @param imag Imaginary parts (or working memory of the FHT).
+ * @param hartley TRUE for the FHT.
+ */
+void ft_plan_execute_single_without_gvl(const ft_plan * plan, float * real, float * imag, int hartley)
+{
+    single_call call;
+    ft_job job;
+
+    call.plan = plan;
+    call.hartley = hartley;
+    call.real = real;
+    call.imag = imag;
+    job.kind = FT_JOB_FFT;
+    job.length = plan->length;
+    ft_without_gvl(single_call_run, &call, ft_job_work(&job) / 2);
+}
+
+/**
+ * @brief Convert single precision complex data into a Ruby Array.
+ * @see complex_to_ruby()
+ * @author placek@ragnarson.com
+ */
+VALUE complex_single_to_ruby(const float * real, const float * imag, long length)
+{
+    long i;
+    VALUE outArray = rb_ary_new2(2);
+    VALUE xArray = rb_ary_new2(length);
+    VALUE yArray = rb_ary_new2(length);
+
+    for(i = 0; i < length; i++)
+    {
+        rb_ary_push(xArray, DBL2NUM(real[i]));
+        rb_ary_push(yArray, DBL2NUM(imag[i]));
+    }
+
+    rb_ary_push(outArray, xArray);
+    rb_ary_push(outArray, yArray);
+
+    return outArray;
+}
+
+/**
+ * @brief Read the precision option of a call.
+ * @author placek@ragnarson.com
+ * @param options A Hash of keyword arguments (or nil).
+ * @return FT_FLOAT64 (the default) or FT_FLOAT32 for precision: :float32.
+ */
+int ft_precision(VALUE options)
+{
+    VALUE precision = Qundef;
+
+    if(!NIL_P(options))
+        rb_get_kwargs(options, &id_precision, 0, 1, &precision);
+    return ft_precision_value(precision);
+}
+
+/**
+ * @brief Read the value of a precision option.
+ * For calls that read the precision together with other keywords.
+ * @author placek@ragnarson.com
+ * @param precision :float64, :float32 or Qundef (no option).
+ * @return FT_FLOAT64 (the default) or FT_FLOAT32.
+ */
+int ft_precision_value(VALUE precision)
+{
+    if(precision == Qundef || precision == ID2SYM(id_float64))
+        return FT_FLOAT64;
+    if(precision == ID2SYM(id_float32))
+        return FT_FLOAT32;
+    rb_raise(rb_eArgError, "precision should be :float64 or :float32");
+    return FT_FLOAT64;
+}
+
+/**
+ * @brief Get the symbol of a precision.
+ * @author placek@ragnarson.com
+ * @param precision FT_FLOAT64 or FT_FLOAT32.
+ * @return :float64 or :float32.
+ */
+VALUE ft_precision_to_ruby(int precision)
+{
+    return ID2SYM(precision == FT_FLOAT32 ? id_float32 : id_float64);
+}
+
+/**
+ * @brief Prepare the symbols of precisions.
+ * @author placek@ragnarson.com
+ */
+void Init_single(void)
+{
+    id_precision = rb_intern("precision");
+    id_float32 = rb_intern("float32");
+    id_float64 = rb_intern("float64");
+}
@@ -0,0 +1,416 @@
+/**
+ * @file sliding_dft.c
+ * @brief Sliding DFT of a stream of real samples.
+ * FT::SlidingDFT keeps the last length samples in a ring buffer and the
+ * DFT of that window (all the bins of the half spectrum or a chosen
+ * subset). The bins are seeded by one real FFT of the initial window and
+ * every new sample updates each of them in O(1) with the recursion
+ * X[k] = (X[k] + x_new - x_old) * exp(2 pi i k / length),
+ * so tracking K bins costs O(K) per sample instead of an FFT. Rounding
+ * errors of the recursion accumulate, so the bins are recomputed from the
+ * window by the FFT (re-anchored) every reanchor samples.
+ * @author placek@ragnarson.com
+ */
+#include "frequency_transformations.h"
+
+static VALUE cSlidingDFT;
+static ID id_bins, id_reanchor;
+
+/**
+ * @brief A sliding DFT.
+ */
+typedef struct
+{
+    long length;
+    long count;
+    long reanchor;
+    long since_anchor;
+    long position;
+    long * bins;
+    double * ring;
+    double * frame;
+    double * real;
+    double * imag;
+    double * factor_real;
+    double * factor_imag;
+    double * half[2];
+    ft_real_plan * plan;
+} ft_sliding_dft;
+
+static void sliding_dft_free(void * ptr)
+{
+    ft_sliding_dft * sdft = ptr;
+
+    if(!sdft)
+        return;
+    ft_real_plan_free(sdft->plan);
+    free(sdft->bins);
+    free(sdft->ring);
+    free(sdft->frame);
+    free(sdft->real);
+    free(sdft->imag);
+    free(sdft->factor_real);
+    free(sdft->factor_imag);
+    free(sdft->half[0]);
+    free(sdft->half[1]);
+    free(sdft);
+}
+
+static size_t sliding_dft_memsize(const void * ptr)
+{
+    const ft_sliding_dft * sdft = ptr;
+
+    if(!sdft)
+        return 0;
+    return sizeof(ft_sliding_dft) + sdft->count * sizeof(long)
+        + (2 * sdft->length + 4 * sdft->count + 2 * (sdft->length / 2 + 1)) * sizeof(double);
+}
+
+static const rb_data_type_t sliding_dft_type = {
+    "FrequencyTransformations::SlidingDFT",
+    { NULL, sliding_dft_free, sliding_dft_memsize, },
+    NULL, NULL, RUBY_TYPED_FREE_IMMEDIATELY
+};
+
+static VALUE sliding_dft_alloc(VALUE klass)
+{
+    return TypedData_Wrap_Struct(klass, &sliding_dft_type, NULL);
+}
+
+static ft_sliding_dft * get_sliding_dft(VALUE self)
+{
+    ft_sliding_dft * sdft;
+    TypedData_Get_Struct(self, ft_sliding_dft, &sliding_dft_type, sdft);
+    if(!sdft)
+        rb_raise(rb_eRuntimeError, "uninitialized SlidingDFT");
+    return sdft;
+}
+
+/**
+ * @brief Recompute the tracked bins from the window.
+ * Bins above the half of the spectrum are the complex conjugates of the
+ * bins below it (the samples are real).
+ * @author placek@ragnarson.com
+ * @param sdft A sliding DFT.
+ */
+static void sliding_dft_anchor(ft_sliding_dft * sdft)
+{
+    long i, k, n = sdft->length, first = n - sdft->position;
+
+    // unroll the ring (oldest sample first)
+    for(i = 0; i < first; i++)
+        sdft->frame[i] = sdft->ring[sdft->position + i];
+    for(; i < n; i++)
+        sdft->frame[i] = sdft->ring[i - first];
+
+    ft_real_plan_forward(sdft->plan, sdft->frame, sdft->half[0], sdft->half[1]);
+
+    for(i = 0; i < sdft->count; i++)
+    {
+        k = sdft->bins[i];
+        if(k <= n / 2)
+        {
+            sdft->real[i] = sdft->half[0][k];
+            sdft->imag[i] = sdft->half[1][k];
+        }
+        else
+        {
+            sdft->real[i] = sdft->half[0][n - k];
+            sdft->imag[i] = -sdft->half[1][n - k];
+        }
+    }
+    sdft->since_anchor = 0;
+}
+
+/**
+ * @brief Slide the window by one sample and update the tracked bins.
+ * @author placek@ragnarson.com
+ * @param sdft A sliding DFT.
+ * @param sample The new sample.
+ */
+static void sliding_dft_update(ft_sliding_dft * sdft, double sample)
+{
+    long i;
+    double delta = sample - sdft->ring[sdft->position], re, im;
+    double * real = sdft->real, * imag = sdft->imag;
+    const double * c = sdft->factor_real, * s = sdft->factor_imag;
+
+    sdft->ring[sdft->position] = sample;
+    if(++sdft->position == sdft->length)
+        sdft->position = 0;
+
+    if(sdft->reanchor && ++sdft->since_anchor >= sdft->reanchor)
+    {
+        sliding_dft_anchor(sdft);
+        return;
+    }
+
+    for(i = 0; i < sdft->count; i++)
+    {
+        re = real[i] + delta;
+        im = imag[i];
+        real[i] = re * c[i] - im * s[i];
+        imag[i] = re * s[i] + im * c[i];
+    }
+}
+
+/**
+ * @brief Initialize a sliding DFT.
+ * SlidingDFT.new(window, bins: nil, reanchor: window_length) tracks the
+ * DFT of the last window_length samples. The window is an Array with the
+ * initial samples (oldest first) or the length of a window of zeros. The
+ * bins are indices from 0 to window_length - 1 (the length / 2 + 1 bins of
+ * the half spectrum by default). Reanchor is the number of samples between
+ * recomputations of the bins by the FFT (nil or false to never do it).
+ * @author placek@ragnarson.com
+ * @params argc Number of arguments.
+ * @params argv Arguments (window and options).
+ * @params self A sliding DFT being initialized.
+ * @return The sliding DFT.
+ */
+static VALUE sliding_dft_initialize(int argc, VALUE * argv, VALUE self)
+{
+    VALUE window, options, values[2] = { Qundef, Qundef };
+    ID keys[2];
+    long i, length, count, reanchor;
+    ft_sliding_dft * sdft;
+
+    rb_scan_args(argc, argv, "1:", &window, &options);
+    if(RB_TYPE_P(window, T_ARRAY))
+        length = RARRAY_LEN(window);
+    else
+        length = NUM2LONG(window);
+    if(length < 1)
+        rb_raise(rb_eArgError, "window length should be positive");
+    count = length / 2 + 1;
+    reanchor = length;
+
+    keys[0] = id_bins;
+    keys[1] = id_reanchor;
+    if(!NIL_P(options))
+        rb_get_kwargs(options, keys, 0, 2, values);
+    if(values[0] != Qundef && !NIL_P(values[0]))
+    {
+        Check_Type(values[0], T_ARRAY);
+        count = RARRAY_LEN(values[0]);
+        for(i = 0; i < count; i++)
+            if(NUM2LONG(RARRAY_AREF(values[0], i)) < 0 || NUM2LONG(RARRAY_AREF(values[0], i)) >= length)
+                rb_raise(rb_eArgError, "bins should be between 0 and %ld", length - 1);
+    }
+    if(values[1] != Qundef)
+    {
+        reanchor = RTEST(values[1]) ? NUM2LONG(values[1]) : 0;
+        if(RTEST(values[1]) && reanchor < 1)
+            rb_raise(rb_eArgError, "reanchor should be positive");
+    }
+
+    if(DATA_PTR(self))
+        rb_raise(rb_eRuntimeError, "SlidingDFT already initialized");
+    sdft = calloc(1, sizeof(ft_sliding_dft));
+    sdft->length = length;
+    sdft->count = count;
+    sdft->reanchor = reanchor;
+    sdft->bins = malloc((count + 1) * sizeof(long));
+    sdft->ring = calloc(length, sizeof(double));
+    sdft->frame = malloc(length * sizeof(double));
+    sdft->real = malloc((count + 1) * sizeof(double));
+    sdft->imag = malloc((count + 1) * sizeof(double));
+    sdft->factor_real = malloc((count + 1) * sizeof(double));
+    sdft->factor_imag = malloc((count + 1) * sizeof(double));
+    sdft->half[0] = malloc((length / 2 + 1) * sizeof(double));
+    sdft->half[1] = malloc((length / 2 + 1) * sizeof(double));
+    sdft->plan = ft_real_plan_create(length, 1);
+    DATA_PTR(self) = sdft;
+
+    for(i = 0; i < count; i++)
+    {
+        sdft->bins[i] = values[0] != Qundef && !NIL_P(values[0]) ? NUM2LONG(RARRAY_AREF(values[0], i)) : i;
+        sdft->factor_real[i] = cos(2.0 * M_PI * sdft->bins[i] / (double)length);
+        sdft->factor_imag[i] = sin(2.0 * M_PI * sdft->bins[i] / (double)length);
+    }
+    if(RB_TYPE_P(window, T_ARRAY))
+        for(i = 0; i < length; i++)
+            sdft->ring[i] = NUM2DBL(RARRAY_AREF(window, i));
+
+    // seed the bins from the initial window
+    sliding_dft_anchor(sdft);
+
+    return self;
+}
+
+/**
+ * @brief Get the tracked bins of a sliding DFT.
+ * @author placek@ragnarson.com
+ * @params self A sliding DFT.
+ * @return A Ruby Array with real and imaginary parts of the bins (in the order of the bins).
+ */
+static VALUE sliding_dft_spectrum(VALUE self)
+{
+    ft_sliding_dft * sdft = get_sliding_dft(self);
+    return complex_to_ruby(sdft->real, sdft->imag, sdft->count);
+}
+
+/**
+ * @brief Feed samples.
+ * The spectrum after every sample is yielded when a block is given.
+ * @author placek@ragnarson.com
+ * @params self A sliding DFT.
+ * @params samples An Array of real samples (or a single sample).
+ * @return The spectrum after the last sample (self when a block is given).
+ */
+static VALUE sliding_dft_push(VALUE self, VALUE samples)
+{
+    ft_sliding_dft * sdft = get_sliding_dft(self);
+    long i, count;
+    int yield = rb_block_given_p();
+
+    if(!RB_TYPE_P(samples, T_ARRAY))
+    {
+        sliding_dft_update(sdft, NUM2DBL(samples));
+        if(yield)
+            rb_yield(sliding_dft_spectrum(self));
+        return yield ? self : sliding_dft_spectrum(self);
+    }
+
+    count = RARRAY_LEN(samples);
+    for(i = 0; i < count; i++)
+    {
+        sliding_dft_update(sdft, NUM2DBL(RARRAY_AREF(samples, i)));
+        if(yield)
+            rb_yield(sliding_dft_spectrum(self));
+    }
+
+    return yield ? self : sliding_dft_spectrum(self);
+}
+
+/**
+ * @brief Get the magnitudes of the tracked bins.
+ * @author placek@ragnarson.com
+ * @params self A sliding DFT.
+ * @return A Ruby Array with the magnitudes (in the order of the bins).
+ */
+static VALUE sliding_dft_magnitude(VALUE self)
+{
+    ft_sliding_dft * sdft = get_sliding_dft(self);
+    long i;
+    VALUE outArray = rb_ary_new2(sdft->count);
+
+    for(i = 0; i < sdft->count; i++)
+        rb_ary_push(outArray, rb_float_new(hypot(sdft->real[i], sdft->imag[i])));
+
+    return outArray;
+}
+
+/**
+ * @brief Recompute the tracked bins from the window by the FFT now.
+ * @author placek@ragnarson.com
+ * @params self A sliding DFT.
+ * @return The sliding DFT.
+ */
+static VALUE sliding_dft_reanchor(VALUE self)
+{
+    sliding_dft_anchor(get_sliding_dft(self));
+    return self;
+}
+
+/**
+ * @brief Forget all the samples fed so far (the window is zeros again).
+ * @author placek@ragnarson.com
+ * @params self A sliding DFT.
+ * @return The sliding DFT.
+ */
+static VALUE sliding_dft_reset(VALUE self)
+{
+    ft_sliding_dft * sdft = get_sliding_dft(self);
+    long i;
+
+    for(i = 0; i < sdft->length; i++)
+        sdft->ring[i] = 0.0;
+    sdft->position = 0;
+    sliding_dft_anchor(sdft);
+
+    return self;
+}
+
+/**
+ * @brief Get the samples in the window of a sliding DFT.
+ * @author placek@ragnarson.com
+ * @params self A sliding DFT.
+ * @return A Ruby Array with the samples (oldest first).
+ */
+static VALUE sliding_dft_window(VALUE self)
+{
+    ft_sliding_dft * sdft = get_sliding_dft(self);
+    long i;
+    VALUE outArray = rb_ary_new2(sdft->length);
+
+    for(i = 0; i < sdft->length; i++)
+        rb_ary_push(outArray, rb_float_new(sdft->ring[(sdft->position + i) % sdft->length]));
+
+    return outArray;
+}
+
+/**
+ * @brief Get the tracked bin indices of a sliding DFT.
+ * @author placek@ragnarson.com
+ * @params self A sliding DFT.
+ * @return A Ruby Array with the indices.
+ */
+static VALUE sliding_dft_bins(VALUE self)
+{
+    ft_sliding_dft * sdft = get_sliding_dft(self);
+    long i;
+    VALUE outArray = rb_ary_new2(sdft->count);
+
+    for(i = 0; i < sdft->count; i++)
+        rb_ary_push(outArray, LONG2NUM(sdft->bins[i]));
+
+    return outArray;
+}
+
+/**
+ * @brief Get the window length of a sliding DFT.
+ * @author placek@ragnarson.com
+ * @params self A sliding DFT.
+ * @return The number of samples in the window.
+ */
+static VALUE sliding_dft_length(VALUE self)
+{
+    return LONG2NUM(get_sliding_dft(self)->length);
+}
+
+/**
+ * @brief Get the re-anchoring interval of a sliding DFT.
+ * @author placek@ragnarson.com
+ * @params self A sliding DFT.
+ * @return The number of samples between re-anchors (nil if never).
+ */
+static VALUE sliding_dft_reanchor_interval(VALUE self)
+{
+    ft_sliding_dft * sdft = get_sliding_dft(self);
+    return sdft->reanchor ? LONG2NUM(sdft->reanchor) : Qnil;
+}
+
+/**
+ * @brief Initialize the FrequencyTransformations::SlidingDFT class.
+ * @author placek@ragnarson.com
+ */
+void Init_sliding_dft(void)
+{
+    id_bins = rb_intern("bins");
+    id_reanchor = rb_intern("reanchor");
+
+    cSlidingDFT = rb_define_class_under(FT, "SlidingDFT", rb_cObject);
+    rb_define_alloc_func(cSlidingDFT, sliding_dft_alloc);
+    rb_define_method(cSlidingDFT, "initialize", sliding_dft_initialize, -1);
+    rb_define_method(cSlidingDFT, "push", sliding_dft_push, 1);
+    rb_define_method(cSlidingDFT, "<<", sliding_dft_push, 1);
+    rb_define_method(cSlidingDFT, "spectrum", sliding_dft_spectrum, 0);
+    rb_define_method(cSlidingDFT, "magnitude", sliding_dft_magnitude, 0);
+    rb_define_method(cSlidingDFT, "reanchor", sliding_dft_reanchor, 0);
+    rb_define_method(cSlidingDFT, "reset", sliding_dft_reset, 0);
+    rb_define_method(cSlidingDFT, "window", sliding_dft_window, 0);
+    rb_define_method(cSlidingDFT, "bins", sliding_dft_bins, 0);
+    rb_define_method(cSlidingDFT, "window_length", sliding_dft_length, 0);
+    rb_define_method(cSlidingDFT, "reanchor_interval", sliding_dft_reanchor_interval, 0);
+}
@@ -0,0 +1,213 @@
+/**
+ * @file spectrum.c
+ * @brief Transforms fused with the post-processing of the spectrum.
+ * fft_magnitude, fft_power_db and fft_polar unbox the data once, compute
+ * the FFT and turn the spectrum into magnitudes (with the vector square
+ * root of the SIMD passes), decibels of power or magnitudes and phases
+ * before boxing the result, instead of going through Array#fft and then
+ * Array#magnitude. Real data (a flat Array of numbers) is transformed with
+ * the real FFT, which gives the one-sided spectrum directly. fft_polar
+ * returns the true arguments of the bins, see fft_polar().
+ * @author placek@ragnarson.com
+ */
+#include "frequency_transformations.h"
+
+#define SPECTRUM_MAGNITUDE 0
+#define SPECTRUM_POWER_DB 1
+#define SPECTRUM_POLAR 2
+
+static ID ids[2];
+
+/**
+ * @brief Read the options of a call.
+ * @author placek@ragnarson.com
+ * @param options A Hash of keyword arguments (or nil).
+ * @param one_sided Place for TRUE for one_sided: true.
+ * @param shift Place for TRUE for shift: true.
+ */
+static void spectrum_options(VALUE options, int * one_sided, int * shift)
+{
+    VALUE values[2] = { Qundef, Qundef };
+
+    *one_sided = *shift = FALSE;
+    if(NIL_P(options))
+        return;
+    rb_get_kwargs(options, ids, 0, 2, values);
+    *one_sided = values[0] != Qundef && RTEST(values[0]);
+    *shift = values[1] != Qundef && RTEST(values[1]);
+    if(*one_sided && *shift)
+        rb_raise(rb_eArgError, "shift needs the two-sided spectrum");
+}
+
+/**
+ * @brief Compute the spectrum of Ruby data.
+ * @author placek@ragnarson.com
+ * @param inArray Complex data (an array of real and imaginary parts) or real data.
+ * @param one_sided TRUE to keep only length / 2 + 1 bins.
+ * @param spectrum Place for new arrays of real and imaginary parts (to be released with free()).
+ * @return Number of bins (0 for invalid data).
+ */
+static long spectrum_compute(VALUE inArray, int one_sided, double ** spectrum)
+{
+    long i, length, half;
+    VALUE * values;
+    double * samples;
+    ft_real_plan * plan;
+
+    Check_Type(inArray, T_ARRAY);
+    length = RARRAY_LEN(inArray);
+    if(length < 1)
+        return 0;
+    values = RARRAY_PTR(inArray);
+
+    // complex data
+    if(TYPE(values[0]) == T_ARRAY)
+    {
+        if(!fourier_validate(inArray))
+            return 0;
+        length = RARRAY_LEN(values[0]);
+        spectrum[0] = malloc(length * sizeof(double));
+        spectrum[1] = malloc(length * sizeof(double));
+        for(i = 0; i < length; i++)
+        {
+            spectrum[0][i] = NUM2DBL(RARRAY_PTR(values[0])[i]);
+            spectrum[1][i] = NUM2DBL(RARRAY_PTR(values[1])[i]);
+        }
+        ft_perform_job(FT_JOB_FFT, spectrum[0], spectrum[1], length, 1);
+        return one_sided ? length / 2 + 1 : length;
+    }
+
+    // real data
+    half = length / 2;
+    samples = malloc(length * sizeof(double));
+    for(i = 0; i < length; i++)
+        samples[i] = NUM2DBL(values[i]);
+    spectrum[0] = malloc(length * sizeof(double) + sizeof(double));
+    spectrum[1] = malloc(length * sizeof(double) + sizeof(double));
+    plan = ft_real_plan_create(length, 1);
+    ft_real_plan_forward_without_gvl(plan, samples, spectrum[0], spectrum[1]);
+    ft_real_plan_free(plan);
+    free(samples);
+    if(one_sided)
+        return half + 1;
+
+    // the other half is the complex conjugate
+    for(i = half + 1; i < length; i++)
+    {
+        spectrum[0][i] = spectrum[0][length - i];
+        spectrum[1][i] = -spectrum[1][length - i];
+    }
+    return length;
+}
+
+/**
+ * @brief Compute a FFT and post-process the spectrum.
+ * @author placek@ragnarson.com
+ * @param argc Number of arguments.
+ * @param argv Arguments (one_sided: and shift: options).
+ * @param self A Ruby input data array.
+ * @param kind A post-processing (SPECTRUM_*).
+ * @return The output Ruby Array (nil for invalid data).
+ */
+static VALUE perform_spectrum(int argc, VALUE * argv, VALUE self, int kind)
+{
+    VALUE options, outArray;
+    double * spectrum[2], power;
+    long i, bins, offset;
+    int one_sided, shift;
+
+    rb_scan_args(argc, argv, "0:", &options);
+    spectrum_options(options, &one_sided, &shift);
+    bins = spectrum_compute(self, one_sided, spectrum);
+    if(bins == 0)
+        return Qnil;
+    offset = ft_shift_offset(bins, FALSE);
+
+    switch(kind)
+    {
+        case SPECTRUM_POWER_DB:
+            for(i = 0; i < bins; i++)
+            {
+                power = spectrum[0][i] * spectrum[0][i] + spectrum[1][i] * spectrum[1][i];
+                spectrum[0][i] = 10.0 * log10(power);
+            }
+            outArray = ft_nd_to_ruby(spectrum[0], &bins, 1, shift ? &offset : NULL);
+            break;
+        case SPECTRUM_POLAR:
+            // arguments of the bins, computed before the real parts are overwritten
+            for(i = 0; i < bins; i++)
+            {
+                power = atan2(spectrum[1][i], spectrum[0][i]);
+                spectrum[0][i] = hypot(spectrum[0][i], spectrum[1][i]);
+                spectrum[1][i] = power;
+            }
+            outArray = rb_ary_new2(2);
+            rb_ary_push(outArray, ft_nd_to_ruby(spectrum[0], &bins, 1, shift ? &offset : NULL));
+            rb_ary_push(outArray, ft_nd_to_ruby(spectrum[1], &bins, 1, shift ? &offset : NULL));
+            break;
+        default:
+            ft_simd()->magnitude(spectrum[0], spectrum[1], spectrum[0], bins);
+            outArray = ft_nd_to_ruby(spectrum[0], &bins, 1, shift ? &offset : NULL);
+            break;
+    }
+
+    // no memory leaks
+    free(spectrum[0]);
+    free(spectrum[1]);
+
+    return outArray;
+}
+
+/**
+ * @brief Compute magnitudes of a FFT.
+ * data.fft_magnitude(one_sided: false, shift: false) is data.fft.magnitude
+ * in one pass (shift: true is like fftshift).
+ * @author placek@ragnarson.com
+ * @params self A Ruby input data array (complex or real data).
+ * @return The output Ruby Array with magnitudes.
+ */
+static VALUE fft_magnitude(int argc, VALUE * argv, VALUE self)
+{
+    return perform_spectrum(argc, argv, self, SPECTRUM_MAGNITUDE);
+}
+
+/**
+ * @brief Compute power of a FFT in decibels.
+ * Each bin is 10 * log10(re^2 + im^2) (-Infinity for empty bins).
+ * @author placek@ragnarson.com
+ * @params self A Ruby input data array (complex or real data).
+ * @return The output Ruby Array with power in decibels.
+ */
+static VALUE fft_power_db(int argc, VALUE * argv, VALUE self)
+{
+    return perform_spectrum(argc, argv, self, SPECTRUM_POWER_DB);
+}
+
+/**
+ * @brief Compute magnitudes and phases of a FFT.
+ * data.fft_polar(one_sided: false) is [data.fft.magnitude, phases] in one
+ * pass. The phases are the arguments of the bins, atan2(imag, real) in
+ * (-pi, pi]; unlike Array#phase, which keeps atan2(real, imag) (pi / 2 minus
+ * the argument) for compatibility.
+ * @author placek@ragnarson.com
+ * @params self A Ruby input data array (complex or real data).
+ * @return The output Ruby Array with magnitudes and phases.
+ */
+static VALUE fft_polar(int argc, VALUE * argv, VALUE self)
+{
+    return perform_spectrum(argc, argv, self, SPECTRUM_POLAR);
+}
+
+/**
+ * @brief Define the fused spectrum methods.
+ * @author placek@ragnarson.com
+ */
+void Init_spectrum(void)
+{
+    ids[0] = rb_intern("one_sided");
+    ids[1] = rb_intern("shift");
+
+    rb_define_method(FT, "fft_magnitude", fft_magnitude, -1);
+    rb_define_method(FT, "fft_power_db", fft_power_db, -1);
+    rb_define_method(FT, "fft_polar", fft_polar, -1);
+}
@@ -0,0 +1,340 @@
+/**
+ * @file stft.c
+ * @brief Streaming short-time Fourier transform.
+ * FT::STFT is fed samples in chunks of any size. The last frame length
+ * samples are kept in a ring buffer; every hop samples (once the first
+ * frame is full) the frame is windowed with a precomputed window and
+ * transformed by one real FFT plan, and the half of its spectrum is
+ * emitted. All the memory is allocated when the object is created, so
+ * a stream of any length runs in constant memory.
+ * @author placek@ragnarson.com
+ */
+#include "frequency_transformations.h"
+
+#define STFT_RECTANGULAR 0
+#define STFT_HANN 1
+#define STFT_HAMMING 2
+#define STFT_BLACKMAN 3
+
+static VALUE cSTFT;
+static ID id_hop, id_window, id_output, id_rectangular, id_hann, id_hamming, id_blackman, id_magnitude, id_complex;
+
+/**
+ * @brief A streaming short-time Fourier transform.
+ */
+typedef struct
+{
+    long length;
+    long hop;
+    int window_kind;
+    int magnitude;
+    long position;
+    long long seen;
+    long long next_frame;
+    double * window;
+    double * ring;
+    double * frame;
+    double * spectrum[2];
+    ft_real_plan * plan;
+} ft_stft;
+
+static void stft_free(void * ptr)
+{
+    ft_stft * stft = ptr;
+
+    if(!stft)
+        return;
+    ft_real_plan_free(stft->plan);
+    free(stft->window);
+    free(stft->ring);
+    free(stft->frame);
+    free(stft->spectrum[0]);
+    free(stft->spectrum[1]);
+    free(stft);
+}
+
+static size_t stft_memsize(const void * ptr)
+{
+    const ft_stft * stft = ptr;
+
+    if(!stft)
+        return 0;
+    return sizeof(ft_stft) + (3 * stft->length + 2 * (stft->length / 2 + 1)) * sizeof(double);
+}
+
+static const rb_data_type_t stft_type = {
+    "FrequencyTransformations::STFT",
+    { NULL, stft_free, stft_memsize, },
+    NULL, NULL, RUBY_TYPED_FREE_IMMEDIATELY
+};
+
+static VALUE stft_alloc(VALUE klass)
+{
+    return TypedData_Wrap_Struct(klass, &stft_type, NULL);
+}
+
+static ft_stft * get_stft(VALUE self)
+{
+    ft_stft * stft;
+    TypedData_Get_Struct(self, ft_stft, &stft_type, stft);
+    if(!stft)
+        rb_raise(rb_eRuntimeError, "uninitialized STFT");
+    return stft;
+}
+
+/**
+ * @brief Compute a periodic window.
+ * Periodic windows (the period is the frame length) overlap-add to
+ * a constant at the usual hops.
+ * @author placek@ragnarson.com
+ * @param window Place for the window.
+ * @param length Length of the window.
+ * @param kind A window (STFT_*).
+ */
+static void stft_window(double * window, long length, int kind)
+{
+    long n;
+    double arg = 2.0 * M_PI / (double)length;
+
+    for(n = 0; n < length; n++)
+    {
+        switch(kind)
+        {
+            case STFT_HANN:
+                window[n] = 0.5 - 0.5 * cos(arg * n);
+                break;
+            case STFT_HAMMING:
+                window[n] = 0.54 - 0.46 * cos(arg * n);
+                break;
+            case STFT_BLACKMAN:
+                window[n] = 0.42 - 0.5 * cos(arg * n) + 0.08 * cos(2.0 * arg * n);
+                break;
+            default:
+                window[n] = 1.0;
+                break;
+        }
+    }
+}
+
+/**
+ * @brief Initialize a STFT.
+ * STFT.new(frame_length, hop: frame_length / 2, window: :hann,
+ * output: :magnitude) prepares a transform of frames of the given length.
+ * The window is :hann, :hamming, :blackman or :rectangular, the output
+ * :magnitude (frame_length / 2 + 1 magnitudes per frame) or :complex
+ * (real and imaginary parts of frame_length / 2 + 1 bins per frame).
+ * @author placek@ragnarson.com
+ * @params argc Number of arguments.
+ * @params argv Arguments (frame length and options).
+ * @params self A STFT being initialized.
+ * @return The STFT.
+ */
+static VALUE stft_initialize(int argc, VALUE * argv, VALUE self)
+{
+    VALUE rb_length, options, values[3] = { Qundef, Qundef, Qundef };
+    ID keys[3];
+    long length, hop;
+    int kind = STFT_HANN, magnitude = TRUE;
+    ft_stft * stft;
+
+    rb_scan_args(argc, argv, "1:", &rb_length, &options);
+    length = NUM2LONG(rb_length);
+    if(length < 1)
+        rb_raise(rb_eArgError, "frame length should be positive");
+    hop = length / 2 > 0 ? length / 2 : 1;
+
+    keys[0] = id_hop;
+    keys[1] = id_window;
+    keys[2] = id_output;
+    if(!NIL_P(options))
+        rb_get_kwargs(options, keys, 0, 3, values);
+    if(values[0] != Qundef)
+    {
+        hop = NUM2LONG(values[0]);
+        if(hop < 1)
+            rb_raise(rb_eArgError, "hop should be positive");
+    }
+    if(values[1] != Qundef)
+    {
+        if(values[1] == ID2SYM(id_rectangular))
+            kind = STFT_RECTANGULAR;
+        else if(values[1] == ID2SYM(id_hamming))
+            kind = STFT_HAMMING;
+        else if(values[1] == ID2SYM(id_blackman))
+            kind = STFT_BLACKMAN;
+        else if(values[1] != ID2SYM(id_hann))
+            rb_raise(rb_eArgError, "window should be :hann, :hamming, :blackman or :rectangular");
+    }
+    if(values[2] != Qundef)
+    {
+        if(values[2] == ID2SYM(id_complex))
+            magnitude = FALSE;
+        else if(values[2] != ID2SYM(id_magnitude))
+            rb_raise(rb_eArgError, "output should be :magnitude or :complex");
+    }
+
+    if(DATA_PTR(self))
+        rb_raise(rb_eRuntimeError, "STFT already initialized");
+    stft = calloc(1, sizeof(ft_stft));
+    stft->length = length;
+    stft->hop = hop;
+    stft->window_kind = kind;
+    stft->magnitude = magnitude;
+    stft->next_frame = length;
+    stft->window = malloc(length * sizeof(double));
+    stft->ring = calloc(length, sizeof(double));
+    stft->frame = malloc(length * sizeof(double));
+    stft->spectrum[0] = malloc((length / 2 + 1) * sizeof(double));
+    stft->spectrum[1] = malloc((length / 2 + 1) * sizeof(double));
+    stft->plan = ft_real_plan_create(length, 1);
+    stft_window(stft->window, length, kind);
+    DATA_PTR(self) = stft;
+
+    return self;
+}
+
+/**
+ * @brief Transform the frame held in the ring buffer.
+ * @author placek@ragnarson.com
+ * @param stft A STFT with a full frame.
+ * @return A Ruby Array with the frame (magnitudes or real and imaginary parts).
+ */
+static VALUE stft_emit(ft_stft * stft)
+{
+    long i, bins = stft->length / 2 + 1;
+    long first = stft->length - stft->position;
+
+    // unroll the ring (oldest sample first) and apply the window
+    for(i = 0; i < first; i++)
+        stft->frame[i] = stft->ring[stft->position + i] * stft->window[i];
+    for(; i < stft->length; i++)
+        stft->frame[i] = stft->ring[i - first] * stft->window[i];
+
+    ft_real_plan_forward(stft->plan, stft->frame, stft->spectrum[0], stft->spectrum[1]);
+
+    if(!stft->magnitude)
+        return complex_to_ruby(stft->spectrum[0], stft->spectrum[1], bins);
+    ft_simd()->magnitude(stft->spectrum[0], stft->spectrum[1], stft->spectrum[0], bins);
+    return real_to_ruby(stft->spectrum[0], bins);
+}
+
+/**
+ * @brief Feed samples.
+ * Frames completed by the samples are yielded when a block is given,
+ * otherwise returned.
+ * @author placek@ragnarson.com
+ * @params self A STFT.
+ * @params samples An Array of real samples.
+ * @return An Array of frames (self when a block is given).
+ */
+static VALUE stft_push(VALUE self, VALUE samples)
+{
+    ft_stft * stft = get_stft(self);
+    long i, count;
+    VALUE frame, outArray = Qnil;
+    int yield = rb_block_given_p();
+
+    Check_Type(samples, T_ARRAY);
+    count = RARRAY_LEN(samples);
+    if(!yield)
+        outArray = rb_ary_new();
+
+    for(i = 0; i < count; i++)
+    {
+        stft->ring[stft->position] = NUM2DBL(rb_ary_entry(samples, i));
+        if(++stft->position == stft->length)
+            stft->position = 0;
+        if(++stft->seen < stft->next_frame)
+            continue;
+
+        stft->next_frame += stft->hop;
+        frame = stft_emit(stft);
+        if(yield)
+            rb_yield(frame);
+        else
+            rb_ary_push(outArray, frame);
+    }
+
+    return yield ? self : outArray;
+}
+
+/**
+ * @brief Forget all the samples fed so far.
+ * @author placek@ragnarson.com
+ * @params self A STFT.
+ * @return The STFT.
+ */
+static VALUE stft_reset(VALUE self)
+{
+    ft_stft * stft = get_stft(self);
+    long i;
+
+    for(i = 0; i < stft->length; i++)
+        stft->ring[i] = 0.0;
+    stft->position = 0;
+    stft->seen = 0;
+    stft->next_frame = stft->length;
+
+    return self;
+}
+
+/**
+ * @brief Get the frame length of a STFT.
+ * @author placek@ragnarson.com
+ * @params self A STFT.
+ * @return The number of samples in a frame.
+ */
+static VALUE stft_length(VALUE self)
+{
+    return LONG2NUM(get_stft(self)->length);
+}
+
+/**
+ * @brief Get the hop size of a STFT.
+ * @author placek@ragnarson.com
+ * @params self A STFT.
+ * @return The number of samples between frames.
+ */
+static VALUE stft_hop(VALUE self)
+{
+    return LONG2NUM(get_stft(self)->hop);
+}
+
+/**
+ * @brief Get the window of a STFT.
+ * @author placek@ragnarson.com
+ * @params self A STFT.
+ * @return :hann, :hamming, :blackman or :rectangular.
+ */
+static VALUE stft_window_kind(VALUE self)
+{
+    static const ID * ids[] = { &id_rectangular, &id_hann, &id_hamming, &id_blackman };
+    return ID2SYM(*ids[get_stft(self)->window_kind]);
+}
+
+/**
+ * @brief Initialize the FrequencyTransformations::STFT class.
+ * @author placek@ragnarson.com
+ */
+void Init_stft(void)
+{
+    id_hop = rb_intern("hop");
+    id_window = rb_intern("window");
+    id_output = rb_intern("output");
+    id_rectangular = rb_intern("rectangular");
+    id_hann = rb_intern("hann");
+    id_hamming = rb_intern("hamming");
+    id_blackman = rb_intern("blackman");
+    id_magnitude = rb_intern("magnitude");
+    id_complex = rb_intern("complex");
+
+    cSTFT = rb_define_class_under(FT, "STFT", rb_cObject);
+    rb_define_alloc_func(cSTFT, stft_alloc);
+    rb_define_method(cSTFT, "initialize", stft_initialize, -1);
+    rb_define_method(cSTFT, "push", stft_push, 1);
+    rb_define_method(cSTFT, "<<", stft_push, 1);
+    rb_define_method(cSTFT, "reset", stft_reset, 0);
+    rb_define_method(cSTFT, "frame_length", stft_length, 0);
+    rb_define_method(cSTFT, "hop", stft_hop, 0);
+    rb_define_method(cSTFT, "window", stft_window_kind, 0);
+}
@@ -0,0 +1,485 @@
+/**
+ * @file transform2d.c
+ * @brief Two dimensional transforms computed on contiguous C buffers.
+ * The data is unboxed once into a row-major buffer, all the rows are transformed,
+ * the buffer is transposed with a cache-blocked transposition, the rows
+ * (previous columns) are transformed again and the result is transposed back.
+ * Packed buffers of doubles go through the same passes without boxing.
+ * @author placek@ragnarson.com
+ */
+#include "frequency_transformations.h"
+
+#define TRANSPOSE_BLOCK 32
+
+/**
+ * @brief Transpose a matrix.
+ * The matrix is processed in square blocks, so both reading and writing
+ * stay within a few cache lines at a time.
+ * @author placek@ragnarson.com
+ * @param in A row-major input matrix.
+ * @param out A row-major output matrix (columns x rows).
+ * @param rows Number of rows of the input matrix.
+ * @param columns Number of columns of the input matrix.
+ */
+void transpose_blocked(const double * in, double * out, long rows, long columns)
+{
+    long i, j, block_i, block_j, end_i, end_j;
+
+    for(block_j = 0; block_j < rows; block_j += TRANSPOSE_BLOCK)
+    {
+        end_j = block_j + TRANSPOSE_BLOCK < rows ? block_j + TRANSPOSE_BLOCK : rows;
+        for(block_i = 0; block_i < columns; block_i += TRANSPOSE_BLOCK)
+        {
+            end_i = block_i + TRANSPOSE_BLOCK < columns ? block_i + TRANSPOSE_BLOCK : columns;
+            for(j = block_j; j < end_j; j++)
+                for(i = block_i; i < end_i; i++)
+                    out[i * rows + j] = in[j * columns + i];
+        }
+    }
+}
+
+/**
+ * @brief Validate a matrix.
+ * Makes sure the matrix is an array of non-empty arrays of the same length
+ * and grabs its dimensions.
+ * @author placek@ragnarson.com
+ * @param matrix A Ruby array we work on.
+ * @param rows Place for the number of rows.
+ * @param columns Place for the number of columns.
+ * @return A validation result (1 if passed, 0 if failed).
+ */
+static int matrix_validate(VALUE matrix, long * rows, long * columns)
+{
+    long j;
+
+    if(TYPE(matrix) != T_ARRAY || RARRAY_LEN(matrix) < 1)
+        return FALSE;
+
+    *rows = RARRAY_LEN(matrix);
+    if(TYPE(RARRAY_PTR(matrix)[0]) != T_ARRAY)
+        return FALSE;
+    *columns = RARRAY_LEN(RARRAY_PTR(matrix)[0]);
+    if(*columns < 1)
+        return FALSE;
+
+    for(j = 1; j < *rows; j++)
+        if(TYPE(RARRAY_PTR(matrix)[j]) != T_ARRAY || RARRAY_LEN(RARRAY_PTR(matrix)[j]) != *columns)
+            return FALSE;
+
+    return TRUE;
+}
+
+/**
+ * @brief Convert a Ruby matrix into a row-major C buffer.
+ * @author placek@ragnarson.com
+ * @param matrix A validated Ruby matrix.
+ * @param out An output buffer (rows x columns).
+ * @param rows Number of rows.
+ * @param columns Number of columns.
+ */
+static void matrix_from_ruby(VALUE matrix, double * out, long rows, long columns)
+{
+    long i, j;
+    VALUE * row;
+
+    for(j = 0; j < rows; j++)
+    {
+        row = RARRAY_PTR(RARRAY_PTR(matrix)[j]);
+        for(i = 0; i < columns; i++)
+            out[j * columns + i] = NUM2DBL(row[i]);
+    }
+}
+
+/**
+ * @brief Convert a row-major C buffer into a Ruby matrix.
+ * @author placek@ragnarson.com
+ * @param values A row-major buffer (rows x columns).
+ * @param rows Number of rows.
+ * @param columns Number of columns.
+ * @return A Ruby Array of rows.
+ */
+static VALUE matrix_to_ruby(const double * values, long rows, long columns)
+{
+    long j;
+    VALUE outArray = rb_ary_new2(rows);
+
+    for(j = 0; j < rows; j++)
+        rb_ary_push(outArray, real_to_ruby(values + j * columns, columns));
+
+    return outArray;
+}
+
+/**
+ * @brief Transform all rows of complex data.
+ * @author placek@ragnarson.com
+ * @param real Real parts (rows x columns).
+ * @param imag Imaginary parts (rows x columns).
+ * @param rows Number of rows.
+ * @param columns Number of columns.
+ * @param direction A direction (1 - forward, -1 - reverse).
+ * @param fast Use FFT (TRUE) or DFT (FALSE).
+ */
+static void fourier_rows(double * real, double * imag, long rows, long columns, int direction, int fast)
+{
+    long j;
+    ft_plan * plan = fast ? ft_plan_create(columns, direction) : NULL;
+
+    for(j = 0; j < rows; j++)
+    {
+        if(fast)
+            ft_plan_execute(plan, real + j * columns, imag + j * columns);
+        else
+            dft_kernel(real + j * columns, imag + j * columns, columns, direction);
+    }
+
+    ft_plan_free(plan);
+}
+
+/**
+ * @brief Data of a two dimensional transform.
+ */
+typedef struct
+{
+    long rows;
+    long columns;
+    int direction;
+    int fast;
+    double * values[2];
+    double * transposed[2];
+} transform2d;
+
+/**
+ * @brief Transform rows, then columns as rows of the transposed data.
+ * Does not touch any Ruby object, so it runs without the GVL.
+ * @author placek@ragnarson.com
+ * @param data A transform (transform2d).
+ * @return NULL.
+ */
+static void * fourier2d_run(void * data)
+{
+    transform2d * t = data;
+
+    fourier_rows(t->values[0], t->values[1], t->rows, t->columns, t->direction, t->fast);
+    transpose_blocked(t->values[0], t->transposed[0], t->rows, t->columns);
+    transpose_blocked(t->values[1], t->transposed[1], t->rows, t->columns);
+    fourier_rows(t->transposed[0], t->transposed[1], t->columns, t->rows, t->direction, t->fast);
+    transpose_blocked(t->transposed[0], t->values[0], t->columns, t->rows);
+    transpose_blocked(t->transposed[1], t->values[1], t->columns, t->rows);
+
+    return NULL;
+}
+
+/**
+ * @brief Transform rows, then columns as rows of the transposed data.
+ * @see fourier2d_run()
+ */
+static void * hartley2d_run(void * data)
+{
+    transform2d * t = data;
+    long j;
+
+    for(j = 0; j < t->rows; j++)
+        t->fast ? fht_kernel(t->values[0] + j * t->columns, t->columns) : dht_kernel(t->values[0] + j * t->columns, t->columns);
+    transpose_blocked(t->values[0], t->transposed[0], t->rows, t->columns);
+    for(j = 0; j < t->columns; j++)
+        t->fast ? fht_kernel(t->transposed[0] + j * t->rows, t->rows) : dht_kernel(t->transposed[0] + j * t->rows, t->rows);
+    transpose_blocked(t->transposed[0], t->values[0], t->columns, t->rows);
+
+    return NULL;
+}
+
+/**
+ * @brief Estimate the number of operations of a two dimensional transform.
+ */
+static long transform2d_work(const transform2d * t, int kind)
+{
+    ft_job job;
+    long work;
+
+    job.kind = kind;
+    job.length = t->columns;
+    work = t->rows * ft_job_work(&job);
+    job.length = t->rows;
+    return work + t->columns * ft_job_work(&job);
+}
+
+/**
+ * @brief Compute a two dimensional Fourier transform.
+ * @author placek@ragnarson.com
+ * @params inArray A Ruby input data array (matrices of real and imaginary parts).
+ * @params direction A direction (1 - forward, -1 - reverse).
+ * @params fast Use FFT (TRUE) or DFT (FALSE).
+ * @params shift TRUE to return the spectrum shifted like by fftshift.
+ * @return The output Ruby Array with processed data.
+ */
+static VALUE prepare_fourier2d(VALUE inArray, int direction, int fast, int shift)
+{
+    long rows, columns, imag_rows, imag_columns, shape[2], offsets[2];
+    transform2d t;
+    VALUE outArray;
+
+    // check if array of two matrices of the same dimensions
+    Check_Type(inArray, T_ARRAY);
+    if(RARRAY_LEN(inArray) != 2) return Qnil;
+    if(!matrix_validate(RARRAY_PTR(inArray)[0], &rows, &columns)) return Qnil;
+    if(!matrix_validate(RARRAY_PTR(inArray)[1], &imag_rows, &imag_columns)) return Qnil;
+    if(rows != imag_rows || columns != imag_columns) return Qnil;
+
+    t.rows = rows;
+    t.columns = columns;
+    t.direction = direction;
+    t.fast = fast;
+    t.values[0] = malloc(rows * columns * sizeof(double));
+    t.values[1] = malloc(rows * columns * sizeof(double));
+    t.transposed[0] = malloc(rows * columns * sizeof(double));
+    t.transposed[1] = malloc(rows * columns * sizeof(double));
+    matrix_from_ruby(RARRAY_PTR(inArray)[0], t.values[0], rows, columns);
+    matrix_from_ruby(RARRAY_PTR(inArray)[1], t.values[1], rows, columns);
+
+    // do the actual transform
+    ft_without_gvl(fourier2d_run, &t, transform2d_work(&t, fast ? FT_JOB_FFT : FT_JOB_DFT));
+
+    outArray = rb_ary_new2(2);
+    if(shift)
+    {
+        shape[0] = rows;
+        shape[1] = columns;
+        offsets[0] = ft_shift_offset(rows, FALSE);
+        offsets[1] = ft_shift_offset(columns, FALSE);
+        rb_ary_push(outArray, ft_nd_to_ruby(t.values[0], shape, 2, offsets));
+        rb_ary_push(outArray, ft_nd_to_ruby(t.values[1], shape, 2, offsets));
+    }
+    else
+    {
+        rb_ary_push(outArray, matrix_to_ruby(t.values[0], rows, columns));
+        rb_ary_push(outArray, matrix_to_ruby(t.values[1], rows, columns));
+    }
+
+    // no memory leaks
+    free(t.values[0]);
+    free(t.values[1]);
+    free(t.transposed[0]);
+    free(t.transposed[1]);
+
+    return outArray;
+}
+
+/**
+ * @brief Compute a two dimensional Hartley transform.
+ * @author placek@ragnarson.com
+ * @params inArray A Ruby input data matrix.
+ * @params fast Use FHT (TRUE) or DHT (FALSE).
+ * @return The output Ruby Array with processed data.
+ */
+static VALUE prepare_hartley2d(VALUE inArray, int fast)
+{
+    long rows, columns;
+    transform2d t;
+    VALUE outArray;
+
+    Check_Type(inArray, T_ARRAY);
+    if(!matrix_validate(inArray, &rows, &columns)) return Qnil;
+
+    // check lengths of both dimensions
+    if(rows % 2 == 1 || columns % 2 == 1) return Qnil;
+
+    t.rows = rows;
+    t.columns = columns;
+    t.fast = fast;
+    t.values[0] = malloc(rows * columns * sizeof(double));
+    t.transposed[0] = malloc(rows * columns * sizeof(double));
+    matrix_from_ruby(inArray, t.values[0], rows, columns);
+
+    // do the actual transform
+    ft_without_gvl(hartley2d_run, &t, transform2d_work(&t, fast ? FT_JOB_FHT : FT_JOB_DHT));
+
+    outArray = matrix_to_ruby(t.values[0], rows, columns);
+
+    // no memory leaks
+    free(t.values[0]);
+    free(t.transposed[0]);
+
+    return outArray;
+}
+
+/**
+ * @brief Compute a forward FFT for 2D data.
+ * fft2d(shift: true) returns the spectrum shifted like by fftshift.
+ * @author placek@ragnarson.com
+ * @params self A Ruby input data array.
+ * @return A result of forward FFT.
+ */
+static VALUE forward_fft2d(int argc, VALUE * argv, VALUE self)
+{
+    VALUE options;
+
+    rb_scan_args(argc, argv, "0:", &options);
+    return prepare_fourier2d(self, 1, TRUE, ft_shift_option(options));
+}
+
+/**
+ * @brief Compute a reverse FFT for 2D data.
+ * @author placek@ragnarson.com
+ * @params self A Ruby input data array.
+ * @return A result of reverse FFT.
+ */
+static VALUE reverse_fft2d(VALUE self)
+{
+    return prepare_fourier2d(self, -1, TRUE, FALSE);
+}
+
+/**
+ * @brief Compute a forward DFT for 2D data.
+ * @author placek@ragnarson.com
+ * @params self A Ruby input data array.
+ * @return A result of forward DFT.
+ */
+static VALUE forward_dft2d(VALUE self)
+{
+    return prepare_fourier2d(self, 1, FALSE, FALSE);
+}
+
+/**
+ * @brief Compute a reverse DFT for 2D data.
+ * @author placek@ragnarson.com
+ * @params self A Ruby input data array.
+ * @return A result of reverse DFT.
+ */
+static VALUE reverse_dft2d(VALUE self)
+{
+    return prepare_fourier2d(self, -1, FALSE, FALSE);
+}
+
+/**
+ * @brief Compute a FHT for 2D data.
+ * @author placek@ragnarson.com
+ * @params self A Ruby input data array.
+ * @return A result of FHT.
+ */
+static VALUE forward_fht2d(VALUE self)
+{
+    return prepare_hartley2d(self, TRUE);
+}
+
+/**
+ * @brief Compute a DHT for 2D data.
+ * @author placek@ragnarson.com
+ * @params self A Ruby input data array.
+ * @return A result of DHT.
+ */
+static VALUE forward_dht2d(VALUE self)
+{
+    return prepare_hartley2d(self, FALSE);
+}
+
+/**
+ * @brief Compute a two dimensional FFT or FHT of a packed buffer.
+ * @author placek@ragnarson.com
+ * @params argc Number of arguments.
+ * @params argv Arguments (input, number of rows and optional output String).
+ * @params direction A direction (1 - forward, -1 - reverse, 0 - FHT).
+ * @return The output String (nil for empty data, data that is not a whole
+ * number of rows or, for the FHT, odd dimensions).
+ */
+static VALUE prepare_buffer2d(int argc, VALUE * argv, int direction)
+{
+    VALUE input, rb_rows, output;
+    ft_buffer buffer;
+    transform2d t;
+    long count, value = direction ? 2 : 1;
+
+    rb_scan_args(argc, argv, "21", &input, &rb_rows, &output);
+    t.rows = NUM2LONG(rb_rows);
+    if(t.rows < 1)
+        rb_raise(rb_eArgError, "number of rows should be positive");
+    ft_buffer_open(input, &buffer, FT_FLOAT64);
+    count = buffer.size / (value * sizeof(double));
+    t.columns = count / t.rows;
+    if(count < 1 || buffer.size % (value * sizeof(double)) || count % t.rows
+        || (!direction && (t.rows % 2 == 1 || t.columns % 2 == 1)))
+    {
+        ft_buffer_close(&buffer);
+        return Qnil;
+    }
+
+    t.direction = direction;
+    t.fast = TRUE;
+    t.values[0] = malloc(value * count * sizeof(double));
+    t.values[1] = t.values[0] + count;
+    t.transposed[0] = malloc(value * count * sizeof(double));
+    t.transposed[1] = t.transposed[0] + count;
+    if(direction)
+        ft_buffer_read_complex(&buffer, t.values[0], t.values[1], count);
+    else
+        ft_buffer_read_real(&buffer, t.values[0], count);
+    ft_buffer_close(&buffer);
+
+    // do the actual transform
+    if(direction)
+        ft_without_gvl(fourier2d_run, &t, transform2d_work(&t, FT_JOB_FFT));
+    else
+        ft_without_gvl(hartley2d_run, &t, transform2d_work(&t, FT_JOB_FHT));
+
+    output = ft_buffer_output(output, value * count * sizeof(double));
+    if(direction)
+        ft_buffer_write_complex(RSTRING_PTR(output), t.values[0], t.values[1], count);
+    else
+        ft_buffer_write_real(RSTRING_PTR(output), t.values[0], count);
+
+    // no memory leaks
+    free(t.values[0]);
+    free(t.transposed[0]);
+
+    return output;
+}
+
+/**
+ * @brief Compute a forward FFT of a packed 2D buffer.
+ * FT.fft2d_buffer(input, rows, output = nil) transforms row-major interleaved
+ * complex doubles, like fft2d does with arrays.
+ * @author placek@ragnarson.com
+ * @return A String with the interleaved spectrum.
+ */
+static VALUE fft2d_buffer(int argc, VALUE * argv, VALUE self)
+{
+    return prepare_buffer2d(argc, argv, 1);
+}
+
+/**
+ * @brief Compute a reverse FFT of a packed 2D buffer.
+ * @see fft2d_buffer()
+ * @author placek@ragnarson.com
+ * @return A String with the interleaved data.
+ */
+static VALUE rfft2d_buffer(int argc, VALUE * argv, VALUE self)
+{
+    return prepare_buffer2d(argc, argv, -1);
+}
+
+/**
+ * @brief Compute a FHT of a packed 2D buffer of row-major doubles.
+ * @see fft2d_buffer()
+ * @author placek@ragnarson.com
+ * @return A String with the transform.
+ */
+static VALUE fht2d_buffer(int argc, VALUE * argv, VALUE self)
+{
+    return prepare_buffer2d(argc, argv, 0);
+}
+
+/**
+ * @brief Define the two dimensional transforms.
+ * @author placek@ragnarson.com
+ */
+void Init_transform2d(void)
+{
+    rb_define_method(FT, "fft2d", forward_fft2d, -1);
+    rb_define_method(FT, "rfft2d", reverse_fft2d, 0);
+    rb_define_method(FT, "dft2d", forward_dft2d, 0);
+    rb_define_method(FT, "rdft2d", reverse_dft2d, 0);
+    rb_define_method(FT, "fht2d", forward_fht2d, 0);
+    rb_define_method(FT, "dht2d", forward_dht2d, 0);
+    rb_define_singleton_method(FT, "fft2d_buffer", fft2d_buffer, -1);
+    rb_define_singleton_method(FT, "rfft2d_buffer", rfft2d_buffer, -1);
+    rb_define_singleton_method(FT, "fht2d_buffer", fht2d_buffer, -1);
+}
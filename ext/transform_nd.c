@@ -0,0 +1,480 @@
+/**
+ * @file transform_nd.c
+ * @brief N-dimensional FFT and FHT over strided buffers.
+ * Each axis is transformed in turn. Lines along the axis are taken in
+ * blocks of ND_BLOCK neighbours (adjacent in the innermost other axis, so
+ * a gather reads a short contiguous run per step of the axis), copied into
+ * a contiguous block, transformed by one shared plan and scattered back.
+ * Blocks are independent, so large volumes spread chunks of them over the
+ * worker threads (each chunk allocates its block and scratch once). Hartley lines go in pairs through one complex FFT. Shapes and
+ * strides are given in elements, so any row-major, column-major or
+ * sub-volume layout of one buffer can be transformed in place.
+ * @author placek@ragnarson.com
+ */
+#include "frequency_transformations.h"
+
+#define ND_BLOCK 8
+
+#ifndef FT_ND_PARALLEL
+#define FT_ND_PARALLEL (1L << 15)
+#endif
+
+static ID id_strides;
+
+/**
+ * @brief A N-dimensional transform of a strided buffer.
+ * Hartley transforms use only the real parts.
+ */
+typedef struct
+{
+    double * real;
+    double * imag;
+    long shape[FT_MAX_DIMS];
+    long strides[FT_MAX_DIMS];
+    int dims;
+    int direction;
+    int hartley;
+    int axis;
+    long lines;
+    long blocks;
+    long chunk;
+    const ft_plan * plan;
+} transform_nd;
+
+/**
+ * @brief Find the first elements of lines along the axis.
+ * @author placek@ragnarson.com
+ * @param t A transform.
+ * @param first Index of the first line.
+ * @param count Number of lines.
+ * @param bases Place for offsets of the lines.
+ */
+static void nd_line_bases(const transform_nd * t, long first, long count, long * bases)
+{
+    long b, line, offset;
+    int d;
+
+    for(b = 0; b < count; b++)
+    {
+        line = first + b;
+        offset = 0;
+        for(d = t->dims - 1; d >= 0; d--)
+        {
+            if(d == t->axis)
+                continue;
+            offset += (line % t->shape[d]) * t->strides[d];
+            line /= t->shape[d];
+        }
+        bases[b] = offset;
+    }
+}
+
+/**
+ * @brief Compute the FHT of two real lines with one complex FFT.
+ * With z = x + i y and Z its FFT, the Hartley transforms are
+ * H_x[k] = (Re Z[k] + Re Z[n - k] - Im Z[k] + Im Z[n - k]) / 2 and
+ * H_y[k] = (Im Z[k] + Im Z[n - k] + Re Z[k] - Re Z[n - k]) / 2.
+ * @author placek@ragnarson.com
+ */
+static void nd_hartley_pair(const ft_plan * plan, double * x, double * y, double * z_real, double * z_imag, double * scratch)
+{
+    long k, m, n = plan->length;
+    double scale = 0.5 / sqrt((double)n);
+
+    for(k = 0; k < n; k++)
+    {
+        z_real[k] = x[k];
+        z_imag[k] = y ? y[k] : 0.0;
+    }
+    ft_plan_execute_scratch(plan, z_real, z_imag, scratch);
+    for(k = 0; k < n; k++)
+    {
+        m = k ? n - k : 0;
+        x[k] = (z_real[k] + z_real[m] - z_imag[k] + z_imag[m]) * scale;
+        if(y)
+            y[k] = (z_imag[k] + z_imag[m] + z_real[k] - z_real[m]) * scale;
+    }
+}
+
+/**
+ * @brief Transform a block of lines along the axis.
+ * @author placek@ragnarson.com
+ * @param t A transform.
+ * @param index Index of the block.
+ * @param block Memory for the block (ND_BLOCK lines of real and imaginary parts).
+ * @param scratch Scratch memory of the plan.
+ */
+static void nd_block(const transform_nd * t, long index, double ** block, double * scratch)
+{
+    long n = t->shape[t->axis], step = t->strides[t->axis];
+    long b, k, count, bases[ND_BLOCK];
+    double * work[2];
+
+    count = t->lines - index * ND_BLOCK;
+    if(count > ND_BLOCK)
+        count = ND_BLOCK;
+    nd_line_bases(t, index * ND_BLOCK, count, bases);
+
+    // gather: neighbouring lines are read together at every step of the axis
+    for(k = 0; k < n; k++)
+        for(b = 0; b < count; b++)
+            block[0][b * n + k] = t->real[bases[b] + k * step];
+    if(!t->hartley)
+        for(k = 0; k < n; k++)
+            for(b = 0; b < count; b++)
+                block[1][b * n + k] = t->imag[bases[b] + k * step];
+
+    // do the actual transform
+    if(t->hartley)
+    {
+        work[0] = block[1];
+        work[1] = block[1] + n;
+        for(b = 0; b < count; b += 2)
+            nd_hartley_pair(t->plan, block[0] + b * n, b + 1 < count ? block[0] + (b + 1) * n : NULL,
+                work[0], work[1], scratch);
+    }
+    else
+        for(b = 0; b < count; b++)
+            ft_plan_execute_scratch(t->plan, block[0] + b * n, block[1] + b * n, scratch);
+
+    // scatter
+    for(k = 0; k < n; k++)
+        for(b = 0; b < count; b++)
+            t->real[bases[b] + k * step] = block[0][b * n + k];
+    if(!t->hartley)
+        for(k = 0; k < n; k++)
+            for(b = 0; b < count; b++)
+                t->imag[bases[b] + k * step] = block[1][b * n + k];
+}
+
+/**
+ * @brief Transform a chunk of blocks of lines along the axis.
+ * @author placek@ragnarson.com
+ * @param index Index of the chunk.
+ * @param data A transform (transform_nd).
+ */
+static void nd_chunk(long index, void * data)
+{
+    const transform_nd * t = data;
+    long i, n = t->shape[t->axis];
+    long last = (index + 1) * t->chunk < t->blocks ? (index + 1) * t->chunk : t->blocks;
+    double * block[2], * scratch;
+
+    block[0] = malloc(ND_BLOCK * n * sizeof(double));
+    block[1] = malloc(ND_BLOCK * n * sizeof(double));
+    scratch = malloc((ft_plan_scratch_length(t->plan) + 1) * sizeof(double));
+
+    for(i = index * t->chunk; i < last; i++)
+        nd_block(t, i, block, scratch);
+
+    // free the memory
+    free(block[0]);
+    free(block[1]);
+    free(scratch);
+}
+
+/**
+ * @brief Transform every axis.
+ * Does not touch any Ruby object, so it runs without the GVL.
+ * @author placek@ragnarson.com
+ * @param data A transform (transform_nd).
+ * @return NULL.
+ */
+static void * nd_run(void * data)
+{
+    transform_nd * t = data;
+    long size = 1, threads;
+    int d;
+    ft_plan * plan;
+
+    for(d = 0; d < t->dims; d++)
+        size *= t->shape[d];
+
+    for(d = 0; d < t->dims; d++)
+    {
+        if(t->shape[d] == 1)
+            continue;
+        plan = ft_plan_create(t->shape[d], t->hartley ? 1 : t->direction);
+        t->axis = d;
+        t->plan = plan;
+        t->lines = size / t->shape[d];
+        t->blocks = (t->lines + ND_BLOCK - 1) / ND_BLOCK;
+        threads = size >= FT_ND_PARALLEL ? ft_thread_count() : 1;
+        t->chunk = (t->blocks + threads - 1) / threads;
+        ft_parallel_for((t->blocks + t->chunk - 1) / t->chunk, nd_chunk, t);
+        ft_plan_free(plan);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Compute a N-dimensional transform in place, releasing the GVL for large ones.
+ * @author placek@ragnarson.com
+ * @param real Real parts (or values of the FHT).
+ * @param imag Imaginary parts (NULL for the FHT).
+ * @param shape Lengths of the axes.
+ * @param strides Distances between neighbours along the axes (in elements).
+ * @param dims Number of axes.
+ * @param direction A direction (1 - forward, -1 - reverse), ignored by the FHT.
+ */
+void ft_transform_nd(double * real, double * imag, const long * shape, const long * strides, int dims, int direction)
+{
+    transform_nd t;
+    ft_job job;
+    int d;
+
+    t.real = real;
+    t.imag = imag;
+    t.dims = dims;
+    t.direction = direction;
+    t.hartley = imag == NULL;
+    job.kind = FT_JOB_FFT;
+    job.length = 1;
+    for(d = 0; d < dims; d++)
+    {
+        t.shape[d] = shape[d];
+        t.strides[d] = strides[d];
+        job.length *= shape[d];
+    }
+
+    ft_without_gvl(nd_run, &t, ft_job_work(&job));
+}
+
+/**
+ * @brief Get row-major strides of a shape.
+ * @author placek@ragnarson.com
+ */
+static void nd_row_major(const long * shape, long * strides, int dims)
+{
+    long stride = 1;
+    int d;
+
+    for(d = dims - 1; d >= 0; d--)
+    {
+        strides[d] = stride;
+        stride *= shape[d];
+    }
+}
+
+/**
+ * @brief Compute a N-dimensional Fourier transform of nested Ruby arrays.
+ * @author placek@ragnarson.com
+ * @params inArray A Ruby input data array (arrays of real and imaginary parts of the same shape).
+ * @params direction A direction (1 - forward, -1 - reverse).
+ * @params shift TRUE to return the spectrum shifted like by fftshift.
+ * @return The output Ruby Array with processed data (nil for invalid data).
+ */
+static VALUE prepare_fourier_nd(VALUE inArray, int direction, int shift)
+{
+    long shape[FT_MAX_DIMS], imag_shape[FT_MAX_DIMS], strides[FT_MAX_DIMS], offsets[FT_MAX_DIMS], size = 1;
+    double * values[2];
+    int d, dims;
+    VALUE outArray;
+
+    Check_Type(inArray, T_ARRAY);
+    if(RARRAY_LEN(inArray) != 2) return Qnil;
+    dims = ft_nd_shape(RARRAY_PTR(inArray)[0], shape);
+    if(dims == 0 || ft_nd_shape(RARRAY_PTR(inArray)[1], imag_shape) != dims) return Qnil;
+    for(d = 0; d < dims; d++)
+    {
+        if(shape[d] != imag_shape[d]) return Qnil;
+        size *= shape[d];
+        offsets[d] = ft_shift_offset(shape[d], FALSE);
+    }
+
+    values[0] = malloc(size * sizeof(double));
+    values[1] = malloc(size * sizeof(double));
+    ft_nd_from_ruby(RARRAY_PTR(inArray)[0], values[0], shape, dims);
+    ft_nd_from_ruby(RARRAY_PTR(inArray)[1], values[1], shape, dims);
+
+    // do the actual transform
+    nd_row_major(shape, strides, dims);
+    ft_transform_nd(values[0], values[1], shape, strides, dims, direction);
+
+    outArray = rb_ary_new2(2);
+    rb_ary_push(outArray, ft_nd_to_ruby(values[0], shape, dims, shift ? offsets : NULL));
+    rb_ary_push(outArray, ft_nd_to_ruby(values[1], shape, dims, shift ? offsets : NULL));
+
+    // no memory leaks
+    free(values[0]);
+    free(values[1]);
+
+    return outArray;
+}
+
+/**
+ * @brief Compute a forward FFT of N-dimensional data.
+ * fftnd(shift: true) returns the spectrum shifted like by fftshift.
+ * @author placek@ragnarson.com
+ * @params self A Ruby input data array.
+ * @return A result of forward FFT.
+ */
+static VALUE forward_fftnd(int argc, VALUE * argv, VALUE self)
+{
+    VALUE options;
+
+    rb_scan_args(argc, argv, "0:", &options);
+    return prepare_fourier_nd(self, 1, ft_shift_option(options));
+}
+
+/**
+ * @brief Compute a reverse FFT of N-dimensional data.
+ * @author placek@ragnarson.com
+ * @params self A Ruby input data array.
+ * @return A result of reverse FFT.
+ */
+static VALUE reverse_fftnd(VALUE self)
+{
+    return prepare_fourier_nd(self, -1, FALSE);
+}
+
+/**
+ * @brief Compute a FHT of N-dimensional data.
+ * Like fht2d, every axis is transformed in turn (and the result is its own
+ * inverse).
+ * @author placek@ragnarson.com
+ * @params self A Ruby input data array (real numbers).
+ * @return A result of FHT (nil for invalid data).
+ */
+static VALUE forward_fhtnd(VALUE self)
+{
+    long shape[FT_MAX_DIMS], strides[FT_MAX_DIMS], size = 1;
+    double * values;
+    int d, dims;
+    VALUE outArray;
+
+    Check_Type(self, T_ARRAY);
+    dims = ft_nd_shape(self, shape);
+    if(dims == 0)
+        return Qnil;
+    for(d = 0; d < dims; d++)
+        size *= shape[d];
+
+    values = malloc(size * sizeof(double));
+    ft_nd_from_ruby(self, values, shape, dims);
+    nd_row_major(shape, strides, dims);
+    ft_transform_nd(values, NULL, shape, strides, dims, 1);
+    outArray = ft_nd_to_ruby(values, shape, dims, NULL);
+    free(values);
+
+    return outArray;
+}
+
+/**
+ * @brief Compute a N-dimensional transform of a buffer.
+ * Elements outside of the shape and strides are copied unchanged.
+ * @author placek@ragnarson.com
+ * @params argc Number of arguments.
+ * @params argv Arguments (input, shape, optional output String and strides: option).
+ * @params direction A direction (1 - forward, -1 - reverse, 0 - FHT).
+ * @return The output String.
+ */
+static VALUE prepare_nd_buffer(int argc, VALUE * argv, int direction)
+{
+    VALUE input, rb_shape, output, options, rb_strides = Qundef;
+    long shape[FT_MAX_DIMS], strides[FT_MAX_DIMS], length, last = 0;
+    int d, dims, complex = direction != 0;
+    double * values;
+    ft_buffer buffer;
+
+    rb_scan_args(argc, argv, "21:", &input, &rb_shape, &output, &options);
+    Check_Type(rb_shape, T_ARRAY);
+    dims = (int)RARRAY_LEN(rb_shape);
+    if(dims < 1 || dims > FT_MAX_DIMS)
+        rb_raise(rb_eArgError, "shape should have 1 to %d axes", FT_MAX_DIMS);
+    for(d = 0; d < dims; d++)
+        if((shape[d] = NUM2LONG(RARRAY_PTR(rb_shape)[d])) < 1)
+            rb_raise(rb_eArgError, "lengths of axes should be positive");
+    nd_row_major(shape, strides, dims);
+    if(!NIL_P(options))
+        rb_get_kwargs(options, &id_strides, 0, 1, &rb_strides);
+    if(rb_strides != Qundef && !NIL_P(rb_strides))
+    {
+        Check_Type(rb_strides, T_ARRAY);
+        if(RARRAY_LEN(rb_strides) != dims)
+            rb_raise(rb_eArgError, "strides should match the shape");
+        for(d = 0; d < dims; d++)
+            if((strides[d] = NUM2LONG(RARRAY_PTR(rb_strides)[d])) < 1)
+                rb_raise(rb_eArgError, "strides should be positive");
+    }
+    for(d = 0; d < dims; d++)
+        last += (shape[d] - 1) * strides[d];
+
+    ft_buffer_open(input, &buffer, FT_FLOAT64);
+    length = buffer.size / sizeof(double);
+    if(buffer.size % sizeof(double) || (complex ? 2 * last + 1 : last) >= length)
+    {
+        ft_buffer_close(&buffer);
+        rb_raise(rb_eArgError, "buffer is too small for the shape");
+    }
+    values = malloc(length * sizeof(double));
+    ft_buffer_read_real(&buffer, values, length);
+    ft_buffer_close(&buffer);
+
+    // interleaved complex numbers are pairs of doubles
+    if(complex)
+        for(d = 0; d < dims; d++)
+            strides[d] *= 2;
+
+    // do the actual transform
+    ft_transform_nd(values, complex ? values + 1 : NULL, shape, strides, dims, direction);
+
+    output = ft_buffer_output(output, length * sizeof(double));
+    ft_buffer_write_real(RSTRING_PTR(output), values, length);
+    free(values);
+
+    return output;
+}
+
+/**
+ * @brief Compute a forward N-dimensional FFT of a buffer.
+ * FT.fftnd_buffer(input, shape, output = nil, strides: nil) transforms
+ * interleaved complex doubles; strides are counted in complex numbers
+ * (row-major by default).
+ * @author placek@ragnarson.com
+ * @return A String with the interleaved spectrum.
+ */
+static VALUE fftnd_buffer(int argc, VALUE * argv, VALUE self)
+{
+    return prepare_nd_buffer(argc, argv, 1);
+}
+
+/**
+ * @brief Compute a reverse N-dimensional FFT of a buffer.
+ * FT.rfftnd_buffer(input, shape, output = nil, strides: nil)
+ * @author placek@ragnarson.com
+ * @return A String with interleaved data.
+ */
+static VALUE rfftnd_buffer(int argc, VALUE * argv, VALUE self)
+{
+    return prepare_nd_buffer(argc, argv, -1);
+}
+
+/**
+ * @brief Compute a N-dimensional FHT of a buffer.
+ * FT.fhtnd_buffer(input, shape, output = nil, strides: nil) transforms
+ * real doubles.
+ * @author placek@ragnarson.com
+ * @return A String with the transform.
+ */
+static VALUE fhtnd_buffer(int argc, VALUE * argv, VALUE self)
+{
+    return prepare_nd_buffer(argc, argv, 0);
+}
+
+/**
+ * @brief Define the N-dimensional transform methods.
+ * @author placek@ragnarson.com
+ */
+void Init_transform_nd(void)
+{
+    id_strides = rb_intern("strides");
+
+    rb_define_method(FT, "fftnd", forward_fftnd, -1);
+    rb_define_method(FT, "rfftnd", reverse_fftnd, 0);
+    rb_define_method(FT, "fhtnd", forward_fhtnd, 0);
+    rb_define_singleton_method(FT, "fftnd_buffer", fftnd_buffer, -1);
+    rb_define_singleton_method(FT, "rfftnd_buffer", rfftnd_buffer, -1);
+    rb_define_singleton_method(FT, "fhtnd_buffer", fhtnd_buffer, -1);
+}
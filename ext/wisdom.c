@@ -0,0 +1,501 @@
+/**
+ * @file wisdom.c
+ * @brief Measured choices of the FFT algorithm for each length (wisdom).
+ * The defaults of ft_plan_create() (radix-2 with the best instruction set
+ * and the codelets for powers of 2, four-step from FT_FOUR_STEP_THRESHOLD,
+ * mixed-radix for lengths of small factors) are not the fastest on every
+ * CPU. FT.tune(length) times every strategy that can compute the length
+ * (algorithms, instruction sets of the radix-2 passes, codelets on or off)
+ * and records the fastest one; every plan of that length created afterwards
+ * (FT::Plan, the Array methods, buffers, inner plans of other plans) uses
+ * it; only Array transforms of up to FT_CODELET_MAX points keep the
+ * codelets without looking for it. Wisdom is exported to and imported from
+ * a small text file, one length per line, so a program can load it at
+ * startup without measuring again.
+ * Nothing is measured or changed unless it is asked for.
+ * @author placek@ragnarson.com
+ */
+#include "frequency_transformations.h"
+#include <time.h>
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+#endif
+
+/**
+ * @brief Shortest time of one round of measurement in seconds.
+ */
+#define WISDOM_ROUND 0.002
+
+/**
+ * @brief Number of rounds measured for each strategy (the best one counts).
+ */
+#define WISDOM_ROUNDS 5
+
+/**
+ * @brief Header of exported wisdom.
+ */
+#define WISDOM_HEADER "# ft wisdom 1"
+
+static const char * algorithm_names[] = { "radix2", "mixed_radix", "bluestein", "four_step" };
+static const char * simd_names[] = { "scalar", "sse2", "avx2", "avx512" };
+
+static ID id_length, id_algorithm, id_simd, id_codelet, id_time;
+
+// plans are created without the GVL too, so the table has its own lock
+// (none without threads)
+#ifdef HAVE_PTHREAD_H
+static pthread_mutex_t wisdom_mutex = PTHREAD_MUTEX_INITIALIZER;
+#define WISDOM_LOCK() pthread_mutex_lock(&wisdom_mutex)
+#define WISDOM_UNLOCK() pthread_mutex_unlock(&wisdom_mutex)
+#else
+#define WISDOM_LOCK()
+#define WISDOM_UNLOCK()
+#endif
+static ft_wisdom * entries = NULL;
+static long entry_count = 0;
+
+/**
+ * @brief Find the wisdom of a length.
+ * The entries are sorted by length, so they are searched by bisection.
+ * @author placek@ragnarson.com
+ * @param length Length of processing data.
+ * @param wisdom Place for the wisdom (or NULL to check only).
+ * @return TRUE if there is wisdom for the length.
+ */
+int ft_wisdom_lookup(long length, ft_wisdom * wisdom)
+{
+    long low, high, middle;
+    int found = FALSE;
+
+    WISDOM_LOCK();
+    low = 0;
+    high = entry_count;
+    while(low < high)
+    {
+        middle = (low + high) / 2;
+        if(entries[middle].length < length)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    if(low < entry_count && entries[low].length == length)
+    {
+        if(wisdom)
+            *wisdom = entries[low];
+        found = TRUE;
+    }
+    WISDOM_UNLOCK();
+
+    return found;
+}
+
+/**
+ * @brief Copy the wisdom of every length.
+ * Ruby objects are made from the copy, as they may raise while the table
+ * would be locked.
+ * @author placek@ragnarson.com
+ * @param count Place for the number of entries.
+ * @return A new array of entries sorted by length (to be released with free()).
+ */
+static ft_wisdom * wisdom_copy(long * count)
+{
+    ft_wisdom * copy;
+    long i;
+
+    WISDOM_LOCK();
+    *count = entry_count;
+    copy = malloc((entry_count + 1) * sizeof(ft_wisdom));
+    for(i = 0; i < entry_count; i++)
+        copy[i] = entries[i];
+    WISDOM_UNLOCK();
+
+    return copy;
+}
+
+/**
+ * @brief Record the wisdom of a length (replacing the old one).
+ * Entries are kept sorted by length.
+ * @author placek@ragnarson.com
+ * @param wisdom The wisdom.
+ */
+static void wisdom_store(const ft_wisdom * wisdom)
+{
+    long i, j;
+
+    WISDOM_LOCK();
+    for(i = 0; i < entry_count && entries[i].length < wisdom->length; i++);
+    if(i == entry_count || entries[i].length != wisdom->length)
+    {
+        entries = realloc(entries, (entry_count + 1) * sizeof(ft_wisdom));
+        for(j = entry_count; j > i; j--)
+            entries[j] = entries[j - 1];
+        entry_count++;
+    }
+    entries[i] = *wisdom;
+    WISDOM_UNLOCK();
+}
+
+/**
+ * @brief Get the name of an algorithm.
+ * @author placek@ragnarson.com
+ * @param algorithm An algorithm (FT_RADIX2, FT_MIXED_RADIX, FT_BLUESTEIN or FT_FOUR_STEP).
+ * @return A symbol (:radix2, :mixed_radix, :bluestein or :four_step).
+ */
+VALUE ft_algorithm_to_ruby(int algorithm)
+{
+    return ID2SYM(rb_intern(algorithm_names[algorithm]));
+}
+
+/**
+ * @brief Describe the wisdom of a length.
+ * @author placek@ragnarson.com
+ * @param wisdom The wisdom.
+ * @return A Hash with :length, :algorithm, :simd (nil for the instruction
+ * set in use), :codelet and :time (seconds per transform, nil if unknown).
+ */
+static VALUE wisdom_to_ruby(const ft_wisdom * wisdom)
+{
+    VALUE hash = rb_hash_new();
+
+    rb_hash_aset(hash, ID2SYM(id_length), LONG2NUM(wisdom->length));
+    rb_hash_aset(hash, ID2SYM(id_algorithm), ft_algorithm_to_ruby(wisdom->algorithm));
+    rb_hash_aset(hash, ID2SYM(id_simd), wisdom->simd >= 0 ? ID2SYM(rb_intern(simd_names[wisdom->simd])) : Qnil);
+    rb_hash_aset(hash, ID2SYM(id_codelet), wisdom->codelet ? Qtrue : Qfalse);
+    rb_hash_aset(hash, ID2SYM(id_time), wisdom->time > 0.0 ? rb_float_new(wisdom->time) : Qnil);
+
+    return hash;
+}
+
+/**
+ * @brief Read the monotonic clock.
+ * @author placek@ragnarson.com
+ * @return Time in seconds.
+ */
+static double wisdom_clock(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + 1.0e-09 * (double)now.tv_nsec;
+}
+
+/**
+ * @brief A measurement of the strategies of a length.
+ */
+typedef struct
+{
+    long length;
+    ft_wisdom best;
+} wisdom_tuning;
+
+/**
+ * @brief Measure one strategy.
+ * Forward and reverse transforms alternate, so the data stays bounded;
+ * rounds are long enough for the clock and the best one counts.
+ * @author placek@ragnarson.com
+ * @param wisdom The strategy.
+ * @param real Real parts of test data.
+ * @param imag Imaginary parts of test data.
+ * @return Seconds per transform.
+ */
+static double wisdom_measure(const ft_wisdom * wisdom, double * real, double * imag)
+{
+    ft_plan * forward = ft_plan_create_with(wisdom->length, 1, wisdom);
+    ft_plan * reverse = ft_plan_create_with(wisdom->length, -1, wisdom);
+    long i, runs = 1;
+    int round;
+    double start, elapsed, best = 0.0;
+
+    // warm up and find the number of runs of a round
+    for(;;)
+    {
+        start = wisdom_clock();
+        for(i = 0; i < runs; i++)
+        {
+            ft_plan_execute(forward, real, imag);
+            ft_plan_execute(reverse, real, imag);
+        }
+        elapsed = wisdom_clock() - start;
+        if(elapsed >= WISDOM_ROUND)
+            break;
+        runs *= 2;
+    }
+
+    for(round = 0; round < WISDOM_ROUNDS; round++)
+    {
+        start = wisdom_clock();
+        for(i = 0; i < runs; i++)
+        {
+            ft_plan_execute(forward, real, imag);
+            ft_plan_execute(reverse, real, imag);
+        }
+        elapsed = wisdom_clock() - start;
+        if(round == 0 || elapsed < best)
+            best = elapsed;
+    }
+
+    // no memory leaks
+    ft_plan_free(forward);
+    ft_plan_free(reverse);
+
+    return best / (double)(2 * runs);
+}
+
+/**
+ * @brief Measure every strategy of a length (run without the GVL).
+ * @author placek@ragnarson.com
+ * @param data A measurement (wisdom_tuning).
+ * @return NULL.
+ */
+static void * wisdom_tune(void * data)
+{
+    wisdom_tuning * tuning = data;
+    long k, length = tuning->length;
+    int algorithm, simd, codelet;
+    double * real = malloc(length * sizeof(double)), * imag = malloc(length * sizeof(double)), seconds;
+    ft_wisdom candidate;
+
+    for(k = 0; k < length; k++)
+    {
+        real[k] = sin(0.1 * k);
+        imag[k] = cos(0.3 * k);
+    }
+
+    tuning->best.time = 0.0;
+    candidate.length = length;
+    for(algorithm = FT_RADIX2; algorithm <= FT_FOUR_STEP; algorithm++)
+    {
+        if(!ft_plan_supports(length, algorithm))
+            continue;
+        candidate.algorithm = algorithm;
+        for(simd = algorithm == FT_RADIX2 ? FT_SIMD_SCALAR : -1; simd <= (algorithm == FT_RADIX2 ? FT_SIMD_AVX512 : -1); simd++)
+        {
+            if(simd >= 0 && !ft_simd_kernels_for(simd))
+                continue;
+            candidate.simd = simd;
+            for(codelet = TRUE; codelet >= (algorithm == FT_RADIX2 && length <= FT_CODELET_MAX ? FALSE : TRUE); codelet--)
+            {
+                candidate.codelet = codelet;
+                seconds = wisdom_measure(&candidate, real, imag);
+                if(tuning->best.time == 0.0 || seconds < tuning->best.time)
+                {
+                    tuning->best = candidate;
+                    tuning->best.time = seconds;
+                }
+            }
+        }
+    }
+
+    // no memory leaks
+    free(real);
+    free(imag);
+
+    return NULL;
+}
+
+/**
+ * @brief Find the fastest way to compute FFTs of a length.
+ * FT.tune(length) measures every algorithm that can compute the length
+ * (radix-2 with the passes of every supported instruction set and with or
+ * without the codelets, mixed-radix, four-step, Bluestein) and records the
+ * fastest one as the wisdom of the length. Every strategy is timed for
+ * about 10 ms (a dozen transforms at least for long lengths).
+ * @author placek@ragnarson.com
+ * @params self The FT module.
+ * @params rb_length Length of transforms.
+ * @return A Hash describing the wisdom (see FT.wisdom).
+ */
+static VALUE ft_tune(VALUE self, VALUE rb_length)
+{
+    wisdom_tuning tuning;
+
+    tuning.length = NUM2LONG(rb_length);
+    if(tuning.length < 2)
+        rb_raise(rb_eArgError, "length should be at least 2");
+
+    // always release the GVL, the measurement takes long
+    ft_without_gvl(wisdom_tune, &tuning, LONG_MAX);
+    wisdom_store(&tuning.best);
+
+    return wisdom_to_ruby(&tuning.best);
+}
+
+/**
+ * @brief List the wisdom.
+ * @author placek@ragnarson.com
+ * @params self The FT module.
+ * @return An Array of Hashes (:length, :algorithm, :simd, :codelet and :time), sorted by length.
+ */
+static VALUE ft_wisdom_list(VALUE self)
+{
+    VALUE list = rb_ary_new();
+    long i, count;
+    ft_wisdom * copy = wisdom_copy(&count);
+
+    for(i = 0; i < count; i++)
+        rb_ary_push(list, wisdom_to_ruby(copy + i));
+    free(copy);
+
+    return list;
+}
+
+/**
+ * @brief Export the wisdom.
+ * FT.export_wisdom(path = nil) returns the wisdom as text (and writes it
+ * into the file when a path is given): a header line and one line per
+ * length with the length, the algorithm, the instruction set (default for
+ * the one in use), the codelets (1 or 0) and the seconds per transform.
+ * @author placek@ragnarson.com
+ * @params argc Number of arguments.
+ * @params argv Arguments (optional path).
+ * @params self The FT module.
+ * @return A String with the wisdom.
+ */
+static VALUE ft_export_wisdom(int argc, VALUE * argv, VALUE self)
+{
+    VALUE path, text = rb_str_new_cstr(WISDOM_HEADER "\n");
+    long i, count;
+    char line[128];
+    ft_wisdom * copy;
+
+    rb_scan_args(argc, argv, "01", &path);
+
+    copy = wisdom_copy(&count);
+    for(i = 0; i < count; i++)
+    {
+        snprintf(line, sizeof(line), "%ld %s %s %d %.6e\n", copy[i].length,
+            algorithm_names[copy[i].algorithm],
+            copy[i].simd >= 0 ? simd_names[copy[i].simd] : "default",
+            copy[i].codelet, copy[i].time);
+        rb_str_cat_cstr(text, line);
+    }
+    free(copy);
+
+    if(!NIL_P(path))
+        rb_funcall(rb_cFile, rb_intern("write"), 2, path, text);
+
+    return text;
+}
+
+/**
+ * @brief Find a name in a table.
+ * @author placek@ragnarson.com
+ * @param name A name.
+ * @param names The table.
+ * @param count Number of names in the table.
+ * @return Index of the name (-1 if not found).
+ */
+static int wisdom_index(const char * name, const char ** names, int count)
+{
+    int i;
+
+    for(i = 0; i < count; i++)
+        if(!strcmp(name, names[i]))
+            return i;
+    return -1;
+}
+
+/**
+ * @brief Import wisdom from text.
+ * FT.import_wisdom_string(text) reads wisdom exported by FT.export_wisdom
+ * and records it. Lengths measured with an instruction set this CPU does
+ * not support, or with an algorithm that cannot compute the length, are
+ * skipped (they keep the defaults).
+ * @author placek@ragnarson.com
+ * @params self The FT module.
+ * @params text A String with the wisdom.
+ * @return Number of imported lengths.
+ */
+static VALUE ft_import_wisdom_string(VALUE self, VALUE text)
+{
+    VALUE lines, store;
+    long i, count, imported = 0;
+    char algorithm[32], simd[32];
+    const char * line;
+    ft_wisdom * parsed;
+    int codelet;
+
+    StringValue(text);
+    lines = rb_funcall(text, rb_intern("lines"), 0);
+    count = RARRAY_LEN(lines);
+    parsed = ALLOCV_N(ft_wisdom, store, count + 1);
+
+    // parse everything before recording anything
+    for(i = 0; i < count; i++)
+    {
+        line = StringValueCStr(RARRAY_PTR(lines)[i]);
+        while(*line == ' ' || *line == '\t')
+            line++;
+        parsed[i].length = 0;
+        if(*line == '#' || *line == '\n' || *line == '\r' || !*line)
+            continue;
+        if(sscanf(line, "%ld %31s %31s %d %lf", &parsed[i].length, algorithm, simd, &codelet, &parsed[i].time) != 5
+            || parsed[i].length < 2 || (parsed[i].algorithm = wisdom_index(algorithm, algorithm_names, 4)) < 0
+            || ((parsed[i].simd = wisdom_index(simd, simd_names, 4)) < 0 && strcmp(simd, "default")))
+            rb_raise(rb_eArgError, "invalid wisdom line %ld", i + 1);
+        parsed[i].codelet = codelet != 0;
+    }
+
+    for(i = 0; i < count; i++)
+    {
+        if(!parsed[i].length || !ft_plan_supports(parsed[i].length, parsed[i].algorithm))
+            continue;
+        if(parsed[i].simd >= 0 && !ft_simd_kernels_for(parsed[i].simd))
+            continue;
+        wisdom_store(parsed + i);
+        imported++;
+    }
+    ALLOCV_END(store);
+
+    return LONG2NUM(imported);
+}
+
+/**
+ * @brief Import wisdom from a file.
+ * @see ft_import_wisdom_string()
+ * @author placek@ragnarson.com
+ * @params self The FT module.
+ * @params path Path of a file written by FT.export_wisdom.
+ * @return Number of imported lengths.
+ */
+static VALUE ft_import_wisdom(VALUE self, VALUE path)
+{
+    return ft_import_wisdom_string(self, rb_funcall(rb_cFile, rb_intern("read"), 1, path));
+}
+
+/**
+ * @brief Forget all the wisdom (plans use the defaults again).
+ * @author placek@ragnarson.com
+ * @params self The FT module.
+ * @return nil.
+ */
+static VALUE ft_forget_wisdom(VALUE self)
+{
+    WISDOM_LOCK();
+    free(entries);
+    entries = NULL;
+    entry_count = 0;
+    WISDOM_UNLOCK();
+
+    return Qnil;
+}
+
+/**
+ * @brief Define the wisdom methods.
+ * @author placek@ragnarson.com
+ */
+void Init_wisdom(void)
+{
+    id_length = rb_intern("length");
+    id_algorithm = rb_intern("algorithm");
+    id_simd = rb_intern("simd");
+    id_codelet = rb_intern("codelet");
+    id_time = rb_intern("time");
+
+    rb_define_singleton_method(FT, "tune", ft_tune, 1);
+    rb_define_singleton_method(FT, "wisdom", ft_wisdom_list, 0);
+    rb_define_singleton_method(FT, "export_wisdom", ft_export_wisdom, -1);
+    rb_define_singleton_method(FT, "import_wisdom", ft_import_wisdom, 1);
+    rb_define_singleton_method(FT, "import_wisdom_string", ft_import_wisdom_string, 1);
+    rb_define_singleton_method(FT, "forget_wisdom", ft_forget_wisdom, 0);
+}
@@ -0,0 +1,553 @@
+/**
+ * @file zoom_fft.c
+ * @brief Zoom FFT: the chirp-z transform over a band of frequencies.
+ * M bins evenly spaced from f0 to f1 of the DFT of N values are
+ * X[j] = sum x[n] exp(-2 pi i (nu0 + j dnu) n) (nu in cycles per sample).
+ * With n j = (n^2 + j^2 - (j - n)^2) / 2 the sum becomes a convolution of
+ * x[n] exp(-i (2 pi nu0 n + pi dnu n^2)) with the chirp exp(i pi dnu k^2),
+ * computed by power of 2 FFT plans of the length L >= N + M - 1 (like the
+ * Bluestein FFT of plan.c), and multiplied by exp(-i pi dnu j^2). That is
+ * O((N + M) log(N + M)) for any band and resolution, while zero-padding to
+ * the same resolution takes an FFT of N / (dnu * N) points. The chirps and
+ * the spectrum of the filter are kept in a FT::ZoomFFT plan.
+ * @author placek@ragnarson.com
+ */
+#include "frequency_transformations.h"
+
+static VALUE cZoomFFT;
+static ID id_sample_rate;
+
+/**
+ * @brief A precomputed zoom FFT.
+ */
+typedef struct
+{
+    long length;
+    long count;
+    long padded;
+    double start;
+    double step;
+    double rate;
+    double * pre[2];
+    double * post[2];
+    double * filter[2];
+    ft_plan * inner[2];
+} ft_zoom_plan;
+
+/**
+ * @brief A zoom FFT of data held in C memory.
+ */
+typedef struct
+{
+    const ft_zoom_plan * plan;
+    const double * real;
+    const double * imag;
+    double * out[2];
+} zoom_call;
+
+/**
+ * @brief Compute exp(-2 pi i cycles) of an angle given in cycles.
+ * The whole cycles are dropped before the trigonometric calls, so the
+ * large arguments of long chirps keep their precision.
+ * @author placek@ragnarson.com
+ * @param cycles The angle in cycles.
+ * @param real Place for the real part.
+ * @param imag Place for the imaginary part.
+ */
+static void zoom_turn(double cycles, double * real, double * imag)
+{
+    double arg = 2.0 * M_PI * (cycles - floor(cycles));
+
+    *real = cos(arg);
+    *imag = -sin(arg);
+}
+
+/**
+ * @brief Prepare a zoom FFT.
+ * @author placek@ragnarson.com
+ * @param length Length of transformed data (N).
+ * @param count Number of bins (M).
+ * @param start Frequency of the first bin in cycles per sample.
+ * @param step Distance of the bins in cycles per sample.
+ * @return A new plan (free it with zoom_plan_free()).
+ */
+static ft_zoom_plan * zoom_plan_create(long length, long count, double start, double step)
+{
+    ft_zoom_plan * plan = calloc(1, sizeof(ft_zoom_plan));
+    long k, padded = 1;
+    double n2;
+
+    while(padded < length + count - 1)
+        padded <<= 1;
+    plan->length = length;
+    plan->count = count;
+    plan->padded = padded;
+    plan->start = start;
+    plan->step = step;
+    plan->pre[0] = malloc(length * sizeof(double));
+    plan->pre[1] = malloc(length * sizeof(double));
+    plan->post[0] = malloc(count * sizeof(double));
+    plan->post[1] = malloc(count * sizeof(double));
+    plan->filter[0] = calloc(padded, sizeof(double));
+    plan->filter[1] = calloc(padded, sizeof(double));
+    plan->inner[0] = ft_plan_create(padded, 1);
+    plan->inner[1] = ft_plan_create(padded, -1);
+
+    // exp(-i (2 pi nu0 n + pi dnu n^2)) for the data
+    for(k = 0; k < length; k++)
+    {
+        n2 = (double)k * (double)k;
+        zoom_turn(start * k + 0.5 * step * n2, plan->pre[0] + k, plan->pre[1] + k);
+    }
+
+    // exp(-i pi dnu j^2) for the bins
+    for(k = 0; k < count; k++)
+    {
+        n2 = (double)k * (double)k;
+        zoom_turn(0.5 * step * n2, plan->post[0] + k, plan->post[1] + k);
+    }
+
+    // spectrum of the chirp exp(i pi dnu k^2) for k from 1 - N to M - 1 wrapped around L
+    for(k = 0; k < count; k++)
+    {
+        plan->filter[0][k] = plan->post[0][k];
+        plan->filter[1][k] = -plan->post[1][k];
+    }
+    for(k = 1; k < length; k++)
+    {
+        n2 = (double)k * (double)k;
+        zoom_turn(-0.5 * step * n2, plan->filter[0] + padded - k, plan->filter[1] + padded - k);
+    }
+    ft_plan_execute(plan->inner[0], plan->filter[0], plan->filter[1]);
+
+    return plan;
+}
+
+static void zoom_plan_free(ft_zoom_plan * plan)
+{
+    if(!plan)
+        return;
+    ft_plan_free(plan->inner[0]);
+    ft_plan_free(plan->inner[1]);
+    free(plan->pre[0]);
+    free(plan->pre[1]);
+    free(plan->post[0]);
+    free(plan->post[1]);
+    free(plan->filter[0]);
+    free(plan->filter[1]);
+    free(plan);
+}
+
+/**
+ * @brief Compute a zoom FFT (run without the GVL).
+ * Uses its own scratch memory, so one plan can run in many threads.
+ * @author placek@ragnarson.com
+ * @param data A call (zoom_call) with N values and place for M bins.
+ * @return NULL.
+ */
+static void * zoom_run(void * data)
+{
+    zoom_call * call = data;
+    const ft_zoom_plan * plan = call->plan;
+    long k, padded = plan->padded;
+    double * work = malloc((2 * padded + ft_plan_scratch_length(plan->inner[0]) + 1) * sizeof(double));
+    double * work_real = work, * work_imag = work + padded, * scratch = work + 2 * padded;
+    double re, im;
+
+    // multiply by the chirp and pad with zeros
+    for(k = 0; k < plan->length; k++)
+    {
+        work_real[k] = call->real[k] * plan->pre[0][k] - call->imag[k] * plan->pre[1][k];
+        work_imag[k] = call->real[k] * plan->pre[1][k] + call->imag[k] * plan->pre[0][k];
+    }
+    for(k = plan->length; k < padded; k++)
+        work_real[k] = work_imag[k] = 0.0;
+
+    // convolve with the chirp
+    ft_plan_execute_scratch(plan->inner[0], work_real, work_imag, scratch);
+    for(k = 0; k < padded; k++)
+    {
+        re = work_real[k] * plan->filter[0][k] - work_imag[k] * plan->filter[1][k];
+        im = work_real[k] * plan->filter[1][k] + work_imag[k] * plan->filter[0][k];
+        work_real[k] = re;
+        work_imag[k] = im;
+    }
+    ft_plan_execute_scratch(plan->inner[1], work_real, work_imag, scratch);
+
+    // multiply the bins by the chirp again
+    for(k = 0; k < plan->count; k++)
+    {
+        call->out[0][k] = work_real[k] * plan->post[0][k] - work_imag[k] * plan->post[1][k];
+        call->out[1][k] = work_real[k] * plan->post[1][k] + work_imag[k] * plan->post[0][k];
+    }
+
+    // no memory leaks
+    free(work);
+
+    return NULL;
+}
+
+/**
+ * @brief Compute a zoom FFT, releasing the GVL for large ones.
+ * @author placek@ragnarson.com
+ * @param plan A zoom FFT plan.
+ * @param real Real parts of N values.
+ * @param imag Imaginary parts of N values.
+ * @param out_real Place for real parts of M bins.
+ * @param out_imag Place for imaginary parts of M bins.
+ */
+static void zoom_execute(const ft_zoom_plan * plan, const double * real, const double * imag,
+    double * out_real, double * out_imag)
+{
+    zoom_call call;
+    ft_job job;
+
+    call.plan = plan;
+    call.real = real;
+    call.imag = imag;
+    call.out[0] = out_real;
+    call.out[1] = out_imag;
+    job.kind = FT_JOB_FFT;
+    job.length = 2 * plan->padded;
+    ft_without_gvl(zoom_run, &call, ft_job_work(&job));
+}
+
+/**
+ * @brief Read the band of a zoom FFT.
+ * The frequencies are bins of the DFT (cycles per length, fractional too)
+ * or in the units of the sample_rate: option when it is given.
+ * @author placek@ragnarson.com
+ * @param length Length of transformed data.
+ * @param rb_f0 Frequency of the first bin.
+ * @param rb_f1 Frequency of the last bin.
+ * @param rb_count Number of bins.
+ * @param options A Hash of keyword arguments (or nil).
+ * @return A new plan.
+ */
+static ft_zoom_plan * zoom_plan_from_ruby(long length, VALUE rb_f0, VALUE rb_f1, VALUE rb_count, VALUE options)
+{
+    VALUE value = Qundef;
+    ft_zoom_plan * plan;
+    double f0 = NUM2DBL(rb_f0), f1 = NUM2DBL(rb_f1), rate = (double)length;
+    long count = NUM2LONG(rb_count);
+
+    if(count < 1)
+        rb_raise(rb_eArgError, "number of bins should be positive");
+    if(!NIL_P(options))
+        rb_get_kwargs(options, &id_sample_rate, 0, 1, &value);
+    if(value != Qundef && !NIL_P(value))
+    {
+        rate = NUM2DBL(value);
+        if(!(rate > 0.0))
+            rb_raise(rb_eArgError, "sample rate should be positive");
+    }
+
+    plan = zoom_plan_create(length, count, f0 / rate, count > 1 ? (f1 - f0) / rate / (double)(count - 1) : 0.0);
+    plan->rate = value != Qundef && !NIL_P(value) ? rate : 0.0;
+    return plan;
+}
+
+/**
+ * @brief Unbox complex data or real data (a flat Array of numbers).
+ * @author placek@ragnarson.com
+ * @param inArray A Ruby input data array.
+ * @param length Required length (0 for any).
+ * @param data Place for the real and imaginary parts (free data[0] only),
+ * NULL to only check the data.
+ * @return Length of data (0 for invalid data).
+ */
+static long zoom_from_ruby(VALUE inArray, long length, double ** data)
+{
+    long i, n;
+    VALUE * values;
+
+    Check_Type(inArray, T_ARRAY);
+    if(RARRAY_LEN(inArray) < 1)
+        return 0;
+    values = RARRAY_PTR(inArray);
+    if(TYPE(values[0]) == T_ARRAY)
+    {
+        if(!fourier_validate(inArray))
+            return 0;
+        n = RARRAY_LEN(values[0]);
+    }
+    else
+        n = RARRAY_LEN(inArray);
+    if(length && n != length)
+        return 0;
+    if(!data)
+        return n;
+
+    data[0] = malloc(2 * n * sizeof(double));
+    data[1] = data[0] + n;
+    if(TYPE(values[0]) == T_ARRAY)
+        for(i = 0; i < n; i++)
+        {
+            data[0][i] = NUM2DBL(RARRAY_PTR(values[0])[i]);
+            data[1][i] = NUM2DBL(RARRAY_PTR(values[1])[i]);
+        }
+    else
+        for(i = 0; i < n; i++)
+        {
+            data[0][i] = NUM2DBL(values[i]);
+            data[1][i] = 0.0;
+        }
+
+    return n;
+}
+
+/**
+ * @brief Compute a zoom FFT of data.
+ * data.zoom_fft(f0, f1, count, sample_rate: nil) gives the same values as
+ * data.dft_bins at count bins evenly spaced from f0 to f1 (both included).
+ * Data is complex like for fft or a flat array of real numbers.
+ * @see FT::ZoomFFT
+ * @author placek@ragnarson.com
+ * @params argc Number of arguments.
+ * @params argv Arguments (first and last frequency, number of bins and sample_rate: option).
+ * @params self A Ruby input data array.
+ * @return The output Ruby Array with real and imaginary parts of the bins
+ * (nil for invalid data).
+ */
+static VALUE zoom_fft(int argc, VALUE * argv, VALUE self)
+{
+    VALUE rb_f0, rb_f1, rb_count, options, outArray;
+    ft_zoom_plan * plan;
+    double * data[2], * out;
+    long length;
+
+    rb_scan_args(argc, argv, "3:", &rb_f0, &rb_f1, &rb_count, &options);
+    length = zoom_from_ruby(self, 0, NULL);
+    if(!length)
+        return Qnil;
+    plan = zoom_plan_from_ruby(length, rb_f0, rb_f1, rb_count, options);
+    zoom_from_ruby(self, length, data);
+
+    // do the actual transform
+    out = malloc(2 * plan->count * sizeof(double));
+    zoom_execute(plan, data[0], data[1], out, out + plan->count);
+    outArray = complex_to_ruby(out, out + plan->count, plan->count);
+
+    // no memory leaks
+    free(data[0]);
+    free(out);
+    zoom_plan_free(plan);
+
+    return outArray;
+}
+
+static void zoom_plan_type_free(void * ptr)
+{
+    zoom_plan_free(ptr);
+}
+
+static size_t zoom_plan_memsize(const void * ptr)
+{
+    const ft_zoom_plan * plan = ptr;
+
+    if(!plan)
+        return 0;
+    return sizeof(ft_zoom_plan) + 2 * (plan->length + plan->count + plan->padded) * sizeof(double);
+}
+
+static const rb_data_type_t zoom_plan_type = {
+    "FrequencyTransformations::ZoomFFT",
+    { NULL, zoom_plan_type_free, zoom_plan_memsize, },
+    NULL, NULL, RUBY_TYPED_FREE_IMMEDIATELY
+};
+
+static VALUE zoom_plan_alloc(VALUE klass)
+{
+    return TypedData_Wrap_Struct(klass, &zoom_plan_type, NULL);
+}
+
+static ft_zoom_plan * get_zoom_plan(VALUE self)
+{
+    ft_zoom_plan * plan;
+    TypedData_Get_Struct(self, ft_zoom_plan, &zoom_plan_type, plan);
+    if(!plan)
+        rb_raise(rb_eRuntimeError, "uninitialized zoom FFT");
+    return plan;
+}
+
+/**
+ * @brief Initialize a zoom FFT plan.
+ * ZoomFFT.new(length, f0, f1, count, sample_rate: nil) prepares the chirps
+ * of data.zoom_fft(f0, f1, count) for data of the given length.
+ * @author placek@ragnarson.com
+ * @params argc Number of arguments.
+ * @params argv Arguments (length, first and last frequency, number of bins and sample_rate: option).
+ * @params self A plan being initialized.
+ * @return The plan.
+ */
+static VALUE zoom_plan_initialize(int argc, VALUE * argv, VALUE self)
+{
+    VALUE rb_length, rb_f0, rb_f1, rb_count, options;
+    long length;
+
+    rb_scan_args(argc, argv, "4:", &rb_length, &rb_f0, &rb_f1, &rb_count, &options);
+    length = NUM2LONG(rb_length);
+    if(length < 1)
+        rb_raise(rb_eArgError, "length should be positive");
+    if(DATA_PTR(self))
+        rb_raise(rb_eRuntimeError, "zoom FFT already initialized");
+    DATA_PTR(self) = zoom_plan_from_ruby(length, rb_f0, rb_f1, rb_count, options);
+
+    return self;
+}
+
+/**
+ * @brief Execute a zoom FFT plan.
+ * @author placek@ragnarson.com
+ * @params self A plan.
+ * @params inArray A Ruby input data array (complex or real).
+ * @return The output Ruby Array with real and imaginary parts of the bins
+ * (nil if the data does not match the plan).
+ */
+static VALUE zoom_plan_execute(VALUE self, VALUE inArray)
+{
+    ft_zoom_plan * plan = get_zoom_plan(self);
+    double * data[2], * out;
+    VALUE outArray;
+
+    if(!zoom_from_ruby(inArray, plan->length, data))
+        return Qnil;
+
+    // do the actual transform
+    out = malloc(2 * plan->count * sizeof(double));
+    zoom_execute(plan, data[0], data[1], out, out + plan->count);
+    outArray = complex_to_ruby(out, out + plan->count, plan->count);
+
+    // no memory leaks
+    free(data[0]);
+    free(out);
+
+    return outArray;
+}
+
+/**
+ * @brief Execute a zoom FFT plan on a packed buffer.
+ * ZoomFFT#execute_buffer(input, output = nil, precision: :float64) reads
+ * interleaved complex values like FT.fft_buffer and writes the interleaved
+ * bins into the output String, reused when given.
+ * @author placek@ragnarson.com
+ * @params argc Number of arguments.
+ * @params argv Arguments (input, optional output String and precision: option).
+ * @params self A plan.
+ * @return The output String (nil if the data does not match the plan).
+ */
+static VALUE zoom_plan_execute_buffer(int argc, VALUE * argv, VALUE self)
+{
+    ft_zoom_plan * plan = get_zoom_plan(self);
+    VALUE input, output, options;
+    ft_buffer buffer;
+    double * data, * out;
+    float * single;
+    long k, n = plan->length, m = plan->count;
+    int precision;
+    size_t size;
+
+    rb_scan_args(argc, argv, "11:", &input, &output, &options);
+    precision = ft_precision(options);
+    size = precision == FT_FLOAT32 ? sizeof(float) : sizeof(double);
+    ft_buffer_open(input, &buffer, precision);
+    if(buffer.size != (long)(2 * n * size))
+    {
+        ft_buffer_close(&buffer);
+        return Qnil;
+    }
+    data = malloc(2 * (n + m) * sizeof(double));
+    out = data + 2 * n;
+    if(precision == FT_FLOAT32)
+    {
+        single = malloc(2 * n * sizeof(float));
+        ft_buffer_read_complex_single(&buffer, single, single + n, n);
+        for(k = 0; k < 2 * n; k++)
+            data[k] = single[k];
+        free(single);
+    }
+    else
+        ft_buffer_read_complex(&buffer, data, data + n, n);
+    ft_buffer_close(&buffer);
+
+    // do the actual transform
+    zoom_execute(plan, data, data + n, out, out + m);
+
+    output = ft_buffer_output(output, 2 * m * size);
+    if(precision == FT_FLOAT32)
+    {
+        single = malloc(2 * m * sizeof(float));
+        for(k = 0; k < 2 * m; k++)
+            single[k] = (float)out[k];
+        ft_buffer_write_complex_single(RSTRING_PTR(output), single, single + m, m);
+        free(single);
+    }
+    else
+        ft_buffer_write_complex(RSTRING_PTR(output), out, out + m, m);
+
+    // no memory leaks
+    free(data);
+
+    return output;
+}
+
+/**
+ * @brief Get the frequencies of the bins of a zoom FFT.
+ * @author placek@ragnarson.com
+ * @params self A plan.
+ * @return A Ruby Array with the frequencies (in the units of f0 and f1).
+ */
+static VALUE zoom_plan_frequencies(VALUE self)
+{
+    ft_zoom_plan * plan = get_zoom_plan(self);
+    double rate = plan->rate > 0.0 ? plan->rate : (double)plan->length;
+    long k;
+    VALUE outArray = rb_ary_new2(plan->count);
+
+    for(k = 0; k < plan->count; k++)
+        rb_ary_push(outArray, rb_float_new((plan->start + k * plan->step) * rate));
+
+    return outArray;
+}
+
+/**
+ * @brief Get the length of data of a zoom FFT.
+ * @author placek@ragnarson.com
+ * @params self A plan.
+ * @return The length of transformed data.
+ */
+static VALUE zoom_plan_length(VALUE self)
+{
+    return LONG2NUM(get_zoom_plan(self)->length);
+}
+
+/**
+ * @brief Get the number of bins of a zoom FFT.
+ * @author placek@ragnarson.com
+ * @params self A plan.
+ * @return The number of bins.
+ */
+static VALUE zoom_plan_count(VALUE self)
+{
+    return LONG2NUM(get_zoom_plan(self)->count);
+}
+
+/**
+ * @brief Define the zoom FFT method and the FrequencyTransformations::ZoomFFT class.
+ * @author placek@ragnarson.com
+ */
+void Init_zoom_fft(void)
+{
+    id_sample_rate = rb_intern("sample_rate");
+
+    rb_define_method(FT, "zoom_fft", zoom_fft, -1);
+
+    cZoomFFT = rb_define_class_under(FT, "ZoomFFT", rb_cObject);
+    rb_define_alloc_func(cZoomFFT, zoom_plan_alloc);
+    rb_define_method(cZoomFFT, "initialize", zoom_plan_initialize, -1);
+    rb_define_method(cZoomFFT, "execute", zoom_plan_execute, 1);
+    rb_define_method(cZoomFFT, "execute_buffer", zoom_plan_execute_buffer, -1);
+    rb_define_method(cZoomFFT, "frequencies", zoom_plan_frequencies, 0);
+    rb_define_method(cZoomFFT, "length", zoom_plan_length, 0);
+    rb_define_method(cZoomFFT, "count", zoom_plan_count, 0);
+}
@@ -0,0 +1,58 @@
+require 'plymouth'
+require Pathname.pwd.join('lib').join('ft.rb')
+
+describe FT do
+
+  before do
+    @tolerance = 1.0e-08
+  end
+
+  after do
+    FT.threads = nil
+  end
+
+  describe 'batch of transforms' do
+
+    it 'should give the same results as single transforms' do
+      FT.threads = 3
+      list = Array.new(7) do |m|
+        length = 2048 + 100 * m
+        [Array.new(length) { |n| Math.sin(n * 0.01 * (m + 1)) },
+         Array.new(length) { |n| Math.cos(n * 0.02) }]
+      end
+      FT.batch(:fft, list).zip(list).each do |result, data|
+        expected = data.fft
+        result.first.size.times do |n|
+          result.first[n].should be_within(@tolerance).of(expected.first[n])
+          result.last[n].should be_within(@tolerance).of(expected.last[n])
+        end
+      end
+    end
+
+    it 'should calculate Hartley transforms and return nil for invalid data' do
+      result = FT.batch(:dht, [[2.0, 1.0, 1.0, 2.0], [1.0, 2.0, 3.0]])
+      result.last.should be_nil
+      result.first[0].should be_within(@tolerance).of(3.0)
+      result.first[3].should be_within(@tolerance).of(1.0)
+    end
+
+    it 'should return nil for lists mixing other objects' do
+      FT.batch(:fft, [5]).should == [nil]
+      FT.batch(:fht, [5]).should == [nil]
+      FT.batch(:fft, [[1, 2]]).should == [nil]
+      result = FT.batch(:fft, [[[1.0], [2.0]], nil])
+      result.last.should be_nil
+      result.first[0][0].should be_within(@tolerance).of(1.0)
+      result.first[1][0].should be_within(@tolerance).of(2.0)
+    end
+
+    it 'should use the number of threads that was set' do
+      FT.threads = 2
+      FT.threads.should eq(2)
+      FT.threads = nil
+      (FT.threads >= 1).should eq(true)
+    end
+
+  end
+
+end
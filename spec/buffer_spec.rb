@@ -0,0 +1,158 @@
+require 'plymouth'
+require Pathname.pwd.join('lib').join('ft.rb')
+
+describe FT do
+
+  before do
+    @tolerance = 1.0e-08
+  end
+
+  describe 'transforms of packed buffers' do
+
+    it 'should calculate forward and reverse FFT properly' do
+      data = [2.0, 0.0, 1.0, 0.0, 1.0, 0.0, 2.0, 0.0].pack('E*')
+      result = FT.fft_buffer(data)
+      result.encoding.should eq(Encoding::BINARY)
+      expected = [6.0, 0.0, 1.0, 1.0, 0.0, 0.0, 1.0, -1.0]
+      result.unpack('E*').each_with_index do |value, n|
+        value.should be_within(@tolerance).of(expected[n])
+      end
+      FT.rfft_buffer(result).unpack('E*').each_with_index do |value, n|
+        value.should be_within(@tolerance).of(data.unpack('E*')[n])
+      end
+    end
+
+    it 'should reuse the output String' do
+      data = [[1.0, 2.0, 3.0, 4.0, 5.0, 6.0], [0.5, 0.0, 1.0, 0.0, 2.0, 1.0]]
+      expected = data.fft
+      plan = FT::Plan.new(6)
+      output = ''
+      plan.execute_buffer(data.transpose.flatten.pack('E*'), output).should equal(output)
+      output.unpack('E*').each_slice(2).each_with_index do |(real, imag), n|
+        real.should be_within(@tolerance).of(expected.first[n])
+        imag.should be_within(@tolerance).of(expected.last[n])
+      end
+    end
+
+    it 'should calculate FFT of real data properly' do
+      data = [2.0, 1.0, 1.0, 2.0]
+      result = FT.real_fft_buffer(data.pack('E*'))
+      expected = [6.0, 0.0, 1.0, 1.0, 0.0, 0.0]
+      result.unpack('E*').each_with_index do |value, n|
+        value.should be_within(@tolerance).of(expected[n])
+      end
+      FT.inverse_real_fft_buffer(result).unpack('E*').each_with_index do |value, n|
+        value.should be_within(@tolerance).of(data[n])
+      end
+    end
+
+    it 'should calculate FHT properly' do
+      result = FT.fht_buffer([2.0, 1.0, 1.0, 2.0].pack('E*')).unpack('E*')
+      result[0].should be_within(@tolerance).of(3.0)
+      result[1].should be_within(@tolerance).of(0.0)
+      result[2].should be_within(@tolerance).of(0.0)
+      result[3].should be_within(@tolerance).of(1.0)
+    end
+
+    it 'should calculate FFT and FHT of floats in single precision' do
+      data = [Array.new(256) { |n| Math.sin(n * 0.2) }, Array.new(256) { |n| Math.cos(n * 0.05) }]
+      expected = data.fft
+      result = FT.fft_buffer(data.transpose.flatten.pack('e*'), precision: :float32)
+      result.bytesize.should eq(256 * 8)
+      result.unpack('e*').each_slice(2).each_with_index do |(real, imag), n|
+        real.should be_within(1.0e-04).of(expected.first[n])
+        imag.should be_within(1.0e-04).of(expected.last[n])
+      end
+      FT.rfft_buffer(result, precision: :float32).unpack('e*').each_slice(2).each_with_index do |(real, imag), n|
+        real.should be_within(1.0e-05).of(data.first[n])
+        imag.should be_within(1.0e-05).of(data.last[n])
+      end
+      FT.fht_buffer([2.0, 1.0, 1.0, 2.0].pack('e*'), precision: :float32).unpack('e*').zip([3.0, 0.0, 0.0, 1.0]).each do |value, expected_value|
+        value.should be_within(1.0e-06).of(expected_value)
+      end
+    end
+
+    it 'should raise for an unknown precision' do
+      lambda { FT.fft_buffer([1.0, 0.0].pack('E*'), precision: :float16) }.should raise_error(ArgumentError)
+    end
+
+    it 'should return nil for uneven buffers' do
+      FT.fft_buffer('abc').should be_nil
+    end
+
+    it 'should calculate 2D FFT and FHT of buffers like arrays' do
+      real = Array.new(4) { |j| Array.new(6) { |i| Math.sin(i * 0.7 + j) } }
+      imag = Array.new(4) { |j| Array.new(6) { |i| Math.cos(i * 0.2 * j) } }
+      packed = real.flatten.zip(imag.flatten).flatten.pack('E*')
+      result = FT.fft2d_buffer(packed, 4)
+      result.unpack('E*').zip([real, imag].fft2d.map(&:flatten).transpose.flatten).each { |value, e| value.should be_within(@tolerance).of(e) }
+      FT.rfft2d_buffer(result, 4).unpack('E*').zip(packed.unpack('E*')).each { |value, e| value.should be_within(@tolerance).of(e) }
+      FT.fht2d_buffer(real.flatten.pack('E*'), 4).unpack('E*').zip(real.fht2d.flatten).each { |value, e| value.should be_within(@tolerance).of(e) }
+      FT.fft2d_buffer(packed, 5).should be_nil
+      FT.fht2d_buffer([1.0, 2.0, 3.0].pack('E*'), 1).should be_nil
+      lambda { FT.fft2d_buffer(packed, 0) }.should raise_error(ArgumentError)
+    end
+
+    it 'should calculate batches of FFTs with every instruction set' do
+      [[64, 37], [256, 9], [1, 3], [12, 20]].each do |length, count|
+        signals = Array.new(count) do |k|
+          [Array.new(length) { |n| Math.sin(n * 0.37 + k) }, Array.new(length) { |n| Math.cos(n * 0.11 * k) }]
+        end
+        input = signals.map { |data| data.transpose.flatten }.flatten.pack('E*')
+        FT.simd_available.each do |isa|
+          FT.simd = isa
+          result = FT.fft_batch_buffer(input, length).unpack('E*').each_slice(2 * length).to_a
+          result.length.should eq(count)
+          signals.each_with_index do |data, k|
+            data.fft.transpose.flatten.each_with_index { |value, n| result[k][n].should be_within(@tolerance).of(value) }
+          end
+          back = FT.rfft_batch_buffer(result.flatten.pack('E*'), length).unpack('E*')
+          back.each_with_index { |value, n| value.should be_within(@tolerance).of(input.unpack('E*')[n]) }
+        end
+        FT.simd = nil
+      end
+    end
+
+    it 'should calculate batches of FFTs of floats' do
+      signals = Array.new(21) { |k| [Array.new(128) { |n| Math.sin(n * 0.2 + k) }, Array.new(128) { |n| Math.cos(n * 0.05) }] }
+      input = signals.map { |data| data.transpose.flatten }.flatten.pack('e*')
+      output = ''
+      FT.fft_batch_buffer(input, 128, output, precision: :float32).should equal(output)
+      result = output.unpack('e*').each_slice(256).to_a
+      signals.each_with_index do |data, k|
+        data.fft.transpose.flatten.each_with_index { |value, n| result[k][n].should be_within(1.0e-04).of(value) }
+      end
+      odd = FT.fft_batch_buffer([1.0, 0.0, 2.0, 0.0, 3.0, 0.0].pack('e*'), 3, precision: :float32).unpack('e*')
+      odd.zip([6.0, 0.0, -1.5, Math.sqrt(0.75), -1.5, -Math.sqrt(0.75)]).each { |value, e| value.should be_within(1.0e-06).of(e) }
+    end
+
+    it 'should reject batches that are not whole transforms' do
+      FT.fft_batch_buffer([1.0, 0.0, 2.0, 0.0, 3.0, 0.0].pack('E*'), 2).should be_nil
+      FT.fft_batch_buffer('', 2).should be_nil
+      lambda { FT.fft_batch_buffer([1.0, 0.0].pack('E*'), 0) }.should raise_error(ArgumentError)
+    end
+
+    it 'should lock the Strings of a batch while it runs' do
+      3.times do
+        input = ([0.5, 0.0] * 64 * 16384).pack('E*')
+        thread = Thread.new { FT.fft_batch_buffer(input, 64) }
+        sleep 0.002
+        begin
+          input.replace('x' * 10)
+        rescue RuntimeError
+        end
+        result = thread.value
+        if result
+          result.bytesize.should == 64 * 16384 * 16
+          result.unpack('E2').should == [32.0, 0.0]
+        end
+      end
+      data = [1.0, 0.0, 2.0, 0.0].pack('E*')
+      FT.fft_batch_buffer(data, 2, data).should equal(data)
+      data.unpack('E*').should == [3.0, 0.0, -1.0, 0.0]
+      data.replace('')
+    end
+
+  end
+
+end
@@ -0,0 +1,76 @@
+require 'plymouth'
+require Pathname.pwd.join('lib').join('ft.rb')
+
+describe FT::ComplexVector do
+
+  before do
+    @tolerance = 1.0e-08
+    @data = [Array.new(12) { |n| Math.sin(n * 0.37) + 0.1 * n }, Array.new(12) { |n| Math.cos(n * 0.11) }]
+  end
+
+  def compare(result, expected)
+    result.flatten.zip(expected.flatten).each { |value, e| value.should be_within(@tolerance).of(e) }
+  end
+
+  describe 'complex data in C memory' do
+
+    it 'should convert from and into arrays' do
+      vector = @data.to_complex_vector
+      vector.shape.should eq([12])
+      vector.size.should eq(12)
+      vector.to_a.should eq(@data)
+      vector.real.should eq(@data.first)
+      vector.imag.should eq(@data.last)
+      vector[1].should eq(Complex(@data.first[1], @data.last[1]))
+      vector[-1].should eq(Complex(@data.first[11], @data.last[11]))
+      vector[12].should be_nil
+      FT::ComplexVector.new([Complex(1, 2), 3.0]).to_complex.should eq([Complex(1.0, 2.0), Complex(3.0, 0.0)])
+      FT::ComplexVector.zeros(2, 3).to_a.should eq([[[0.0] * 3] * 2, [[0.0] * 3] * 2])
+      buffer = vector.to_buffer
+      FT::ComplexVector.from_buffer(buffer).to_a.should eq(@data)
+      FT::ComplexVector.from_buffer(buffer, [3, 4]).shape.should eq([3, 4])
+      [[1.0, 2.0], [1.0]].to_complex_vector.should be_nil
+    end
+
+    it 'should calculate FFT, FHT and their inverses like the Array methods' do
+      vector = @data.to_complex_vector
+      compare(vector.fft.to_a, @data.fft)
+      compare(vector.fft.ifft.to_a, @data)
+      compare(FT::ComplexVector.new(@data.first).fht.real, @data.first.fht)
+      compare(vector.fht.fht.to_a, @data)
+      vector.to_a.should eq(@data)
+      vector.fft!.should equal(vector)
+      compare(vector.to_a, @data.fft)
+    end
+
+    it 'should calculate 2D transforms' do
+      data = [[[1.0, 2.0, 3.0], [4.0, 5.0, 6.0]], [[0.5, 0.0, 1.0], [0.0, 2.0, 1.0]]]
+      vector = data.to_complex_vector
+      vector.shape.should eq([2, 3])
+      compare(vector.fft.to_a, data.fftnd)
+      compare(vector.fft.fftshift.to_a, data.fftnd(shift: true))
+      compare(vector.fft.fftshift.ifftshift!.to_a, data.fftnd)
+      compare(vector.fht.real, data.first.fhtnd)
+    end
+
+    it 'should multiply, conjugate and scale' do
+      vector = @data.to_complex_vector
+      spectrum = vector.fft
+      power = (spectrum * spectrum.conj).real
+      compare(power, @data.fft.magnitude.map { |m| m * m })
+      compare(spectrum.magnitude.real, @data.fft.magnitude)
+      compare(spectrum.phase.real, @data.fft.transpose.map { |real, imag| Math.atan2(imag, real) })
+      compare((vector * 2.0).to_a, @data.map { |part| part.map { |v| 2.0 * v } })
+      compare((vector * Complex(0, 1)).to_a, [@data.last.map { |v| -v }, @data.first])
+      compare(vector.dup.scale!(0.5).conj!.to_a, [@data.first.map { |v| 0.5 * v }, @data.last.map { |v| -0.5 * v }])
+      vector.to_a.should eq(@data)
+      lambda { vector * FT::ComplexVector.zeros(3) }.should raise_error(ArgumentError)
+    end
+
+    it 'should reject invalid data' do
+      lambda { FT::ComplexVector.new([]) }.should raise_error(ArgumentError)
+      lambda { FT::ComplexVector.new([1.0, 2.0], [1.0]) }.should raise_error(ArgumentError)
+      lambda { FT::ComplexVector.from_buffer([1.0, 0.0].pack('E*'), [2]) }.should raise_error(ArgumentError)
+    end
+  end
+end
@@ -0,0 +1,70 @@
+require 'plymouth'
+require Pathname.pwd.join('lib').join('ft.rb')
+
+describe Array do
+
+  before do
+    @tolerance = 1.0e-08
+  end
+
+  def direct_convolution(data, kernel)
+    (0...(data.length + kernel.length - 1)).map do |n|
+      kernel.each_with_index.inject(0.0) do |sum, (h, k)|
+        n - k >= 0 && n - k < data.length ? sum + h * data[n - k] : sum
+      end
+    end
+  end
+
+  describe 'convolution' do
+
+    it 'should convolve with short and long kernels' do
+      data = (0...300).map { |i| Math.sin(i * 0.21) + (i % 7) * 0.1 }
+      [[1.0, -2.0, 0.5], (0...50).map { |k| Math.cos(k * 0.3) / (k + 1) }].each do |kernel|
+        expected = direct_convolution(data, kernel)
+        result = data.convolve(kernel)
+        result.length.should == expected.length
+        expected.each_with_index { |value, n| result[n].should be_within(@tolerance).of(value) }
+        result = kernel.convolve(data)
+        expected.each_with_index { |value, n| result[n].should be_within(@tolerance).of(value) }
+      end
+    end
+
+    it 'should correlate' do
+      data = [1.0, 2.0, 3.0, 4.0]
+      result = data.correlate([1.0, 1.0])
+      [1.0, 3.0, 5.0, 7.0, 4.0].each_with_index { |value, n| result[n].should be_within(@tolerance).of(value) }
+    end
+
+  end
+
+  describe 'streaming convolution' do
+
+    it 'should give the full convolution in chunks' do
+      data = (0...2000).map { |i| Math.sin(i * 0.05) * ((i % 13) - 6) }
+      kernel = (0...100).map { |k| Math.exp(-k * 0.05) }
+      expected = direct_convolution(data, kernel)
+      convolver = FT::Convolver.new(kernel)
+      result = []
+      data.each_slice(333) { |chunk| result.concat(convolver.push(chunk)) }
+      result.concat(convolver.flush)
+      result.length.should == expected.length
+      expected.each_with_index { |value, n| result[n].should be_within(1.0e-06).of(value) }
+      convolver.push([1.0]).length.should == 0
+      convolver.flush.length.should == kernel.length
+    end
+
+    it 'should keep the stream whole when threads push at once' do
+      kernel = (0...100).map { |k| Math.exp(-k * 0.05) }
+      total = kernel.inject(:+)
+      3.times do
+        convolver = FT::Convolver.new(kernel)
+        outputs = (0...4).map { Thread.new { (0...5).map { convolver.push([1.0] * 20000) }.flatten } }.map(&:value).flatten
+        outputs.concat(convolver.flush)
+        outputs.length.should == 400000 + kernel.length - 1
+        outputs.count { |value| (value - total).abs < 1.0e-06 }.should == 400000 - kernel.length + 1
+      end
+    end
+
+  end
+
+end
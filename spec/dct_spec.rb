@@ -0,0 +1,95 @@
+require 'plymouth'
+require Pathname.pwd.join('lib').join('ft.rb')
+
+describe FT do
+
+  before do
+    @tolerance = 1.0e-08
+  end
+
+  # orthonormal DCT/DST matrix element (row k, column n)
+  def element(type, sine, k, n, length)
+    k, n = n, k if type == 3
+    full = Math.sqrt(2.0 / length)
+    half = Math.sqrt(1.0 / length)
+    if type == 4
+      arg = Math::PI * (2 * n + 1) * (2 * k + 1) / (4.0 * length)
+      return full * (sine ? Math.sin(arg) : Math.cos(arg))
+    end
+    return (k == length - 1 ? half : full) * Math.sin(Math::PI * (k + 1) * (2 * n + 1) / (2.0 * length)) if sine
+    (k == 0 ? half : full) * Math.cos(Math::PI * k * (2 * n + 1) / (2.0 * length))
+  end
+
+  def reference(values, type, sine)
+    (0...values.length).map { |k| (0...values.length).inject(0.0) { |sum, n| sum + element(type, sine, k, n, values.length) * values[n] } }
+  end
+
+  describe 'DCT and DST' do
+
+    it 'should calculate DCT and DST of types II, III and IV like their definitions' do
+      [1, 2, 7, 8, 16, 17, 30, 33, 64].each do |length|
+        values = (0...length).map { |i| Math.sin(i * 0.9) + 0.05 * i }
+        [2, 3, 4].each do |type|
+          [values.dct(type: type), reference(values, type, false)].transpose.each { |a, b| a.should be_within(@tolerance).of(b) }
+          [values.dst(type: type), reference(values, type, true)].transpose.each { |a, b| a.should be_within(@tolerance).of(b) }
+        end
+      end
+    end
+
+    it 'should invert the transforms' do
+      [5, 8, 40, 45].each do |length|
+        values = (0...length).map { |i| Math.cos(i * 1.7) * i }
+        [2, 3, 4].each do |type|
+          [values.dct(type: type).idct(type: type), values].transpose.each { |a, b| a.should be_within(@tolerance).of(b) }
+          [values.dst(type: type).idst(type: type), values].transpose.each { |a, b| a.should be_within(@tolerance).of(b) }
+        end
+      end
+      values = [1.0, 2.0, 3.0, 4.0]
+      values.idct.should == values.dct(type: 3)
+    end
+
+    it 'should calculate DCT and DST for 2D data as transforms of rows and columns' do
+      matrix = (0...18).map { |j| (0...20).map { |i| Math.sin(i * 0.3 + j * 0.7) } }
+      [[matrix.dct2d, matrix.map(&:dct).transpose.map(&:dct).transpose],
+       [matrix.dst2d(type: 4), matrix.map { |row| row.dst(type: 4) }.transpose.map { |column| column.dst(type: 4) }.transpose],
+       [matrix.dct2d.idct2d, matrix],
+       [matrix.dst2d.idst2d, matrix]].each do |result, expected|
+        result.length.should == 18
+        result.flatten.zip(expected.flatten).each { |a, b| a.should be_within(@tolerance).of(b) }
+      end
+    end
+
+    it 'should transform 8x8 tiles on their own in block mode' do
+      image = (0...16).map { |j| (0...24).map { |i| ((i * 7 + j * 3) % 11) * 10.0 } }
+      blocks = image.dct2d(block: 8)
+      [0, 8].each do |j|
+        [0, 8, 16].each do |i|
+          tile = image[j, 8].map { |row| row[i, 8] }.dct2d
+          blocks[j, 8].map { |row| row[i, 8] }.flatten.zip(tile.flatten).each { |a, b| a.should be_within(@tolerance).of(b) }
+        end
+      end
+      blocks.idct2d(block: 8).flatten.zip(image.flatten).each { |a, b| a.should be_within(@tolerance).of(b) }
+      image.dct2d(block: 5).should be_nil
+    end
+
+    it 'should transform buffers of 2D data' do
+      image = (0...16).map { |j| (0...8).map { |i| Math.cos(i + j * 0.5) } }
+      expected = image.dct2d(block: 8).flatten
+      output = FT.dct2d_buffer(image.flatten.pack('E*'), 16, block: 8)
+      output.unpack('E*').zip(expected).each { |a, b| a.should be_within(@tolerance).of(b) }
+      FT.idct2d_buffer(output, 16, block: 8).unpack('E*').zip(image.flatten).each { |a, b| a.should be_within(@tolerance).of(b) }
+      FT.dct2d_buffer(image.flatten.pack('e*'), 16, precision: :float32).unpack('e*').zip(image.dct2d.flatten).each { |a, b| a.should be_within(1.0e-05).of(b) }
+      FT.dct2d_buffer([1.0, 2.0, 3.0].pack('E*'), 2).should be_nil
+    end
+
+    it 'should return nil for invalid data and reject bad options' do
+      [].dct.should be_nil
+      [[1.0, 2.0], [3.0]].dct2d.should be_nil
+      lambda { [1.0, 2.0].dct(type: 1) }.should raise_error(ArgumentError)
+      lambda { [1.0, 2.0].dct(block: 8) }.should raise_error(ArgumentError)
+      lambda { [[1.0, 2.0]].dct2d(block: 0) }.should raise_error(ArgumentError)
+    end
+
+  end
+
+end
@@ -37,6 +37,76 @@ describe Array do
       result.last[3].should be_within(@tolerance).of(0.0)
     end
 
+    it 'should calculate FFT properly for lengths other than powers of 2' do
+      [3, 6, 12, 35, 11, 26].each do |length|
+        data = [Array.new(length) { |n| Math.sin(n * 0.4) + n % 3 },
+                Array.new(length) { |n| Math.cos(n * 0.9) }]
+        expected = data.dft
+        result = data.fft
+        length.times do |n|
+          result.first[n].should be_within(@tolerance).of(expected.first[n])
+          result.last[n].should be_within(@tolerance).of(expected.last[n])
+        end
+        result = result.rfft
+        length.times do |n|
+          result.first[n].should be_within(@tolerance).of(data.first[n])
+          result.last[n].should be_within(@tolerance).of(data.last[n])
+        end
+      end
+    end
+
+    it 'should calculate short FFTs with the unrolled codelets like the DFT' do
+      [2, 4, 8, 16, 32, 64, 128].each do |length|
+        data = [Array.new(length) { |n| Math.sin(n * 0.4) + n % 3 },
+                Array.new(length) { |n| Math.cos(n * 0.9) }]
+        expected = data.dft
+        [data.fft, FT::Plan.new(length).execute(data), FT.batch(:fft, [data]).first].each do |result|
+          length.times do |n|
+            result.first[n].should be_within(@tolerance).of(expected.first[n])
+            result.last[n].should be_within(@tolerance).of(expected.last[n])
+          end
+        end
+        [data.fft.rfft, FT::Plan.new(length, :reverse).execute(data.fft)].each do |result|
+          length.times do |n|
+            result.first[n].should be_within(@tolerance).of(data.first[n])
+            result.last[n].should be_within(@tolerance).of(data.last[n])
+          end
+        end
+      end
+    end
+
+  end
+
+  describe 'Fast Fourier Transform of real data' do
+
+    it 'should calculate half of the spectrum properly' do
+      data = [2.0, 1.0, 1.0, 2.0]
+      result = data.real_fft
+      result.first.size.should eq(3)
+      result.first[0].should be_within(@tolerance).of(6.0)
+      result.first[1].should be_within(@tolerance).of(1.0)
+      result.first[2].should be_within(@tolerance).of(0.0)
+      result.last[0].should be_within(@tolerance).of(0.0)
+      result.last[1].should be_within(@tolerance).of(1.0)
+      result.last[2].should be_within(@tolerance).of(0.0)
+    end
+
+    it 'should match complex FFT and reverse it for even and odd lengths' do
+      [16, 12, 9].each do |length|
+        data = Array.new(length) { |n| Math.sin(n * 0.6) + n % 4 }
+        expected = [data, [0.0] * length].fft
+        result = data.real_fft
+        (length / 2 + 1).times do |n|
+          result.first[n].should be_within(@tolerance).of(expected.first[n])
+          result.last[n].should be_within(@tolerance).of(expected.last[n])
+        end
+        result = result.inverse_real_fft(length)
+        length.times do |n|
+          result[n].should be_within(@tolerance).of(data[n])
+        end
+      end
+    end
+
   end
 
   describe 'Descreete Fourier Transform' do
@@ -71,8 +141,36 @@ describe Array do
 
   end
 
+  describe 'Selected bins of Descreete Fourier Transform' do
+
+    it 'should match DFT at the given bins for any length' do
+      [8, 12, 13].each do |n|
+        data = [(0...n).map { |i| Math.cos(i * 0.9) + i * 0.05 },
+                (0...n).map { |i| Math.sin(i * 0.3) }]
+        expected = data.dft
+        bins = [0, 1, 3, n - 1]
+        result = data.dft_bins(bins)
+        bins.each_with_index do |bin, k|
+          result.first[k].should be_within(@tolerance).of(expected.first[bin])
+          result.last[k].should be_within(@tolerance).of(expected.last[bin])
+        end
+      end
+    end
+
+    it 'should return nil for invalid data' do
+      [[1.0, 2.0], [1.0]].dft_bins([0]).should be_nil
+    end
+
+  end
+
   describe 'two dimensional Fast Fourier Transform' do
 
+    it 'should return nil for matrices without columns' do
+      [[[]], [[]]].fft2d.should be_nil
+      [[], []].fht2d.should be_nil
+      [[], []].rfft2d.should be_nil
+    end
+
     it 'should calculate FFT2D properly' do
       data = [[[1.0, 1.0, 1.0, 1.0],
                [1.0, 2.0, 2.0, 1.0],
@@ -161,6 +259,26 @@ describe Array do
       result.last[3][3].should be_within(@tolerance).of(0.0)
     end
 
+    it 'should calculate FFT2D properly for non-square data' do
+      real = [[1.0, 2.0, 0.0, 1.0, 3.0, 0.0, 1.0, 2.0],
+              [0.0, 1.0, 1.0, 2.0, 0.0, 1.0, 0.0, 1.0]]
+      imag = [[0.0, 1.0, 0.0, 0.0, 2.0, 0.0, 1.0, 0.0],
+              [1.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 1.0]]
+      result = [real, imag].fft2d
+      2.times do |k|
+        8.times do |l|
+          sum = Complex(0.0, 0.0)
+          2.times do |m|
+            8.times do |n|
+              arg = -2.0 * Math::PI * (k * m / 2.0 + l * n / 8.0)
+              sum += Complex(real[m][n], imag[m][n]) * Complex(Math.cos(arg), Math.sin(arg))
+            end
+          end
+          result.first[k][l].should be_within(@tolerance).of(sum.real)
+          result.last[k][l].should be_within(@tolerance).of(sum.imag)
+        end
+      end
+    end
   end
 
   describe 'two dimensional Descreete Fourier Transform' do
@@ -9,6 +9,43 @@ describe Array do
 
   describe 'Discrete Hartley Transform' do
 
+    def hartley(data)
+      n = data.length
+      (0...n).map do |k|
+        data.each_with_index.inject(0.0) do |sum, (x, i)|
+          arg = 2.0 * Math::PI * i * k / n
+          sum + x * (Math.cos(arg) + Math.sin(arg))
+        end / Math.sqrt(n)
+      end
+    end
+
+    it 'should calculate FHT and DHT of any even length' do
+      [8, 16, 12, 18].each do |n|
+        data = (0...n).map { |i| Math.sin(i * 0.7) + i * 0.1 }
+        expected = hartley(data)
+        [data.fht, data.dht].each do |result|
+          expected.each_with_index { |value, k| result[k].should be_within(@tolerance).of(value) }
+        end
+      end
+    end
+
+    it 'should calculate short FHTs with the unrolled codelets like the DHT' do
+      [2, 4, 32, 64, 128].each do |n|
+        data = (0...n).map { |i| Math.sin(i * 0.7) + i * 0.1 }
+        expected = hartley(data)
+        [data.fht, data.dht, FT.fht_buffer(data.pack('E*')).unpack('E*')].each do |result|
+          expected.each_with_index { |value, k| result[k].should be_within(@tolerance).of(value) }
+        end
+        data.fht.rfht.each_with_index { |value, i| value.should be_within(@tolerance).of(data[i]) }
+      end
+    end
+
+    it 'should invert FHT and DHT with rfht and rdht' do
+      data = [1.0, 3.0, -2.0, 0.5, 4.0, 2.0, -1.0, 0.0, 1.5, 2.5]
+      data.fht.rfht.each_with_index { |value, i| value.should be_within(@tolerance).of(data[i]) }
+      data.dht.rdht.each_with_index { |value, i| value.should be_within(@tolerance).of(data[i]) }
+    end
+
     it 'should calculate DHT properly' do
       data = [2.0, 1.0, 1.0, 2.0]
       result = data.dht
@@ -0,0 +1,120 @@
+require 'plymouth'
+require 'tmpdir'
+require 'stringio'
+require Pathname.pwd.join('lib').join('ft.rb')
+
+describe FT do
+
+  before do
+    @tolerance = 1.0e-08
+    @dir = Dir.mktmpdir
+    @input = File.join(@dir, 'input.bin')
+    @output = File.join(@dir, 'output.bin')
+  end
+
+  after do
+    FileUtils.remove_entry(@dir)
+  end
+
+  def signal(n)
+    [Array.new(n) { |i| Math.sin(i * 0.37) + 0.01 * i }, Array.new(n) { |i| Math.cos(i * 1.3) }]
+  end
+
+  def read_interleaved(path, format = 'E*')
+    values = File.binread(path).unpack(format)
+    [values.each_slice(2).map(&:first), values.each_slice(2).map(&:last)]
+  end
+
+  def warnings
+    stderr = $stderr
+    $stderr = StringIO.new
+    yield
+    $stderr.string
+  ensure
+    $stderr = stderr
+  end
+
+  def compare(result, expected, tolerance)
+    2.times do |p|
+      expected[p].each_with_index { |value, n| result[p][n].should be_within(tolerance).of(value) }
+    end
+  end
+
+  describe 'transforms of memory-mapped files' do
+
+    it 'should calculate FFT of a file in memory and reverse it' do
+      data = signal(12)
+      File.binwrite(@input, data.transpose.flatten.pack('E*'))
+      FT.fft_file(@input, @output).should eq(12)
+      compare(read_interleaved(@output), data.fft, @tolerance)
+      back = File.join(@dir, 'back.bin')
+      FT.rfft_file(@output, back)
+      compare(read_interleaved(back), data, @tolerance)
+    end
+
+    it 'should calculate FFT out of core with a small memory budget' do
+      [[1024, 1], [3000, 3], [2 * 2 * 3 * 7 * 11, nil]].each do |n, threads|
+        FT.threads = threads
+        data = signal(n)
+        File.binwrite(@input, data.transpose.flatten.pack('E*'))
+        FT.fft_file(@input, @output, memory: 2048).should eq(n)
+        compare(read_interleaved(@output), data.fft, 1.0e-07)
+        back = File.join(@dir, 'back.bin')
+        FT.rfft_file(@output, back, memory: 2048)
+        compare(read_interleaved(back), data, @tolerance)
+      end
+      FT.threads = nil
+    end
+
+    it 'should transform prime lengths in memory whatever the budget' do
+      data = signal(101)
+      File.binwrite(@input, data.transpose.flatten.pack('E*'))
+      warnings { FT.fft_file(@input, @output, memory: 64) }.should include('transformed in memory')
+      compare(read_interleaved(@output), data.fft, @tolerance)
+    end
+
+    it 'should warn about lengths whose rows do not fit in the budget' do
+      [[2 * 1009, true], [1024, false]].each do |n, warned|
+        data = signal(n)
+        File.binwrite(@input, data.transpose.flatten.pack('E*'))
+        text = warnings { FT.fft_file(@input, @output, memory: 2048).should eq(n) }
+        text.include?("no split of #{n} points fits in 2048 bytes").should == warned
+        compare(read_interleaved(@output), data.fft, 1.0e-07)
+      end
+      File.binwrite(@input, [2.0, 1.0].pack('E*'))
+      warnings { FT.fft_file(@input, @output, memory: 1).should eq(1) }.should == ''
+      read_interleaved(@output).should == [[2.0], [1.0]]
+    end
+
+    it 'should read and write split complex data' do
+      data = signal(256)
+      File.binwrite(@input, data.flatten.pack('E*'))
+      FT.fft_file(@input, @output, layout: :split, memory: 1024)
+      values = File.binread(@output).unpack('E*')
+      compare([values[0, 256], values[256, 256]], data.fft, 1.0e-07)
+    end
+
+    it 'should read and write floats' do
+      data = signal(512)
+      File.binwrite(@input, data.transpose.flatten.pack('e*'))
+      FT.fft_file(@input, @output, precision: :float32, memory: 4096)
+      File.size(@output).should eq(512 * 8)
+      compare(read_interleaved(@output, 'e*'), data.fft, 1.0e-03)
+    end
+
+    it 'should return nil for empty or uneven files' do
+      File.binwrite(@input, '')
+      FT.fft_file(@input, @output).should be_nil
+      File.binwrite(@input, [1.0, 2.0, 3.0].pack('E*'))
+      FT.fft_file(@input, @output).should be_nil
+    end
+
+    it 'should reject invalid arguments' do
+      File.binwrite(@input, [1.0, 2.0].pack('E*'))
+      lambda { FT.fft_file(@input, @input) }.should raise_error(ArgumentError)
+      lambda { FT.fft_file(@input, @output, layout: :planar) }.should raise_error(ArgumentError)
+      lambda { FT.fft_file(@input, @output, memory: 0) }.should raise_error(ArgumentError)
+      lambda { FT.fft_file(File.join(@dir, 'missing.bin'), @output) }.should raise_error(SystemCallError)
+    end
+  end
+end
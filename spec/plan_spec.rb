@@ -0,0 +1,100 @@
+require 'plymouth'
+require Pathname.pwd.join('lib').join('ft.rb')
+
+describe FT::Plan do
+
+  before do
+    @tolerance = 1.0e-08
+  end
+
+  describe 'FFT plan' do
+
+    it 'should calculate forward FFT properly' do
+      data = [[2.0, 1.0, 1.0, 2.0],
+              [0.0, 0.0, 0.0, 0.0]]
+      plan = FT::Plan.new(4, :forward)
+      2.times do
+        result = plan.execute(data)
+        result.first[0].should be_within(@tolerance).of(6.0)
+        result.first[1].should be_within(@tolerance).of(1.0)
+        result.first[2].should be_within(@tolerance).of(0.0)
+        result.first[3].should be_within(@tolerance).of(1.0)
+        result.last[0].should be_within(@tolerance).of(0.0)
+        result.last[1].should be_within(@tolerance).of(1.0)
+        result.last[2].should be_within(@tolerance).of(0.0)
+        result.last[3].should be_within(@tolerance).of(-1.0)
+      end
+    end
+
+    it 'should calculate reverse FFT properly' do
+      data = [[6.0, 1.0, 0.0, 1.0],
+              [0.0, 1.0, 0.0, -1.0]]
+      result = FT::Plan.new(4, :reverse).execute(data)
+      result.first[0].should be_within(@tolerance).of(2.0)
+      result.first[1].should be_within(@tolerance).of(1.0)
+      result.first[2].should be_within(@tolerance).of(1.0)
+      result.first[3].should be_within(@tolerance).of(2.0)
+      result.last[0].should be_within(@tolerance).of(0.0)
+      result.last[1].should be_within(@tolerance).of(0.0)
+      result.last[2].should be_within(@tolerance).of(0.0)
+      result.last[3].should be_within(@tolerance).of(0.0)
+    end
+
+    it 'should give the same result as FFT for longer data' do
+      data = [Array.new(64) { |n| Math.sin(n * 0.3) + n % 5 },
+              Array.new(64) { |n| Math.cos(n * 0.7) }]
+      expected = data.fft
+      result = FT::Plan.new(64).execute(data)
+      64.times do |n|
+        result.first[n].should be_within(@tolerance).of(expected.first[n])
+        result.last[n].should be_within(@tolerance).of(expected.last[n])
+      end
+    end
+
+    it 'should calculate FFT of data that does not fit in the cache properly' do
+      length = 1 << 22
+      tone = Array.new(length) { |n| Math.cos(2 * Math::PI * 5 * n / length) }
+      input = tone.zip(Array.new(length, 0.0)).flatten.pack('E*')
+      output = FT::Plan.new(length).execute_buffer(input).unpack('E*')
+      [0, 5, 6, length - 5, length / 2].each do |k|
+        expected = (k == 5 || k == length - 5) ? length / 2.0 : 0.0
+        output[2 * k].should be_within(1.0e-06).of(expected)
+        output[2 * k + 1].should be_within(1.0e-06).of(0.0)
+      end
+      values = input.unpack('E*')
+      inverse = FT::Plan.new(length, :reverse).execute_buffer(FT::Plan.new(length).execute_buffer(input)).unpack('E*')
+      (0...2 * length).step(4099) do |n|
+        inverse[n].should be_within(@tolerance).of(values[n])
+      end
+    end
+
+    it 'should calculate FFT in single precision' do
+      data = [Array.new(64) { |n| Math.sin(n * 0.3) + n % 5 },
+              Array.new(64) { |n| Math.cos(n * 0.7) }]
+      expected = data.fft
+      plan = FT::Plan.new(64, :forward, precision: :float32)
+      plan.precision.should == :float32
+      result = plan.execute(data)
+      64.times do |n|
+        result.first[n].should be_within(1.0e-04).of(expected.first[n])
+        result.last[n].should be_within(1.0e-04).of(expected.last[n])
+      end
+      plan.execute_buffer(data.transpose.flatten.pack('e*')).unpack('e*').each_slice(2).each_with_index do |(real, imag), n|
+        real.should be_within(1.0e-04).of(expected.first[n])
+        imag.should be_within(1.0e-04).of(expected.last[n])
+      end
+    end
+
+    it 'should return nil for data of other length' do
+      FT::Plan.new(8).execute([[1.0, 2.0], [0.0, 0.0]]).should be_nil
+    end
+
+    it 'should reject data which is not an array of two arrays' do
+      lambda { FT::Plan.new(8).execute(5) }.should raise_error(TypeError)
+      FT::Plan.new(2).execute([[1.0, 2.0], 5]).should be_nil
+      FT::Plan.new(2).execute([5, [1.0, 2.0]]).should be_nil
+    end
+
+  end
+
+end
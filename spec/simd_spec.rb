@@ -0,0 +1,48 @@
+require 'plymouth'
+require Pathname.pwd.join('lib').join('ft.rb')
+
+describe FT do
+
+  before do
+    @tolerance = 1.0e-08
+  end
+
+  after do
+    FT.simd = nil
+  end
+
+  describe 'instruction sets' do
+
+    it 'should always offer the scalar passes' do
+      FT.simd_available.first.should == :scalar
+      FT.simd_available.should include(FT.simd)
+    end
+
+    it 'should give the same results as the scalar passes' do
+      [1, 2, 4, 8, 16, 32, 64, 128, 1024, 4096, 12, 2000].each do |length|
+        data = [Array.new(length) { |n| Math.sin(n * 0.37) + 0.1 * n },
+                Array.new(length) { |n| Math.cos(n * 0.11) }]
+        FT.simd = :scalar
+        expected = data.fft
+        FT.simd_available.each do |isa|
+          FT.simd = isa
+          result = data.fft
+          length.times do |n|
+            result.first[n].should be_within(@tolerance).of(expected.first[n])
+            result.last[n].should be_within(@tolerance).of(expected.last[n])
+          end
+          inverse = result.rfft
+          length.times do |n|
+            inverse.first[n].should be_within(@tolerance).of(data.first[n])
+          end
+        end
+      end
+    end
+
+    it 'should raise for an unknown instruction set' do
+      lambda { FT.simd = :unknown }.should raise_error(ArgumentError)
+    end
+
+  end
+
+end
@@ -0,0 +1,72 @@
+require 'plymouth'
+require Pathname.pwd.join('lib').join('ft.rb')
+
+describe FT::SlidingDFT do
+
+  before do
+    @tolerance = 1.0e-08
+  end
+
+  describe 'sliding DFT' do
+
+    it 'should track the half spectrum of the last window of samples' do
+      samples = (0...200).map { |i| Math.sin(i * 0.37) + 0.01 * i }
+      sdft = FT::SlidingDFT.new(samples[0, 16])
+      sdft.bins.should == (0..8).to_a
+      sdft.push(samples[16, 7])
+      spectra = []
+      sdft.push(samples[23..-1]) { |spectrum| spectra << spectrum }
+      spectra.length.should == 200 - 23
+      spectra.each_with_index do |spectrum, s|
+        expected = samples[s + 8, 16].real_fft
+        9.times do |k|
+          spectrum.first[k].should be_within(@tolerance).of(expected.first[k])
+          spectrum.last[k].should be_within(@tolerance).of(expected.last[k])
+        end
+      end
+      sdft.window.should == samples[-16..-1]
+    end
+
+    it 'should track chosen bins of both halves of the spectrum' do
+      samples = (0...60).map { |i| Math.cos(i * 1.1) * (i % 3) }
+      sdft = FT::SlidingDFT.new(10, bins: [7, 1, 5])
+      spectrum = sdft.push(samples)
+      expected = [samples[-10..-1], [0.0] * 10].fft
+      [7, 1, 5].each_with_index do |k, i|
+        spectrum.first[i].should be_within(@tolerance).of(expected.first[k])
+        spectrum.last[i].should be_within(@tolerance).of(expected.last[k])
+        sdft.magnitude[i].should be_within(@tolerance).of(Math.hypot(expected.first[k], expected.last[k]))
+      end
+      sdft << 2.0
+      sdft.window.last.should == 2.0
+    end
+
+    it 'should re-anchor the bins to bound the drift' do
+      samples = (0...20050).map { |i| Math.sin(i * 0.011) * 1000.0 + (i % 7) }
+      anchored = FT::SlidingDFT.new(64, reanchor: 100)
+      free = FT::SlidingDFT.new(64, reanchor: false)
+      anchored.reanchor_interval.should == 100
+      free.reanchor_interval.should be_nil
+      anchored.push(samples)
+      free.push(samples)
+      expected = samples[-64..-1].real_fft
+      drift = (0..32).map { |k| Math.hypot(free.spectrum.first[k] - expected.first[k], free.spectrum.last[k] - expected.last[k]) }.max
+      error = (0..32).map { |k| Math.hypot(anchored.spectrum.first[k] - expected.first[k], anchored.spectrum.last[k] - expected.last[k]) }.max
+      (error < drift).should == true
+      error.should be_within(@tolerance).of(0.0)
+      free.reanchor.spectrum.first[3].should be_within(@tolerance).of(expected.first[3])
+    end
+
+    it 'should start over after reset and reject bad arguments' do
+      sdft = FT::SlidingDFT.new([1.0, 2.0, 3.0])
+      sdft.spectrum.first.first.should be_within(@tolerance).of(6.0)
+      sdft.reset.spectrum.should == [[0.0, 0.0], [0.0, 0.0]]
+      sdft.window_length.should == 3
+      lambda { FT::SlidingDFT.new(0) }.should raise_error(ArgumentError)
+      lambda { FT::SlidingDFT.new(8, bins: [8]) }.should raise_error(ArgumentError)
+      lambda { FT::SlidingDFT.new(8, reanchor: 0) }.should raise_error(ArgumentError)
+    end
+
+  end
+
+end
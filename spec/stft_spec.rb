@@ -0,0 +1,44 @@
+require 'plymouth'
+require Pathname.pwd.join('lib').join('ft.rb')
+
+describe FT::STFT do
+
+  before do
+    @tolerance = 1.0e-08
+  end
+
+  describe 'streaming STFT' do
+
+    it 'should emit windowed frames every hop samples' do
+      samples = (0...100).map { |i| Math.sin(i * 0.37) + 0.01 * i }
+      stft = FT::STFT.new(16, hop: 6, window: :hann, output: :complex)
+      frames = []
+      samples.each_slice(7) { |chunk| frames.concat(stft.push(chunk)) }
+      frames.length.should == (100 - 16) / 6 + 1
+      frames.each_with_index do |frame, f|
+        windowed = (0...16).map { |n| samples[f * 6 + n] * (0.5 - 0.5 * Math.cos(2.0 * Math::PI * n / 16)) }
+        expected = windowed.real_fft
+        9.times do |k|
+          frame.first[k].should be_within(@tolerance).of(expected.first[k])
+          frame.last[k].should be_within(@tolerance).of(expected.last[k])
+        end
+      end
+    end
+
+    it 'should emit magnitudes and start over after reset' do
+      samples = (0...40).map { |i| Math.cos(i * 1.1) }
+      stft = FT::STFT.new(10, hop: 10, window: :rectangular)
+      frames = stft.push(samples)
+      frames.length.should == 4
+      expected = samples[10, 10].real_fft
+      6.times do |k|
+        frames[1][k].should be_within(@tolerance).of(Math.hypot(expected.first[k], expected.last[k]))
+      end
+      stft.reset
+      stft.push(samples[0, 9]).length.should == 0
+      stft.push([0.0]).length.should == 1
+    end
+
+  end
+
+end
@@ -20,6 +20,48 @@ describe Array do
                                       [1.0, 1.0, 1.0, 1.0]])
     end
 
+    it 'should shift 1D, 2D and 3D data of odd and even sizes' do
+      [1, 2, 5, 6].each do |n|
+        data = (0...n).map(&:to_f)
+        data.fftshift.should eq(data.rotate(n - n / 2))
+        data.fftshift.ifftshift.should eq(data)
+      end
+      data = [[1.0, 2.0, 3.0],
+              [4.0, 5.0, 6.0],
+              [7.0, 8.0, 9.0]]
+      data.fftshift.should eq([[9.0, 7.0, 8.0],
+                               [3.0, 1.0, 2.0],
+                               [6.0, 4.0, 5.0]])
+      data.switch_quarters.should eq(data.fftshift)
+      data.fftshift.ifftshift.should eq(data)
+      cube = (0...3).map { |i| (0...4).map { |j| (0...5).map { |k| (i * 100 + j * 10 + k).to_f } } }
+      shifted = cube.fftshift
+      3.times do |i|
+        4.times do |j|
+          5.times { |k| shifted[i][j][k].should eq(cube[(i + 2) % 3][(j + 2) % 4][(k + 3) % 5]) }
+        end
+      end
+      shifted.ifftshift.should eq(cube)
+      [[1.0, 2.0], [3.0]].fftshift.should be_nil
+    end
+
+    it 'should shift the output of transforms' do
+      data = [(0...7).map { |i| Math.sin(i * 1.3) }, (0...7).map { |i| 0.5 * i }]
+      expected = data.fft.map(&:fftshift)
+      result = data.fft(shift: true)
+      2.times { |p| 7.times { |k| result[p][k].should be_within(@tolerance).of(expected[p][k]) } }
+      magnitude = data.fft_magnitude(shift: true)
+      7.times { |k| magnitude[k].should be_within(@tolerance).of(data.fft_magnitude.fftshift[k]) }
+      data2d = [[[1.0, 2.0, 0.0], [3.0, 1.0, 5.0]], [[0.0, 1.0, 0.0], [2.0, 0.0, 1.0]]]
+      expected = data2d.fft2d.map(&:fftshift)
+      result = data2d.fft2d(shift: true)
+      2.times { |p| 2.times { |j| 3.times { |k| result[p][j][k].should be_within(@tolerance).of(expected[p][j][k]) } } }
+    end
+
+    it 'should return nil for shifted transforms of empty axes' do
+      [[[]], [[]]].fft2d(shift: true).should be_nil
+    end
+
     it 'should calculate magnitude properly' do
       data = [[3.0, 1.0, 1.0, 2.0],
               [4.0, 2.0, 1.0, 0.0]]
@@ -39,6 +81,40 @@ describe Array do
       end
     end
 
+    it 'should calculate fused spectrum of complex data' do
+      data = [(0...12).map { |i| Math.sin(i * 0.8) }, (0...12).map { |i| 0.1 * i }]
+      spectrum = data.fft
+      magnitude = spectrum.magnitude
+      phase = spectrum.transpose.map { |real, imag| Math.atan2(imag, real) }
+      result = data.fft_magnitude
+      result.length.should == 12
+      polar = data.fft_polar
+      power = data.fft_power_db
+      12.times do |k|
+        result[k].should be_within(@tolerance).of(magnitude[k])
+        polar.first[k].should be_within(@tolerance).of(magnitude[k])
+        polar.last[k].should be_within(@tolerance).of(phase[k])
+        power[k].should be_within(@tolerance).of(20.0 * Math.log10(magnitude[k]))
+      end
+      data.fft_magnitude(one_sided: true).length.should == 7
+    end
+
+    it 'should calculate fused spectrum of real data' do
+      data = (0...37).map { |i| Math.cos(i * 0.4) + 0.2 }
+      magnitude = [data, [0.0] * 37].fft.magnitude
+      [false, true].each do |one_sided|
+        result = data.fft_magnitude(one_sided: one_sided)
+        result.length.should == (one_sided ? 19 : 37)
+        result.each_with_index { |value, k| value.should be_within(@tolerance).of(magnitude[k]) }
+      end
+    end
+
+    it 'should return nil for fused spectrum of invalid data' do
+      [[1.0, 2.0], 5].fft_magnitude.should be_nil
+      [[1.0, 2.0], 5].fft_polar.should be_nil
+      [[1.0, 2.0], [1.0]].fft_power_db.should be_nil
+    end
+
   end
 
 end
@@ -0,0 +1,74 @@
+require 'plymouth'
+require Pathname.pwd.join('lib').join('ft.rb')
+
+describe Array do
+
+  before do
+    @tolerance = 1.0e-08
+  end
+
+  def volume(a, b, c)
+    (0...a).map { |i| (0...b).map { |j| (0...c).map { |k| yield(i, j, k) } } }
+  end
+
+  def dft3d(real, imag)
+    a, b, c = real.length, real[0].length, real[0][0].length
+    out = [volume(a, b, c) { 0.0 }, volume(a, b, c) { 0.0 }]
+    a.times { |u| b.times { |v| c.times { |w|
+      a.times { |i| b.times { |j| c.times { |k|
+        arg = -2.0 * Math::PI * (u * i / a.to_f + v * j / b.to_f + w * k / c.to_f)
+        out[0][u][v][w] += real[i][j][k] * Math.cos(arg) - imag[i][j][k] * Math.sin(arg)
+        out[1][u][v][w] += real[i][j][k] * Math.sin(arg) + imag[i][j][k] * Math.cos(arg)
+      } } }
+    } } }
+    out
+  end
+
+  describe 'N-dimensional Fast Fourier Transform' do
+
+    it 'should calculate 3D FFT and reverse it' do
+      data = [volume(3, 4, 5) { |i, j, k| Math.sin(i + 2 * j + 0.3 * k) },
+              volume(3, 4, 5) { |i, j, k| 0.1 * (i - j + k) }]
+      expected = dft3d(*data)
+      result = data.fftnd
+      2.times { |p| 3.times { |i| 4.times { |j| 5.times { |k|
+        result[p][i][j][k].should be_within(@tolerance).of(expected[p][i][j][k])
+      } } } }
+      back = result.rfftnd
+      2.times { |p| 3.times { |i| 4.times { |j| 5.times { |k|
+        back[p][i][j][k].should be_within(@tolerance).of(data[p][i][j][k])
+      } } } }
+    end
+
+    it 'should match 2D transforms' do
+      data = [[[1.0, 2.0, 0.0, 4.0], [3.0, 1.0, 5.0, 2.0]], [[0.0, 1.0, 0.0, 1.0], [2.0, 0.0, 1.0, 0.0]]]
+      expected = data.fft2d
+      result = data.fftnd
+      2.times { |p| 2.times { |j| 4.times { |k| result[p][j][k].should be_within(@tolerance).of(expected[p][j][k]) } } }
+      hartley = [[1.0, 2.0, 0.0, 4.0], [3.0, 1.0, 5.0, 2.0]]
+      expected = hartley.fht2d
+      result = hartley.fhtnd
+      2.times { |j| 4.times { |k| result[j][k].should be_within(@tolerance).of(expected[j][k]) } }
+      result.fhtnd.each_with_index { |row, j| row.each_with_index { |value, k| value.should be_within(@tolerance).of(hartley[j][k]) } }
+    end
+
+    it 'should transform strided buffers in place' do
+      data = [volume(2, 3, 4) { |i, j, k| i + j * 0.5 - k }, volume(2, 3, 4) { |i, j, k| (i * j * k) % 3 }]
+      expected = data.fftnd
+      # column-major layout of the volume
+      packed = []
+      4.times { |k| 3.times { |j| 2.times { |i| packed << data[0][i][j][k] << data[1][i][j][k] } } }
+      output = FT.fftnd_buffer(packed.pack('E*'), [2, 3, 4], strides: [1, 2, 6]).unpack('E*')
+      4.times { |k| 3.times { |j| 2.times { |i|
+        index = 2 * (i + 2 * j + 6 * k)
+        output[index].should be_within(@tolerance).of(expected[0][i][j][k])
+        output[index + 1].should be_within(@tolerance).of(expected[1][i][j][k])
+      } } }
+      back = FT.rfftnd_buffer(output.pack('E*'), [2, 3, 4], strides: [1, 2, 6]).unpack('E*')
+      back.each_with_index { |value, n| value.should be_within(@tolerance).of(packed[n]) }
+      lambda { FT.fftnd_buffer(packed.pack('E*'), [3, 3, 4]) }.should raise_error(ArgumentError)
+    end
+
+  end
+
+end
@@ -0,0 +1,96 @@
+require 'plymouth'
+require 'tmpdir'
+require Pathname.pwd.join('lib').join('ft.rb')
+
+describe FT do
+
+  before do
+    @tolerance = 1.0e-08
+    FT.forget_wisdom
+  end
+
+  after do
+    FT.forget_wisdom
+  end
+
+  def check_fft(length)
+    data = [(0...length).map { |i| Math.sin(i * 0.3) }, (0...length).map { |i| Math.cos(i * 0.7) }]
+    expected = data.dft
+    [data.fft, FT::Plan.new(length).execute(data)].each do |result|
+      result.flatten.zip(expected.flatten).each { |a, b| a.should be_within(@tolerance).of(b) }
+    end
+    FT::Plan.new(length, :reverse).execute(data.fft).flatten.zip(data.flatten).each { |a, b| a.should be_within(@tolerance).of(b) }
+  end
+
+  describe 'wisdom' do
+
+    it 'should measure the fastest algorithm of a length and use it in plans' do
+      FT.wisdom.should == []
+      FT::Plan.new(96).algorithm.should == :mixed_radix
+      [32, 96, 97].each do |length|
+        wisdom = FT.tune(length)
+        wisdom[:length].should == length
+        [:radix2, :mixed_radix, :bluestein, :four_step].include?(wisdom[:algorithm]).should == true
+        (wisdom[:time] > 0.0).should == true
+        FT::Plan.new(length).algorithm.should == wisdom[:algorithm]
+        FT.simd_available.include?(wisdom[:simd]).should == true if wisdom[:simd]
+        check_fft(length)
+      end
+      FT.wisdom.map { |wisdom| wisdom[:length] }.should == [32, 96, 97]
+      lambda { FT.tune(1) }.should raise_error(ArgumentError)
+    end
+
+    it 'should compute the same transforms with every imported strategy' do
+      ['1024 four_step default 1 0', '1024 mixed_radix default 1 0', '64 radix2 scalar 0 0',
+       '60 bluestein default 1 0', '300 mixed_radix default 1 0'].each do |line|
+        FT.import_wisdom_string(line).should == 1
+        length = line.to_i
+        FT::Plan.new(length).algorithm.to_s.should == line.split[1]
+        check_fft(length)
+        FT.forget_wisdom
+      end
+    end
+
+    it 'should export and import wisdom' do
+      FT.tune(256)
+      FT.import_wisdom_string("# comment\n\n100 mixed_radix default 1 1.5e-06\n").should == 1
+      text = FT.export_wisdom
+      text.lines.first.should == "# ft wisdom 1\n"
+      text.lines.length.should == 3
+      Dir.mktmpdir do |dir|
+        path = File.join(dir, 'wisdom.txt')
+        FT.export_wisdom(path).should == text
+        exported = FT.wisdom
+        FT.forget_wisdom
+        FT.wisdom.should == []
+        FT.import_wisdom(path).should == 2
+        FT.wisdom.map { |wisdom| wisdom.reject { |key, _| key == :time } }.should == exported.map { |wisdom| wisdom.reject { |key, _| key == :time } }
+        FT.wisdom.first[:time].should be_within(1.0e-12).of(1.5e-06)
+      end
+    end
+
+    it 'should skip wisdom this CPU or length cannot use and reject invalid text' do
+      FT.import_wisdom_string("100 radix2 scalar 1 0\n64 bluestein default 1 0\n128 four_step default 1 0\n").should == 0
+      FT.wisdom.should == []
+      lambda { FT.import_wisdom_string("64 radix3 scalar 1 0\n") }.should raise_error(ArgumentError)
+      lambda { FT.import_wisdom_string("64 radix2\n") }.should raise_error(ArgumentError)
+      FT.wisdom.should == []
+    end
+
+    it 'should run the inner plans of a Bluestein plan on the scratch memory of each thread' do
+      FT.import_wisdom_string("4096 mixed_radix default 1 1.0e-06\n").should == 1
+      FT.threads = 4
+      length = 1031
+      list = (1..256).map { |k| (0...2 * length).map { |i| Math.sin(i * 0.01 * k) } }
+      result = FT.fft_batch_buffer(list.flatten.pack('E*'), length).unpack('E*').each_slice(2 * length).to_a
+      FT.threads = nil
+      plan = FT::Plan.new(length)
+      plan.algorithm.should == :bluestein
+      list.zip(result).each do |data, output|
+        plan.execute_buffer(data.pack('E*')).unpack('E*').zip(output).each { |a, b| a.should be_within(1.0e-06).of(b) }
+      end
+    end
+
+  end
+
+end
@@ -0,0 +1,76 @@
+require 'plymouth'
+require Pathname.pwd.join('lib').join('ft.rb')
+
+describe FT::ZoomFFT do
+
+  before do
+    @tolerance = 1.0e-08
+  end
+
+  def dft_at(real, imag, bin)
+    n = real.length
+    (0...n).inject([0.0, 0.0]) do |(re, im), k|
+      arg = -2.0 * Math::PI * bin * k / n
+      [re + real[k] * Math.cos(arg) - imag[k] * Math.sin(arg), im + real[k] * Math.sin(arg) + imag[k] * Math.cos(arg)]
+    end
+  end
+
+  describe 'zoom FFT' do
+
+    it 'should calculate evenly spaced bins of a band like the DFT' do
+      [[100, 10.25, 14.75, 19], [37, 0.0, 36.0, 37], [64, 30.0, 2.0, 8], [50, 7.5, 7.5, 1]].each do |n, f0, f1, count|
+        real = (0...n).map { |i| Math.sin(i * 0.7) + 0.1 * i }
+        imag = (0...n).map { |i| Math.cos(i * 0.2) }
+        result = [real, imag].zoom_fft(f0, f1, count)
+        result.first.length.should == count
+        count.times do |j|
+          expected = dft_at(real, imag, count > 1 ? f0 + j * (f1 - f0) / (count - 1) : f0)
+          result.first[j].should be_within(@tolerance).of(expected.first)
+          result.last[j].should be_within(@tolerance).of(expected.last)
+        end
+      end
+    end
+
+    it 'should calculate the zoom FFT of real data and frequencies in units of the sample rate' do
+      samples = (0...80).map { |i| Math.cos(2.0 * Math::PI * 12.3 * i / 400.0) }
+      result = samples.zoom_fft(50.0, 70.0, 41, sample_rate: 400.0)
+      complex = [samples, [0.0] * 80].zoom_fft(10.0, 14.0, 41)
+      41.times do |j|
+        result.first[j].should be_within(@tolerance).of(complex.first[j])
+        result.last[j].should be_within(@tolerance).of(complex.last[j])
+      end
+      plan = FT::ZoomFFT.new(80, 50.0, 70.0, 41, sample_rate: 400.0)
+      plan.length.should == 80
+      plan.count.should == 41
+      plan.frequencies.last.should be_within(@tolerance).of(70.0)
+      plan.execute(samples).should == result
+      plan.execute(samples[0, 79]).should be_nil
+    end
+
+    it 'should calculate the zoom FFT of buffers' do
+      real = (0...30).map { |i| Math.sin(i * 1.3) }
+      imag = (0...30).map { |i| 0.5 * i }
+      plan = FT::ZoomFFT.new(30, 3.0, 4.0, 5)
+      expected = plan.execute([real, imag])
+      output = plan.execute_buffer([real, imag].transpose.flatten.pack('E*')).unpack('E*')
+      single = plan.execute_buffer([real, imag].transpose.flatten.pack('e*'), precision: :float32).unpack('e*')
+      5.times do |j|
+        output[2 * j].should be_within(@tolerance).of(expected.first[j])
+        output[2 * j + 1].should be_within(@tolerance).of(expected.last[j])
+        single[2 * j].should be_within(1.0e-03).of(expected.first[j])
+      end
+      plan.execute_buffer([1.0, 2.0].pack('E*')).should be_nil
+    end
+
+    it 'should return nil for empty or invalid data and reject bad arguments' do
+      [].zoom_fft(0.0, 1.0, 2).should be_nil
+      [[1.0, 2.0], 5].zoom_fft(0, 1, 4).should be_nil
+      FT::ZoomFFT.new(2, 0, 1, 4).execute([[1.0, 2.0], 5]).should be_nil
+      lambda { [1.0, 2.0].zoom_fft(0.0, 1.0, 0) }.should raise_error(ArgumentError)
+      lambda { [1.0, 2.0].zoom_fft(0.0, 1.0, 2, sample_rate: 0) }.should raise_error(ArgumentError)
+      lambda { FT::ZoomFFT.new(0, 0.0, 1.0, 2) }.should raise_error(ArgumentError)
+    end
+
+  end
+
+end